@@ -31,14 +31,21 @@
 
 #include <djvAV/AVSystem.h>
 #include <djvAV/IO.h>
+#include <djvAV/Transcode.h>
 
 #include <djvCore/Context.h>
 #include <djvCore/Error.h>
+#include <djvCore/FileIO.h>
 #include <djvCore/FileInfo.h>
+#include <djvCore/PicoJSON.h>
+#include <djvCore/StringFormat.h>
 #include <djvCore/TextSystem.h>
 #include <djvCore/Timer.h>
 #include <djvCore/Vector.h>
 
+#include <future>
+#include <thread>
+
 using namespace djv;
 
 namespace djv
@@ -46,6 +53,30 @@ namespace djv
     //! This namespace provides functionality for djv_convert.
     namespace convert
     {
+        //! This struct provides the options for a conversion job.
+        struct JobOptions
+        {
+            Core::FileSystem::FileInfo input;
+            Core::FileSystem::FileInfo output;
+            AV::Image::Size resize;
+            bool readSeq = false;
+            bool writeSeq = false;
+            bool cpuConvert = false;
+        };
+
+        //! This struct provides a conversion job.
+        struct Job
+        {
+            JobOptions options;
+            std::shared_ptr<AV::IO::IRead> read;
+            std::future<AV::IO::Info> info;
+            std::shared_ptr<AV::IO::IWrite> write;
+            std::shared_ptr<AV::IO::Transcode> transcode;
+            AV::IO::TranscodeStats stats;
+            std::string error;
+            bool finished = false;
+        };
+
         class Application : public CmdLine::Application
         {
             DJV_NON_COPYABLE(Application);
@@ -55,6 +86,8 @@ namespace djv
             {
                 CmdLine::Application::_init(args);
 
+                std::string batch;
+                JobOptions jobOptions;
                 auto i = args.begin();
                 while (i != args.end())
                 {
@@ -65,17 +98,17 @@ namespace djv
                         std::stringstream ss(*i);
                         ss >> resize;
                         i = args.erase(i);
-                        _resize.reset(new AV::Image::Size(resize));
+                        jobOptions.resize = resize;
                     }
                     else if ("-readSeq" == *i)
                     {
                         i = args.erase(i);
-                        _readSeq = true;
+                        jobOptions.readSeq = true;
                     }
                     else if ("-writeSeq" == *i)
                     {
                         i = args.erase(i);
-                        _writeSeq = true;
+                        jobOptions.writeSeq = true;
                     }
                     else if ("-readQueue" == *i)
                     {
@@ -113,23 +146,50 @@ namespace djv
                         i = args.erase(i);
                         _writeThreadCount = std::max(value, 1);
                     }
+                    else if ("-cpuConvert" == *i)
+                    {
+                        i = args.erase(i);
+                        jobOptions.cpuConvert = true;
+                    }
+                    else if ("-batch" == *i)
+                    {
+                        i = args.erase(i);
+                        batch = *i;
+                        i = args.erase(i);
+                    }
+                    else if ("-jobs" == *i)
+                    {
+                        i = args.erase(i);
+                        int value = 0;
+                        std::stringstream ss(*i);
+                        ss >> value;
+                        i = args.erase(i);
+                        _jobCount = std::max(value, 1);
+                    }
                     else
                     {
                         ++i;
                     }
                 }
 
-                if (!args.size())
+                if (!batch.empty() && !args.size())
+                {
+                    _readBatchFile(batch, jobOptions);
+                }
+                else if (!args.size())
                 {
                     printUsage();
                     exit(1);
                 }
-                else if (2 == args.size())
+                else if (batch.empty() && 2 == args.size())
                 {
-                    _input = args.front();
+                    jobOptions.input = args.front();
                     args.pop_front();
-                    _output = args.front();
+                    jobOptions.output = args.front();
                     args.pop_front();
+                    auto job = std::make_shared<Job>();
+                    job->options = jobOptions;
+                    _jobs.push_back(job);
                 }
                 else
                 {
@@ -160,6 +220,7 @@ namespace djv
                 std::cout << " " << textSystem->getText(DJV_TEXT("djv_convert_usage")) << std::endl;
                 std::cout << std::endl;
                 std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_usage_format")) << std::endl;
+                std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_usage_format_batch")) << std::endl;
                 std::cout << std::endl;
                 std::cout << " " << textSystem->getText(DJV_TEXT("djv_convert_options")) << std::endl;
                 std::cout << std::endl;
@@ -184,62 +245,52 @@ namespace djv
                 std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_option_writethreads")) << std::endl;
                 std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_option_writethreads_description")) << std::endl;
                 std::cout << std::endl;
+                std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_option_cpuconvert")) << std::endl;
+                std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_option_cpuconvert_description")) << std::endl;
+                std::cout << std::endl;
+                std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_option_batch")) << std::endl;
+                std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_option_batch_description")) << std::endl;
+                std::cout << std::endl;
+                std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_option_jobs")) << std::endl;
+                std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_option_jobs_description")) << std::endl;
+                std::cout << std::endl;
 
                 CmdLine::Application::printUsage();
             }
 
             void run() override
             {
-                auto io = getSystemT<AV::IO::System>();
-                if (_readSeq)
-                {
-                    _input.evalSequence();
-                }
-                AV::IO::ReadOptions readOptions;
-                readOptions.videoQueueSize = _readQueueSize;
-                _read = io->read(_input, readOptions);
-                _read->setThreadCount(_readThreadCount);
-                auto info = _read->getInfo().get();
-                auto& video = info.video;
-                auto textSystem = getSystemT<Core::TextSystem>();
-                if (!video.size())
-                {
-                    throw std::invalid_argument(textSystem->getText(DJV_TEXT("djv_convert_nothing_convert")));
-                }
-                auto& videoInfo = video[0];
-                if (_resize)
-                {
-                    video[0].info.size = *_resize;
-                }
-                const size_t size = videoInfo.sequence.getSize();
-                if (_writeSeq)
+                // All of the jobs share the I/O system thread pool and the
+                // image data pool. By default the cores are divided between
+                // the jobs that run concurrently, so that the number of
+                // tasks in flight stays close to the number of cores.
+                const size_t threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+                if (!_jobCount)
                 {
-                    _output.evalSequence();
+                    _jobCount = _jobs.size() > 1 ? std::max(threadCount / 4, static_cast<size_t>(1)) : 1;
                 }
-                AV::IO::WriteOptions writeOptions;
-                writeOptions.videoQueueSize = _writeQueueSize;
-                _write = io->write(_output, info, writeOptions);
-                _write->setThreadCount(_writeThreadCount);
+                _jobCount = std::min(_jobCount, _jobs.size());
+                const size_t jobThreadCount = std::max(threadCount / std::max(_jobCount, static_cast<size_t>(1)), static_cast<size_t>(1));
+                _jobReadThreadCount = _readThreadCount ? _readThreadCount : jobThreadCount;
+                _jobWriteThreadCount = _writeThreadCount ? _writeThreadCount : jobThreadCount;
+
+                _startTime = std::chrono::steady_clock::now();
+                _startJobs();
 
                 _statsTimer = Core::Time::Timer::create(shared_from_this());
                 _statsTimer->setRepeating(true);
                 _statsTimer->start(
                     Core::Time::getTime(Core::Time::TimerValue::Slow),
-                    [this, size](const std::chrono::steady_clock::time_point&, const Core::Time::Unit&)
+                    [this](const std::chrono::steady_clock::time_point&, const Core::Time::Unit&)
                     {
-                        Core::Frame::Number frame = 0;
+                        for (size_t i = 0; i < _jobs.size(); ++i)
                         {
-                            std::lock_guard<std::mutex> lock(_read->getMutex());
-                            auto& queue = _read->getVideoQueue();
-                            if (!queue.isEmpty())
+                            const auto& job = _jobs[i];
+                            if (job->transcode && !job->finished)
                             {
-                                frame = queue.getFrame().frame;
+                                _printJob(i, job->transcode->getStats());
                             }
                         }
-                        if (frame && size)
-                        {
-                            std::cout << static_cast<size_t>(frame / static_cast<float>(size - 1) * 100.F) << "%" << std::endl;
-                        }
                     });
 
                 CmdLine::Application::run();
@@ -248,45 +299,329 @@ namespace djv
             void tick(const std::chrono::steady_clock::time_point& t, const Core::Time::Unit& dt) override
             {
                 CmdLine::Application::tick(t, dt);
-                if (_read && _write)
+                if (_statsTimer)
+                {
+                    for (size_t i = 0; i < _jobs.size(); ++i)
+                    {
+                        auto& job = _jobs[i];
+                        if (job->finished)
+                        {
+                            continue;
+                        }
+                        if (job->info.valid() &&
+                            job->info.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                        {
+                            // Start the transcode once the information has been
+                            // read, without blocking the other jobs.
+                            try
+                            {
+                                _startTranscode(*job);
+                            }
+                            catch (const std::exception& e)
+                            {
+                                job->error = Core::Error::format(e);
+                                _finishJob(i);
+                            }
+                        }
+                        else if (job->transcode && !job->transcode->isRunning())
+                        {
+                            // The transcode error includes the writer failing.
+                            job->stats = job->transcode->getStats();
+                            job->error = job->transcode->getError();
+                            _finishJob(i);
+                        }
+                    }
+                    _startJobs();
+                    if (_finishedCount == _jobs.size())
+                    {
+                        _statsTimer.reset();
+                        size_t errorCount = 0;
+                        for (const auto& job : _jobs)
+                        {
+                            if (!job->error.empty())
+                            {
+                                ++errorCount;
+                            }
+                        }
+                        if (_jobs.size() > 1)
+                        {
+                            _printBatch(errorCount);
+                        }
+                        exit(errorCount ? 1 : 0);
+                    }
+                }
+            }
+
+        private:
+            void _readBatchFile(const std::string& fileName, const JobOptions& defaults)
+            {
+                // The batch file is a JSON array of objects with the input and
+                // output file names and any of the per-job options, for example:
+                //
+                // [
+                //     { "input": "a.mov", "output": "a.1.tif", "writeSeq": "true" },
+                //     { "input": "b.mov", "output": "b.1.tif", "resize": "960 540" }
+                // ]
+                //
+                // Options that are not given default to the command line.
+                auto textSystem = getSystemT<Core::TextSystem>();
+                try
                 {
-                    std::unique_lock<std::mutex> readLock(_read->getMutex(), std::try_to_lock);
-                    if (readLock.owns_lock())
+                    auto fileIO = Core::FileSystem::FileIO::create();
+                    fileIO->open(fileName, Core::FileSystem::FileIO::Mode::Read);
+                    std::vector<char> buf;
+                    const size_t fileSize = fileIO->getSize();
+                    buf.resize(fileSize);
+                    fileIO->read(buf.data(), fileSize);
+                    const char* bufP = buf.data();
+                    const char* bufEnd = bufP + fileSize;
+
+                    picojson::value v;
+                    std::string error;
+                    picojson::parse(v, bufP, bufEnd, &error);
+                    if (!error.empty())
+                    {
+                        throw std::invalid_argument(error);
+                    }
+                    if (!v.is<picojson::array>())
                     {
-                        std::lock_guard<std::mutex> writeLock(_write->getMutex());
-                        auto& readQueue = _read->getVideoQueue();
-                        auto& writeQueue = _write->getVideoQueue();
-                        if (!readQueue.isEmpty() && writeQueue.getCount() < writeQueue.getMax())
+                        throw std::invalid_argument(DJV_TEXT("error_cannot_parse_the_value"));
+                    }
+                    for (const auto& i : v.get<picojson::array>())
+                    {
+                        if (!i.is<picojson::object>())
+                        {
+                            throw std::invalid_argument(DJV_TEXT("error_cannot_parse_the_value"));
+                        }
+                        JobOptions options = defaults;
+                        std::string input;
+                        std::string output;
+                        for (const auto& j : i.get<picojson::object>())
                         {
-                            auto frame = readQueue.popFrame();
-                            writeQueue.addFrame(frame);
-                        } 
-                        else if (readQueue.isFinished())
+                            if ("input" == j.first)
+                            {
+                                fromJSON(j.second, input);
+                            }
+                            else if ("output" == j.first)
+                            {
+                                fromJSON(j.second, output);
+                            }
+                            else if ("resize" == j.first)
+                            {
+                                std::string value;
+                                fromJSON(j.second, value);
+                                std::stringstream ss(value);
+                                ss >> options.resize;
+                            }
+                            else if ("readSeq" == j.first)
+                            {
+                                fromJSON(j.second, options.readSeq);
+                            }
+                            else if ("writeSeq" == j.first)
+                            {
+                                fromJSON(j.second, options.writeSeq);
+                            }
+                            else if ("cpuConvert" == j.first)
+                            {
+                                fromJSON(j.second, options.cpuConvert);
+                            }
+                        }
+                        if (input.empty() || output.empty())
                         {
-                            writeQueue.setFinished(true);
+                            throw std::invalid_argument(textSystem->getText(DJV_TEXT("djv_convert_output_error")));
                         }
+                        options.input = input;
+                        options.output = output;
+                        auto job = std::make_shared<Job>();
+                        job->options = options;
+                        _jobs.push_back(job);
                     }
                 }
-                if (_write && !_write->isRunning())
+                catch (const std::exception& e)
                 {
-                    exit(0);
+                    throw std::runtime_error(Core::String::Format(textSystem->getText(DJV_TEXT("djv_convert_batch_error"))).
+                        arg(fileName).
+                        arg(textSystem->getText(e.what())));
+                }
+                if (!_jobs.size())
+                {
+                    throw std::invalid_argument(textSystem->getText(DJV_TEXT("djv_convert_nothing_convert")));
                 }
             }
 
-        private:
-            Core::FileSystem::FileInfo _input;
-            Core::FileSystem::FileInfo _output;
-            std::unique_ptr<AV::Image::Size> _resize;
-            bool _readSeq = false;
-            bool _writeSeq = false;
-            //! \todo What's a good default for this?
-            size_t _readQueueSize = 10;
-            size_t _writeQueueSize = 10;
-            size_t _readThreadCount = 4;
-            size_t _writeThreadCount = 4;
-            std::shared_ptr<AV::IO::IRead> _read;
+            void _startJobs()
+            {
+                while (_nextJob < _jobs.size() && _nextJob - _finishedCount < _jobCount)
+                {
+                    const size_t index = _nextJob++;
+                    auto& job = _jobs[index];
+                    try
+                    {
+                        _startJob(*job);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        job->read.reset();
+                        job->write.reset();
+                        job->error = Core::Error::format(e);
+                        _finishJob(index);
+                    }
+                }
+            }
+
+            void _startJob(Job& job)
+            {
+                auto io = getSystemT<AV::IO::System>();
+                if (job.options.readSeq)
+                {
+                    job.options.input.evalSequence();
+                }
+                AV::IO::ReadOptions readOptions;
+                readOptions.videoQueueSize = _readQueueSize ? _readQueueSize : (_jobReadThreadCount * 2);
+                job.read = io->read(job.options.input, readOptions);
+                job.read->setThreadCount(_jobReadThreadCount);
+                job.info = job.read->getInfo();
+            }
+
+            void _startTranscode(Job& job)
+            {
+                auto io = getSystemT<AV::IO::System>();
+                auto info = job.info.get();
+                auto& video = info.video;
+                auto textSystem = getSystemT<Core::TextSystem>();
+                if (!video.size())
+                {
+                    throw std::invalid_argument(textSystem->getText(DJV_TEXT("djv_convert_nothing_convert")));
+                }
+                if (job.options.resize.isValid())
+                {
+                    video[0].info.size = job.options.resize;
+                }
+                if (job.options.writeSeq)
+                {
+                    job.options.output.evalSequence();
+                }
+                AV::IO::WriteOptions writeOptions;
+                writeOptions.videoQueueSize = _writeQueueSize ? _writeQueueSize : (_jobWriteThreadCount * 2);
+                if (job.options.cpuConvert)
+                {
+                    writeOptions.convertBackend = AV::Image::ConvertBackend::CPU;
+                }
+                job.write = io->write(job.options.output, info, writeOptions);
+                job.write->setThreadCount(_jobWriteThreadCount);
+
+                AV::IO::TranscodeOptions transcodeOptions;
+                transcodeOptions.resize = job.options.resize;
+                transcodeOptions.threadPool = io->getThreadPool();
+                job.transcode = AV::IO::Transcode::create(job.read, info, job.write, transcodeOptions);
+            }
+
+            void _finishJob(size_t index)
+            {
+                auto& job = _jobs[index];
+                job->finished = true;
+                job->transcode.reset();
+                job->read.reset();
+                job->write.reset();
+                ++_finishedCount;
+                _printJob(index, job->stats);
+                if (!job->error.empty())
+                {
+                    auto textSystem = getSystemT<Core::TextSystem>();
+                    std::cout << textSystem->getText(job->error) << std::endl;
+                }
+            }
+
+            std::string _getStatsText(const AV::IO::TranscodeStats& stats) const
+            {
+                auto textSystem = getSystemT<Core::TextSystem>();
+                std::stringstream frames;
+                frames << stats.frameCount << "/" << stats.frameTotal;
+                std::stringstream fps;
+                fps.precision(2);
+                fps << std::fixed << stats.getFramesPerSecond();
+                std::stringstream megabytes;
+                megabytes.precision(2);
+                megabytes << std::fixed << stats.getMegabytesPerSecond();
+                std::stringstream read;
+                read << static_cast<int>(stats.getReadUtilization() * 100.F);
+                std::stringstream resize;
+                resize << static_cast<int>(stats.getResizeUtilization() * 100.F);
+                std::stringstream write;
+                write << static_cast<int>(stats.getWriteUtilization() * 100.F);
+                return Core::String::Format(textSystem->getText(DJV_TEXT("djv_convert_stats"))).
+                    arg(frames.str()).
+                    arg(fps.str()).
+                    arg(megabytes.str()).
+                    arg(read.str()).
+                    arg(resize.str()).
+                    arg(write.str());
+            }
+
+            void _printJob(size_t index, const AV::IO::TranscodeStats& stats)
+            {
+                if (_jobs.size() > 1)
+                {
+                    const auto& job = _jobs[index];
+                    auto textSystem = getSystemT<Core::TextSystem>();
+                    std::stringstream time;
+                    time.precision(2);
+                    time << std::fixed << stats.time;
+                    std::cout << std::string(Core::String::Format(textSystem->getText(DJV_TEXT("djv_convert_job"))).
+                        arg(std::to_string(index + 1)).
+                        arg(std::to_string(_jobs.size())).
+                        arg(std::string(job->options.input)).
+                        arg(std::string(job->options.output)).
+                        arg(time.str()).
+                        arg(_getStatsText(stats))) << std::endl;
+                }
+                else
+                {
+                    std::cout << _getStatsText(stats) << std::endl;
+                }
+            }
+
+            void _printBatch(size_t errorCount)
+            {
+                AV::IO::TranscodeStats stats;
+                for (const auto& job : _jobs)
+                {
+                    stats.frameCount += job->stats.frameCount;
+                    stats.frameTotal += job->stats.frameTotal;
+                    stats.byteCount += job->stats.byteCount;
+                }
+                stats.time = std::chrono::duration<float>(std::chrono::steady_clock::now() - _startTime).count();
+                auto textSystem = getSystemT<Core::TextSystem>();
+                std::stringstream time;
+                time.precision(2);
+                time << std::fixed << stats.time;
+                std::stringstream fps;
+                fps.precision(2);
+                fps << std::fixed << stats.getFramesPerSecond();
+                std::stringstream megabytes;
+                megabytes.precision(2);
+                megabytes << std::fixed << stats.getMegabytesPerSecond();
+                std::cout << std::string(Core::String::Format(textSystem->getText(DJV_TEXT("djv_convert_batch_stats"))).
+                    arg(std::to_string(_jobs.size())).
+                    arg(std::to_string(errorCount)).
+                    arg(std::to_string(stats.frameCount)).
+                    arg(time.str()).
+                    arg(fps.str()).
+                    arg(megabytes.str())) << std::endl;
+            }
+
+            std::vector<std::shared_ptr<Job> > _jobs;
+            size_t _jobCount = 0;
+            size_t _nextJob = 0;
+            size_t _finishedCount = 0;
+            size_t _readQueueSize = 0;
+            size_t _writeQueueSize = 0;
+            size_t _readThreadCount = 0;
+            size_t _writeThreadCount = 0;
+            size_t _jobReadThreadCount = 1;
+            size_t _jobWriteThreadCount = 1;
+            std::chrono::steady_clock::time_point _startTime;
             std::shared_ptr<Core::Time::Timer> _statsTimer;
-            std::shared_ptr<AV::IO::IWrite> _write;
         };
 
     } // namespace convert
@@ -232,7 +232,6 @@ namespace djv
         {
             CmdLine::Application::tick(t, dt);
             {
-                std::lock_guard<std::mutex> writeLock(_write->getMutex());
                 auto& writeQueue = _write->getVideoQueue();
                 if (_images.size() && writeQueue.getCount() < writeQueue.getMax())
                 {
@@ -33,9 +33,19 @@ precision mediump float;
 varying vec2 Texture;
 
 uniform sampler2D textureSampler;
+uniform int inputChannels;
+uniform int outputChannels;
 
 void main()
 {
     vec4 t = texture2D(textureSampler, Texture);
+
+    // Luminance textures are already replicated into the color channels.
+    if (outputChannels <= 2 && inputChannels > 2)
+    {
+        float l = (t.r + t.g + t.b) / 3.0;
+        t = vec4(l, l, l, t.a);
+    }
+
     gl_FragColor = t;
 }
@@ -34,9 +34,29 @@ in vec2 Texture;
 out vec4 FragColor;
 
 uniform sampler2D textureSampler;
+uniform int inputChannels;
+uniform int outputChannels;
 
 void main()
 {
     vec4 t = texture(textureSampler, Texture);
+
+    // Luminance textures are stored in the red and green channels.
+    if (1 == inputChannels)
+    {
+        t = vec4(t.r, t.r, t.r, 1.0);
+    }
+    else if (2 == inputChannels)
+    {
+        t = vec4(t.r, t.r, t.r, t.g);
+    }
+
+    // Luminance output is read from the red and green channels.
+    if (outputChannels <= 2)
+    {
+        float l = inputChannels > 2 ? ((t.r + t.g + t.b) / 3.0) : t.r;
+        t = vec4(l, t.a, 0.0, 0.0);
+    }
+
     FragColor = t;
 }
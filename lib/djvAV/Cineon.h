@@ -230,18 +230,22 @@ namespace djv
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
 
+                    //! Read the image data at the given proxy level, or only the
+                    //! scanlines inside of the region of interest.
                     static std::shared_ptr<Image::Image> readImage(
                         const Info&,
-                        const std::shared_ptr<Core::FileSystem::FileIO>&);
+                        const std::shared_ptr<Core::FileSystem::FileIO>&,
+                        size_t proxy = 0,
+                        const Core::BBox2i& roi = Core::BBox2i());
 
                 protected:
                     Info _readInfo(const std::string &) override;
                     std::shared_ptr<Image::Image> _readImage(const std::string &) override;
+                    std::shared_ptr<IDecoderSession> _createSession() override;
 
                 private:
-                    Info _open(const std::string&, const std::shared_ptr<Core::FileSystem::FileIO>&);
-
-                    DJV_PRIVATE();
+                    struct Session;
+                    Info _open(const std::string&, const std::shared_ptr<Core::FileSystem::FileIO>&, Session&);
                 };
 
                 //! This class provides the Cineon file writer.
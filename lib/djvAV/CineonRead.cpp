@@ -30,6 +30,8 @@
 #include <djvAV/Cineon.h>
 
 #include <djvCore/FileIO.h>
+#include <djvCore/FileSystem.h>
+#include <djvCore/TextSystem.h>
 
 using namespace djv::Core;
 
@@ -41,13 +43,17 @@ namespace djv
         {
             namespace Cineon
             {
-                struct Read::Private
+                struct Read::Session : public IDecoderSession
                 {
+                    std::vector<uint8_t> headerData;
+                    std::vector<uint8_t> headerScratch;
+                    Header header;
+                    Info info;
                     ColorProfile colorProfile = ColorProfile::FilmPrint;
+                    bool endianConversion = false;
                 };
 
-                Read::Read() :
-                    _p(new Private)
+                Read::Read()
                 {}
 
                 Read::~Read()
@@ -69,61 +75,125 @@ namespace djv
                 
                 std::shared_ptr<Image::Image> Read::readImage(
                     const Info& info,
-                    const std::shared_ptr<FileSystem::FileIO>& io)
+                    const std::shared_ptr<FileSystem::FileIO>& io,
+                    size_t proxy,
+                    const BBox2i& roi)
                 {
-#if defined(DJV_MMAP)
-                    auto out = Image::Image::create(info.video[0].info, io);
-#else // DJV_MMAP
-                    auto infoTmp = info;
-                    bool convertEndian = false;
-                    if (infoTmp.video[0].info.layout.endian != Memory::getEndian())
+                    std::shared_ptr<Image::Image> out;
+                    if (0 == proxy && Image::Data::canMemoryMap(info.video[0].info, io))
                     {
-                        convertEndian = true;
-                        infoTmp.video[0].info.layout.endian = Memory::getEndian();
+                        // Reference the pixels in the file, the image keeps the
+                        // endian of the file.
+                        out = Image::Image::create(info.video[0].info, io);
                     }
-                    auto out = Image::Image::create(infoTmp.video[0].info);
-                    io->read(out->getData(), io->getSize() - io->getPos());
-                    if (convertEndian)
+                    else
                     {
-                        const size_t dataByteCount = out->getDataByteCount();
-                        switch (Image::getDataType(infoTmp.video[0].info.type))
+                        auto imageInfo = info.video[0].info;
+                        bool convertEndian = false;
+                        if (imageInfo.layout.endian != Memory::getEndian())
+                        {
+                            convertEndian = true;
+                            imageInfo.layout.endian = Memory::getEndian();
+                        }
+                        if (proxy > 0)
+                        {
+                            out = readProxyImage(*io, imageInfo, proxy);
+                        }
+                        else if (roi.isValid())
+                        {
+                            out = readROIImage(*io, imageInfo, roi);
+                        }
+                        else
+                        {
+                            out = Image::Image::create(imageInfo);
+                            io->read(out->getData(), io->getSize() - io->getPos());
+                        }
+                        if (convertEndian)
                         {
-                            case Image::DataType::U10:
-                                Memory::endian(out->getData(), dataByteCount / 4, 4);
-                                break;
-                            case Image::DataType::U16:
-                                Memory::endian(out->getData(), dataByteCount / 2, 2);
-                                break;
-                            default: break;                            
+                            const size_t dataByteCount = out->getDataByteCount();
+                            switch (Image::getDataType(imageInfo.type))
+                            {
+                                case Image::DataType::U10:
+                                    Memory::endian(out->getData(), dataByteCount / 4, 4);
+                                    break;
+                                case Image::DataType::U16:
+                                    Memory::endian(out->getData(), dataByteCount / 2, 2);
+                                    break;
+                                default: break;                            
+                            }
                         }
                     }
-#endif // DJV_MMAP
-                    out->setTags(infoTmp.tags);
+                    out->setTags(info.tags);
                     return out;
                 }
 
                 Info Read::_readInfo(const std::string & fileName)
                 {
                     auto io = FileSystem::FileIO::create();
-                    return _open(fileName, io);
+                    Session session;
+                    return _open(fileName, io, session);
                 }
 
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
                 {
+                    Session localSession;
+                    Session& session = _getSession() ? static_cast<Session&>(*_getSession()) : localSession;
                     auto io = FileSystem::FileIO::create();
-                    const auto info = _open(fileName, io);
-                    auto out = readImage(info, io);
+                    const auto info = _open(fileName, io, session);
+                    auto out = readImage(info, io, _options.proxy, _getROI());
                     out->setPluginName(pluginName);
                     return out;
                 }
 
-                Info Read::_open(const std::string & fileName, const std::shared_ptr<FileSystem::FileIO>& io)
+                std::shared_ptr<IDecoderSession> Read::_createSession()
+                {
+                    return std::shared_ptr<IDecoderSession>(new Session);
+                }
+
+                Info Read::_open(const std::string & fileName, const std::shared_ptr<FileSystem::FileIO>& io, Session& session)
                 {
-                    DJV_PRIVATE_PTR();
+                    io->setMemoryMapEnabled(_options.memoryMap);
                     io->open(fileName, FileSystem::FileIO::Mode::Read);
+
+                    // The frames in a sequence often have identical headers, so
+                    // compare the raw header data with the previous frame and
+                    // only parse it when it has changed.
+                    const size_t headerByteCount =
+                        sizeof(Header::File) +
+                        sizeof(Header::Image) +
+                        sizeof(Header::Source) +
+                        sizeof(Header::Film);
                     Info info;
-                    info.video.resize(1);
-                    read(io, info, p.colorProfile, _textSystem);
+                    session.headerScratch.clear();
+                    if (io->getSize() >= headerByteCount)
+                    {
+                        session.headerScratch.resize(headerByteCount);
+                        io->read(session.headerScratch.data(), headerByteCount);
+                    }
+                    if (session.headerData.size() && session.headerScratch == session.headerData)
+                    {
+                        info = session.info;
+                        info.fileName = io->getFileName();
+                        io->setEndianConversion(session.endianConversion);
+                        if (io->getSize() - session.header.file.imageOffset != info.video[0].info.getDataByteCount())
+                        {
+                            throw FileSystem::Error(_textSystem->getText(DJV_TEXT("error_incomplete_file")));
+                        }
+                        if (session.header.file.imageOffset)
+                        {
+                            io->setPos(session.header.file.imageOffset);
+                        }
+                    }
+                    else
+                    {
+                        session.headerData.clear();
+                        io->setPos(0);
+                        info.video.resize(1);
+                        session.header = read(io, info, session.colorProfile, _textSystem);
+                        session.headerData.swap(session.headerScratch);
+                        session.info = info;
+                        session.endianConversion = io->hasEndianConversion();
+                    }
                     info.video[0].sequence = _sequence;
                     return info;
                 }
@@ -0,0 +1,202 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/CompressedImage.h>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            namespace
+            {
+                //! The fastest zlib settings are used since the frames are
+                //! compressed in the background during playback. Run length
+                //! encoding works well after the delta encoding.
+                const int compressionLevel    = Z_BEST_SPEED;
+                const int compressionStrategy = Z_RLE;
+
+                //! The zlib stream sizes are 32-bit so large images are passed
+                //! in chunks.
+                const size_t chunkSize = 1 << 30;
+
+                size_t getWordSize(const Image::Info& info)
+                {
+                    return std::max(Image::getByteCount(Image::getDataType(info.type)), static_cast<size_t>(1));
+                }
+
+                //! Split the bytes of each word into planes and delta encode the
+                //! planes.
+                void encode(const uint8_t* in, size_t size, size_t wordSize, uint8_t* out)
+                {
+                    const size_t wordCount = size / wordSize;
+                    for (size_t b = 0; b < wordSize; ++b)
+                    {
+                        const uint8_t* inP = in + b;
+                        uint8_t* outP = out + b * wordCount;
+                        uint8_t prev = 0;
+                        for (size_t i = 0; i < wordCount; ++i, inP += wordSize, ++outP)
+                        {
+                            *outP = *inP - prev;
+                            prev = *inP;
+                        }
+                    }
+                    const size_t wordByteCount = wordCount * wordSize;
+                    memcpy(out + wordByteCount, in + wordByteCount, size - wordByteCount);
+                }
+
+                void decode(const uint8_t* in, size_t size, size_t wordSize, uint8_t* out)
+                {
+                    const size_t wordCount = size / wordSize;
+                    for (size_t b = 0; b < wordSize; ++b)
+                    {
+                        const uint8_t* inP = in + b * wordCount;
+                        uint8_t* outP = out + b;
+                        uint8_t prev = 0;
+                        for (size_t i = 0; i < wordCount; ++i, ++inP, outP += wordSize)
+                        {
+                            prev += *inP;
+                            *outP = prev;
+                        }
+                    }
+                    const size_t wordByteCount = wordCount * wordSize;
+                    memcpy(out + wordByteCount, in + wordByteCount, size - wordByteCount);
+                }
+
+            } // namespace
+
+            void CompressedImage::_init(const std::shared_ptr<Image::Image>& image)
+            {
+                _info = image->getInfo();
+                _pluginName = image->getPluginName();
+                _tags = image->getTags();
+
+                const size_t size = image->getDataByteCount();
+                std::vector<uint8_t> planes(size);
+                encode(image->getData(), size, getWordSize(_info), planes.data());
+
+                z_stream stream;
+                memset(&stream, 0, sizeof(z_stream));
+                if (deflateInit2(&stream, compressionLevel, Z_DEFLATED, 15, 8, compressionStrategy) != Z_OK)
+                {
+                    throw std::runtime_error(DJV_TEXT("error_image_compression"));
+                }
+                std::vector<uint8_t> data(deflateBound(&stream, static_cast<uLong>(size)));
+                const uint8_t* inP = planes.data();
+                const uint8_t* inEnd = inP + size;
+                uint8_t* outP = data.data();
+                const uint8_t* outEnd = outP + data.size();
+                int r = Z_OK;
+                while (Z_OK == r)
+                {
+                    const size_t inChunk = std::min(static_cast<size_t>(inEnd - inP), chunkSize);
+                    const size_t outChunk = std::min(static_cast<size_t>(outEnd - outP), chunkSize);
+                    stream.next_in = const_cast<Bytef*>(inP);
+                    stream.avail_in = static_cast<uInt>(inChunk);
+                    stream.next_out = outP;
+                    stream.avail_out = static_cast<uInt>(outChunk);
+                    r = deflate(&stream, inP + inChunk == inEnd ? Z_FINISH : Z_NO_FLUSH);
+                    inP += inChunk - stream.avail_in;
+                    outP += outChunk - stream.avail_out;
+                }
+                deflateEnd(&stream);
+                if (r != Z_STREAM_END)
+                {
+                    throw std::runtime_error(DJV_TEXT("error_image_compression"));
+                }
+
+                // Copy the data so only the compressed size is allocated.
+                _data = std::vector<uint8_t>(data.data(), outP);
+            }
+
+            CompressedImage::CompressedImage()
+            {}
+
+            CompressedImage::~CompressedImage()
+            {}
+
+            std::shared_ptr<CompressedImage> CompressedImage::create(const std::shared_ptr<Image::Image>& image)
+            {
+                auto out = std::shared_ptr<CompressedImage>(new CompressedImage);
+                out->_init(image);
+                return out;
+            }
+
+            std::shared_ptr<Image::Image> CompressedImage::decompress() const
+            {
+                auto out = Image::Image::create(_info);
+                out->setPluginName(_pluginName);
+                out->setTags(_tags);
+
+                const size_t size = out->getDataByteCount();
+                std::vector<uint8_t> planes(size);
+                z_stream stream;
+                memset(&stream, 0, sizeof(z_stream));
+                if (inflateInit(&stream) != Z_OK)
+                {
+                    throw std::runtime_error(DJV_TEXT("error_image_decompression"));
+                }
+                const uint8_t* inP = _data.data();
+                const uint8_t* inEnd = inP + _data.size();
+                uint8_t* outP = planes.data();
+                const uint8_t* outEnd = outP + size;
+                int r = Z_OK;
+                while (Z_OK == r)
+                {
+                    const size_t inChunk = std::min(static_cast<size_t>(inEnd - inP), chunkSize);
+                    const size_t outChunk = std::min(static_cast<size_t>(outEnd - outP), chunkSize);
+                    stream.next_in = const_cast<Bytef*>(inP);
+                    stream.avail_in = static_cast<uInt>(inChunk);
+                    stream.next_out = outP;
+                    stream.avail_out = static_cast<uInt>(outChunk);
+                    r = inflate(&stream, Z_NO_FLUSH);
+                    inP += inChunk - stream.avail_in;
+                    outP += outChunk - stream.avail_out;
+                }
+                inflateEnd(&stream);
+                if (r != Z_STREAM_END || outP != outEnd)
+                {
+                    throw std::runtime_error(DJV_TEXT("error_image_decompression"));
+                }
+                decode(planes.data(), size, getWordSize(_info), out->getData());
+                return out;
+            }
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
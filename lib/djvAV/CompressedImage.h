@@ -0,0 +1,86 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvAV/Image.h>
+
+#include <vector>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            //! This class provides a losslessly compressed image for the
+            //! compressed tier of the frame cache.
+            //!
+            //! The bytes of each channel value are split into planes and delta
+            //! encoded before they are compressed with zlib, which works well
+            //! for the smooth gradients of film and half float images.
+            class CompressedImage
+            {
+                DJV_NON_COPYABLE(CompressedImage);
+                void _init(const std::shared_ptr<Image::Image>&);
+                CompressedImage();
+
+            public:
+                ~CompressedImage();
+
+                //! Create a new compressed image.
+                //! Throws:
+                //! - std::exception
+                static std::shared_ptr<CompressedImage> create(const std::shared_ptr<Image::Image>&);
+
+                const Image::Info& getInfo() const;
+
+                //! Get the size of the compressed data.
+                size_t getByteCount() const;
+
+                //! Get the size of the uncompressed data.
+                size_t getDataByteCount() const;
+
+                //! Decompress the image.
+                //! Throws:
+                //! - std::exception
+                std::shared_ptr<Image::Image> decompress() const;
+
+            private:
+                Image::Info _info;
+                std::string _pluginName;
+                Tags _tags;
+                std::vector<uint8_t> _data;
+            };
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
+
+#include <djvAV/CompressedImageInline.h>
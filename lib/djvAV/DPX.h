@@ -342,9 +342,11 @@ namespace djv
                 protected:
                     Info _readInfo(const std::string &) override;
                     std::shared_ptr<Image::Image> _readImage(const std::string &) override;
+                    std::shared_ptr<IDecoderSession> _createSession() override;
 
                 private:
-                    Info _open(const std::string &, const std::shared_ptr<Core::FileSystem::FileIO>&);
+                    struct Session;
+                    Info _open(const std::string &, const std::shared_ptr<Core::FileSystem::FileIO>&, Session&);
 
                     DJV_PRIVATE();
                 };
@@ -30,6 +30,8 @@
 #include <djvAV/DPX.h>
 
 #include <djvCore/FileIO.h>
+#include <djvCore/FileSystem.h>
+#include <djvCore/TextSystem.h>
 
 using namespace djv::Core;
 
@@ -43,10 +45,19 @@ namespace djv
             {
                 struct Read::Private
                 {
-                    Cineon::ColorProfile colorProfile = Cineon::ColorProfile::FilmPrint;
                     Options options;
                 };
 
+                struct Read::Session : public IDecoderSession
+                {
+                    std::vector<uint8_t> headerData;
+                    std::vector<uint8_t> headerScratch;
+                    Header header;
+                    Info info;
+                    Cineon::ColorProfile colorProfile = Cineon::ColorProfile::FilmPrint;
+                    bool endianConversion = false;
+                };
+
                 Read::Read() :
                     _p(new Private)
                 {}
@@ -73,25 +84,71 @@ namespace djv
                 Info Read::_readInfo(const std::string & fileName)
                 {
                     auto io = FileSystem::FileIO::create();
-                    return _open(fileName, io);
+                    Session session;
+                    return _open(fileName, io, session);
                 }
 
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
                 {
+                    Session localSession;
+                    Session& session = _getSession() ? static_cast<Session&>(*_getSession()) : localSession;
                     auto io = FileSystem::FileIO::create();
-                    const auto info = _open(fileName, io);
-                    auto out = Cineon::Read::readImage(info, io);
+                    const auto info = _open(fileName, io, session);
+                    auto out = Cineon::Read::readImage(info, io, _options.proxy, _getROI());
                     out->setPluginName(pluginName);
                     return out;
                 }
 
-                Info Read::_open(const std::string & fileName, const std::shared_ptr<FileSystem::FileIO>& io)
+                std::shared_ptr<IDecoderSession> Read::_createSession()
                 {
-                    DJV_PRIVATE_PTR();
+                    return std::shared_ptr<IDecoderSession>(new Session);
+                }
+
+                Info Read::_open(const std::string & fileName, const std::shared_ptr<FileSystem::FileIO>& io, Session& session)
+                {
+                    io->setMemoryMapEnabled(_options.memoryMap);
                     io->open(fileName, FileSystem::FileIO::Mode::Read);
+
+                    // The frames in a sequence often have identical headers, so
+                    // compare the raw header data with the previous frame and
+                    // only parse it when it has changed.
+                    const size_t headerByteCount =
+                        sizeof(Header::File) +
+                        sizeof(Header::Image) +
+                        sizeof(Header::Source) +
+                        sizeof(Header::Film) +
+                        sizeof(Header::TV);
                     Info info;
-                    info.video.resize(1);
-                    DPX::read(io, info, p.colorProfile, _textSystem);
+                    session.headerScratch.clear();
+                    if (io->getSize() >= headerByteCount)
+                    {
+                        session.headerScratch.resize(headerByteCount);
+                        io->read(session.headerScratch.data(), headerByteCount);
+                    }
+                    if (session.headerData.size() && session.headerScratch == session.headerData)
+                    {
+                        info = session.info;
+                        info.fileName = io->getFileName();
+                        io->setEndianConversion(session.endianConversion);
+                        if (io->getSize() - session.header.file.imageOffset != info.video[0].info.getDataByteCount())
+                        {
+                            throw FileSystem::Error(_textSystem->getText(DJV_TEXT("error_incomplete_file")));
+                        }
+                        if (session.header.file.imageOffset)
+                        {
+                            io->setPos(session.header.file.imageOffset);
+                        }
+                    }
+                    else
+                    {
+                        session.headerData.clear();
+                        io->setPos(0);
+                        info.video.resize(1);
+                        session.header = DPX::read(io, info, session.colorProfile, _textSystem);
+                        session.headerData.swap(session.headerScratch);
+                        session.info = info;
+                        session.endianConversion = io->hasEndianConversion();
+                    }
                     info.video[0].sequence = _sequence;
                     return info;
                 }
@@ -0,0 +1,864 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/DiskCache.h>
+
+#include <djvCore/FileIO.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/Path.h>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <list>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            namespace
+            {
+                //! The file extension of cache entries.
+                const std::string fileExtension = ".djvc";
+
+                //! The file extension of cache entries that are being written.
+                const std::string tempExtension = ".djvctmp";
+
+                //! The file extension of media data entries.
+                const std::string mediaDataExtension = ".djvm";
+
+                const char magic[] = "DJVC";
+                const uint32_t fileVersion = 2;
+
+                const char mediaDataMagic[] = "DJVM";
+                const uint32_t mediaDataFileVersion = 1;
+
+                //! The size of the fixed part of the header: the magic number,
+                //! the version, the header size, and the header checksum.
+                const size_t prefixByteCount = 16;
+
+                //! The maximum size of the variable part of the header.
+                const size_t headerByteCountMax = 1024 * 1024;
+
+                //! The pixels start on a page boundary so they can be memory
+                //! mapped.
+                const size_t dataAlignment = 4096;
+
+                //! The maximum number of frames waiting to be written.
+                const size_t writeQueueMax = 16;
+
+                size_t getDataOffset(size_t headerByteCount)
+                {
+                    const size_t size = prefixByteCount + headerByteCount;
+                    return (size + dataAlignment - 1) / dataAlignment * dataAlignment;
+                }
+
+                uint32_t checksum(const uint8_t* data, size_t size)
+                {
+                    uLong out = crc32(0L, Z_NULL, 0);
+                    while (size > 0)
+                    {
+                        const uInt chunk = static_cast<uInt>(std::min(size, static_cast<size_t>(1 << 30)));
+                        out = crc32(out, data, chunk);
+                        data += chunk;
+                        size -= chunk;
+                    }
+                    return static_cast<uint32_t>(out);
+                }
+
+                std::string getEntryName(const DiskCacheKey& key, const std::string& extension = fileExtension)
+                {
+                    // 64-bit FNV-1a hash.
+                    uint64_t hash = 14695981039346656037ULL;
+                    for (const char c : key.getString())
+                    {
+                        hash ^= static_cast<uint8_t>(c);
+                        hash *= 1099511628211ULL;
+                    }
+                    std::stringstream ss;
+                    ss << "djv_" << std::hex << std::setfill('0') << std::setw(16) << hash << extension;
+                    return ss.str();
+                }
+
+                class HeaderWriter
+                {
+                public:
+                    void writeU32(uint32_t value)
+                    {
+                        const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+                        data.insert(data.end(), p, p + sizeof(uint32_t));
+                    }
+
+                    void writeU64(uint64_t value)
+                    {
+                        const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+                        data.insert(data.end(), p, p + sizeof(uint64_t));
+                    }
+
+                    void writeF32(float value)
+                    {
+                        const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+                        data.insert(data.end(), p, p + sizeof(float));
+                    }
+
+                    void writeString(const std::string& value)
+                    {
+                        writeU32(static_cast<uint32_t>(value.size()));
+                        data.insert(data.end(), value.begin(), value.end());
+                    }
+
+                    std::vector<uint8_t> data;
+                };
+
+                class HeaderReader
+                {
+                public:
+                    explicit HeaderReader(const std::vector<uint8_t>& data) :
+                        _p(data.data()),
+                        _end(data.data() + data.size())
+                    {}
+
+                    uint32_t readU32()
+                    {
+                        uint32_t out = 0;
+                        _read(&out, sizeof(uint32_t));
+                        return out;
+                    }
+
+                    uint64_t readU64()
+                    {
+                        uint64_t out = 0;
+                        _read(&out, sizeof(uint64_t));
+                        return out;
+                    }
+
+                    float readF32()
+                    {
+                        float out = 0.F;
+                        _read(&out, sizeof(float));
+                        return out;
+                    }
+
+                    std::string readString()
+                    {
+                        const size_t size = readU32();
+                        if (size > static_cast<size_t>(_end - _p))
+                        {
+                            throw std::runtime_error(DJV_TEXT("error_disk_cache_damaged"));
+                        }
+                        std::string out(reinterpret_cast<const char*>(_p), size);
+                        _p += size;
+                        return out;
+                    }
+
+                private:
+                    void _read(void* out, size_t size)
+                    {
+                        if (size > static_cast<size_t>(_end - _p))
+                        {
+                            throw std::runtime_error(DJV_TEXT("error_disk_cache_damaged"));
+                        }
+                        memcpy(out, _p, size);
+                        _p += size;
+                    }
+
+                    const uint8_t* _p = nullptr;
+                    const uint8_t* _end = nullptr;
+                };
+
+                struct Entry
+                {
+                    size_t byteCount = 0;
+                    std::list<std::string>::iterator lru;
+                };
+
+            } // namespace
+
+            DiskCacheKey::DiskCacheKey()
+            {}
+
+            DiskCacheKey::DiskCacheKey(
+                const std::string& fileName,
+                time_t time,
+                uint64_t size,
+                size_t layer,
+                size_t proxy) :
+                fileName(fileName),
+                time(time),
+                size(size),
+                layer(layer),
+                proxy(proxy)
+            {}
+
+            std::string DiskCacheKey::getString() const
+            {
+                std::stringstream ss;
+                ss << fileName << '\n' << time << '\n' << size << '\n' << layer << '\n' << proxy;
+                return ss.str();
+            }
+
+            bool DiskCacheKey::operator == (const DiskCacheKey& other) const
+            {
+                return
+                    fileName == other.fileName &&
+                    time == other.time &&
+                    size == other.size &&
+                    layer == other.layer &&
+                    proxy == other.proxy;
+            }
+
+            bool DiskCacheStats::operator == (const DiskCacheStats& other) const
+            {
+                return
+                    count == other.count &&
+                    byteCount == other.byteCount &&
+                    maxByteCount == other.maxByteCount &&
+                    hitCount == other.hitCount &&
+                    missCount == other.missCount &&
+                    writeCount == other.writeCount &&
+                    evictCount == other.evictCount &&
+                    errorCount == other.errorCount;
+            }
+
+            struct DiskCache::Private
+            {
+                mutable std::mutex mutex;
+                std::string path;
+                size_t maxByteCount = 0;
+                size_t byteCount = 0;
+                std::map<std::string, Entry> entries;
+                //! The entry names, least recently used first.
+                std::list<std::string> lru;
+                DiskCacheStats stats;
+
+                std::list<std::pair<DiskCacheKey, std::shared_ptr<Image::Image> > > writeQueue;
+                std::condition_variable writeCV;
+                bool running = true;
+                std::thread thread;
+            };
+
+            void DiskCache::_init()
+            {
+                DJV_PRIVATE_PTR();
+                p.thread = std::thread(
+                    [this]
+                    {
+                        DJV_PRIVATE_PTR();
+                        while (true)
+                        {
+                            std::pair<DiskCacheKey, std::shared_ptr<Image::Image> > item;
+                            {
+                                std::unique_lock<std::mutex> lock(p.mutex);
+                                p.writeCV.wait(
+                                    lock,
+                                    [this]
+                                    {
+                                        return !_p->running || _p->writeQueue.size() > 0;
+                                    });
+                                if (!p.running)
+                                {
+                                    break;
+                                }
+                                item = p.writeQueue.front();
+                                p.writeQueue.pop_front();
+                            }
+                            _write(item.first, item.second);
+                        }
+                    });
+            }
+
+            DiskCache::DiskCache() :
+                _p(new Private)
+            {}
+
+            DiskCache::~DiskCache()
+            {
+                DJV_PRIVATE_PTR();
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    p.running = false;
+                }
+                p.writeCV.notify_one();
+                if (p.thread.joinable())
+                {
+                    p.thread.join();
+                }
+            }
+
+            std::shared_ptr<DiskCache> DiskCache::create()
+            {
+                auto out = std::shared_ptr<DiskCache>(new DiskCache);
+                out->_init();
+                return out;
+            }
+
+            std::string DiskCache::getPath() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return p.path;
+            }
+
+            void DiskCache::setPath(const std::string& value)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                if (value == p.path)
+                {
+                    return;
+                }
+                p.path = value;
+                p.byteCount = 0;
+                p.entries.clear();
+                p.lru.clear();
+                p.writeQueue.clear();
+                if (p.path.empty())
+                {
+                    return;
+                }
+                const FileSystem::Path path(p.path);
+                if (!FileSystem::FileInfo(path).doesExist())
+                {
+                    FileSystem::Path::mkdir(path);
+                }
+
+                // Index the existing entries, oldest first, and remove the
+                // entries that were not finished.
+                FileSystem::DirectoryListOptions options;
+                options.fileExtensions.insert(fileExtension);
+                options.fileExtensions.insert(tempExtension);
+                options.sort = FileSystem::DirectoryListSort::Time;
+                for (const auto& i : FileSystem::FileInfo::directoryList(path, options))
+                {
+                    const std::string fileName = i.getFileName(Frame::invalid, false);
+                    if (i.getPath().getExtension() == tempExtension)
+                    {
+                        std::remove(i.getFileName().c_str());
+                    }
+                    else
+                    {
+                        Entry entry;
+                        entry.byteCount = i.getSize();
+                        entry.lru = p.lru.insert(p.lru.end(), fileName);
+                        p.entries[fileName] = entry;
+                        p.byteCount += entry.byteCount;
+                    }
+                }
+                _evict();
+            }
+
+            size_t DiskCache::getMaxByteCount() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return p.maxByteCount;
+            }
+
+            void DiskCache::setMaxByteCount(size_t value)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.maxByteCount = value;
+                _evict();
+            }
+
+            bool DiskCache::isEnabled() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return !p.path.empty() && p.maxByteCount > 0;
+            }
+
+            std::shared_ptr<Image::Image> DiskCache::read(const DiskCacheKey& key)
+            {
+                DJV_PRIVATE_PTR();
+                const std::string name = getEntryName(key);
+                std::string fileName;
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    if (p.path.empty() || 0 == p.maxByteCount)
+                    {
+                        return nullptr;
+                    }
+                    const auto i = p.entries.find(name);
+                    if (i == p.entries.end())
+                    {
+                        ++p.stats.missCount;
+                        return nullptr;
+                    }
+                    p.lru.splice(p.lru.end(), p.lru, i->second.lru);
+                    fileName = FileSystem::Path(p.path, name).get();
+                }
+
+                std::shared_ptr<Image::Image> out;
+                bool damaged = false;
+                try
+                {
+                    auto io = FileSystem::FileIO::create();
+                    io->setMemoryMapEnabled(true);
+                    io->open(fileName, FileSystem::FileIO::Mode::Read);
+
+                    uint8_t prefix[prefixByteCount];
+                    io->read(prefix, prefixByteCount);
+                    uint32_t version = 0;
+                    uint32_t headerByteCount = 0;
+                    uint32_t headerChecksum = 0;
+                    memcpy(&version, prefix + 4, sizeof(uint32_t));
+                    memcpy(&headerByteCount, prefix + 8, sizeof(uint32_t));
+                    memcpy(&headerChecksum, prefix + 12, sizeof(uint32_t));
+                    if (memcmp(prefix, magic, 4) != 0 ||
+                        version != fileVersion ||
+                        headerByteCount > headerByteCountMax)
+                    {
+                        throw std::runtime_error(DJV_TEXT("error_disk_cache_damaged"));
+                    }
+                    std::vector<uint8_t> header(headerByteCount);
+                    io->read(header.data(), headerByteCount);
+                    if (checksum(header.data(), header.size()) != headerChecksum)
+                    {
+                        throw std::runtime_error(DJV_TEXT("error_disk_cache_damaged"));
+                    }
+
+                    HeaderReader reader(header);
+                    if (reader.readString() == key.getString())
+                    {
+                        Image::Info info;
+                        info.name = reader.readString();
+                        info.size.w = static_cast<uint16_t>(reader.readU32());
+                        info.size.h = static_cast<uint16_t>(reader.readU32());
+                        info.pixelAspectRatio = reader.readF32();
+                        info.type = static_cast<Image::Type>(reader.readU32());
+                        info.layout.mirror.x = reader.readU32() != 0;
+                        info.layout.mirror.y = reader.readU32() != 0;
+                        info.layout.alignment = static_cast<GLint>(reader.readU32());
+                        info.layout.endian = static_cast<Memory::Endian>(reader.readU32());
+                        info.yuvCoefficients = static_cast<Image::YUVCoefficients>(reader.readU32());
+                        info.yuvRange = static_cast<Image::YUVRange>(reader.readU32());
+                        const std::string pluginName = reader.readString();
+                        Tags tags;
+                        const size_t tagCount = reader.readU32();
+                        for (size_t i = 0; i < tagCount; ++i)
+                        {
+                            const std::string tagKey = reader.readString();
+                            tags.setTag(tagKey, reader.readString());
+                        }
+                        const uint64_t dataByteCount = reader.readU64();
+                        const uint32_t dataChecksum = reader.readU32();
+
+                        const size_t dataOffset = getDataOffset(headerByteCount);
+                        if (info.type >= Image::Type::Count ||
+                            info.yuvCoefficients >= Image::YUVCoefficients::Count ||
+                            info.yuvRange >= Image::YUVRange::Count ||
+                            !info.isValid() ||
+                            info.getDataByteCount() != dataByteCount ||
+                            io->getSize() != dataOffset + dataByteCount)
+                        {
+                            throw std::runtime_error(DJV_TEXT("error_disk_cache_damaged"));
+                        }
+                        io->setPos(dataOffset);
+                        out = Image::Image::create(info, io);
+                        out->setPluginName(pluginName);
+                        out->setTags(tags);
+
+                        // Use const access so that the memory mapped pixels are
+                        // not copied.
+                        const Image::Data& data = *out;
+                        if (checksum(data.getData(), dataByteCount) != dataChecksum)
+                        {
+                            throw std::runtime_error(DJV_TEXT("error_disk_cache_damaged"));
+                        }
+                    }
+                }
+                catch (const std::exception&)
+                {
+                    out.reset();
+                    damaged = true;
+                }
+
+                std::lock_guard<std::mutex> lock(p.mutex);
+                if (out)
+                {
+                    ++p.stats.hitCount;
+                }
+                else
+                {
+                    ++p.stats.missCount;
+                    if (damaged)
+                    {
+                        ++p.stats.errorCount;
+                        const auto i = p.entries.find(name);
+                        if (i != p.entries.end())
+                        {
+                            p.byteCount -= i->second.byteCount;
+                            p.lru.erase(i->second.lru);
+                            p.entries.erase(i);
+                        }
+                        std::remove(fileName.c_str());
+                    }
+                }
+                return out;
+            }
+
+            void DiskCache::write(const DiskCacheKey& key, const std::shared_ptr<Image::Image>& image)
+            {
+                DJV_PRIVATE_PTR();
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    if (p.path.empty() ||
+                        0 == p.maxByteCount ||
+                        image->getDataByteCount() > p.maxByteCount ||
+                        p.writeQueue.size() >= writeQueueMax ||
+                        p.entries.find(getEntryName(key)) != p.entries.end())
+                    {
+                        return;
+                    }
+                    for (const auto& i : p.writeQueue)
+                    {
+                        if (key == i.first)
+                        {
+                            return;
+                        }
+                    }
+                    p.writeQueue.push_back(std::make_pair(key, image));
+                }
+                p.writeCV.notify_one();
+            }
+
+            void DiskCache::clear()
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                for (const auto& i : p.entries)
+                {
+                    std::remove(FileSystem::Path(p.path, i.first).get().c_str());
+                }
+                p.byteCount = 0;
+                p.entries.clear();
+                p.lru.clear();
+                p.writeQueue.clear();
+                if (!p.path.empty())
+                {
+                    FileSystem::DirectoryListOptions options;
+                    options.fileExtensions.insert(mediaDataExtension);
+                    for (const auto& i : FileSystem::FileInfo::directoryList(FileSystem::Path(p.path), options))
+                    {
+                        std::remove(i.getFileName().c_str());
+                    }
+                }
+            }
+
+            bool DiskCache::readMediaData(const DiskCacheKey& key, std::vector<uint8_t>& out)
+            {
+                DJV_PRIVATE_PTR();
+                std::string fileName;
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    if (p.path.empty() || 0 == p.maxByteCount)
+                    {
+                        return false;
+                    }
+                    fileName = FileSystem::Path(p.path, getEntryName(key, mediaDataExtension)).get();
+                }
+                if (!FileSystem::FileInfo(fileName).doesExist())
+                {
+                    return false;
+                }
+
+                bool found = false;
+                bool damaged = false;
+                try
+                {
+                    auto io = FileSystem::FileIO::create();
+                    io->open(fileName, FileSystem::FileIO::Mode::Read);
+
+                    uint8_t prefix[prefixByteCount];
+                    io->read(prefix, prefixByteCount);
+                    uint32_t version = 0;
+                    uint32_t headerByteCount = 0;
+                    uint32_t headerChecksum = 0;
+                    memcpy(&version, prefix + 4, sizeof(uint32_t));
+                    memcpy(&headerByteCount, prefix + 8, sizeof(uint32_t));
+                    memcpy(&headerChecksum, prefix + 12, sizeof(uint32_t));
+                    if (memcmp(prefix, mediaDataMagic, 4) != 0 ||
+                        version != mediaDataFileVersion ||
+                        headerByteCount > headerByteCountMax)
+                    {
+                        throw std::runtime_error(DJV_TEXT("error_disk_cache_damaged"));
+                    }
+                    std::vector<uint8_t> header(headerByteCount);
+                    io->read(header.data(), headerByteCount);
+                    if (checksum(header.data(), header.size()) != headerChecksum)
+                    {
+                        throw std::runtime_error(DJV_TEXT("error_disk_cache_damaged"));
+                    }
+
+                    HeaderReader reader(header);
+                    if (reader.readString() == key.getString())
+                    {
+                        const uint64_t dataByteCount = reader.readU64();
+                        const uint32_t dataChecksum = reader.readU32();
+                        if (io->getSize() != prefixByteCount + headerByteCount + dataByteCount)
+                        {
+                            throw std::runtime_error(DJV_TEXT("error_disk_cache_damaged"));
+                        }
+                        std::vector<uint8_t> data(dataByteCount);
+                        io->read(data.data(), dataByteCount);
+                        if (checksum(data.data(), data.size()) != dataChecksum)
+                        {
+                            throw std::runtime_error(DJV_TEXT("error_disk_cache_damaged"));
+                        }
+                        out = std::move(data);
+                        found = true;
+                    }
+                }
+                catch (const std::exception&)
+                {
+                    damaged = true;
+                }
+
+                std::lock_guard<std::mutex> lock(p.mutex);
+                if (damaged)
+                {
+                    std::remove(fileName.c_str());
+                    ++p.stats.errorCount;
+                }
+                return found;
+            }
+
+            void DiskCache::writeMediaData(const DiskCacheKey& key, const std::vector<uint8_t>& data)
+            {
+                DJV_PRIVATE_PTR();
+                std::string fileName;
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    if (p.path.empty() || 0 == p.maxByteCount)
+                    {
+                        return;
+                    }
+                    fileName = FileSystem::Path(p.path, getEntryName(key, mediaDataExtension)).get();
+                }
+                const std::string tempFileName = fileName + tempExtension;
+
+                HeaderWriter header;
+                header.writeString(key.getString());
+                header.writeU64(data.size());
+                header.writeU32(checksum(data.data(), data.size()));
+
+                uint8_t prefix[prefixByteCount];
+                const uint32_t headerByteCount = static_cast<uint32_t>(header.data.size());
+                const uint32_t headerChecksum = checksum(header.data.data(), header.data.size());
+                memcpy(prefix, mediaDataMagic, 4);
+                memcpy(prefix + 4, &mediaDataFileVersion, sizeof(uint32_t));
+                memcpy(prefix + 8, &headerByteCount, sizeof(uint32_t));
+                memcpy(prefix + 12, &headerChecksum, sizeof(uint32_t));
+
+                bool written = false;
+                try
+                {
+                    {
+                        auto io = FileSystem::FileIO::create();
+                        io->open(tempFileName, FileSystem::FileIO::Mode::Write);
+                        io->write(prefix, prefixByteCount);
+                        io->write(header.data.data(), header.data.size());
+                        io->write(data.data(), data.size());
+                        std::string error;
+                        if (!io->close(&error))
+                        {
+                            throw std::runtime_error(error);
+                        }
+                    }
+                    std::remove(fileName.c_str());
+                    written = 0 == std::rename(tempFileName.c_str(), fileName.c_str());
+                }
+                catch (const std::exception&)
+                {}
+                if (!written)
+                {
+                    std::remove(tempFileName.c_str());
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    ++p.stats.errorCount;
+                }
+            }
+
+            DiskCacheStats DiskCache::getStats() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                DiskCacheStats out = p.stats;
+                out.count = p.entries.size();
+                out.byteCount = p.byteCount;
+                out.maxByteCount = p.maxByteCount;
+                return out;
+            }
+
+            void DiskCache::_write(const DiskCacheKey& key, const std::shared_ptr<Image::Image>& image)
+            {
+                DJV_PRIVATE_PTR();
+                const std::string name = getEntryName(key);
+                std::string path;
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    path = p.path;
+                }
+                if (path.empty())
+                {
+                    return;
+                }
+                const std::string fileName = FileSystem::Path(path, name).get();
+                const std::string tempFileName = fileName + tempExtension;
+
+                // Use const access so that memory mapped images are not copied.
+                const Image::Data& data = *image;
+                const auto& info = image->getInfo();
+                const size_t dataByteCount = data.getDataByteCount();
+                HeaderWriter header;
+                header.writeString(key.getString());
+                header.writeString(info.name);
+                header.writeU32(info.size.w);
+                header.writeU32(info.size.h);
+                header.writeF32(info.pixelAspectRatio);
+                header.writeU32(static_cast<uint32_t>(info.type));
+                header.writeU32(info.layout.mirror.x);
+                header.writeU32(info.layout.mirror.y);
+                header.writeU32(static_cast<uint32_t>(info.layout.alignment));
+                header.writeU32(static_cast<uint32_t>(info.layout.endian));
+                header.writeU32(static_cast<uint32_t>(info.yuvCoefficients));
+                header.writeU32(static_cast<uint32_t>(info.yuvRange));
+                header.writeString(image->getPluginName());
+                const auto& tags = image->getTags().getTags();
+                header.writeU32(static_cast<uint32_t>(tags.size()));
+                for (const auto& i : tags)
+                {
+                    header.writeString(i.first);
+                    header.writeString(i.second);
+                }
+                header.writeU64(dataByteCount);
+                header.writeU32(checksum(data.getData(), dataByteCount));
+
+                uint8_t prefix[prefixByteCount];
+                const uint32_t headerByteCount = static_cast<uint32_t>(header.data.size());
+                const uint32_t headerChecksum = checksum(header.data.data(), header.data.size());
+                memcpy(prefix, magic, 4);
+                memcpy(prefix + 4, &fileVersion, sizeof(uint32_t));
+                memcpy(prefix + 8, &headerByteCount, sizeof(uint32_t));
+                memcpy(prefix + 12, &headerChecksum, sizeof(uint32_t));
+                const size_t dataOffset = getDataOffset(headerByteCount);
+
+                bool written = false;
+                try
+                {
+                    // Write to a temporary file first so that a partially
+                    // written entry is never found in the cache.
+                    {
+                        auto io = FileSystem::FileIO::create();
+                        io->open(tempFileName, FileSystem::FileIO::Mode::Write);
+                        io->write(prefix, prefixByteCount);
+                        io->write(header.data.data(), header.data.size());
+                        const std::vector<uint8_t> padding(dataOffset - prefixByteCount - headerByteCount, 0);
+                        io->write(padding.data(), padding.size());
+                        io->write(data.getData(), dataByteCount);
+                        std::string error;
+                        if (!io->close(&error))
+                        {
+                            throw std::runtime_error(error);
+                        }
+                    }
+                    std::remove(fileName.c_str());
+                    written = 0 == std::rename(tempFileName.c_str(), fileName.c_str());
+                }
+                catch (const std::exception&)
+                {}
+                if (!written)
+                {
+                    std::remove(tempFileName.c_str());
+                }
+
+                std::lock_guard<std::mutex> lock(p.mutex);
+                if (!written)
+                {
+                    ++p.stats.errorCount;
+                }
+                else if (path != p.path)
+                {
+                    // The path was changed while the frame was being written.
+                    std::remove(fileName.c_str());
+                }
+                else
+                {
+                    const auto i = p.entries.find(name);
+                    if (i != p.entries.end())
+                    {
+                        p.byteCount -= i->second.byteCount;
+                        p.lru.erase(i->second.lru);
+                        p.entries.erase(i);
+                    }
+                    Entry entry;
+                    entry.byteCount = dataOffset + dataByteCount;
+                    entry.lru = p.lru.insert(p.lru.end(), name);
+                    p.entries[name] = entry;
+                    p.byteCount += entry.byteCount;
+                    ++p.stats.writeCount;
+                    _evict();
+                }
+            }
+
+            void DiskCache::_evict()
+            {
+                DJV_PRIVATE_PTR();
+                while (p.maxByteCount > 0 && p.byteCount > p.maxByteCount && p.lru.size())
+                {
+                    const std::string name = p.lru.front();
+                    p.lru.pop_front();
+                    const auto i = p.entries.find(name);
+                    if (i != p.entries.end())
+                    {
+                        p.byteCount -= i->second.byteCount;
+                        p.entries.erase(i);
+                    }
+                    std::remove(FileSystem::Path(p.path, name).get().c_str());
+                    ++p.stats.evictCount;
+                }
+            }
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,171 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvAV/Image.h>
+
+#include <ctime>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            //! This class provides a disk cache key. The modification time and
+            //! size of the file are part of the key so that entries for files
+            //! that have changed are not used.
+            class DiskCacheKey
+            {
+            public:
+                DiskCacheKey();
+                DiskCacheKey(
+                    const std::string& fileName,
+                    time_t time,
+                    uint64_t size,
+                    size_t layer,
+                    size_t proxy);
+
+                std::string fileName;
+                time_t      time     = 0;
+                uint64_t    size     = 0;
+                size_t      layer    = 0;
+                size_t      proxy    = 0;
+
+                //! Get the key as a string.
+                std::string getString() const;
+
+                bool operator == (const DiskCacheKey&) const;
+            };
+
+            //! This struct provides disk cache statistics.
+            struct DiskCacheStats
+            {
+                size_t count        = 0;
+                size_t byteCount    = 0;
+                size_t maxByteCount = 0;
+                size_t hitCount     = 0;
+                size_t missCount    = 0;
+                size_t writeCount   = 0;
+                size_t evictCount   = 0;
+                size_t errorCount   = 0;
+
+                bool operator == (const DiskCacheStats&) const;
+            };
+
+            //! This class provides a persistent cache of decoded frames on disk.
+            //!
+            //! Each frame is stored in its own file in the cache directory. The
+            //! file has a header with the key, the image information, and
+            //! checksums, followed by the pixels aligned to a page boundary so
+            //! that they can be memory mapped when the frame is read back.
+            //! Entries that fail the checksums are removed.
+            //!
+            //! Frames are written by a background thread so that the readers are
+            //! not blocked. When the cache is over budget the least recently used
+            //! entries are removed. The entries found in the directory when the
+            //! path is set are ordered by their modification time.
+            class DiskCache
+            {
+                DJV_NON_COPYABLE(DiskCache);
+                void _init();
+                DiskCache();
+
+            public:
+                ~DiskCache();
+
+                //! Create a new disk cache. The cache is disabled until a path
+                //! and a maximum byte count are set.
+                static std::shared_ptr<DiskCache> create();
+
+                //! \name Settings
+                ///@{
+
+                std::string getPath() const;
+
+                //! Set the cache directory. The directory is created if it does
+                //! not exist.
+                //! Throws:
+                //! - Core::FileSystem::Error
+                void setPath(const std::string&);
+
+                //! Get the maximum size of the cache. A maximum byte count of
+                //! zero disables the cache.
+                size_t getMaxByteCount() const;
+                void setMaxByteCount(size_t);
+
+                bool isEnabled() const;
+
+                ///@}
+
+                //! \name Frames
+                ///@{
+
+                //! Read a frame from the cache. Returns null if the frame is not
+                //! in the cache or the entry is damaged.
+                std::shared_ptr<Image::Image> read(const DiskCacheKey&);
+
+                //! Queue a frame to be written to the cache. Frames are dropped if
+                //! the write queue is full.
+                void write(const DiskCacheKey&, const std::shared_ptr<Image::Image>&);
+
+                //! Remove all of the entries from the cache.
+                void clear();
+
+                ///@}
+
+                //! \name Media Data
+                //! Small amounts of data about a media file, like the keyframe
+                //! index of a movie, can be stored next to the frames. The data
+                //! is not counted against the maximum byte count and is written
+                //! immediately.
+                ///@{
+
+                //! Read media data from the cache. Returns false if the data is
+                //! not in the cache or the entry is damaged.
+                bool readMediaData(const DiskCacheKey&, std::vector<uint8_t>&);
+
+                //! Write media data to the cache.
+                void writeMediaData(const DiskCacheKey&, const std::vector<uint8_t>&);
+
+                ///@}
+
+                DiskCacheStats getStats() const;
+
+            private:
+                void _write(const DiskCacheKey&, const std::shared_ptr<Image::Image>&);
+                void _evict();
+
+                DJV_PRIVATE();
+            };
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
@@ -85,6 +85,63 @@ namespace djv
                     return i != data.end() ? i->second : DJV_TEXT("error_unknown");
                 }
 
+                Image::Type toImageType(AVPixelFormat value)
+                {
+                    Image::Type out = Image::Type::None;
+                    switch (value)
+                    {
+                    case AV_PIX_FMT_YUV420P:
+                    case AV_PIX_FMT_YUVJ420P:   out = Image::Type::YUV_420P_U8;  break;
+                    case AV_PIX_FMT_YUV422P:
+                    case AV_PIX_FMT_YUVJ422P:   out = Image::Type::YUV_422P_U8;  break;
+                    case AV_PIX_FMT_YUV444P:
+                    case AV_PIX_FMT_YUVJ444P:   out = Image::Type::YUV_444P_U8;  break;
+                    case AV_PIX_FMT_YUV420P10:  out = Image::Type::YUV_420P_U10; break;
+                    case AV_PIX_FMT_YUV422P10:  out = Image::Type::YUV_422P_U10; break;
+                    case AV_PIX_FMT_YUV444P10:  out = Image::Type::YUV_444P_U10; break;
+                    case AV_PIX_FMT_YUV420P16:  out = Image::Type::YUV_420P_U16; break;
+                    case AV_PIX_FMT_YUV422P16:  out = Image::Type::YUV_422P_U16; break;
+                    case AV_PIX_FMT_YUV444P16:  out = Image::Type::YUV_444P_U16; break;
+                    default: break;
+                    }
+                    return out;
+                }
+
+                Image::YUVCoefficients toYUVCoefficients(AVColorSpace value, const Image::Size& size)
+                {
+                    Image::YUVCoefficients out = size.h >= 720 ? Image::YUVCoefficients::BT709 : Image::YUVCoefficients::BT601;
+                    switch (value)
+                    {
+                    case AVCOL_SPC_BT709:      out = Image::YUVCoefficients::BT709;  break;
+                    case AVCOL_SPC_BT470BG:
+                    case AVCOL_SPC_SMPTE170M:  out = Image::YUVCoefficients::BT601;  break;
+                    case AVCOL_SPC_BT2020_NCL:
+                    case AVCOL_SPC_BT2020_CL:  out = Image::YUVCoefficients::BT2020; break;
+                    default: break;
+                    }
+                    return out;
+                }
+
+                Image::YUVRange toYUVRange(AVColorRange value, AVPixelFormat format)
+                {
+                    Image::YUVRange out = Image::YUVRange::Video;
+                    switch (value)
+                    {
+                    case AVCOL_RANGE_JPEG: out = Image::YUVRange::Full; break;
+                    case AVCOL_RANGE_MPEG: break;
+                    default:
+                        switch (format)
+                        {
+                        case AV_PIX_FMT_YUVJ420P:
+                        case AV_PIX_FMT_YUVJ422P:
+                        case AV_PIX_FMT_YUVJ444P: out = Image::YUVRange::Full; break;
+                        default: break;
+                        }
+                        break;
+                    }
+                    return out;
+                }
+
                 std::string getErrorString(int r)
                 {
                     char buf[String::cStringLength];
@@ -92,6 +149,19 @@ namespace djv
                     return std::string(buf);
                 }
 
+                int toFFmpeg(ThreadType value)
+                {
+                    int out = 0;
+                    switch (value)
+                    {
+                    case ThreadType::Slice: out = FF_THREAD_SLICE; break;
+                    case ThreadType::Frame: out = FF_THREAD_FRAME; break;
+                    case ThreadType::Auto:  out = FF_THREAD_FRAME | FF_THREAD_SLICE; break;
+                    default: break;
+                    }
+                    return out;
+                }
+
                 namespace
                 {
                     std::weak_ptr<LogSystem> _logSystem;
@@ -161,11 +231,23 @@ namespace djv
         } // namespace IO
     } // namespace AV
 
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        AV::IO::FFmpeg,
+        ThreadType,
+        DJV_TEXT("ffmpeg_thread_type_slice"),
+        DJV_TEXT("ffmpeg_thread_type_frame"),
+        DJV_TEXT("ffmpeg_thread_type_auto"));
+
     picojson::value toJSON(const AV::IO::FFmpeg::Options& value)
     {
         picojson::value out(picojson::object_type, true);
         {
             out.get<picojson::object>()["ThreadCount"] = toJSON(value.threadCount);
+            {
+                std::stringstream ss;
+                ss << value.threadType;
+                out.get<picojson::object>()["ThreadType"] = picojson::value(ss.str());
+            }
         }
         return out;
     }
@@ -180,6 +262,11 @@ namespace djv
                 {
                     fromJSON(i.second, out.threadCount);
                 }
+                else if ("ThreadType" == i.first)
+                {
+                    std::stringstream ss(i.second.get<std::string>());
+                    ss >> out.threadType;
+                }
             }
         }
         else
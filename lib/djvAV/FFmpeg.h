@@ -30,6 +30,7 @@
 #pragma once
 
 #include <djvAV/IO.h>
+#include <djvAV/ReadScheduler.h>
 
 #include <djvCore/Frame.h>
 
@@ -81,12 +82,107 @@ namespace djv
                 Audio::Type toAudioType(AVSampleFormat);
                 std::string toString(AVSampleFormat);
 
+                //! Convert a pixel format to an image type. Only the planar YUV
+                //! pixel formats are supported, other pixel formats return
+                //! Image::Type::None.
+                Image::Type toImageType(AVPixelFormat);
+
+                //! Get the YUV coefficients for a color space. Unspecified
+                //! color spaces are guessed from the image size.
+                Image::YUVCoefficients toYUVCoefficients(AVColorSpace, const Image::Size&);
+
+                //! Get the YUV range for a color range. Unspecified color
+                //! ranges are guessed from the pixel format.
+                Image::YUVRange toYUVRange(AVColorRange, AVPixelFormat);
+
                 std::string getErrorString(int);
 
+                //! This enumeration provides the decoder threading types.
+                //!
+                //! Slice threading decodes the slices of a frame in parallel,
+                //! which only helps codecs and files with many slices. Frame
+                //! threading decodes several frames in parallel, which scales
+                //! better but adds a frame of latency per thread.
+                enum class ThreadType
+                {
+                    Slice,
+                    Frame,
+                    Auto,
+
+                    Count,
+                    First = Slice
+                };
+                DJV_ENUM_HELPERS(ThreadType);
+
+                //! Convert a thread type to the FFmpeg thread type flags.
+                int toFFmpeg(ThreadType);
+
                 //! This struct provides the FFmpeg file I/O optioms.
                 struct Options
                 {
-                    size_t threadCount = 4;
+                    size_t     threadCount = 4;
+                    ThreadType threadType  = ThreadType::Auto;
+                };
+
+                //! This struct provides a keyframe of a video stream.
+                struct KeyFrame
+                {
+                    KeyFrame();
+                    KeyFrame(Core::Frame::Number, int64_t timestamp);
+
+                    Core::Frame::Number frame     = 0;
+                    int64_t             timestamp = 0;
+
+                    bool operator == (const KeyFrame&) const;
+                };
+
+                //! This class provides an index of the keyframes in a video
+                //! stream. The index is built by demuxing the packets of the
+                //! stream without decoding them, and is used to seek to the
+                //! keyframe before a frame.
+                class Index
+                {
+                public:
+                    Index();
+                    explicit Index(const std::vector<KeyFrame>&);
+
+                    bool isValid() const;
+                    const std::vector<KeyFrame>& getKeyFrames() const;
+
+                    //! Get the keyframe at or before the given frame. Frames
+                    //! before the first keyframe return the first keyframe.
+                    KeyFrame getKeyFrame(Core::Frame::Number) const;
+
+                    //! Get the keyframe after the given frame. Returns an
+                    //! invalid frame number if there are no more keyframes.
+                    Core::Frame::Number getNextKeyFrame(Core::Frame::Number) const;
+
+                    //! Build the index for the first video stream of a file.
+                    //! The packets are read until the end of the file or the
+                    //! token is cancelled.
+                    //!
+                    //! Throws:
+                    //! - std::exception
+                    static Index create(
+                        const std::string& fileName,
+                        const Core::Time::Speed&,
+                        const std::shared_ptr<CancelToken>&);
+
+                    //! \name Serialization
+                    ///@{
+
+                    std::vector<uint8_t> toData() const;
+
+                    //! Throws:
+                    //! - std::exception
+                    static Index fromData(const std::vector<uint8_t>&);
+
+                    ///@}
+
+                    bool operator == (const Index&) const;
+
+                private:
+                    std::vector<KeyFrame> _keyFrames;
                 };
 
                 //! This class provides the FFmpeg file reader.
@@ -137,6 +233,21 @@ namespace djv
                     };
                     int _decodeAudio(const DecodeAudio&, Core::Frame::Number&);
 
+                    //! Start converting the current video frame with the thread
+                    //! pool. The conversion of the previous frame is finished
+                    //! first so that the frames stay in order.
+                    void _convertVideo(Core::Frame::Number, const std::shared_ptr<Image::Image>&, bool cacheEnabled);
+                    void _convertVideoSlice(size_t);
+
+                    //! Wait for the current conversion and optionally add the
+                    //! frame to the video queue.
+                    void _finishConvertVideo(bool add);
+
+                    //! Read frames for reverse playback, starting a new read if
+                    //! the seek frame is valid.
+                    void _readReverse(Core::Frame::Number seek);
+                    void _stopReverse();
+
                     DJV_PRIVATE();
                 };
 
@@ -166,6 +277,8 @@ namespace djv
         } // namespace IO
     } // namespace AV
 
+    DJV_ENUM_SERIALIZE_HELPERS(AV::IO::FFmpeg::ThreadType);
+
     picojson::value toJSON(const AV::IO::FFmpeg::Options&);
 
     //! Throws:
@@ -0,0 +1,269 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/FFmpeg.h>
+
+#include <djvCore/FileSystem.h>
+#include <djvCore/String.h>
+#include <djvCore/StringFormat.h>
+
+extern "C"
+{
+#include <libavformat/avformat.h>
+
+} // extern "C"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            namespace FFmpeg
+            {
+                namespace
+                {
+                    const uint32_t indexVersion = 1;
+
+                } // namespace
+
+                KeyFrame::KeyFrame()
+                {}
+
+                KeyFrame::KeyFrame(Frame::Number frame, int64_t timestamp) :
+                    frame(frame),
+                    timestamp(timestamp)
+                {}
+
+                bool KeyFrame::operator == (const KeyFrame& other) const
+                {
+                    return frame == other.frame && timestamp == other.timestamp;
+                }
+
+                Index::Index()
+                {}
+
+                Index::Index(const std::vector<KeyFrame>& keyFrames) :
+                    _keyFrames(keyFrames)
+                {
+                    std::sort(
+                        _keyFrames.begin(),
+                        _keyFrames.end(),
+                        [](const KeyFrame& a, const KeyFrame& b)
+                        {
+                            return a.frame < b.frame;
+                        });
+                    _keyFrames.erase(
+                        std::unique(
+                            _keyFrames.begin(),
+                            _keyFrames.end(),
+                            [](const KeyFrame& a, const KeyFrame& b)
+                            {
+                                return a.frame == b.frame;
+                            }),
+                        _keyFrames.end());
+                }
+
+                bool Index::isValid() const
+                {
+                    return !_keyFrames.empty();
+                }
+
+                const std::vector<KeyFrame>& Index::getKeyFrames() const
+                {
+                    return _keyFrames;
+                }
+
+                KeyFrame Index::getKeyFrame(Frame::Number value) const
+                {
+                    KeyFrame out;
+                    if (!_keyFrames.empty())
+                    {
+                        auto i = std::upper_bound(
+                            _keyFrames.begin(),
+                            _keyFrames.end(),
+                            value,
+                            [](Frame::Number value, const KeyFrame& keyFrame)
+                            {
+                                return value < keyFrame.frame;
+                            });
+                        out = i != _keyFrames.begin() ? *(i - 1) : _keyFrames.front();
+                    }
+                    return out;
+                }
+
+                Frame::Number Index::getNextKeyFrame(Frame::Number value) const
+                {
+                    const auto i = std::upper_bound(
+                        _keyFrames.begin(),
+                        _keyFrames.end(),
+                        value,
+                        [](Frame::Number value, const KeyFrame& keyFrame)
+                        {
+                            return value < keyFrame.frame;
+                        });
+                    return i != _keyFrames.end() ? i->frame : Frame::invalid;
+                }
+
+                Index Index::create(
+                    const std::string& fileName,
+                    const Time::Speed& speed,
+                    const std::shared_ptr<CancelToken>& cancelToken)
+                {
+                    // The index uses a separate format context so that it can
+                    // be built while the reader is decoding.
+                    AVFormatContext* avFormatContext = nullptr;
+                    int r = avformat_open_input(&avFormatContext, fileName.c_str(), nullptr, nullptr);
+                    if (r < 0)
+                    {
+                        throw FileSystem::Error(String::Format("'{0}': {1}").
+                            arg(fileName).
+                            arg(getErrorString(r)));
+                    }
+                    std::vector<KeyFrame> keyFrames;
+                    AVPacket packet;
+                    try
+                    {
+                        r = avformat_find_stream_info(avFormatContext, 0);
+                        if (r < 0)
+                        {
+                            throw FileSystem::Error(String::Format("'{0}': {1}").
+                                arg(fileName).
+                                arg(getErrorString(r)));
+                        }
+
+                        // Only read the packets of the first video stream.
+                        int stream = -1;
+                        for (unsigned int i = 0; i < avFormatContext->nb_streams; ++i)
+                        {
+                            if (-1 == stream && avFormatContext->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO)
+                            {
+                                stream = i;
+                            }
+                            else
+                            {
+                                avFormatContext->streams[i]->discard = AVDISCARD_ALL;
+                            }
+                        }
+                        if (stream != -1)
+                        {
+                            const AVRational timeBase = avFormatContext->streams[stream]->time_base;
+                            AVRational r;
+                            r.num = speed.getDen();
+                            r.den = speed.getNum();
+                            while (!cancelToken->isCancelled() && av_read_frame(avFormatContext, &packet) >= 0)
+                            {
+                                if (stream == packet.stream_index && (packet.flags & AV_PKT_FLAG_KEY))
+                                {
+                                    const int64_t timestamp = packet.pts != AV_NOPTS_VALUE ? packet.pts : packet.dts;
+                                    if (timestamp != AV_NOPTS_VALUE)
+                                    {
+                                        keyFrames.push_back(KeyFrame(av_rescale_q(timestamp, timeBase, r), timestamp));
+                                    }
+                                }
+                                av_packet_unref(&packet);
+                            }
+                        }
+                    }
+                    catch (const std::exception&)
+                    {
+                        avformat_close_input(&avFormatContext);
+                        throw;
+                    }
+                    avformat_close_input(&avFormatContext);
+                    if (cancelToken->isCancelled())
+                    {
+                        keyFrames.clear();
+                    }
+                    return Index(keyFrames);
+                }
+
+                std::vector<uint8_t> Index::toData() const
+                {
+                    const uint32_t count = static_cast<uint32_t>(_keyFrames.size());
+                    std::vector<uint8_t> out(sizeof(uint32_t) * 2 + count * sizeof(int64_t) * 2);
+                    uint8_t* p = out.data();
+                    memcpy(p, &indexVersion, sizeof(uint32_t));
+                    p += sizeof(uint32_t);
+                    memcpy(p, &count, sizeof(uint32_t));
+                    p += sizeof(uint32_t);
+                    for (const auto& i : _keyFrames)
+                    {
+                        const int64_t frame = i.frame;
+                        memcpy(p, &frame, sizeof(int64_t));
+                        p += sizeof(int64_t);
+                        memcpy(p, &i.timestamp, sizeof(int64_t));
+                        p += sizeof(int64_t);
+                    }
+                    return out;
+                }
+
+                Index Index::fromData(const std::vector<uint8_t>& data)
+                {
+                    uint32_t version = 0;
+                    uint32_t count = 0;
+                    if (data.size() >= sizeof(uint32_t) * 2)
+                    {
+                        memcpy(&version, data.data(), sizeof(uint32_t));
+                        memcpy(&count, data.data() + sizeof(uint32_t), sizeof(uint32_t));
+                    }
+                    if (version != indexVersion ||
+                        data.size() != sizeof(uint32_t) * 2 + static_cast<size_t>(count) * sizeof(int64_t) * 2)
+                    {
+                        throw std::invalid_argument(DJV_TEXT("error_cannot_parse_the_value"));
+                    }
+                    std::vector<KeyFrame> keyFrames(count);
+                    const uint8_t* p = data.data() + sizeof(uint32_t) * 2;
+                    for (auto& i : keyFrames)
+                    {
+                        int64_t frame = 0;
+                        memcpy(&frame, p, sizeof(int64_t));
+                        p += sizeof(int64_t);
+                        memcpy(&i.timestamp, p, sizeof(int64_t));
+                        p += sizeof(int64_t);
+                        i.frame = static_cast<Frame::Number>(frame);
+                    }
+                    return Index(keyFrames);
+                }
+
+                bool Index::operator == (const Index& other) const
+                {
+                    return _keyFrames == other._keyFrames;
+                }
+
+            } // namespace FFmpeg
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
+
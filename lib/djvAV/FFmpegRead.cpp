@@ -29,10 +29,14 @@
 
 #include <djvAV/FFmpeg.h>
 
+#include <djvAV/DiskCache.h>
+
 #include <djvCore/FileSystem.h>
 #include <djvCore/LogSystem.h>
+#include <djvCore/Memory.h>
 #include <djvCore/StringFormat.h>
 #include <djvCore/TextSystem.h>
+#include <djvCore/ThreadPool.h>
 #include <djvCore/Timer.h>
 #include <djvCore/Vector.h>
 
@@ -41,10 +45,13 @@ extern "C"
 #include <libavformat/avformat.h>
 #include <libavutil/dict.h>
 #include <libavutil/imgutils.h>
+#include <libavutil/pixdesc.h>
 #include <libswscale/swscale.h>
 
 } // extern "C"
 
+#include <list>
+
 using namespace djv::Core;
 
 namespace djv
@@ -55,6 +62,293 @@ namespace djv
         {
             namespace FFmpeg
             {
+                namespace
+                {
+                    //! The minimum number of scanlines in a conversion slice.
+                    const int sliceHeightMin = 64;
+
+                    //! The number of decoders used for reverse playback.
+                    const size_t reverseDecoderCount = 2;
+
+                    //! The maximum size of the frames decoded at once for reverse
+                    //! playback. Groups of pictures that are larger are split, and
+                    //! the frames before each split are decoded again.
+                    const size_t reverseByteCountMax = 128 * Memory::megabyte;
+
+                    //! Get the image information for a decoded frame.
+                    Image::Info getFrameInfo(const Image::Info& info, const AVFrame* avFrame)
+                    {
+                        Image::Info out = info;
+                        if (!((0 == avFrame->sample_aspect_ratio.num && 1 == avFrame->sample_aspect_ratio.den) ||
+                            0 == avFrame->sample_aspect_ratio.den))
+                        {
+                            out.pixelAspectRatio = avFrame->sample_aspect_ratio.num / static_cast<float>(avFrame->sample_aspect_ratio.den);
+                        }
+                        if (Image::isYUVType(out.type))
+                        {
+                            out.yuvCoefficients = toYUVCoefficients(avFrame->colorspace, out.size);
+                            out.yuvRange = toYUVRange(avFrame->color_range, static_cast<AVPixelFormat>(avFrame->format));
+                        }
+                        return out;
+                    }
+
+                    //! Copy the planes of a decoded frame that is in the native
+                    //! format of the image.
+                    void copyPlanes(const AVFrame* avFrame, Image::Image& image)
+                    {
+                        const auto& info = image.getInfo();
+                        const size_t pixelByteCount = info.getPixelByteCount();
+                        for (size_t i = 0; i < info.getPlaneCount(); ++i)
+                        {
+                            const Image::Size planeSize = info.getPlaneSize(i);
+                            const size_t byteCount = planeSize.w * pixelByteCount;
+                            for (uint16_t y = 0; y < planeSize.h; ++y)
+                            {
+                                memcpy(
+                                    image.getPlaneData(i, y),
+                                    avFrame->data[i] + y * static_cast<size_t>(avFrame->linesize[i]),
+                                    byteCount);
+                            }
+                        }
+                    }
+
+                    //! This struct provides a range of frames decoded for reverse
+                    //! playback.
+                    struct ReverseChunk
+                    {
+                        Frame::Number first = Frame::invalid;
+                        Frame::Number last  = Frame::invalid;
+                        std::vector<VideoFrame> frames;
+                    };
+
+                    //! This class provides a video decoder for reverse playback.
+                    //! Each decoder has its own format context so that several
+                    //! decoders can run in parallel with the reader.
+                    class ReverseDecoder
+                    {
+                        DJV_NON_COPYABLE(ReverseDecoder);
+
+                    public:
+                        ReverseDecoder()
+                        {}
+
+                        ~ReverseDecoder()
+                        {
+                            if (_swsContext)
+                            {
+                                sws_freeContext(_swsContext);
+                            }
+                            if (_avFrame)
+                            {
+                                av_frame_free(&_avFrame);
+                            }
+                            if (_avCodecContext)
+                            {
+                                avcodec_close(_avCodecContext);
+                                avcodec_free_context(&_avCodecContext);
+                            }
+                            if (_avFormatContext)
+                            {
+                                avformat_close_input(&_avFormatContext);
+                            }
+                        }
+
+                        //! Throws:
+                        //! - std::exception
+                        void open(
+                            const std::string& fileName,
+                            int stream,
+                            const Options& options,
+                            const Image::Info& info,
+                            AVPixelFormat avPixelFormatOut,
+                            const Time::Speed& speed)
+                        {
+                            int r = avformat_open_input(&_avFormatContext, fileName.c_str(), nullptr, nullptr);
+                            if (r < 0)
+                            {
+                                throw FileSystem::Error(String::Format("'{0}': {1}").
+                                    arg(fileName).
+                                    arg(getErrorString(r)));
+                            }
+                            r = avformat_find_stream_info(_avFormatContext, 0);
+                            if (r < 0 || stream >= static_cast<int>(_avFormatContext->nb_streams))
+                            {
+                                throw FileSystem::Error(String::Format("'{0}': {1}").
+                                    arg(fileName).
+                                    arg(getErrorString(r)));
+                            }
+                            for (unsigned int i = 0; i < _avFormatContext->nb_streams; ++i)
+                            {
+                                if (static_cast<int>(i) != stream)
+                                {
+                                    _avFormatContext->streams[i]->discard = AVDISCARD_ALL;
+                                }
+                            }
+                            _avStream = stream;
+                            const auto avCodecParameters = _avFormatContext->streams[stream]->codecpar;
+                            auto avCodec = avcodec_find_decoder(avCodecParameters->codec_id);
+                            if (!avCodec)
+                            {
+                                throw FileSystem::Error(String::Format("'{0}': {1}").
+                                    arg(fileName).
+                                    arg(getErrorString(AVERROR_DECODER_NOT_FOUND)));
+                            }
+                            _avCodecContext = avcodec_alloc_context3(avCodec);
+                            r = avcodec_parameters_to_context(_avCodecContext, avCodecParameters);
+                            if (r < 0)
+                            {
+                                throw FileSystem::Error(String::Format("'{0}': {1}").
+                                    arg(fileName).
+                                    arg(getErrorString(r)));
+                            }
+                            _avCodecContext->thread_count = options.threadCount;
+                            _avCodecContext->thread_type = toFFmpeg(options.threadType);
+                            r = avcodec_open2(_avCodecContext, avCodec, 0);
+                            if (r < 0)
+                            {
+                                throw FileSystem::Error(String::Format("'{0}': {1}").
+                                    arg(fileName).
+                                    arg(getErrorString(r)));
+                            }
+                            _avFrame = av_frame_alloc();
+
+                            _info = info;
+                            _avPixelFormatOut = avPixelFormatOut;
+                            const AVPixelFormat avPixelFormat = static_cast<AVPixelFormat>(avCodecParameters->format);
+                            if (avPixelFormat != avPixelFormatOut ||
+                                avCodecParameters->width != info.size.w ||
+                                avCodecParameters->height != info.size.h)
+                            {
+                                _swsContext = sws_getContext(
+                                    avCodecParameters->width,
+                                    avCodecParameters->height,
+                                    avPixelFormat,
+                                    info.size.w,
+                                    info.size.h,
+                                    avPixelFormatOut,
+                                    SWS_BILINEAR,
+                                    0,
+                                    0,
+                                    0);
+                            }
+                            _speed = speed;
+                        }
+
+                        //! Decode the frames up to the last frame, keeping the
+                        //! frames from the first frame on. The decoder seeks to
+                        //! the given timestamp before decoding, and the first frame
+                        //! of the range is moved up to the first decoded frame.
+                        ReverseChunk decode(
+                            Frame::Number first,
+                            Frame::Number last,
+                            int64_t timestamp,
+                            const std::shared_ptr<CancelToken>& cancelToken)
+                        {
+                            ReverseChunk out;
+                            out.first = first;
+                            out.last = last;
+                            avcodec_flush_buffers(_avCodecContext);
+                            if (av_seek_frame(_avFormatContext, _avStream, timestamp, AVSEEK_FLAG_BACKWARD) < 0)
+                            {
+                                out.first = last;
+                                return out;
+                            }
+                            const AVRational timeBase = _avFormatContext->streams[_avStream]->time_base;
+                            AVRational rate;
+                            rate.num = _speed.getDen();
+                            rate.den = _speed.getNum();
+                            bool decoded = false;
+                            bool finished = false;
+                            AVPacket packet;
+                            while (!finished && !cancelToken->isCancelled())
+                            {
+                                const bool eof = av_read_frame(_avFormatContext, &packet) < 0;
+                                if (!eof && packet.stream_index != _avStream)
+                                {
+                                    av_packet_unref(&packet);
+                                    continue;
+                                }
+                                int r = avcodec_send_packet(_avCodecContext, eof ? nullptr : &packet);
+                                while (r >= 0 && !finished)
+                                {
+                                    r = avcodec_receive_frame(_avCodecContext, _avFrame);
+                                    if (r < 0)
+                                    {
+                                        break;
+                                    }
+                                    const Frame::Number frame = av_rescale_q(
+                                        _avFrame->pts != AV_NOPTS_VALUE ? _avFrame->pts : _avFrame->best_effort_timestamp,
+                                        timeBase,
+                                        rate);
+                                    if (!decoded)
+                                    {
+                                        decoded = true;
+                                        out.first = std::min(std::max(out.first, frame), last);
+                                    }
+                                    if (frame >= out.first && frame <= last)
+                                    {
+                                        out.frames.push_back(VideoFrame(frame, _convert()));
+                                    }
+                                    finished = frame >= last;
+                                }
+                                if (!eof)
+                                {
+                                    av_packet_unref(&packet);
+                                }
+                                finished |= eof;
+                            }
+                            if (!decoded)
+                            {
+                                out.first = last;
+                            }
+                            return out;
+                        }
+
+                    private:
+                        std::shared_ptr<Image::Image> _convert()
+                        {
+                            auto out = Image::Image::create(getFrameInfo(_info, _avFrame));
+                            out->setPluginName(pluginName);
+                            if (_swsContext)
+                            {
+                                uint8_t* data[4] = { nullptr, nullptr, nullptr, nullptr };
+                                int linesize[4] = { 0, 0, 0, 0 };
+                                av_image_fill_arrays(
+                                    data,
+                                    linesize,
+                                    out->getData(),
+                                    _avPixelFormatOut,
+                                    out->getWidth(),
+                                    out->getHeight(),
+                                    1);
+                                sws_scale(
+                                    _swsContext,
+                                    _avFrame->data,
+                                    _avFrame->linesize,
+                                    0,
+                                    _avCodecContext->height,
+                                    data,
+                                    linesize);
+                            }
+                            else
+                            {
+                                copyPlanes(_avFrame, *out);
+                            }
+                            return out;
+                        }
+
+                        AVFormatContext* _avFormatContext = nullptr;
+                        int _avStream = -1;
+                        AVCodecContext* _avCodecContext = nullptr;
+                        AVFrame* _avFrame = nullptr;
+                        SwsContext* _swsContext = nullptr;
+                        Image::Info _info;
+                        AVPixelFormat _avPixelFormatOut = AV_PIX_FMT_NONE;
+                        Time::Speed _speed;
+                    };
+
+                } // namespace
+
                 struct Read::Private
                 {
                     Options options;
@@ -62,7 +356,6 @@ namespace djv
                     AudioInfo audioInfo;
                     Time::Speed speed;
                     std::promise<Info> infoPromise;
-                    std::condition_variable queueCV;
                     int64_t seek = Frame::invalid;
                     Direction direction = Direction::Forward;
                     std::thread thread;
@@ -74,8 +367,52 @@ namespace djv
                     std::map<int, AVCodecParameters *> avCodecParameters;
                     std::map<int, AVCodecContext *> avCodecContext;
                     AVFrame * avFrame = nullptr;
-                    AVFrame * avFrameRgb = nullptr;
-                    SwsContext * swsContext = nullptr;
+                    AVFrame * avFrameOut = nullptr;
+                    AVPixelFormat avPixelFormatOut = AV_PIX_FMT_NONE;
+
+                    //! The software scaler contexts, one for each horizontal
+                    //! slice of the frame.
+                    struct Slice
+                    {
+                        SwsContext* swsContext = nullptr;
+                        int y = 0;
+                        int h = 0;
+                    };
+                    std::vector<Slice> swsSlices;
+                    int chromaShiftY = 0;
+                    int chromaShiftYOut = 0;
+
+                    //! The frame currently being converted.
+                    AVFrame * avFrameConvert = nullptr;
+                    Frame::Number convertFrame = Frame::invalid;
+                    std::shared_ptr<Image::Image> convertImage;
+                    bool convertCacheEnabled = false;
+                    std::vector<std::future<void> > convertFutures;
+
+                    //! The keyframe index is built in the background after the
+                    //! file is opened.
+                    std::future<Index> indexFuture;
+                    std::shared_ptr<CancelToken> indexCancelToken;
+                    std::shared_ptr<Index> index;
+
+                    //! The last frame that came out of the video decoder.
+                    Frame::Number videoFrame = Frame::invalid;
+
+                    //! Reverse playback decodes each group of pictures forward
+                    //! into a buffer, and adds the frames to the queue backwards.
+                    //! The earlier groups of pictures are decoded with the thread
+                    //! pool while the frames are added.
+                    struct ReverseRead
+                    {
+                        size_t decoder = 0;
+                        std::future<ReverseChunk> future;
+                    };
+                    std::unique_ptr<ReverseDecoder> reverseDecoders[reverseDecoderCount];
+                    size_t reverseFramesMax = 1;
+                    std::list<ReverseRead> reverseReads;
+                    std::vector<VideoFrame> reverseFrames;
+                    Frame::Number reverseNext = Frame::invalid;
+                    std::shared_ptr<CancelToken> reverseCancelToken;
                 };
 
                 void Read::_init(
@@ -180,7 +517,7 @@ namespace djv
                                         arg(FFmpeg::getErrorString(r)));
                                 }
                                 p.avCodecContext[p.avVideoStream]->thread_count = p.options.threadCount;
-                                p.avCodecContext[p.avVideoStream]->thread_type = FF_THREAD_SLICE;
+                                p.avCodecContext[p.avVideoStream]->thread_type = toFFmpeg(p.options.threadType);
                                 r = avcodec_open2(p.avCodecContext[p.avVideoStream], avVideoCodec, 0);
                                 if (r < 0)
                                 {
@@ -190,26 +527,76 @@ namespace djv
                                 }
 
                                 // Initialize the buffers.
-                                p.avFrameRgb = av_frame_alloc();
-
-                                // Initialize the software scaler.
-                                p.swsContext = sws_getContext(
-                                    p.avCodecParameters[p.avVideoStream]->width,
-                                    p.avCodecParameters[p.avVideoStream]->height,
-                                    static_cast<AVPixelFormat>(p.avCodecParameters[p.avVideoStream]->format),
-                                    p.avCodecParameters[p.avVideoStream]->width,
-                                    p.avCodecParameters[p.avVideoStream]->height,
-                                    AV_PIX_FMT_RGBA,
-                                    SWS_BILINEAR,
-                                    0,
-                                    0,
-                                    0);
+                                p.avFrameOut = av_frame_alloc();
+                                p.avFrameConvert = av_frame_alloc();
+
+                                // Initialize the software scaler. Planar YUV
+                                // frames are kept in their native format and
+                                // only need the software scaler for proxies,
+                                // other formats are converted to RGBA.
+                                const auto avCodecParameters = p.avCodecParameters[p.avVideoStream];
+                                const AVPixelFormat avPixelFormat = static_cast<AVPixelFormat>(avCodecParameters->format);
+                                const Image::Size size(avCodecParameters->width, avCodecParameters->height);
+                                const Image::Size proxySize = getProxySize(size, _options.proxy);
+                                Image::Type imageType = toImageType(avPixelFormat);
+                                if (imageType != Image::Type::None)
+                                {
+                                    p.avPixelFormatOut = avPixelFormat;
+                                }
+                                else
+                                {
+                                    imageType = Image::Type::RGBA_U8;
+                                    p.avPixelFormatOut = AV_PIX_FMT_RGBA;
+                                }
+                                if (p.avPixelFormatOut != avPixelFormat || proxySize != size)
+                                {
+                                    // Split the conversion into horizontal slices
+                                    // that are converted in parallel. The slices
+                                    // are aligned to the chroma subsampling. Proxies
+                                    // use a single slice since the scaling filter
+                                    // would otherwise stop at the slice edges.
+                                    const AVPixFmtDescriptor* avPixFmtDesc = av_pix_fmt_desc_get(avPixelFormat);
+                                    const AVPixFmtDescriptor* avPixFmtDescOut = av_pix_fmt_desc_get(p.avPixelFormatOut);
+                                    int sliceCount = 1;
+                                    int sliceAlign = 1;
+                                    if (proxySize == size &&
+                                        avPixFmtDesc &&
+                                        avPixFmtDescOut &&
+                                        !(avPixFmtDesc->flags & AV_PIX_FMT_FLAG_PAL))
+                                    {
+                                        p.chromaShiftY = avPixFmtDesc->log2_chroma_h;
+                                        p.chromaShiftYOut = avPixFmtDescOut->log2_chroma_h;
+                                        sliceAlign = 1 << std::max(p.chromaShiftY, p.chromaShiftYOut);
+                                        sliceCount = std::max(
+                                            std::min(static_cast<int>(_threadCount), size.h / sliceHeightMin),
+                                            1);
+                                    }
+                                    int sliceHeight = (size.h + sliceCount - 1) / sliceCount;
+                                    sliceHeight = (sliceHeight + sliceAlign - 1) / sliceAlign * sliceAlign;
+                                    for (int y = 0; y < size.h; y += sliceHeight)
+                                    {
+                                        Private::Slice slice;
+                                        slice.y = y;
+                                        slice.h = std::min(sliceHeight, size.h - y);
+                                        slice.swsContext = sws_getContext(
+                                            size.w,
+                                            slice.h,
+                                            avPixelFormat,
+                                            proxySize.w,
+                                            1 == sliceCount ? proxySize.h : slice.h,
+                                            p.avPixelFormatOut,
+                                            SWS_BILINEAR,
+                                            0,
+                                            0,
+                                            0);
+                                        p.swsSlices.push_back(slice);
+                                    }
+                                }
 
                                 // Get information.
-                                const auto pixelDataInfo = Image::Info(
-                                    p.avCodecParameters[p.avVideoStream]->width,
-                                    p.avCodecParameters[p.avVideoStream]->height,
-                                    Image::Type::RGBA_U8);
+                                auto pixelDataInfo = Image::Info(proxySize, imageType);
+                                pixelDataInfo.yuvCoefficients = toYUVCoefficients(avCodecParameters->color_space, size);
+                                pixelDataInfo.yuvRange = toYUVRange(avCodecParameters->color_range, avPixelFormat);
                                 if (avVideoStream->duration != AV_NOPTS_VALUE)
                                 {
                                     AVRational r;
@@ -233,6 +620,10 @@ namespace djv
                                 p.speed = Time::Speed(avVideoStream->r_frame_rate.num, avVideoStream->r_frame_rate.den);
                                 p.videoInfo = VideoInfo(pixelDataInfo, p.speed, Frame::Sequence(Frame::Range(1, sequenceSize)));
                                 p.videoInfo.codec = std::string(avVideoCodec->long_name);
+                                const size_t dataByteCount = pixelDataInfo.getDataByteCount();
+                                p.reverseFramesMax = dataByteCount ?
+                                    std::max(reverseByteCountMax / dataByteCount, static_cast<size_t>(1)) :
+                                    1;
                                 info.video.push_back(p.videoInfo);
                                 /*{
                                     std::stringstream ss;
@@ -328,8 +719,65 @@ namespace djv
 
                             p.infoPromise.set_value(info);
 
+                            if (p.avVideoStream != -1)
+                            {
+                                // Read the keyframe index from the disk cache, or
+                                // build it with the thread pool. The task does
+                                // not reference the reader so that it can finish
+                                // after the reader is destroyed.
+                                p.indexCancelToken = CancelToken::create();
+                                const std::string fileName = _fileInfo.getFileName();
+                                const Time::Speed speed = p.speed;
+                                const auto diskCache = _options.diskCache;
+                                const auto cancelToken = p.indexCancelToken;
+                                p.indexFuture = _threadPool->addTaskFuture<Index>(
+                                    [fileName, speed, diskCache, cancelToken]
+                                    {
+                                        Index out;
+                                        const bool diskCacheEnabled = diskCache && diskCache->isEnabled();
+                                        DiskCacheKey diskCacheKey;
+                                        if (diskCacheEnabled)
+                                        {
+                                            const FileSystem::FileInfo fileInfo(fileName);
+                                            diskCacheKey = DiskCacheKey(fileName, fileInfo.getTime(), fileInfo.getSize(), 0, 0);
+                                            std::vector<uint8_t> data;
+                                            if (diskCache->readMediaData(diskCacheKey, data))
+                                            {
+                                                try
+                                                {
+                                                    out = Index::fromData(data);
+                                                }
+                                                catch (const std::exception&)
+                                                {}
+                                            }
+                                        }
+                                        if (!out.isValid())
+                                        {
+                                            try
+                                            {
+                                                out = Index::create(fileName, speed, cancelToken);
+                                                if (diskCacheEnabled && out.isValid())
+                                                {
+                                                    diskCache->writeMediaData(diskCacheKey, out.toData());
+                                                }
+                                            }
+                                            catch (const std::exception&)
+                                            {}
+                                        }
+                                        return out;
+                                    },
+                                    TaskPriority::Low);
+                            }
+
+                            const auto timeout = Time::getTime(Time::TimerValue::Slow);
                             while (p.running)
                             {
+                                if (p.indexFuture.valid() &&
+                                    p.indexFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                                {
+                                    p.index = std::make_shared<Index>(p.indexFuture.get());
+                                }
+
                                 //! \todo Implement me!
                                 /*bool cacheEnabled = false;
                                 size_t cacheMaxByteCount = 0;
@@ -354,46 +802,40 @@ namespace djv
                                 }*/
 
                                 bool read = false;
+                                bool clear = false;
                                 int64_t seek = Frame::invalid;
                                 {
                                     //const std::vector<Frame::Number> cachedFrames = _cache.getKeys();
-                                    std::unique_lock<std::mutex> lock(_mutex);
-                                    if (p.queueCV.wait_for(
-                                        lock,
-                                        Time::getTime(Time::TimerValue::Fast),
-                                        [this, sequenceSize]
-                                        //[this, sequenceSize, cacheEnabled, &cachedFrames]
-                                    {
-                                        DJV_PRIVATE_PTR();
-                                        const bool video = p.avVideoStream != -1 && (_videoQueue.isFinished() ? false : (_videoQueue.getCount() < _videoQueue.getMax()));
-                                        const bool audio = p.avAudioStream != -1 && (_audioQueue.isFinished() ? false : (_audioQueue.getCount() < _audioQueue.getMax()));
+                                    std::lock_guard<std::mutex> lock(_mutex);
+                                    const bool video = p.avVideoStream != -1 && (_videoQueue.isFinished() ? false : (_videoQueue.getCount() < _videoQueue.getMax()));
+                                    const bool audio = p.avAudioStream != -1 && (_audioQueue.isFinished() ? false : (_audioQueue.getCount() < _audioQueue.getMax()));
 
-                                        /*bool cache = false;
-                                        if (cacheEnabled && !_videoQueue.isFinished() && !_audioQueue.isFinished())
+                                    /*bool cache = false;
+                                    if (cacheEnabled && !_videoQueue.isFinished() && !_audioQueue.isFinished())
+                                    {
+                                        const size_t cacheMax = _cache.getMax();
+                                        cache |= _cache.getSize() < cacheMax;
+                                        if (_videoQueue.getFrameCount())
                                         {
-                                            const size_t cacheMax = _cache.getMax();
-                                            cache |= _cache.getSize() < cacheMax;
-                                            if (_videoQueue.getFrameCount())
+                                            const auto& frame = _videoQueue.getFrame();
+                                            for (const auto& i : cachedFrames)
                                             {
-                                                const auto& frame = _videoQueue.getFrame();
-                                                for (const auto& i : cachedFrames)
+                                                if (i < frame.frame || i > frame.frame + cacheMax)
                                                 {
-                                                    if (i < frame.frame || i > frame.frame + cacheMax)
-                                                    {
-                                                        cache = true;
-                                                        break;
-                                                    }
+                                                    cache = true;
+                                                    break;
                                                 }
                                             }
-                                        }*/
-                                        
-                                        return video || audio || p.seek != Frame::invalid || p.direction != _direction;
-                                        //return video || audio || p.seek != Frame::invalid || p.direction != _direction || cache;
-                                    }))
+                                        }
+                                    }*/
+                                    
+                                    if (video || audio || p.seek != Frame::invalid || p.direction != _direction)
+                                    //if (video || audio || p.seek != Frame::invalid || p.direction != _direction || cache)
                                     {
                                         read = true;
                                         if (p.direction != _direction)
                                         {
+                                            clear = true;
                                             p.direction = _direction;
                                             _videoQueue.setFinished(false);
                                             _videoQueue.clearFrames();
@@ -411,49 +853,104 @@ namespace djv
                                         }
                                     }
                                 }
+                                if (!read)
+                                {
+                                    // Finish the current conversion and sleep
+                                    // until a frame is removed from the queues,
+                                    // there is a seek, or the reader is destroyed.
+                                    _finishConvertVideo(true);
+                                    _wait(timeout);
+                                    continue;
+                                }
+                                if (seek != Frame::invalid || clear)
+                                {
+                                    _finishConvertVideo(false);
+                                    _stopReverse();
+                                }
+                                if (Direction::Reverse == p.direction && p.avVideoStream != -1)
+                                {
+                                    if (Frame::invalid == seek && clear)
+                                    {
+                                        seek = p.videoFrame != Frame::invalid ? p.videoFrame : 0;
+                                    }
+                                    _readReverse(seek);
+                                    continue;
+                                }
+
                                 AVPacket packet;
                                 try
                                 {
                                     if (seek != Frame::invalid)
                                     {
-                                        int64_t t = 0;
-                                        int stream = -1;
-                                        if (p.avVideoStream != -1)
-                                        {
-                                            stream = p.avVideoStream;
-                                            AVRational r;
-                                            r.num = p.speed.getDen();
-                                            r.den = p.speed.getNum();
-                                            t = av_rescale_q(seek, r, p.avFormatContext->streams[p.avVideoStream]->time_base);
-                                            //t = av_rescale_q(seek, r, av_get_time_base_q());
-                                        }
-                                        else if (p.avAudioStream != -1)
+                                        // With the keyframe index, frames in the
+                                        // same group of pictures and ahead of the
+                                        // last decoded frame are reached by
+                                        // decoding forward, and other frames by
+                                        // seeking to the keyframe before them.
+                                        bool decodeForward = false;
+                                        KeyFrame keyFrame;
+                                        const bool index = p.avVideoStream != -1 && p.index && p.index->isValid();
+                                        if (index)
                                         {
-                                            stream = p.avAudioStream;
-                                            AVRational r;
-                                            r.num = 1;
-                                            r.den = p.audioInfo.info.sampleRate;
-                                            t = av_rescale_q(seek, r, p.avFormatContext->streams[p.avAudioStream]->time_base);
-                                            //t = av_rescale_q(seek, r, av_get_time_base_q());
+                                            keyFrame = p.index->getKeyFrame(seek);
+                                            decodeForward =
+                                                p.videoFrame != Frame::invalid &&
+                                                seek > p.videoFrame &&
+                                                keyFrame.frame <= p.videoFrame;
                                         }
-                                        if (p.avVideoStream != -1)
+                                        if (!decodeForward)
                                         {
-                                            avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
-                                        }
-                                        if (p.avAudioStream != -1)
-                                        {
-                                            avcodec_flush_buffers(p.avCodecContext[p.avAudioStream]);
-                                        }
-                                        if (av_seek_frame(
-                                            p.avFormatContext,
-                                            stream,
-                                            t,
-                                            AVSEEK_FLAG_BACKWARD) < 0)
-                                        {
-                                            throw std::exception();
+                                            int64_t t = 0;
+                                            int stream = -1;
+                                            if (index)
+                                            {
+                                                stream = p.avVideoStream;
+                                                t = keyFrame.timestamp;
+                                            }
+                                            else if (p.avVideoStream != -1)
+                                            {
+                                                stream = p.avVideoStream;
+                                                AVRational r;
+                                                r.num = p.speed.getDen();
+                                                r.den = p.speed.getNum();
+                                                t = av_rescale_q(seek, r, p.avFormatContext->streams[p.avVideoStream]->time_base);
+                                                //t = av_rescale_q(seek, r, av_get_time_base_q());
+                                            }
+                                            else if (p.avAudioStream != -1)
+                                            {
+                                                stream = p.avAudioStream;
+                                                AVRational r;
+                                                r.num = 1;
+                                                r.den = p.audioInfo.info.sampleRate;
+                                                t = av_rescale_q(seek, r, p.avFormatContext->streams[p.avAudioStream]->time_base);
+                                                //t = av_rescale_q(seek, r, av_get_time_base_q());
+                                            }
+                                            if (p.avVideoStream != -1)
+                                            {
+                                                avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
+                                                p.videoFrame = Frame::invalid;
+                                            }
+                                            if (p.avAudioStream != -1)
+                                            {
+                                                avcodec_flush_buffers(p.avCodecContext[p.avAudioStream]);
+                                            }
+                                            if (av_seek_frame(
+                                                p.avFormatContext,
+                                                stream,
+                                                t,
+                                                AVSEEK_FLAG_BACKWARD) < 0)
+                                            {
+                                                throw std::exception();
+                                            }
                                         }
-                                        Frame::Number videoFrame = Frame::invalid;
-                                        Frame::Number audioFrame = Frame::invalid;
+                                        // Decode until the frame before the seek time
+                                        // comes out of the decoders. With frame
+                                        // threading the decoders return frames a few
+                                        // packets late, so the frames are counted as
+                                        // they are received rather than as the
+                                        // packets are sent.
+                                        Frame::Number videoFrame = p.avVideoStream != -1 ? Frame::invalid : seek;
+                                        Frame::Number audioFrame = p.avAudioStream != -1 ? Frame::invalid : seek;
                                         while (videoFrame < seek - 1 || audioFrame < seek - 1)
                                         {
                                             if (av_read_frame(p.avFormatContext, &packet) < 0)
@@ -465,6 +962,7 @@ namespace djv
                                                     dv.seek         = seek;
                                                     _decodeVideo(dv, videoFrame);
                                                     avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
+                                                    p.videoFrame = Frame::invalid;
                                                 }
                                                 if (p.avAudioStream != -1)
                                                 {
@@ -512,6 +1010,7 @@ namespace djv
                                                 //dv.cacheEnabled = cacheEnabled;
                                                 _decodeVideo(dv, videoFrame);
                                                 avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
+                                                p.videoFrame = Frame::invalid;
                                             }
                                             if (p.avAudioStream != -1)
                                             {
@@ -551,6 +1050,7 @@ namespace djv
                                         _logSystem->log("djv::AV::IO::FFmpeg::Read", ss.str());
                                     }*/
                                     av_packet_unref(&packet);
+                                    _finishConvertVideo(true);
                                     {
                                         std::lock_guard<std::mutex> lock(_mutex);
                                         _videoQueue.setFinished(true);
@@ -564,13 +1064,27 @@ namespace djv
                             p.infoPromise.set_value(Info());
                             _logSystem->log("djvAV::IO::FFmpeg::Read", e.what(), LogLevel::Error);
                         }
-                        if (p.swsContext)
+                        if (p.indexCancelToken)
+                        {
+                            p.indexCancelToken->cancel();
+                        }
+                        _finishConvertVideo(false);
+                        _stopReverse();
+                        for (auto& i : p.reverseDecoders)
+                        {
+                            i.reset();
+                        }
+                        for (const auto& i : p.swsSlices)
+                        {
+                            sws_freeContext(i.swsContext);
+                        }
+                        if (p.avFrameConvert)
                         {
-                            sws_freeContext(p.swsContext);
+                            av_frame_free(&p.avFrameConvert);
                         }
-                        if (p.avFrameRgb)
+                        if (p.avFrameOut)
                         {
-                            av_frame_free(&p.avFrameRgb);
+                            av_frame_free(&p.avFrameOut);
                         }
                         if (p.avFrame)
                         {
@@ -600,6 +1114,7 @@ namespace djv
                 {
                     DJV_PRIVATE_PTR();
                     p.running = false;
+                    _notify();
                     if (p.thread.joinable())
                     {
 						//! \todo How do we safely detach the thread here so we don't block?
@@ -630,7 +1145,7 @@ namespace djv
                     return _p->infoPromise.get_future();
                 }
 
-                void Read::seek(Frame::Number value, Direction)
+                void Read::seek(Frame::Number value, Direction direction)
                 {
                     DJV_PRIVATE_PTR();
                     {
@@ -638,8 +1153,9 @@ namespace djv
                         _videoQueue.clearFrames();
                         _audioQueue.clearFrames();
                         p.seek = value;
+                        _direction = direction;
                     }
-                    p.queueCV.notify_one();
+                    _notify();
                 }
 
                 int Read::_decodeVideo(const DecodeVideo& dv, Frame::Number& frame)
@@ -663,9 +1179,10 @@ namespace djv
                         r.num = p.speed.getDen();
                         r.den = p.speed.getNum();
                         frame = av_rescale_q(
-                            p.avFrame->pts,
+                            p.avFrame->pts != AV_NOPTS_VALUE ? p.avFrame->pts : p.avFrame->best_effort_timestamp,
                             p.avFormatContext->streams[p.avVideoStream]->time_base,
                             r);
+                        p.videoFrame = frame;
                         //std::cout << "decode video = " << frame << std::endl;
 
                         if (Frame::invalid == dv.seek || frame >= dv.seek)
@@ -675,35 +1192,26 @@ namespace djv
                             {}
                             else
                             {
-                                auto info = p.videoInfo.info;
-                                if (!((0 == p.avFrame->sample_aspect_ratio.num && 1 == p.avFrame->sample_aspect_ratio.den) ||
-                                    0 == p.avFrame->sample_aspect_ratio.den))
+                                image = Image::Image::create(getFrameInfo(p.videoInfo.info, p.avFrame));
+                                image->setPluginName(pluginName);
+                                if (p.swsSlices.size())
                                 {
-                                    info.pixelAspectRatio = p.avFrame->sample_aspect_ratio.num / static_cast<float>(p.avFrame->sample_aspect_ratio.den);
+                                    // Convert the frame with the thread pool
+                                    // while the next frame is decoded.
+                                    _convertVideo(frame, image, dv.cacheEnabled);
+                                    continue;
+                                }
+                                else
+                                {
+                                    // Copy the planes of the native frame.
+                                    copyPlanes(p.avFrame, *image);
                                 }
-                                image = Image::Image::create(info);
-                                image->setPluginName(pluginName);
-                                av_image_fill_arrays(
-                                    p.avFrameRgb->data,
-                                    p.avFrameRgb->linesize,
-                                    image->getData(),
-                                    AV_PIX_FMT_RGBA,
-                                    image->getWidth(),
-                                    image->getHeight(),
-                                    1);
-                                sws_scale(
-                                    p.swsContext,
-                                    (uint8_t const* const*)p.avFrame->data,
-                                    p.avFrame->linesize,
-                                    0,
-                                    p.avCodecParameters[p.avVideoStream]->height,
-                                    p.avFrameRgb->data,
-                                    p.avFrameRgb->linesize);
                                 if (dv.cacheEnabled)
                                 {
                                     _cache.add(frame, image);
                                 }
                             }
+                            _finishConvertVideo(true);
                             {
                                 std::lock_guard<std::mutex> lock(_mutex);
                                 if (Frame::invalid == p.seek)
@@ -716,6 +1224,233 @@ namespace djv
                     return r;
                 }
 
+                void Read::_convertVideo(Frame::Number frame, const std::shared_ptr<Image::Image>& image, bool cacheEnabled)
+                {
+                    DJV_PRIVATE_PTR();
+                    _finishConvertVideo(true);
+
+                    // Keep a reference to the decoded frame since the decoder
+                    // re-uses the frame for the next call.
+                    av_frame_ref(p.avFrameConvert, p.avFrame);
+                    av_image_fill_arrays(
+                        p.avFrameOut->data,
+                        p.avFrameOut->linesize,
+                        image->getData(),
+                        p.avPixelFormatOut,
+                        image->getWidth(),
+                        image->getHeight(),
+                        1);
+                    p.convertFrame = frame;
+                    p.convertImage = image;
+                    p.convertCacheEnabled = cacheEnabled;
+                    for (size_t i = 0; i < p.swsSlices.size(); ++i)
+                    {
+                        p.convertFutures.push_back(_threadPool->addTaskFuture<void>(
+                            [this, i]
+                            {
+                                _convertVideoSlice(i);
+                            }));
+                    }
+                }
+
+                void Read::_convertVideoSlice(size_t index)
+                {
+                    DJV_PRIVATE_PTR();
+                    const auto& slice = p.swsSlices[index];
+                    const uint8_t* src[4] = { nullptr, nullptr, nullptr, nullptr };
+                    uint8_t* dst[4] = { nullptr, nullptr, nullptr, nullptr };
+                    for (int i = 0; i < 4; ++i)
+                    {
+                        // The second and third planes are the chroma planes.
+                        if (p.avFrameConvert->data[i])
+                        {
+                            const int y = (1 == i || 2 == i) ? (slice.y >> p.chromaShiftY) : slice.y;
+                            src[i] = p.avFrameConvert->data[i] + y * static_cast<ptrdiff_t>(p.avFrameConvert->linesize[i]);
+                        }
+                        if (p.avFrameOut->data[i])
+                        {
+                            const int y = (1 == i || 2 == i) ? (slice.y >> p.chromaShiftYOut) : slice.y;
+                            dst[i] = p.avFrameOut->data[i] + y * static_cast<ptrdiff_t>(p.avFrameOut->linesize[i]);
+                        }
+                    }
+                    sws_scale(
+                        slice.swsContext,
+                        src,
+                        p.avFrameConvert->linesize,
+                        0,
+                        slice.h,
+                        dst,
+                        p.avFrameOut->linesize);
+                }
+
+                void Read::_finishConvertVideo(bool add)
+                {
+                    DJV_PRIVATE_PTR();
+                    if (p.convertFutures.empty())
+                        return;
+                    for (auto& i : p.convertFutures)
+                    {
+                        i.get();
+                    }
+                    p.convertFutures.clear();
+                    av_frame_unref(p.avFrameConvert);
+                    if (add)
+                    {
+                        if (p.convertCacheEnabled)
+                        {
+                            _cache.add(p.convertFrame, p.convertImage);
+                        }
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        if (Frame::invalid == p.seek)
+                        {
+                            _videoQueue.addFrame(VideoFrame(p.convertFrame, p.convertImage));
+                        }
+                    }
+                    p.convertImage.reset();
+                }
+
+                void Read::_readReverse(Frame::Number seek)
+                {
+                    DJV_PRIVATE_PTR();
+                    if (seek != Frame::invalid)
+                    {
+                        p.reverseNext = seek;
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        _audioQueue.setFinished(true);
+                    }
+
+                    // Open the decoders the first time they are needed.
+                    if (!p.reverseDecoders[0])
+                    {
+                        try
+                        {
+                            for (auto& i : p.reverseDecoders)
+                            {
+                                i.reset(new ReverseDecoder);
+                                i->open(
+                                    _fileInfo.getFileName(),
+                                    p.avVideoStream,
+                                    p.options,
+                                    p.videoInfo.info,
+                                    p.avPixelFormatOut,
+                                    p.speed);
+                            }
+                        }
+                        catch (const std::exception& e)
+                        {
+                            for (auto& i : p.reverseDecoders)
+                            {
+                                i.reset();
+                            }
+                            p.reverseNext = Frame::invalid;
+                            _logSystem->log("djvAV::IO::FFmpeg::Read", e.what(), LogLevel::Error);
+                        }
+                    }
+
+                    // Start decoding the earlier groups of pictures while there
+                    // are free decoders. Without the keyframe index the start of
+                    // a group of pictures is not known until it has been decoded.
+                    const bool index = p.index && p.index->isValid();
+                    const Frame::Number start = index ? p.index->getKeyFrames().front().frame : 0;
+                    while (p.reverseDecoders[0] &&
+                        p.reverseReads.size() < reverseDecoderCount &&
+                        p.reverseNext != Frame::invalid &&
+                        p.reverseNext >= start)
+                    {
+                        const Frame::Number last = p.reverseNext;
+                        Frame::Number first = last - static_cast<Frame::Number>(p.reverseFramesMax) + 1;
+                        int64_t timestamp = 0;
+                        if (index)
+                        {
+                            const KeyFrame keyFrame = p.index->getKeyFrame(last);
+                            first = std::max(first, keyFrame.frame);
+                            timestamp = keyFrame.timestamp;
+                            p.reverseNext = first - 1;
+                        }
+                        else
+                        {
+                            AVRational r;
+                            r.num = p.speed.getDen();
+                            r.den = p.speed.getNum();
+                            timestamp = av_rescale_q(last, r, p.avFormatContext->streams[p.avVideoStream]->time_base);
+                            p.reverseNext = Frame::invalid;
+                        }
+                        Private::ReverseRead read;
+                        read.decoder = p.reverseReads.size() ? ((p.reverseReads.back().decoder + 1) % reverseDecoderCount) : 0;
+                        ReverseDecoder* decoder = p.reverseDecoders[read.decoder].get();
+                        const auto cancelToken = p.reverseCancelToken;
+                        const auto notify = _getNotifyCallback();
+                        read.future = _threadPool->addTaskFuture<ReverseChunk>(
+                            [decoder, first, last, timestamp, cancelToken, notify]
+                            {
+                                const ReverseChunk out = decoder->decode(first, last, timestamp, cancelToken);
+                                notify();
+                                return out;
+                            });
+                        p.reverseReads.push_back(std::move(read));
+                    }
+
+                    // Get the frames of the next group of pictures.
+                    if (p.reverseFrames.empty() &&
+                        p.reverseReads.size() &&
+                        p.reverseReads.front().future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    {
+                        ReverseChunk chunk = p.reverseReads.front().future.get();
+                        p.reverseReads.pop_front();
+                        if (Frame::invalid == p.reverseNext && chunk.frames.size())
+                        {
+                            p.reverseNext = chunk.first - 1;
+                        }
+                        p.reverseFrames = std::move(chunk.frames);
+                        return;
+                    }
+
+                    // Add the frames to the queue in reverse order.
+                    bool wait = false;
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        while (p.reverseFrames.size() && _videoQueue.getCount() < _videoQueue.getMax())
+                        {
+                            if (Frame::invalid == p.seek)
+                            {
+                                _videoQueue.addFrame(p.reverseFrames.back());
+                            }
+                            p.reverseFrames.pop_back();
+                        }
+                        if (p.reverseFrames.empty() && p.reverseReads.empty() &&
+                            (Frame::invalid == p.reverseNext || p.reverseNext < start))
+                        {
+                            _videoQueue.setFinished(true);
+                        }
+                        else
+                        {
+                            wait = p.reverseFrames.empty();
+                        }
+                    }
+                    if (wait)
+                    {
+                        // Sleep until a group of pictures has been decoded.
+                        _wait(Time::getTime(Time::TimerValue::Slow));
+                    }
+                }
+
+                void Read::_stopReverse()
+                {
+                    DJV_PRIVATE_PTR();
+                    if (p.reverseCancelToken)
+                    {
+                        p.reverseCancelToken->cancel();
+                    }
+                    for (auto& i : p.reverseReads)
+                    {
+                        i.future.wait();
+                    }
+                    p.reverseReads.clear();
+                    p.reverseFrames.clear();
+                    p.reverseNext = Frame::invalid;
+                    p.reverseCancelToken = CancelToken::create();
+                }
+
                 int Read::_decodeAudio(const DecodeAudio& da, Frame::Number& frame)
                 {
                     DJV_PRIVATE_PTR();
@@ -0,0 +1,565 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/FrameCache.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <set>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            namespace
+            {
+                //! The rank of frames outside of the cache sequence.
+                const uint64_t rankOutside = std::numeric_limits<uint64_t>::max();
+
+                struct FrameData
+                {
+                    size_t byteCount     = 0;
+                    size_t dataByteCount = 0;
+                };
+
+                struct TierData
+                {
+                    std::map<FrameCacheKey, FrameData> frames;
+                    size_t byteCount     = 0;
+                    size_t dataByteCount = 0;
+                    size_t maxByteCount  = 0;
+                    size_t evictCount    = 0;
+                };
+
+                struct Media
+                {
+                    ReadState state;
+                    Frame::Sequence sequence;
+                    size_t byteCount[2] = { 0, 0 };
+                    std::vector<FrameCacheKey> evicted[2];
+                    std::function<void(void)> callback;
+                };
+
+            } // namespace
+
+            FrameCacheKey::FrameCacheKey()
+            {}
+
+            FrameCacheKey::FrameCacheKey(UID media, size_t layer, Frame::Index frame) :
+                media(media),
+                layer(layer),
+                frame(frame)
+            {}
+
+            bool FrameCacheKey::operator == (const FrameCacheKey& other) const
+            {
+                return
+                    media == other.media &&
+                    layer == other.layer &&
+                    frame == other.frame;
+            }
+
+            bool FrameCacheKey::operator < (const FrameCacheKey& other) const
+            {
+                return
+                    media < other.media ||
+                    (media == other.media && layer < other.layer) ||
+                    (media == other.media && layer == other.layer && frame < other.frame);
+            }
+
+            float FrameCacheStats::getCompressionRatio() const
+            {
+                return compressedByteCount ?
+                    (compressedDataByteCount / static_cast<float>(compressedByteCount)) :
+                    0.F;
+            }
+
+            float FrameCacheStats::getDecompressThroughput() const
+            {
+                return decompressTime > 0.F ? (decompressByteCount / decompressTime) : 0.F;
+            }
+
+            bool FrameCacheStats::operator == (const FrameCacheStats& other) const
+            {
+                return
+                    count == other.count &&
+                    byteCount == other.byteCount &&
+                    maxByteCount == other.maxByteCount &&
+                    hitCount == other.hitCount &&
+                    missCount == other.missCount &&
+                    evictCount == other.evictCount &&
+                    compressedCount == other.compressedCount &&
+                    compressedByteCount == other.compressedByteCount &&
+                    compressedMaxByteCount == other.compressedMaxByteCount &&
+                    compressedDataByteCount == other.compressedDataByteCount &&
+                    compressedEvictCount == other.compressedEvictCount &&
+                    decompressCount == other.decompressCount &&
+                    decompressByteCount == other.decompressByteCount &&
+                    decompressTime == other.decompressTime;
+            }
+
+            struct FrameCache::Private
+            {
+                mutable std::mutex mutex;
+                std::map<UID, Media> media;
+                TierData tiers[2];
+                size_t hitCount = 0;
+                size_t missCount = 0;
+                size_t decompressCount = 0;
+                size_t decompressByteCount = 0;
+                float decompressTime = 0.F;
+            };
+
+            void FrameCache::_init(size_t maxByteCount)
+            {
+                DJV_PRIVATE_PTR();
+                p.tiers[static_cast<size_t>(Tier::Uncompressed)].maxByteCount = maxByteCount;
+            }
+
+            FrameCache::FrameCache() :
+                _p(new Private)
+            {}
+
+            FrameCache::~FrameCache()
+            {}
+
+            std::shared_ptr<FrameCache> FrameCache::create(size_t maxByteCount)
+            {
+                auto out = std::shared_ptr<FrameCache>(new FrameCache);
+                out->_init(maxByteCount);
+                return out;
+            }
+
+            size_t FrameCache::getMaxByteCount() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return p.tiers[static_cast<size_t>(Tier::Uncompressed)].maxByteCount;
+            }
+
+            void FrameCache::setMaxByteCount(size_t value)
+            {
+                DJV_PRIVATE_PTR();
+                std::vector<std::function<void(void)> > callbacks;
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    p.tiers[static_cast<size_t>(Tier::Uncompressed)].maxByteCount = value;
+                    _evict(Tier::Uncompressed, 0, callbacks);
+                }
+                for (const auto& i : callbacks)
+                {
+                    i();
+                }
+            }
+
+            UID FrameCache::addMedia(const std::function<void(void)>& callback)
+            {
+                DJV_PRIVATE_PTR();
+                const UID out = createUID();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.media[out].callback = callback;
+                return out;
+            }
+
+            void FrameCache::removeMedia(UID media)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                for (auto& tier : p.tiers)
+                {
+                    auto i = tier.frames.lower_bound(FrameCacheKey(media, 0, std::numeric_limits<Frame::Index>::min()));
+                    while (i != tier.frames.end() && i->first.media == media)
+                    {
+                        tier.byteCount -= i->second.byteCount;
+                        tier.dataByteCount -= i->second.dataByteCount;
+                        i = tier.frames.erase(i);
+                    }
+                }
+                p.media.erase(media);
+            }
+
+            void FrameCache::setMediaState(UID media, const ReadState& value)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.media.find(media);
+                if (i != p.media.end())
+                {
+                    i->second.state = value;
+                }
+            }
+
+            void FrameCache::setMediaSequence(UID media, const Frame::Sequence& value)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.media.find(media);
+                if (i != p.media.end())
+                {
+                    i->second.sequence = value;
+                }
+            }
+
+            size_t FrameCache::getByteCount(UID media) const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.media.find(media);
+                return i != p.media.end() ? i->second.byteCount[static_cast<size_t>(Tier::Uncompressed)] : 0;
+            }
+
+            std::vector<FrameCacheKey> FrameCache::getEvicted(UID media)
+            {
+                DJV_PRIVATE_PTR();
+                std::vector<FrameCacheKey> out;
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.media.find(media);
+                if (i != p.media.end())
+                {
+                    auto& evicted = i->second.evicted[static_cast<size_t>(Tier::Uncompressed)];
+                    out = std::move(evicted);
+                    evicted.clear();
+                }
+                return out;
+            }
+
+            bool FrameCache::canAdd(const FrameCacheKey& key, size_t byteCount) const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return _canAdd(Tier::Uncompressed, key, byteCount);
+            }
+
+            bool FrameCache::add(const FrameCacheKey& key, size_t byteCount)
+            {
+                DJV_PRIVATE_PTR();
+                bool out = false;
+                std::vector<std::function<void(void)> > callbacks;
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    out = _add(Tier::Uncompressed, key, byteCount, byteCount, callbacks);
+                }
+                for (const auto& i : callbacks)
+                {
+                    i();
+                }
+                return out;
+            }
+
+            void FrameCache::remove(const FrameCacheKey& key)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                _remove(Tier::Uncompressed, key);
+            }
+
+            void FrameCache::addLookup(bool hit)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                if (hit)
+                {
+                    ++p.hitCount;
+                }
+                else
+                {
+                    ++p.missCount;
+                }
+            }
+
+            size_t FrameCache::getCompressedMaxByteCount() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return p.tiers[static_cast<size_t>(Tier::Compressed)].maxByteCount;
+            }
+
+            void FrameCache::setCompressedMaxByteCount(size_t value)
+            {
+                DJV_PRIVATE_PTR();
+                std::vector<std::function<void(void)> > callbacks;
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    p.tiers[static_cast<size_t>(Tier::Compressed)].maxByteCount = value;
+                    _evict(Tier::Compressed, 0, callbacks);
+                }
+                for (const auto& i : callbacks)
+                {
+                    i();
+                }
+            }
+
+            bool FrameCache::canAddCompressed(const FrameCacheKey& key, size_t byteCount) const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return _canAdd(Tier::Compressed, key, byteCount);
+            }
+
+            bool FrameCache::addCompressed(const FrameCacheKey& key, size_t byteCount, size_t dataByteCount)
+            {
+                DJV_PRIVATE_PTR();
+                bool out = false;
+                std::vector<std::function<void(void)> > callbacks;
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    out = _add(Tier::Compressed, key, byteCount, dataByteCount, callbacks);
+                }
+                for (const auto& i : callbacks)
+                {
+                    i();
+                }
+                return out;
+            }
+
+            void FrameCache::removeCompressed(const FrameCacheKey& key)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                _remove(Tier::Compressed, key);
+            }
+
+            std::vector<FrameCacheKey> FrameCache::getEvictedCompressed(UID media)
+            {
+                DJV_PRIVATE_PTR();
+                std::vector<FrameCacheKey> out;
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.media.find(media);
+                if (i != p.media.end())
+                {
+                    auto& evicted = i->second.evicted[static_cast<size_t>(Tier::Compressed)];
+                    out = std::move(evicted);
+                    evicted.clear();
+                }
+                return out;
+            }
+
+            void FrameCache::addDecompress(size_t byteCount, float seconds)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                ++p.decompressCount;
+                p.decompressByteCount += byteCount;
+                p.decompressTime += seconds;
+            }
+
+            FrameCacheStats FrameCache::getStats() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                FrameCacheStats out;
+                const auto& uncompressed = p.tiers[static_cast<size_t>(Tier::Uncompressed)];
+                out.count = uncompressed.frames.size();
+                out.byteCount = uncompressed.byteCount;
+                out.maxByteCount = uncompressed.maxByteCount;
+                out.hitCount = p.hitCount;
+                out.missCount = p.missCount;
+                out.evictCount = uncompressed.evictCount;
+                const auto& compressed = p.tiers[static_cast<size_t>(Tier::Compressed)];
+                out.compressedCount = compressed.frames.size();
+                out.compressedByteCount = compressed.byteCount;
+                out.compressedMaxByteCount = compressed.maxByteCount;
+                out.compressedDataByteCount = compressed.dataByteCount;
+                out.compressedEvictCount = compressed.evictCount;
+                out.decompressCount = p.decompressCount;
+                out.decompressByteCount = p.decompressByteCount;
+                out.decompressTime = p.decompressTime;
+                return out;
+            }
+
+            bool FrameCache::_canAdd(Tier tier, const FrameCacheKey& key, size_t byteCount) const
+            {
+                DJV_PRIVATE_PTR();
+                const auto& data = p.tiers[static_cast<size_t>(tier)];
+                if (Tier::Compressed == tier && !data.maxByteCount)
+                {
+                    return false;
+                }
+                if (!data.maxByteCount || data.frames.find(key) != data.frames.end())
+                {
+                    return true;
+                }
+                if (byteCount > data.maxByteCount)
+                {
+                    return false;
+                }
+                size_t available = data.maxByteCount - std::min(data.byteCount, data.maxByteCount);
+                if (byteCount <= available)
+                {
+                    return true;
+                }
+                const uint64_t rank = _getRank(key);
+                if (rank != rankOutside)
+                {
+                    available += _getByteCount(tier, rank + 1);
+                }
+                return byteCount <= available;
+            }
+
+            bool FrameCache::_add(
+                Tier tier,
+                const FrameCacheKey& key,
+                size_t byteCount,
+                size_t dataByteCount,
+                std::vector<std::function<void(void)> >& callbacks)
+            {
+                DJV_PRIVATE_PTR();
+                if (!_canAdd(tier, key, byteCount))
+                {
+                    return false;
+                }
+                const auto i = p.media.find(key.media);
+                if (i == p.media.end())
+                {
+                    return false;
+                }
+                auto& data = p.tiers[static_cast<size_t>(tier)];
+                auto& mediaByteCount = i->second.byteCount[static_cast<size_t>(tier)];
+                auto& frame = data.frames[key];
+                data.byteCount -= frame.byteCount;
+                data.dataByteCount -= frame.dataByteCount;
+                mediaByteCount -= frame.byteCount;
+                frame.byteCount = byteCount;
+                frame.dataByteCount = dataByteCount;
+                data.byteCount += byteCount;
+                data.dataByteCount += dataByteCount;
+                mediaByteCount += byteCount;
+                const uint64_t rank = _getRank(key);
+                if (rank != rankOutside)
+                {
+                    _evict(tier, rank + 1, callbacks);
+                }
+                return true;
+            }
+
+            void FrameCache::_remove(Tier tier, const FrameCacheKey& key)
+            {
+                DJV_PRIVATE_PTR();
+                auto& data = p.tiers[static_cast<size_t>(tier)];
+                const auto i = data.frames.find(key);
+                if (i != data.frames.end())
+                {
+                    const auto j = p.media.find(key.media);
+                    if (j != p.media.end())
+                    {
+                        j->second.byteCount[static_cast<size_t>(tier)] -= i->second.byteCount;
+                    }
+                    data.byteCount -= i->second.byteCount;
+                    data.dataByteCount -= i->second.dataByteCount;
+                    data.frames.erase(i);
+                }
+            }
+
+            uint64_t FrameCache::_getRank(const FrameCacheKey& key) const
+            {
+                DJV_PRIVATE_PTR();
+                uint64_t out = rankOutside;
+                const auto i = p.media.find(key.media);
+                if (i != p.media.end() && i->second.sequence.contains(key.frame))
+                {
+                    out = std::min(getReadRank(i->second.state, key.frame, ReadType::Cache), rankOutside - 1);
+                }
+                return out;
+            }
+
+            size_t FrameCache::_getByteCount(Tier tier, uint64_t minRank) const
+            {
+                DJV_PRIVATE_PTR();
+                size_t out = 0;
+                for (const auto& i : p.tiers[static_cast<size_t>(tier)].frames)
+                {
+                    if (_getRank(i.first) >= minRank)
+                    {
+                        out += i.second.byteCount;
+                    }
+                }
+                return out;
+            }
+
+            void FrameCache::_evict(Tier tier, uint64_t minRank, std::vector<std::function<void(void)> >& callbacks)
+            {
+                DJV_PRIVATE_PTR();
+                auto& data = p.tiers[static_cast<size_t>(tier)];
+                if ((Tier::Uncompressed == tier && !data.maxByteCount) || data.byteCount <= data.maxByteCount)
+                {
+                    return;
+                }
+
+                // Evict the frames with the worst rank first.
+                std::vector<std::pair<uint64_t, FrameCacheKey> > ranks;
+                for (const auto& i : data.frames)
+                {
+                    const uint64_t rank = _getRank(i.first);
+                    if (rank >= minRank)
+                    {
+                        ranks.push_back(std::make_pair(rank, i.first));
+                    }
+                }
+                std::sort(
+                    ranks.begin(),
+                    ranks.end(),
+                    [](const std::pair<uint64_t, FrameCacheKey>& a, const std::pair<uint64_t, FrameCacheKey>& b)
+                    {
+                        return a.first > b.first;
+                    });
+                std::set<UID> evicted;
+                for (auto i = ranks.begin(); i != ranks.end() && data.byteCount > data.maxByteCount; ++i)
+                {
+                    const auto j = data.frames.find(i->second);
+                    const auto k = p.media.find(i->second.media);
+                    if (k != p.media.end())
+                    {
+                        k->second.byteCount[static_cast<size_t>(tier)] -= j->second.byteCount;
+                        k->second.evicted[static_cast<size_t>(tier)].push_back(i->second);
+                        evicted.insert(i->second.media);
+                    }
+                    data.byteCount -= j->second.byteCount;
+                    data.dataByteCount -= j->second.dataByteCount;
+                    ++data.evictCount;
+                    data.frames.erase(j);
+                }
+                for (const auto& i : evicted)
+                {
+                    const auto j = p.media.find(i);
+                    if (j->second.callback)
+                    {
+                        callbacks.push_back(j->second.callback);
+                    }
+                }
+            }
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,224 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvAV/ReadScheduler.h>
+
+#include <djvCore/Frame.h>
+#include <djvCore/UID.h>
+
+#include <functional>
+#include <vector>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            //! This class provides a frame cache key.
+            class FrameCacheKey
+            {
+            public:
+                FrameCacheKey();
+                FrameCacheKey(Core::UID media, size_t layer, Core::Frame::Index frame);
+
+                Core::UID          media = 0;
+                size_t             layer = 0;
+                Core::Frame::Index frame = 0;
+
+                bool operator == (const FrameCacheKey&) const;
+                bool operator < (const FrameCacheKey&) const;
+            };
+
+            //! This struct provides frame cache statistics.
+            struct FrameCacheStats
+            {
+                size_t count        = 0;
+                size_t byteCount    = 0;
+                size_t maxByteCount = 0;
+                size_t hitCount     = 0;
+                size_t missCount    = 0;
+                size_t evictCount   = 0;
+
+                //! \name Compressed Tier
+                ///@{
+
+                size_t compressedCount         = 0;
+                size_t compressedByteCount     = 0;
+                size_t compressedMaxByteCount  = 0;
+                size_t compressedDataByteCount = 0;
+                size_t compressedEvictCount    = 0;
+                size_t decompressCount         = 0;
+                size_t decompressByteCount     = 0;
+                float  decompressTime          = 0.F;
+
+                //! Get the ratio of the uncompressed to compressed size.
+                float getCompressionRatio() const;
+
+                //! Get the decompression throughput in bytes per second.
+                float getDecompressThroughput() const;
+
+                ///@}
+
+                bool operator == (const FrameCacheStats&) const;
+            };
+
+            //! This class provides the process-wide accounting for the frame
+            //! caches of all of the readers.
+            //!
+            //! The frames themselves are stored by each reader's Cache, which
+            //! reports the frames it adds and removes. When the cache is over
+            //! budget the frames with the worst rank are evicted, regardless of
+            //! which media they belong to. Frames outside of a media's cache
+            //! sequence are evicted first, followed by frames of inactive and
+            //! hidden media and frames furthest from the playhead. Evicted frames
+            //! are queued for their reader to remove.
+            //!
+            //! An optional compressed tier with a separate budget holds frames
+            //! that were evicted and then compressed by their reader. The
+            //! compressed frames are ranked and evicted the same way.
+            class FrameCache
+            {
+                DJV_NON_COPYABLE(FrameCache);
+                void _init(size_t maxByteCount);
+                FrameCache();
+
+            public:
+                ~FrameCache();
+
+                //! Create a new frame cache. A maximum byte count of zero means
+                //! there is no limit.
+                static std::shared_ptr<FrameCache> create(size_t maxByteCount = 0);
+
+                //! \name Size
+                ///@{
+
+                size_t getMaxByteCount() const;
+                void setMaxByteCount(size_t);
+
+                ///@}
+
+                //! \name Media
+                ///@{
+
+                //! Add a media. The callback is called when frames are evicted
+                //! from the media.
+                Core::UID addMedia(const std::function<void(void)>& callback = nullptr);
+
+                void removeMedia(Core::UID);
+
+                //! Set the scheduling state of a media.
+                void setMediaState(Core::UID, const ReadState&);
+
+                //! Set the cache sequence of a media.
+                void setMediaSequence(Core::UID, const Core::Frame::Sequence&);
+
+                size_t getByteCount(Core::UID) const;
+
+                //! Get the frames that have been evicted from a media since the
+                //! last call.
+                std::vector<FrameCacheKey> getEvicted(Core::UID);
+
+                ///@}
+
+                //! \name Frames
+                ///@{
+
+                //! Get whether a frame would be added to the cache.
+                bool canAdd(const FrameCacheKey&, size_t byteCount) const;
+
+                //! Add a frame, evicting other frames if necessary. Returns false
+                //! if the frame does not fit in the cache.
+                bool add(const FrameCacheKey&, size_t byteCount);
+
+                void remove(const FrameCacheKey&);
+
+                //! Count a cache lookup.
+                void addLookup(bool hit);
+
+                ///@}
+
+                //! \name Compressed Tier
+                ///@{
+
+                //! Get the maximum size of the compressed tier. A maximum byte
+                //! count of zero disables the compressed tier.
+                size_t getCompressedMaxByteCount() const;
+                void setCompressedMaxByteCount(size_t);
+
+                //! Get whether a compressed frame would be added to the
+                //! compressed tier.
+                bool canAddCompressed(const FrameCacheKey&, size_t byteCount) const;
+
+                //! Add a compressed frame, evicting other compressed frames if
+                //! necessary. The data byte count is the uncompressed size of the
+                //! frame. Returns false if the frame does not fit.
+                bool addCompressed(const FrameCacheKey&, size_t byteCount, size_t dataByteCount);
+
+                void removeCompressed(const FrameCacheKey&);
+
+                //! Get the compressed frames that have been evicted from a media
+                //! since the last call.
+                std::vector<FrameCacheKey> getEvictedCompressed(Core::UID);
+
+                //! Count a frame decompression.
+                void addDecompress(size_t byteCount, float seconds);
+
+                ///@}
+
+                //! Get the cache statistics.
+                FrameCacheStats getStats() const;
+
+            private:
+                enum class Tier
+                {
+                    Uncompressed,
+                    Compressed
+                };
+
+                bool _canAdd(Tier, const FrameCacheKey&, size_t byteCount) const;
+                bool _add(
+                    Tier,
+                    const FrameCacheKey&,
+                    size_t byteCount,
+                    size_t dataByteCount,
+                    std::vector<std::function<void(void)> >& callbacks);
+                void _remove(Tier, const FrameCacheKey&);
+                uint64_t _getRank(const FrameCacheKey&) const;
+                size_t _getByteCount(Tier, uint64_t minRank) const;
+                void _evict(Tier, uint64_t minRank, std::vector<std::function<void(void)> >& callbacks);
+
+                DJV_PRIVATE();
+            };
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
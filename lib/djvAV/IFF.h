@@ -73,12 +73,11 @@ namespace djv
                 protected:
                     Info _readInfo(const std::string & fileName) override;
                     std::shared_ptr<Image::Image> _readImage(const std::string & fileName) override;
+                    std::shared_ptr<IDecoderSession> _createSession() override;
 
                 private:
-                    Info _open(const std::string &, const std::shared_ptr<Core::FileSystem::FileIO>&);
-                    
-                    int  _tiles       = 0;
-                    bool _compression = false;
+                    struct Session;
+                    Info _open(const std::string &, const std::shared_ptr<Core::FileSystem::FileIO>&, Session&);
                 };
 
                 //! This class provides the IFF file I/O plugin.
@@ -92,6 +92,15 @@ namespace djv
 
                 } // namespace
 
+                struct Read::Session : public IDecoderSession
+                {
+                    int tiles = 0;
+                    bool compression = false;
+                    std::vector<uint8_t> tile;
+                    std::vector<uint8_t> scanline;
+                    std::vector<uint16_t> scanline16;
+                };
+
                 Read::Read()
                 {}
 
@@ -115,14 +124,17 @@ namespace djv
                 Info Read::_readInfo(const std::string & fileName)
                 {
                     auto io = FileSystem::FileIO::create();
-                    return _open(fileName, io);
+                    Session session;
+                    return _open(fileName, io, session);
                 }
 
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
                 {
+                    Session localSession;
+                    Session& session = _getSession() ? static_cast<Session&>(*_getSession()) : localSession;
                     std::shared_ptr<Image::Image> out;
                     auto io = FileSystem::FileIO::create();
-                    const auto info = _open(fileName, io);
+                    const auto info = _open(fileName, io, session);
                     out = Image::Image::create(info.video[0].info);
                     out->setPluginName(pluginName);
 
@@ -130,7 +142,7 @@ namespace djv
                     uint8_t pixels[32];
                     uint32_t size;
                     uint32_t chunkSize;
-                    uint32_t tilesRgba = _tiles;
+                    uint32_t tilesRgba = session.tiles;
 
                     const size_t channelByteCount = Image::getByteCount(Image::getDataType(info.video[0].info.type));
                     const size_t byteCount = Image::getByteCount(info.video[0].info.type);
@@ -264,11 +276,11 @@ namespace djv
                                                     c >= 0;
                                                     --c)
                                                 {
-                                                    std::vector<uint8_t> in(static_cast<size_t>(tw) * static_cast<size_t>(th));
-                                                    uint8_t* inP = in.data();
+                                                    session.tile.resize(static_cast<size_t>(tw) * static_cast<size_t>(th));
+                                                    uint8_t* inP = session.tile.data();
 
                                                     // Uncompress.
-                                                    p += readRle(io, in.data(), static_cast<size_t>(tw) * static_cast<size_t>(th));
+                                                    p += readRle(io, session.tile.data(), static_cast<size_t>(tw) * static_cast<size_t>(th));
 
                                                     for (uint16_t py = ymin; py <= ymax; py++)
                                                     {
@@ -295,8 +307,8 @@ namespace djv
                                                     uint8_t* out_dy = out->getData(xmin, py);
 
                                                     // Tile scanline.
-                                                    std::vector<uint8_t> scanline(tw * byteCount);
-                                                    uint8_t* outP = scanline.data();
+                                                    session.scanline.resize(tw * byteCount);
+                                                    uint8_t* outP = session.scanline.data();
 
                                                     // Set bytes.
                                                     for (uint16_t px = xmin; px <= xmax; px++)
@@ -322,7 +334,7 @@ namespace djv
                                                     }
 
                                                     // Copy data.
-                                                    memcpy(out_dy, scanline.data(), tw * byteCount);
+                                                    memcpy(out_dy, session.scanline.data(), tw * byteCount);
                                                 }
                                             }
                                         }
@@ -373,11 +385,11 @@ namespace djv
                                                 {
                                                     int mc = map[c];
 
-                                                    std::vector<uint8_t> in(static_cast<size_t>(tw) * static_cast<size_t>(th));
-                                                    uint8_t* inP = in.data();
+                                                    session.tile.resize(static_cast<size_t>(tw) * static_cast<size_t>(th));
+                                                    uint8_t* inP = session.tile.data();
 
                                                     // Uncompress.
-                                                    p += readRle(io, in.data(), static_cast<size_t>(tw) * static_cast<size_t>(th));
+                                                    p += readRle(io, session.tile.data(), static_cast<size_t>(tw) * static_cast<size_t>(th));
 
                                                     for (uint16_t py = ymin; py <= ymax; py++)
                                                     {
@@ -404,8 +416,8 @@ namespace djv
                                                     uint8_t* out_dy = out->getData(xmin, py);
 
                                                     // Tile scanline.
-                                                    std::vector<uint16_t> scanline(tw * byteCount);
-                                                    uint16_t* outP = scanline.data();
+                                                    session.scanline16.resize(tw * byteCount);
+                                                    uint16_t* outP = session.scanline16.data();
 
                                                     // Set bytes.
                                                     for (uint16_t px = xmin; px <= xmax; px++)
@@ -441,7 +453,7 @@ namespace djv
                                                     }
 
                                                     // Copy data.
-                                                    memcpy(out_dy, scanline.data(), tw * byteCount);
+                                                    memcpy(out_dy, session.scanline16.data(), tw * byteCount);
                                                 }
                                             }
                                         }
@@ -491,6 +503,11 @@ namespace djv
                     return out;
                 }
 
+                std::shared_ptr<IDecoderSession> Read::_createSession()
+                {
+                    return std::shared_ptr<IDecoderSession>(new Session);
+                }
+
                 namespace
                 {
                     class Header
@@ -745,12 +762,14 @@ namespace djv
 
                 } // namespace
 
-                Info Read::_open(const std::string & fileName, const std::shared_ptr<FileSystem::FileIO>& io)
+                Info Read::_open(const std::string & fileName, const std::shared_ptr<FileSystem::FileIO>& io, Session& session)
                 {
                     io->setEndianConversion(Memory::getEndian() != Memory::Endian::MSB);
                     io->open(fileName, FileSystem::FileIO::Mode::Read);
                     Image::Info imageInfo;
-                    Header().read(io, imageInfo, _tiles, _compression, _textSystem);
+                    session.tiles = 0;
+                    session.compression = false;
+                    Header().read(io, imageInfo, session.tiles, session.compression, _textSystem);
                     auto info = Info(fileName, VideoInfo(imageInfo, _speed, _sequence));
                     return info;
                 }
@@ -30,11 +30,16 @@
 #include <djvAV/IO.h>
 
 #include <djvAV/Cineon.h>
+#include <djvAV/CompressedImage.h>
 #include <djvAV/DPX.h>
+#include <djvAV/DiskCache.h>
+#include <djvAV/FrameCache.h>
 #include <djvAV/GLFWSystem.h>
 #include <djvAV/IFF.h>
+#include <djvAV/ImageDataPool.h>
 #include <djvAV/PPM.h>
 #include <djvAV/RLA.h>
+#include <djvAV/ReadScheduler.h>
 #include <djvAV/SGI.h>
 #include <djvAV/Targa.h>
 
@@ -55,13 +60,19 @@
 #endif // TIFF_FOUND
 
 #include <djvCore/Context.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/FilePrefetch.h>
 #include <djvCore/FileSystem.h>
 #include <djvCore/LogSystem.h>
+#include <djvCore/Math.h>
 #include <djvCore/Path.h>
 #include <djvCore/ResourceSystem.h>
 #include <djvCore/String.h>
 #include <djvCore/StringFormat.h>
 #include <djvCore/TextSystem.h>
+#include <djvCore/ThreadPool.h>
+
+#include <condition_variable>
 
 using namespace djv::Core;
 
@@ -74,71 +85,129 @@ namespace djv
             void VideoQueue::setMax(size_t value)
             {
                 _max = value;
+                _queue.setCapacity(value);
             }
 
             void VideoQueue::addFrame(const VideoFrame& value)
             {
                 _queue.push(value);
+                _changed();
             }
 
             VideoFrame VideoQueue::popFrame()
             {
                 VideoFrame out;
-                if (_queue.size())
+                if (_queue.pop(out))
                 {
-                    out = _queue.front();
-                    _queue.pop();
+                    _changed();
                 }
                 return out;
             }
 
             void VideoQueue::clearFrames()
             {
-                while (_queue.size())
-                {
-                    _queue.pop();
-                }
+                _queue.clear();
+                _changed();
             }
 
             void VideoQueue::setFinished(bool value)
             {
-                _finished = value;
+                _queue.setFinished(value);
+                _changed();
+            }
+
+            void VideoQueue::setCallback(const std::function<void(void)>& value)
+            {
+                _callback = value;
+            }
+
+            void VideoQueue::setObserver(const std::function<void(void)>& value)
+            {
+                std::lock_guard<std::mutex> lock(_observerMutex);
+                _observer = value;
+            }
+
+            void VideoQueue::_changed()
+            {
+                if (_callback)
+                {
+                    _callback();
+                }
+                std::function<void(void)> observer;
+                {
+                    std::lock_guard<std::mutex> lock(_observerMutex);
+                    observer = _observer;
+                }
+                if (observer)
+                {
+                    observer();
+                }
             }
 
             void AudioQueue::setMax(size_t value)
             {
                 _max = value;
+                _queue.setCapacity(value);
             }
 
             void AudioQueue::addFrame(const AudioFrame& value)
             {
                 _queue.push(value);
+                if (_callback)
+                {
+                    _callback();
+                }
             }
 
             AudioFrame AudioQueue::popFrame()
             {
                 AudioFrame out;
-                if (_queue.size())
+                if (_queue.pop(out) && _callback)
                 {
-                    out = _queue.front();
-                    _queue.pop();
+                    _callback();
                 }
                 return out;
             }
 
             void AudioQueue::clearFrames()
             {
-                while (_queue.size())
+                _queue.clear();
+                if (_callback)
                 {
-                    _queue.pop();
+                    _callback();
                 }
             }
 
             void AudioQueue::setFinished(bool value)
             {
-                _finished = value;
+                _queue.setFinished(value);
+                if (_callback)
+                {
+                    _callback();
+                }
             }
 
+            void AudioQueue::setCallback(const std::function<void(void)>& value)
+            {
+                _callback = value;
+            }
+
+            struct IIO::Notify
+            {
+                std::mutex mutex;
+                std::condition_variable cv;
+                bool notified = false;
+
+                void notify()
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        notified = true;
+                    }
+                    cv.notify_one();
+                }
+            };
+
             void IIO::_init(
                 const FileSystem::FileInfo& fileInfo,
                 const IOOptions& options,
@@ -149,9 +218,24 @@ namespace djv
                 _logSystem      = logSystem;
                 _textSystem     = textSystem;
                 _resourceSystem = resourceSystem;
+                _threadPool     = options.threadPool ? options.threadPool : ThreadPool::create();
                 _fileInfo       = fileInfo;
+                _notifyData     = std::make_shared<Notify>();
                 _videoQueue.setMax(options.videoQueueSize);
                 _audioQueue.setMax(options.audioQueueSize);
+
+                // Wake up the I/O thread when frames are added to or removed
+                // from the queues.
+                _videoQueue.setCallback(
+                    [this]
+                    {
+                        _notify();
+                    });
+                _audioQueue.setCallback(
+                    [this]
+                    {
+                        _notify();
+                    });
             }
 
             IIO::~IIO()
@@ -159,41 +243,97 @@ namespace djv
 
             void IIO::setThreadCount(size_t value)
             {
-                std::unique_lock<std::mutex> lock(_mutex);
-                _threadCount = value;
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _threadCount = value;
+                }
+                _notify();
+            }
+
+            void IIO::_notify()
+            {
+                _notifyData->notify();
             }
 
-            Frame::Sequence Cache::getFrames() const
+            void IIO::_wait(const Time::Unit& timeout)
             {
-                Frame::Sequence out;
-                std::vector<Frame::Index> frames;
-                for (const auto& i : _cache)
+                Notify& notify = *_notifyData;
+                std::unique_lock<std::mutex> lock(notify.mutex);
+                notify.cv.wait_for(
+                    lock,
+                    timeout,
+                    [&notify]
+                    {
+                        return notify.notified;
+                    });
+                notify.notified = false;
+            }
+
+            std::function<void(void)> IIO::_getNotifyCallback() const
+            {
+                auto notify = _notifyData;
+                return [notify]
+                {
+                    notify->notify();
+                };
+            }
+
+            Cache::~Cache()
+            {
+                if (_frameCache)
+                {
+                    _frameCache->removeMedia(_frameCacheUID);
+                }
+            }
+
+            void Cache::setFrameCache(
+                const std::shared_ptr<FrameCache>& value,
+                size_t layer,
+                const std::function<void(void)>& callback)
+            {
+                if (_frameCache)
                 {
-                    frames.push_back(i.first);
+                    _frameCache->removeMedia(_frameCacheUID);
+                    _frameCacheUID = 0;
                 }
-                const size_t size = frames.size();
-                if (size)
+                _frameCache = value;
+                _layer = layer;
+                if (_frameCache)
                 {
-                    std::sort(frames.begin(), frames.end());
-                    Frame::Number rangeStart = frames[0];
-                    Frame::Number prevFrame = frames[0];
-                    size_t i = 1;
-                    for (; i < size; prevFrame = frames[i], ++i)
+                    _frameCacheUID = _frameCache->addMedia(callback);
+                    _frameCache->setMediaSequence(_frameCacheUID, _sequence);
+                    for (const auto& i : _ranges)
                     {
-                        if (frames[i] != prevFrame + 1)
+                        for (Frame::Index j = i.first; j <= i.second; ++j)
                         {
-                            out.ranges.push_back(Frame::Range(rangeStart, prevFrame));
-                            rangeStart = frames[i];
+                            const FrameCacheKey key(_frameCacheUID, _layer, j);
+                            if (_frames[j])
+                            {
+                                _frameCache->add(key, _frames[j]->getDataByteCount());
+                            }
+                            else
+                            {
+                                _frameCache->addCompressed(key, _compressed[j]->getByteCount(), _compressed[j]->getDataByteCount());
+                            }
                         }
                     }
-                    if (size > 1)
-                    {
-                        out.ranges.push_back(Frame::Range(rangeStart, prevFrame));
-                    }
-                    else
-                    {
-                        out.ranges.push_back(Frame::Range(rangeStart));
-                    }
+                }
+            }
+
+            void Cache::setReadState(const ReadState& value)
+            {
+                if (_frameCache)
+                {
+                    _frameCache->setMediaState(_frameCacheUID, value);
+                }
+            }
+
+            Frame::Sequence Cache::getFrames() const
+            {
+                Frame::Sequence out;
+                for (const auto& i : _ranges)
+                {
+                    out.ranges.push_back(Frame::Range(i.first, i.second));
                 }
                 return out;
             }
@@ -203,7 +343,7 @@ namespace djv
                 if (value == _max)
                     return;
                 _max = value;
-                _cacheUpdate();
+                _windowUpdate();
             }
 
             void Cache::setSequenceSize(size_t value)
@@ -211,7 +351,7 @@ namespace djv
                 if (value == _sequenceSize)
                     return;
                 _sequenceSize = value;
-                _cacheUpdate();
+                _windowUpdate();
             }
 
             void Cache::setInOutPoints(const InOutPoints& value)
@@ -219,7 +359,7 @@ namespace djv
                 if (value == _inOutPoints)
                     return;
                 _inOutPoints = value;
-                _cacheUpdate();
+                _windowUpdate();
             }
 
             void Cache::setDirection(Direction value)
@@ -227,7 +367,7 @@ namespace djv
                 if (value == _direction)
                     return;
                 _direction = value;
-                _cacheUpdate();
+                _windowUpdate();
             }
 
             void Cache::setCurrentFrame(Frame::Index value)
@@ -235,102 +375,457 @@ namespace djv
                 if (value == _currentFrame)
                     return;
                 _currentFrame = value;
-                _cacheUpdate();
+                _windowUpdate();
+            }
+
+            bool Cache::get(Frame::Index index, std::shared_ptr<AV::Image::Image>& out) const
+            {
+                // Frames in the compressed tier count as hits.
+                const bool found = contains(index);
+                const bool uncompressed = found && _frames[index];
+                if (uncompressed)
+                {
+                    out = _frames[index];
+                }
+                if (_frameCache)
+                {
+                    _frameCache->addLookup(found);
+                }
+                return uncompressed;
+            }
+
+            bool Cache::getCompressed(Frame::Index index, std::shared_ptr<CompressedImage>& out) const
+            {
+                const bool found = contains(index) && _compressed[index];
+                if (found)
+                {
+                    out = _compressed[index];
+                }
+                return found;
+            }
+
+            bool Cache::canAdd(Frame::Index index, size_t byteCount) const
+            {
+                return _frameCache ?
+                    _frameCache->canAdd(FrameCacheKey(_frameCacheUID, _layer, index), byteCount) :
+                    true;
             }
 
             void Cache::add(Frame::Index index, const std::shared_ptr<AV::Image::Image>& image)
             {
-                _cache[index] = image;
-                _cacheUpdate();
+                if (!_isInWindow(index) ||
+                    (_frameCache &&
+                    !_frameCache->add(FrameCacheKey(_frameCacheUID, _layer, index), image->getDataByteCount())))
+                {
+                    return;
+                }
+                auto& frame = _frames[index];
+                if (frame)
+                {
+                    _byteCount -= frame->getDataByteCount();
+                }
+                else
+                {
+                    ++_count;
+                    if (!_compressed[index])
+                    {
+                        _addToRanges(index);
+                    }
+                }
+                frame = image;
+                _byteCount += image->getDataByteCount();
+                _removeCompressed(index);
+                removeEvicted();
             }
 
-            void Cache::_cacheUpdate()
+            void Cache::addCompressed(Frame::Index index, const std::shared_ptr<CompressedImage>& compressed)
             {
-                const auto range = _inOutPoints.getRange(_sequenceSize);
-                Frame::Index frame = _currentFrame;
-                _sequence = Frame::Sequence();
-                switch (_direction)
+                if (!_isInWindow(index) ||
+                    _frames[index] ||
+                    !_frameCache ||
+                    !_frameCache->addCompressed(
+                        FrameCacheKey(_frameCacheUID, _layer, index),
+                        compressed->getByteCount(),
+                        compressed->getDataByteCount()))
                 {
-                case Direction::Forward:
+                    return;
+                }
+                auto& frame = _compressed[index];
+                if (frame)
                 {
-                    for (size_t i = 0; i < _readBehind; ++i)
+                    _compressedByteCount -= frame->getByteCount();
+                }
+                else
+                {
+                    ++_compressedCount;
+                    _addToRanges(index);
+                }
+                frame = compressed;
+                _compressedByteCount += compressed->getByteCount();
+                removeEvicted();
+            }
+
+            void Cache::setCompressEnabled(bool value)
+            {
+                _compressEnabled = value;
+                if (!_compressEnabled)
+                {
+                    _compressible.clear();
+                }
+            }
+
+            std::vector<std::pair<Frame::Index, std::shared_ptr<AV::Image::Image> > > Cache::getCompressible()
+            {
+                auto out = std::move(_compressible);
+                _compressible.clear();
+                return out;
+            }
+
+            void Cache::removeEvicted()
+            {
+                if (_frameCache)
+                {
+                    const bool compress = _compressEnabled && _frameCache->getCompressedMaxByteCount() > 0;
+                    for (const auto& i : _frameCache->getEvicted(_frameCacheUID))
                     {
-                        --frame;
-                        if (frame < range.min)
+                        if (compress && _isInWindow(i.frame) && _frames[i.frame])
                         {
-                            frame = range.max;
+                            _compressible.push_back(std::make_pair(i.frame, _frames[i.frame]));
                         }
+                        _removeImage(i.frame);
                     }
-                    _sequence.ranges.push_back(Frame::Range(frame));
-                    const Frame::Index first = frame;
-                    for (size_t i = 0; i < _max; ++i)
+                    for (const auto& i : _frameCache->getEvictedCompressed(_frameCacheUID))
                     {
-                        ++frame;
-                        if (first == frame)
-                        {
-                            break;
-                        }
-                        if (frame > range.max)
-                        {
-                            frame = range.min;
-                            if (frame != _sequence.ranges.back().max)
-                            {
-                                _sequence.ranges.push_back(Frame::Range(frame));
-                            }
-                        }
-                        else
-                        {
-                            _sequence.ranges.back().max = frame;
-                        }
+                        _removeCompressed(i.frame);
                     }
-                    break;
                 }
-                case Direction::Reverse:
+            }
+
+            void Cache::clear()
+            {
+                while (_ranges.size())
                 {
-                    for (size_t i = 0; i < _readBehind; ++i)
+                    const auto i = _ranges.begin();
+                    const Frame::Index first = i->first;
+                    const Frame::Index last = i->second;
+                    for (Frame::Index j = first; j <= last; ++j)
                     {
-                        ++frame;
-                        if (frame > range.max)
-                        {
-                            frame = range.min;
-                        }
+                        _remove(j);
                     }
-                    _sequence.ranges.push_back(Frame::Range(frame));
-                    const Frame::Index first = frame;
-                    for (size_t i = 0; i < _max; ++i)
+                }
+                _compressible.clear();
+            }
+
+            bool Cache::_isInWindow(Frame::Index value) const
+            {
+                bool out = false;
+                if (value >= _ringMin && value < _ringMin + static_cast<Frame::Index>(_ringSize))
+                {
+                    const size_t offset = static_cast<size_t>(value - _ringMin);
+                    out = (offset + _ringSize - _windowStart) % _ringSize < _windowSize;
+                }
+                return out;
+            }
+
+            void Cache::_windowUpdate()
+            {
+                // Clamp the in/out range to the sequence to get the ring.
+                Frame::Index ringMin = 0;
+                size_t ringSize = 0;
+                if (_sequenceSize)
+                {
+                    const auto range = _inOutPoints.getRange(_sequenceSize);
+                    const Frame::Index sequenceMax = static_cast<Frame::Index>(_sequenceSize) - 1;
+                    ringMin = Math::clamp(range.min, Frame::Index(0), sequenceMax);
+                    const Frame::Index ringMax = Math::clamp(range.max, Frame::Index(0), sequenceMax);
+                    if (ringMax >= ringMin)
                     {
-                        --frame;
-                        if (first == frame)
-                        {
-                            break;
-                        }
-                        if (frame < range.min)
+                        ringSize = static_cast<size_t>(ringMax - ringMin) + 1;
+                    }
+                }
+
+                // Find the start of the window, which is the read behind frames
+                // before the current frame in the direction of playback.
+                size_t windowStart = 0;
+                size_t windowSize = 0;
+                if (ringSize)
+                {
+                    windowSize = std::min(_max + 1, ringSize);
+                    const Frame::Index ringSizeI = static_cast<Frame::Index>(ringSize);
+                    const size_t current = static_cast<size_t>(((_currentFrame - ringMin) % ringSizeI + ringSizeI) % ringSizeI);
+                    const size_t readBehind = _readBehind % ringSize;
+                    switch (_direction)
+                    {
+                    case Direction::Forward:
+                        windowStart = (current + ringSize - readBehind) % ringSize;
+                        break;
+                    case Direction::Reverse:
+                        windowStart = (current + readBehind + ringSize - (windowSize - 1)) % ringSize;
+                        break;
+                    default: break;
+                    }
+                }
+
+                // Remove the frames that are no longer in the window.
+                if (ringMin != _ringMin || ringSize != _ringSize || _sequenceSize != _frames.size())
+                {
+                    // The ring has changed so check all of the frames.
+                    _ringMin = ringMin;
+                    _ringSize = ringSize;
+                    _windowStart = windowStart;
+                    _windowSize = windowSize;
+                    std::vector<Frame::Index> remove;
+                    for (const auto& i : _ranges)
+                    {
+                        for (Frame::Index j = i.first; j <= i.second; ++j)
                         {
-                            frame = range.max;
-                            if (frame != _sequence.ranges.back().max)
+                            if (!_isInWindow(j))
                             {
-                                _sequence.ranges.push_back(Frame::Range(frame));
+                                remove.push_back(j);
                             }
                         }
-                        else
-                        {
-                            _sequence.ranges.back().min = frame;
-                        }
                     }
-                    break;
+                    for (auto i : remove)
+                    {
+                        _remove(i);
+                    }
+                    _frames.resize(_sequenceSize);
+                    _compressed.resize(_sequenceSize);
+                }
+                else if (ringSize)
+                {
+                    // Only visit the frames of the old window that are not in the
+                    // new window. As offsets from the start of the old window these
+                    // are at most two intervals, one before the start of the new
+                    // window and one after the end.
+                    const size_t delta = (windowStart + ringSize - _windowStart) % ringSize;
+                    const size_t aMin = windowSize + delta > ringSize ? (windowSize + delta - ringSize) : 0;
+                    const size_t aMax = std::min(delta, _windowSize);
+                    const size_t bMin = delta + windowSize;
+                    const size_t bMax = _windowSize;
+                    const size_t oldWindowStart = _windowStart;
+                    _windowStart = windowStart;
+                    _windowSize = windowSize;
+                    if (aMax > aMin)
+                    {
+                        _removeRange(ringMin, (oldWindowStart + aMin) % ringSize, aMax - aMin);
+                    }
+                    if (bMax > bMin)
+                    {
+                        _removeRange(ringMin, (oldWindowStart + bMin) % ringSize, bMax - bMin);
+                    }
+                }
+
+                // Update the window sequence.
+                Frame::Sequence sequence;
+                if (windowSize)
+                {
+                    const Frame::Index first = ringMin + static_cast<Frame::Index>(windowStart);
+                    if (windowStart + windowSize <= ringSize)
+                    {
+                        sequence.ranges.push_back(Frame::Range(first, first + static_cast<Frame::Index>(windowSize) - 1));
+                    }
+                    else
+                    {
+                        sequence.ranges.push_back(Frame::Range(first, ringMin + static_cast<Frame::Index>(ringSize) - 1));
+                        sequence.ranges.push_back(Frame::Range(
+                            ringMin,
+                            ringMin + static_cast<Frame::Index>(windowStart + windowSize - ringSize) - 1));
+                    }
+                }
+                if (sequence != _sequence)
+                {
+                    _sequence = sequence;
+                    if (_frameCache)
+                    {
+                        _frameCache->setMediaSequence(_frameCacheUID, _sequence);
+                    }
+                }
+            }
+
+            void Cache::_remove(Frame::Index index)
+            {
+                if (!contains(index))
+                {
+                    return;
+                }
+                _removeImage(index);
+                _removeCompressed(index);
+            }
+
+            void Cache::_removeImage(Frame::Index index)
+            {
+                if (!contains(index) || !_frames[index])
+                {
+                    return;
+                }
+                if (_frameCache)
+                {
+                    _frameCache->remove(FrameCacheKey(_frameCacheUID, _layer, index));
+                }
+                auto& frame = _frames[index];
+                _byteCount -= frame->getDataByteCount();
+                --_count;
+                frame.reset();
+                if (!_compressed[index])
+                {
+                    _removeFromRanges(index);
+                }
+            }
+
+            void Cache::_removeCompressed(Frame::Index index)
+            {
+                if (!contains(index) || !_compressed[index])
+                {
+                    return;
+                }
+                if (_frameCache)
+                {
+                    _frameCache->removeCompressed(FrameCacheKey(_frameCacheUID, _layer, index));
+                }
+                auto& frame = _compressed[index];
+                _compressedByteCount -= frame->getByteCount();
+                --_compressedCount;
+                frame.reset();
+                if (!_frames[index])
+                {
+                    _removeFromRanges(index);
+                }
+            }
+
+            void Cache::_removeRange(Frame::Index ringMin, size_t ringOffset, size_t count)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    _remove(ringMin + static_cast<Frame::Index>((ringOffset + i) % _ringSize));
+                }
+            }
+
+            void Cache::_addToRanges(Frame::Index index)
+            {
+                // Merge the frame with the neighboring ranges.
+                const auto next = _ranges.upper_bound(index);
+                const bool joinNext = next != _ranges.end() && next->first == index + 1;
+                auto prev = next;
+                const bool joinPrev = next != _ranges.begin() && (--prev)->second == index - 1;
+                if (joinPrev && joinNext)
+                {
+                    prev->second = next->second;
+                    _ranges.erase(next);
+                }
+                else if (joinPrev)
+                {
+                    prev->second = index;
+                }
+                else if (joinNext)
+                {
+                    _ranges[index] = next->second;
+                    _ranges.erase(next);
+                }
+                else
+                {
+                    _ranges[index] = index;
+                }
+            }
+
+            void Cache::_removeFromRanges(Frame::Index index)
+            {
+                // Split the range containing the frame.
+                auto i = --_ranges.upper_bound(index);
+                const Frame::Index last = i->second;
+                if (i->first == index)
+                {
+                    _ranges.erase(i);
                 }
-                default: break;
+                else
+                {
+                    i->second = index - 1;
                 }
-                auto i = _cache.begin();
-                while (i != _cache.end())
+                if (last > index)
                 {
-                    auto j = i;
-                    ++i;
-                    if (!_sequence.contains(j->first))
+                    _ranges[index + 1] = last;
+                }
+            }
+
+            Image::Size getProxySize(const Image::Size& value, size_t proxy)
+            {
+                const size_t scale = static_cast<size_t>(1) << std::min(proxy, proxyMax);
+                return Image::Size(
+                    static_cast<uint16_t>(value.w ? std::max((value.w + scale - 1) / scale, static_cast<size_t>(1)) : 0),
+                    static_cast<uint16_t>(value.h ? std::max((value.h + scale - 1) / scale, static_cast<size_t>(1)) : 0));
+            }
+
+            std::shared_ptr<Image::Image> readProxyImage(
+                FileSystem::FileIO& io,
+                const Image::Info& info,
+                size_t proxy)
+            {
+                auto proxyInfo = info;
+                proxyInfo.size = getProxySize(info.size, proxy);
+                auto out = Image::Image::create(proxyInfo);
+                const size_t scale = static_cast<size_t>(1) << std::min(proxy, proxyMax);
+                const size_t pixelByteCount = info.getPixelByteCount();
+                const size_t scanlineByteCount = info.getScanlineByteCount();
+                const size_t pos = io.getPos();
+                std::vector<uint8_t> scanline(scanlineByteCount);
+                for (uint16_t y = 0; y < proxyInfo.size.h; ++y)
+                {
+                    io.setPos(pos + y * scale * scanlineByteCount);
+                    io.read(scanline.data(), scanlineByteCount);
+                    const uint8_t* inP = scanline.data();
+                    uint8_t* outP = out->getData(y);
+                    for (uint16_t x = 0; x < proxyInfo.size.w; ++x)
                     {
-                        _cache.erase(j);
+                        memcpy(outP, inP, pixelByteCount);
+                        inP += scale * pixelByteCount;
+                        outP += pixelByteCount;
                     }
                 }
+                return out;
+            }
+
+            std::shared_ptr<Image::Image> resizeProxyImage(
+                const std::shared_ptr<Image::Image>& value,
+                const Image::Size& size)
+            {
+                auto info = value->getInfo();
+                const Image::Size inSize = info.size;
+                info.size = size;
+                auto out = Image::Image::create(info);
+                out->setPluginName(value->getPluginName());
+                out->setTags(value->getTags());
+                
+                // Use const access so that memory mapped images are not copied.
+                const Image::Data& in = *value;
+                const size_t pixelByteCount = info.getPixelByteCount();
+                for (uint16_t y = 0; y < size.h; ++y)
+                {
+                    const uint8_t* inP = in.getData(static_cast<uint16_t>(static_cast<size_t>(y) * inSize.h / size.h));
+                    uint8_t* outP = out->getData(y);
+                    for (uint16_t x = 0; x < size.w; ++x)
+                    {
+                        memcpy(outP, inP + static_cast<size_t>(x) * inSize.w / size.w * pixelByteCount, pixelByteCount);
+                        outP += pixelByteCount;
+                    }
+                }
+                return out;
+            }
+
+            std::shared_ptr<Image::Image> readROIImage(
+                FileSystem::FileIO& io,
+                const Image::Info& info,
+                const BBox2i& roi)
+            {
+                auto out = Image::Image::create(info);
+                out->zero();
+                const BBox2i bbox = roi.intersect(BBox2i(0, 0, info.size.w, info.size.h));
+                if (bbox.w() > 0 && bbox.h() > 0)
+                {
+                    const size_t scanlineByteCount = info.getScanlineByteCount();
+                    io.setPos(io.getPos() + bbox.min.y * scanlineByteCount);
+                    io.read(out->getData(bbox.min.y), bbox.h() * scanlineByteCount);
+                }
+                return out;
             }
 
             void IRead::_init(
@@ -342,6 +837,7 @@ namespace djv
             {
                 IIO::_init(fileInfo, options, textSystem, resourceSystem, logSystem);
                 _options = options;
+                _cache.setFrameCache(options.frameCache, options.layer, _getNotifyCallback());
             }
 
             IRead::~IRead()
@@ -349,20 +845,56 @@ namespace djv
 
             void IRead::setPlayback(bool value)
             {
-                std::lock_guard<std::mutex> lock(_mutex);
-                _playback = value;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _playback = value;
+                }
+                _notify();
             }
 
             void IRead::setLoop(bool value)
             {
-                std::lock_guard<std::mutex> lock(_mutex);
-                _loop = value;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _loop = value;
+                }
+                _notify();
             }
             
             void IRead::setInOutPoints(const InOutPoints& value)
             {
-                std::lock_guard<std::mutex> lock(_mutex);
-                _inOutPoints = value;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _inOutPoints = value;
+                }
+                _notify();
+            }
+
+            void IRead::setActive(bool value)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _active = value;
+                }
+                _notify();
+            }
+
+            void IRead::setVisible(bool value)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _visible = value;
+                }
+                _notify();
+            }
+
+            void IRead::setROI(const BBox2i& value)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _roi = value;
+                }
+                _notify();
             }
             
             bool IRead::isCacheEnabled() const
@@ -395,14 +927,20 @@ namespace djv
 
             void IRead::setCacheEnabled(bool value)
             {
-                std::lock_guard<std::mutex> lock(_mutex);
-                _cacheEnabled = value;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _cacheEnabled = value;
+                }
+                _notify();
             }
 
             void IRead::setCacheMaxByteCount(size_t value)
             {
-                std::lock_guard<std::mutex> lock(_mutex);
-                _cacheMaxByteCount = value;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _cacheMaxByteCount = value;
+                }
+                _notify();
             }
 
             void IWrite::_init(
@@ -420,6 +958,21 @@ namespace djv
             IWrite::~IWrite()
             {}
 
+            std::string IWrite::getError() const
+            {
+                std::lock_guard<std::mutex> lock(_errorMutex);
+                return _error;
+            }
+
+            void IWrite::_setError(const std::string& value)
+            {
+                std::lock_guard<std::mutex> lock(_errorMutex);
+                if (_error.empty())
+                {
+                    _error = value;
+                }
+            }
+
             void IPlugin::_init(
                 const std::string& pluginName,
                 const std::string& pluginInfo,
@@ -488,6 +1041,10 @@ namespace djv
             {
                 std::shared_ptr<TextSystem> textSystem;
                 std::shared_ptr<ValueSubject<bool> > optionsChanged;
+                std::shared_ptr<ThreadPool> threadPool;
+                std::shared_ptr<ReadScheduler> readScheduler;
+                std::shared_ptr<FrameCache> frameCache;
+                std::shared_ptr<DiskCache> diskCache;
                 std::map<std::string, std::shared_ptr<IPlugin> > plugins;
                 std::set<std::string> sequenceExtensions;
             };
@@ -504,6 +1061,16 @@ namespace djv
 
                 p.optionsChanged = ValueSubject<bool>::create();
 
+                p.threadPool = ThreadPool::create();
+                {
+                    std::stringstream ss;
+                    ss << "Thread pool: " << p.threadPool->getThreadCount() << " threads";
+                    _log(ss.str());
+                }
+                p.readScheduler = ReadScheduler::create(p.threadPool);
+                p.frameCache = FrameCache::create();
+                p.diskCache = DiskCache::create();
+
                 p.plugins[Cineon::pluginName] = Cineon::Plugin::create(context);
                 p.plugins[DPX::pluginName] = DPX::Plugin::create(context);
                 p.plugins[IFF::pluginName] = IFF::Plugin::create(context);
@@ -548,7 +1115,53 @@ namespace djv
             {}
 
             System::~System()
-            {}
+            {
+                DJV_PRIVATE_PTR();
+                {
+                    const auto stats = p.threadPool->getStats();
+                    std::stringstream ss;
+                    ss << "Thread pool tasks: " << stats.taskCount << ", steals: " << stats.stealCount;
+                    _log(ss.str());
+                }
+                {
+                    const auto stats = Image::DataPool::getGlobal()->getStats();
+                    std::stringstream ss;
+                    ss << "Image data pool hits: " << stats.hitCount << ", misses: " << stats.missCount <<
+                        ", evictions: " << stats.evictCount;
+                    _log(ss.str());
+                }
+                {
+                    const auto stats = FileSystem::FilePrefetch::getGlobal()->getStats();
+                    std::stringstream ss;
+                    ss << "File prefetch files: " << stats.fileCount << ", bytes: " << stats.byteCount <<
+                        ", consumed files: " << stats.consumedFileCount << ", consumed bytes: " << stats.consumedByteCount <<
+                        ", late files: " << stats.lateFileCount;
+                    _log(ss.str());
+                }
+                {
+                    const auto stats = p.frameCache->getStats();
+                    std::stringstream ss;
+                    ss << "Frame cache hits: " << stats.hitCount << ", misses: " << stats.missCount <<
+                        ", evictions: " << stats.evictCount;
+                    _log(ss.str());
+                    ss.str(std::string());
+                    ss << "Compressed frame cache frames: " << stats.compressedCount <<
+                        ", bytes: " << stats.compressedByteCount <<
+                        ", ratio: " << stats.getCompressionRatio() <<
+                        ", evictions: " << stats.compressedEvictCount <<
+                        ", decompressed frames: " << stats.decompressCount <<
+                        ", decompressed bytes per second: " << static_cast<size_t>(stats.getDecompressThroughput());
+                    _log(ss.str());
+                }
+                {
+                    const auto stats = p.diskCache->getStats();
+                    std::stringstream ss;
+                    ss << "Disk cache hits: " << stats.hitCount << ", misses: " << stats.missCount <<
+                        ", writes: " << stats.writeCount << ", evictions: " << stats.evictCount <<
+                        ", errors: " << stats.errorCount;
+                    _log(ss.str());
+                }
+            }
 
             std::shared_ptr<System> System::create(const std::shared_ptr<Context>& context)
             {
@@ -607,6 +1220,26 @@ namespace djv
                 return _p->optionsChanged;
             }
 
+            const std::shared_ptr<ThreadPool>& System::getThreadPool() const
+            {
+                return _p->threadPool;
+            }
+
+            const std::shared_ptr<ReadScheduler>& System::getReadScheduler() const
+            {
+                return _p->readScheduler;
+            }
+
+            const std::shared_ptr<FrameCache>& System::getFrameCache() const
+            {
+                return _p->frameCache;
+            }
+
+            const std::shared_ptr<DiskCache>& System::getDiskCache() const
+            {
+                return _p->diskCache;
+            }
+
             const std::set<std::string>& System::getSequenceExtensions() const
             {
                 return _p->sequenceExtensions;
@@ -650,12 +1283,29 @@ namespace djv
             std::shared_ptr<IRead> System::read(const FileSystem::FileInfo& fileInfo, const ReadOptions& options)
             {
                 DJV_PRIVATE_PTR();
+                ReadOptions readOptions = options;
+                if (!readOptions.threadPool)
+                {
+                    readOptions.threadPool = p.threadPool;
+                }
+                if (!readOptions.readScheduler)
+                {
+                    readOptions.readScheduler = p.readScheduler;
+                }
+                if (!readOptions.frameCache)
+                {
+                    readOptions.frameCache = p.frameCache;
+                }
+                if (!readOptions.diskCache)
+                {
+                    readOptions.diskCache = p.diskCache;
+                }
                 std::shared_ptr<IRead> out;
                 for (const auto & i : p.plugins)
                 {
                     if (i.second->canRead(fileInfo))
                     {
-                        out = i.second->read(fileInfo, options);
+                        out = i.second->read(fileInfo, readOptions);
                         break;
                     }
                 }
@@ -671,12 +1321,17 @@ namespace djv
             std::shared_ptr<IWrite> System::write(const FileSystem::FileInfo& fileInfo, const Info & info, const WriteOptions& options)
             {
                 DJV_PRIVATE_PTR();
+                WriteOptions writeOptions = options;
+                if (!writeOptions.threadPool)
+                {
+                    writeOptions.threadPool = p.threadPool;
+                }
                 std::shared_ptr<IWrite> out;
                 for (const auto & i : p.plugins)
                 {
                     if (i.second->canWrite(fileInfo, info))
                     {
-                        out = i.second->write(fileInfo, info, options);
+                        out = i.second->write(fileInfo, info, writeOptions);
                         break;
                     }
                 }
@@ -31,20 +31,25 @@
 
 #include <djvAV/AudioData.h>
 #include <djvAV/Image.h>
+#include <djvAV/ImageConvert.h>
 #include <djvAV/Tags.h>
 
+#include <djvCore/BBox.h>
 #include <djvCore/Error.h>
 #include <djvCore/FileInfo.h>
 #include <djvCore/ISystem.h>
 #include <djvCore/PicoJSON.h>
+#include <djvCore/SPSCQueue.h>
 #include <djvCore/Speed.h>
 #include <djvCore/Time.h>
 #include <djvCore/ValueObserver.h>
 
+#include <functional>
 #include <future>
-#include <queue>
+#include <map>
 #include <mutex>
 #include <set>
+#include <vector>
 
 namespace djv
 {
@@ -53,6 +58,7 @@ namespace djv
         class LogSystem;
         class ResourceSystem;
         class TextSystem;
+        class ThreadPool;
 
     } // namespace Core
 
@@ -61,6 +67,12 @@ namespace djv
         //! This namespace provides I/O functionality.
         namespace IO
         {
+            class CompressedImage;
+            class DiskCache;
+            class FrameCache;
+            class ReadScheduler;
+            class ReadState;
+
             //! This class provides video I/O information.
             class VideoInfo
             {
@@ -124,6 +136,11 @@ namespace djv
             };
 
             //! This class provides a queue of video frames.
+            //!
+            //! The queue has a single producer and a single consumer which do
+            //! not need to lock the I/O mutex, see Core::SPSCQueue. The consumer
+            //! should check isFinished() before checking whether the queue is
+            //! empty.
             class VideoQueue
             {
                 DJV_NON_COPYABLE(VideoQueue);
@@ -132,6 +149,8 @@ namespace djv
                 VideoQueue();
 
                 size_t getMax() const;
+
+                //! Set the maximum number of frames. This is not thread safe.
                 void setMax(size_t);
 
                 bool isEmpty() const;
@@ -144,10 +163,23 @@ namespace djv
                 bool isFinished() const;
                 void setFinished(bool);
 
+                //! Set a callback that is called when the queue changes. This
+                //! is not thread safe.
+                void setCallback(const std::function<void(void)>&);
+
+                //! Set a second callback that is called when the queue changes,
+                //! for the side of the queue that is not the I/O object. This
+                //! may be called while the queue is in use.
+                void setObserver(const std::function<void(void)>&);
+
             private:
+                void _changed();
+
                 size_t _max = 0;
-                std::queue<VideoFrame> _queue;
-                bool _finished = false;
+                Core::SPSCQueue<VideoFrame> _queue;
+                std::function<void(void)> _callback;
+                std::mutex _observerMutex;
+                std::function<void(void)> _observer;
             };
 
             //! This class provides an audio frame.
@@ -163,6 +195,9 @@ namespace djv
             };
 
             //! This class provides a queue of audio frames.
+            //!
+            //! The queue has a single producer and a single consumer which do
+            //! not need to lock the I/O mutex, see Core::SPSCQueue.
             class AudioQueue
             {
                 DJV_NON_COPYABLE(AudioQueue);
@@ -171,6 +206,8 @@ namespace djv
                 AudioQueue();
 
                 size_t getMax() const;
+
+                //! Set the maximum number of frames. This is not thread safe.
                 void setMax(size_t);
 
                 bool isEmpty() const;
@@ -183,11 +220,14 @@ namespace djv
                 bool isFinished() const;
                 void setFinished(bool);
 
+                //! Set a callback that is called when the queue changes. This
+                //! is not thread safe.
+                void setCallback(const std::function<void(void)>&);
+
             private:
-                std::mutex _mutex;
                 size_t _max = 0;
-                std::queue<AudioFrame> _queue;
-                bool _finished = false;
+                Core::SPSCQueue<AudioFrame> _queue;
+                std::function<void(void)> _callback;
             };
 
             //! This class provides I/O options.
@@ -196,6 +236,9 @@ namespace djv
                 size_t videoQueueSize = 1;
                 //! \todo What is a good default for this value?
                 size_t audioQueueSize = 30;
+
+                //! The thread pool for I/O tasks. This is set by the I/O system.
+                std::shared_ptr<Core::ThreadPool> threadPool;
             };
 
             //! This class provides an interface for I/O.
@@ -222,14 +265,32 @@ namespace djv
                 AudioQueue& getAudioQueue();
 
             protected:
+                //! Wake up the I/O thread. This may be called from any thread
+                //! whether or not the I/O mutex is locked.
+                void _notify();
+
+                //! Wait until _notify() is called or the timeout expires. Calls
+                //! to _notify() made while the I/O thread is busy are not lost,
+                //! the next wait returns immediately.
+                void _wait(const Core::Time::Unit&);
+
+                //! Get a callback that calls _notify(). The callback may be
+                //! safely called after this object is destroyed.
+                std::function<void(void)> _getNotifyCallback() const;
+
                 std::shared_ptr<Core::LogSystem> _logSystem;
                 std::shared_ptr<Core::ResourceSystem> _resourceSystem;
                 std::shared_ptr<Core::TextSystem> _textSystem;
+                std::shared_ptr<Core::ThreadPool> _threadPool;
                 Core::FileSystem::FileInfo _fileInfo;
                 std::mutex _mutex;
                 VideoQueue _videoQueue;
                 AudioQueue _audioQueue;
                 size_t _threadCount = 4;
+
+            private:
+                struct Notify;
+                std::shared_ptr<Notify> _notifyData;
             };
 
             //! This class provides options for reading.
@@ -237,8 +298,67 @@ namespace djv
             {
                 size_t layer = 0;
                 std::string colorSpace;
+
+                //! Memory map the files. Readers that support this reference the
+                //! pixels of uncompressed images in the mapped file instead of
+                //! copying them, and fall back to a copy when the layout of the
+                //! file does not match the image. The mapped images keep their
+                //! file mapped while they are in the queue or the cache, so files
+                //! should not be modified in place while they are being read.
+                bool memoryMap = false;
+
+                //! The proxy level. Each level halves the resolution of the
+                //! images (1 = 1/2, 2 = 1/4, 3 = 1/8). Readers that support it
+                //! decode the reduced resolution directly, the images from other
+                //! readers are decimated after they are read.
+                size_t proxy = 0;
+
+                //! The scheduler for frame reads. This is set by the I/O system.
+                std::shared_ptr<ReadScheduler> readScheduler;
+
+                //! The process-wide frame cache. This is set by the I/O system.
+                std::shared_ptr<FrameCache> frameCache;
+
+                //! The disk cache for decoded frames. This is set by the I/O
+                //! system.
+                std::shared_ptr<DiskCache> diskCache;
             };
 
+            //! The maximum proxy level.
+            const size_t proxyMax = 3;
+
+            //! \name Proxies
+            ///@{
+
+            //! Get the size of an image at the given proxy level, rounding up.
+            Image::Size getProxySize(const Image::Size&, size_t proxy);
+
+            //! Read uncompressed image data from the current file position at
+            //! the given proxy level. Only the scanlines that are used are read.
+            //! Throws:
+            //! - Core::FileSystem::Error
+            std::shared_ptr<Image::Image> readProxyImage(
+                Core::FileSystem::FileIO&,
+                const Image::Info&,
+                size_t proxy);
+
+            //! Decimate an image to the given size.
+            std::shared_ptr<Image::Image> resizeProxyImage(
+                const std::shared_ptr<Image::Image>&,
+                const Image::Size&);
+
+            ///@}
+
+            //! Read uncompressed image data from the current file position, only
+            //! reading the scanlines inside of the region of interest. The other
+            //! scanlines are zero.
+            //! Throws:
+            //! - Core::FileSystem::Error
+            std::shared_ptr<Image::Image> readROIImage(
+                Core::FileSystem::FileIO&,
+                const Image::Info&,
+                const Core::BBox2i&);
+
             //! This class provides playback in/out points.
             class InOutPoints
             {
@@ -268,14 +388,43 @@ namespace djv
             };
 
             //! This class provides a frame cache.
+            //!
+            //! The frames are stored in a flat array indexed by frame, and the
+            //! cache window is an arc of the in/out range that starts a few
+            //! frames behind the current frame. Adding, getting, and removing
+            //! frames are constant time. When the window moves only the frames
+            //! that fall out of it are visited, and the list of cached frame
+            //! ranges is updated as frames are added and removed.
+            //!
+            //! When the frame cache has a compressed tier, frames evicted from
+            //! the cache are handed back by getCompressible() so they can be
+            //! compressed and added to the compressed tier. A frame is in one
+            //! tier or the other, and the cached frame ranges cover both tiers.
             class Cache
             {
+                DJV_NON_COPYABLE(Cache);
+
             public:
                 Cache();
-                
+                ~Cache();
+
+                //! Set the process-wide frame cache. Frames are only added if
+                //! they fit in the frame cache, and frames evicted from the frame
+                //! cache are removed by removeEvicted(). The callback is called
+                //! when frames are evicted.
+                void setFrameCache(
+                    const std::shared_ptr<FrameCache>&,
+                    size_t layer,
+                    const std::function<void(void)>& callback = nullptr);
+
+                //! Set the scheduling state used by the frame cache.
+                void setReadState(const ReadState&);
+
                 size_t getMax() const;
                 size_t getCount() const;
                 size_t getTotalByteCount() const;
+                size_t getCompressedCount() const;
+                size_t getCompressedByteCount() const;
                 Core::Frame::Sequence getFrames() const;
                 size_t getReadBehind() const;
                 const Core::Frame::Sequence& getSequence() const;
@@ -285,13 +434,42 @@ namespace djv
                 void setDirection(Direction);
                 void setCurrentFrame(Core::Frame::Index);
 
+                //! Get whether a frame is in either tier.
                 bool contains(Core::Frame::Index) const;
+
                 bool get(Core::Frame::Index, std::shared_ptr<AV::Image::Image>&) const;
+                bool getCompressed(Core::Frame::Index, std::shared_ptr<CompressedImage>&) const;
+
+                //! Get whether a frame would fit in the frame cache.
+                bool canAdd(Core::Frame::Index, size_t byteCount) const;
+
                 void add(Core::Frame::Index, const std::shared_ptr<AV::Image::Image>&);
+
+                //! Add a frame to the compressed tier. The frame is not added if
+                //! it has been added to the uncompressed tier in the meantime.
+                void addCompressed(Core::Frame::Index, const std::shared_ptr<CompressedImage>&);
+
+                //! Set whether frames evicted from the uncompressed tier are kept
+                //! for getCompressible(). Readers that do not compress frames
+                //! leave this disabled.
+                void setCompressEnabled(bool);
+
+                //! Get the frames that were evicted from the uncompressed tier
+                //! since the last call and can be moved to the compressed tier.
+                std::vector<std::pair<Core::Frame::Index, std::shared_ptr<AV::Image::Image> > > getCompressible();
+
+                void removeEvicted();
                 void clear();
 
             private:
-                void _cacheUpdate();
+                bool _isInWindow(Core::Frame::Index) const;
+                void _windowUpdate();
+                void _remove(Core::Frame::Index);
+                void _removeImage(Core::Frame::Index);
+                void _removeCompressed(Core::Frame::Index);
+                void _removeRange(Core::Frame::Index, size_t ringOffset, size_t count);
+                void _addToRanges(Core::Frame::Index);
+                void _removeFromRanges(Core::Frame::Index);
 
                 size_t _max = 0;
                 size_t _sequenceSize = 0;
@@ -300,8 +478,30 @@ namespace djv
                 Core::Frame::Index _currentFrame = 0;
                 //! \todo Should this be configurable?
                 size_t _readBehind = 10;
+
+                //! The window is an arc of the ring made from the in/out range.
+                Core::Frame::Index _ringMin = 0;
+                size_t _ringSize = 0;
+                size_t _windowStart = 0;
+                size_t _windowSize = 0;
                 Core::Frame::Sequence _sequence;
-                std::map<Core::Frame::Index, std::shared_ptr<AV::Image::Image> > _cache;
+
+                std::vector<std::shared_ptr<AV::Image::Image> > _frames;
+                size_t _count = 0;
+                size_t _byteCount = 0;
+                bool _compressEnabled = false;
+                std::vector<std::shared_ptr<CompressedImage> > _compressed;
+                size_t _compressedCount = 0;
+                size_t _compressedByteCount = 0;
+                std::vector<std::pair<Core::Frame::Index, std::shared_ptr<AV::Image::Image> > > _compressible;
+
+                //! The cached frame ranges, the first frame of each range maps to
+                //! the last frame.
+                std::map<Core::Frame::Index, Core::Frame::Index> _ranges;
+
+                std::shared_ptr<FrameCache> _frameCache;
+                Core::UID _frameCacheUID = 0;
+                size_t _layer = 0;
             };
 
             //! This class provides an interface for reading.
@@ -324,6 +524,22 @@ namespace djv
                 void setLoop(bool);
                 void setInOutPoints(const InOutPoints&);
 
+                //! Set whether this is the active media. Reads for the active
+                //! media are scheduled before reads for other media.
+                void setActive(bool);
+
+                //! Set whether this media is visible. Reads for visible media
+                //! are scheduled before reads for hidden media.
+                void setVisible(bool);
+
+                //! Set the region of interest in image pixel coordinates. Frames
+                //! that are not in the cache are only read inside of the region
+                //! and the pixels outside of it are zero. Frames read with a
+                //! region are not added to the cache. An invalid region reads the
+                //! whole frame, the region is ignored for proxies. Seek after
+                //! changing the region to read the current frame again.
+                void setROI(const Core::BBox2i&);
+
                 //! \param value For video files this value represents the
                 //! frame number, for audio files it represents the audio sample.
                 virtual void seek(int64_t value, Direction) = 0;
@@ -343,6 +559,9 @@ namespace djv
                 Direction _direction = Direction::Forward;
                 bool _playback = false;
                 bool _loop = false;
+                bool _active = false;
+                bool _visible = true;
+                Core::BBox2i _roi;
                 bool _cacheEnabled = false;
                 size_t _cacheMaxByteCount = 0;
                 size_t _cacheByteCount = 0;
@@ -355,6 +574,9 @@ namespace djv
             struct WriteOptions : IOOptions
             {
                 std::string colorSpace;
+
+                //! The backend for converting images to the file type.
+                Image::ConvertBackend convertBackend = Image::ConvertBackend::Auto;
             };
 
             //! This class provides an interface for writing.
@@ -372,9 +594,18 @@ namespace djv
             public:
                 virtual ~IWrite() = 0;
 
+                //! Get the error if the writer failed.
+                std::string getError() const;
+
             protected:
+                void _setError(const std::string&);
+
                 Info _info;
                 WriteOptions _options;
+
+            private:
+                mutable std::mutex _errorMutex;
+                std::string _error;
             };
 
             //! This class provides an interface for I/O plugins.
@@ -447,6 +678,18 @@ namespace djv
 
                 std::shared_ptr<Core::IValueSubject<bool> > observeOptionsChanged() const;
 
+                //! Get the thread pool shared by all of the readers and writers.
+                const std::shared_ptr<Core::ThreadPool>& getThreadPool() const;
+
+                //! Get the scheduler shared by all of the readers.
+                const std::shared_ptr<ReadScheduler>& getReadScheduler() const;
+
+                //! Get the frame cache shared by all of the readers.
+                const std::shared_ptr<FrameCache>& getFrameCache() const;
+
+                //! Get the disk cache shared by all of the readers.
+                const std::shared_ptr<DiskCache>& getDiskCache() const;
+
                 const std::set<std::string>& getSequenceExtensions() const;
                 bool canSequence(const Core::FileSystem::FileInfo&) const;
                 bool canRead(const Core::FileSystem::FileInfo&) const;
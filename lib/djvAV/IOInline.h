@@ -119,22 +119,24 @@ namespace djv
 
             inline bool VideoQueue::isEmpty() const
             {
-                return 0 == _queue.size();
+                return _queue.isEmpty();
             }
 
             inline size_t VideoQueue::getCount() const
             {
-                return _queue.size();
+                return _queue.getCount();
             }
 
             inline VideoFrame VideoQueue::getFrame() const
             {
-                return _queue.size() ? _queue.front() : VideoFrame();
+                VideoFrame out;
+                _queue.peek(out);
+                return out;
             }
 
             inline bool VideoQueue::isFinished() const
             {
-                return _finished;
+                return _queue.isFinished();
             }
 
             inline AudioFrame::AudioFrame()
@@ -159,22 +161,24 @@ namespace djv
 
             inline bool AudioQueue::isEmpty() const
             {
-                return 0 == _queue.size();
+                return _queue.isEmpty();
             }
 
             inline size_t AudioQueue::getCount() const
             {
-                return _queue.size();
+                return _queue.getCount();
             }
 
             inline bool AudioQueue::isFinished() const
             {
-                return _finished;
+                return _queue.isFinished();
             }
 
             inline AudioFrame AudioQueue::getFrame() const
             {
-                return _queue.size() ? _queue.front() : AudioFrame();
+                AudioFrame out;
+                _queue.peek(out);
+                return out;
             }
 
             inline size_t IIO::getThreadCount() const
@@ -257,17 +261,22 @@ namespace djv
             
             inline size_t Cache::getCount() const
             {
-                return _cache.size();
+                return _count;
             }
 
             inline size_t Cache::getTotalByteCount() const
             {
-                size_t out = 0;
-                for (const auto& i : _cache)
-                {
-                    out += i.second->getDataByteCount();
-                }
-                return out;
+                return _byteCount;
+            }
+
+            inline size_t Cache::getCompressedCount() const
+            {
+                return _compressedCount;
+            }
+
+            inline size_t Cache::getCompressedByteCount() const
+            {
+                return _compressedByteCount;
             }
 
             inline const std::string & IPlugin::getPluginName() const
@@ -297,23 +306,8 @@ namespace djv
 
             inline bool Cache::contains(Core::Frame::Index value) const
             {
-                return _cache.find(value) != _cache.end();
-            }
-
-            inline bool Cache::get(Core::Frame::Index index, std::shared_ptr<AV::Image::Image>& out) const
-            {
-                const auto i = _cache.find(index);
-                const bool found = i != _cache.end();
-                if (found)
-                {
-                    out = i->second;
-                }
-                return found;
-            }
-
-            inline void Cache::clear()
-            {
-                _cache.clear();
+                return value >= 0 && value < static_cast<Core::Frame::Index>(_frames.size()) &&
+                    (_frames[value] || _compressed[value]);
             }
 
         } // namespace IO
@@ -50,11 +50,11 @@ namespace djv
             public:
                 ~Image();
 
-#if defined(DJV_MMAP)
+                //! Create a new image. See Data::create() for how the pixels are
+                //! taken from the file.
+                //! Throws:
+                //! - Core::FileSystem::Error
                 static std::shared_ptr<Image> create(const Info&, const std::shared_ptr<Core::FileSystem::FileIO>& = nullptr);
-#else // DJV_MMAP
-                static std::shared_ptr<Image> create(const Info&);
-#endif // DJV_MMAP
 
                 const std::string& getPluginName() const;
                 void setPluginName(const std::string&);
@@ -29,6 +29,7 @@
 
 #include <djvAV/ImageConvert.h>
 
+#include <djvAV/ImageUtil.h>
 #include <djvAV/OpenGLMesh.h>
 #include <djvAV/OpenGLOffscreenBuffer.h>
 #include <djvAV/OpenGLShader.h>
@@ -39,9 +40,19 @@
 
 #include <djvCore/Context.h>
 #include <djvCore/ResourceSystem.h>
+#include <djvCore/ThreadPool.h>
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
 
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <limits>
+
 using namespace djv::Core;
 
 namespace djv
@@ -50,8 +61,386 @@ namespace djv
     {
         namespace Image
         {
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const uint16_t taskScanlineCount = 32;
+
+                size_t getWordSize(Type type)
+                {
+                    return Type::RGB_U10 == type ? sizeof(U10_S) : getByteCount(getDataType(type));
+                }
+
+                // The kernels below work on one scanline at a time with
+                // simple loops over contiguous arrays, so that the compiler
+                // can vectorize them.
+
+                template<typename T>
+                void unpackT(const uint8_t* in, size_t size, float scale, float* out)
+                {
+                    const T* inP = reinterpret_cast<const T*>(in);
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        out[i] = static_cast<float>(inP[i]) * scale;
+                    }
+                }
+
+                //! Unpack a scanline to normalized floating point values.
+                void unpack(const uint8_t* in, Type type, uint16_t width, float* out)
+                {
+                    const size_t size = width * static_cast<size_t>(getChannelCount(type));
+                    switch (getDataType(type))
+                    {
+                    case DataType::U8:  unpackT<U8_T>(in, size, 1.F / U8Range.max, out); break;
+                    case DataType::U16: unpackT<U16_T>(in, size, 1.F / U16Range.max, out); break;
+                    case DataType::U32: unpackT<U32_T>(in, size, 1.F / U32Range.max, out); break;
+                    case DataType::F16: unpackT<F16_T>(in, size, 1.F, out); break;
+                    case DataType::F32: memcpy(out, in, size * sizeof(F32_T)); break;
+                    case DataType::U10:
+                    {
+                        const U10_S* inP = reinterpret_cast<const U10_S*>(in);
+                        const float scale = 1.F / U10Range.max;
+                        for (uint16_t x = 0; x < width; ++x, ++inP, out += 3)
+                        {
+                            out[0] = inP->r * scale;
+                            out[1] = inP->g * scale;
+                            out[2] = inP->b * scale;
+                        }
+                        break;
+                    }
+                    default: break;
+                    }
+                }
+
+                //! \todo The 32-bit values are computed in double precision
+                //! since a float can't represent the full range.
+                template<typename T, typename U>
+                void packIntT(const float* in, size_t size, uint8_t* out)
+                {
+                    T* outP = reinterpret_cast<T*>(out);
+                    const U max = static_cast<U>(std::numeric_limits<T>::max());
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        outP[i] = static_cast<T>(static_cast<U>(Math::clamp(in[i], 0.F, 1.F)) * max + static_cast<U>(.5));
+                    }
+                }
+
+                template<typename T>
+                void packFloatT(const float* in, size_t size, uint8_t* out)
+                {
+                    T* outP = reinterpret_cast<T*>(out);
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        outP[i] = static_cast<T>(in[i]);
+                    }
+                }
+
+                //! Pack normalized floating point values to a scanline. Integer
+                //! values are clamped and rounded to the nearest value, the
+                //! same as OpenGL.
+                void pack(const float* in, Type type, uint16_t width, uint8_t* out)
+                {
+                    const size_t size = width * static_cast<size_t>(getChannelCount(type));
+                    switch (getDataType(type))
+                    {
+                    case DataType::U8:  packIntT<U8_T, float>(in, size, out); break;
+                    case DataType::U16: packIntT<U16_T, float>(in, size, out); break;
+                    case DataType::U32: packIntT<U32_T, double>(in, size, out); break;
+                    case DataType::F16: packFloatT<F16_T>(in, size, out); break;
+                    case DataType::F32: memcpy(out, in, size * sizeof(F32_T)); break;
+                    case DataType::U10:
+                    {
+                        U10_S* outP = reinterpret_cast<U10_S*>(out);
+                        const float max = static_cast<float>(U10Range.max);
+                        for (uint16_t x = 0; x < width; ++x, ++outP, in += 3)
+                        {
+                            outP->r = static_cast<U10_T>(Math::clamp(in[0], 0.F, 1.F) * max + .5F);
+                            outP->g = static_cast<U10_T>(Math::clamp(in[1], 0.F, 1.F) * max + .5F);
+                            outP->b = static_cast<U10_T>(Math::clamp(in[2], 0.F, 1.F) * max + .5F);
+                            outP->pad = 0;
+                        }
+                        break;
+                    }
+                    default: break;
+                    }
+                }
+
+                //! Convert the channels of a scanline.
+                void convertChannels(const float* in, size_t inCount, float* out, size_t outCount, uint16_t width)
+                {
+                    for (uint16_t x = 0; x < width; ++x, in += inCount, out += outCount)
+                    {
+                        float r = in[0];
+                        float g = in[0];
+                        float b = in[0];
+                        float a = 1.F;
+                        switch (inCount)
+                        {
+                        case 2: a = in[1]; break;
+                        case 3: g = in[1]; b = in[2]; break;
+                        case 4: g = in[1]; b = in[2]; a = in[3]; break;
+                        default: break;
+                        }
+                        const float l = inCount > 2 ? ((r + g + b) / 3.F) : r;
+                        switch (outCount)
+                        {
+                        case 1: out[0] = l; break;
+                        case 2: out[0] = l; out[1] = a; break;
+                        case 3: out[0] = r; out[1] = g; out[2] = b; break;
+                        case 4: out[0] = r; out[1] = g; out[2] = b; out[3] = a; break;
+                        default: break;
+                        }
+                    }
+                }
+
+                //! This struct provides a bilinear filter sample.
+                struct Sample
+                {
+                    uint16_t i0 = 0;
+                    uint16_t i1 = 0;
+                    float    f  = 0.F;
+                };
+
+                //! Get the bilinear filter samples for resizing. The samples
+                //! are taken at the pixel centers with the edges clamped, the
+                //! same as OpenGL texture filtering.
+                std::vector<Sample> getSamples(uint16_t inSize, uint16_t outSize, bool mirror)
+                {
+                    std::vector<Sample> out(outSize);
+                    const float scale = inSize / static_cast<float>(outSize);
+                    const int max = static_cast<int>(inSize) - 1;
+                    for (uint16_t i = 0; i < outSize; ++i)
+                    {
+                        float s = (i + .5F) * scale;
+                        if (mirror)
+                        {
+                            s = inSize - s;
+                        }
+                        s -= .5F;
+                        const float f = std::floor(s);
+                        out[i].i0 = static_cast<uint16_t>(Math::clamp(static_cast<int>(f), 0, max));
+                        out[i].i1 = static_cast<uint16_t>(Math::clamp(static_cast<int>(f) + 1, 0, max));
+                        out[i].f = s - f;
+                    }
+                    return out;
+                }
+
+                void resample(const float* in, const std::vector<Sample>& samples, size_t channelCount, float* out)
+                {
+                    for (const auto& sample : samples)
+                    {
+                        const float* a = in + sample.i0 * channelCount;
+                        const float* b = in + sample.i1 * channelCount;
+                        for (size_t c = 0; c < channelCount; ++c)
+                        {
+                            *out++ = a[c] + (b[c] - a[c]) * sample.f;
+                        }
+                    }
+                }
+
+                void blend(const float* a, const float* b, float f, size_t size, float* out)
+                {
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        out[i] = a[i] + (b[i] - a[i]) * f;
+                    }
+                }
+
+                //! Copy scanlines when only the layout changes.
+                void copyScanlines(const Data& in, const Mirror& mirror, Data& out, uint16_t begin, uint16_t end)
+                {
+                    const auto& inInfo = in.getInfo();
+                    const auto& outInfo = out.getInfo();
+                    const size_t pixelByteCount = inInfo.getPixelByteCount();
+                    const size_t byteCount = inInfo.size.w * pixelByteCount;
+                    const bool swap = inInfo.layout.endian != outInfo.layout.endian;
+                    const size_t wordSize = getWordSize(inInfo.type);
+                    for (uint16_t y = begin; y < end; ++y)
+                    {
+                        const uint8_t* inP = in.getData(mirror.y ? (inInfo.size.h - 1 - y) : y);
+                        uint8_t* outP = out.getData(y);
+                        if (mirror.x)
+                        {
+                            const uint8_t* inPixelP = inP + byteCount - pixelByteCount;
+                            uint8_t* outPixelP = outP;
+                            for (uint16_t x = 0; x < inInfo.size.w; ++x)
+                            {
+                                memcpy(outPixelP, inPixelP, pixelByteCount);
+                                inPixelP -= pixelByteCount;
+                                outPixelP += pixelByteCount;
+                            }
+                            if (swap)
+                            {
+                                Memory::endian(outP, byteCount / wordSize, wordSize);
+                            }
+                        }
+                        else if (swap)
+                        {
+                            Memory::endian(inP, outP, byteCount / wordSize, wordSize);
+                        }
+                        else
+                        {
+                            memcpy(outP, inP, byteCount);
+                        }
+                    }
+                }
+
+                //! Convert and resize scanlines.
+                void convertScanlines(
+                    const Data& in,
+                    const std::vector<Sample>& xSamples,
+                    const std::vector<Sample>& ySamples,
+                    bool xIdentity,
+                    Data& out,
+                    uint16_t begin,
+                    uint16_t end)
+                {
+                    const auto& inInfo = in.getInfo();
+                    const auto& outInfo = out.getInfo();
+                    const size_t inChannelCount = getChannelCount(inInfo.type);
+                    const size_t outChannelCount = getChannelCount(outInfo.type);
+                    const bool inSwap = inInfo.layout.endian != Memory::getEndian();
+                    const bool outSwap = outInfo.layout.endian != Memory::getEndian();
+                    const size_t inByteCount = inInfo.size.w * inInfo.getPixelByteCount();
+                    const size_t outByteCount = outInfo.size.w * outInfo.getPixelByteCount();
+                    const size_t inWordSize = getWordSize(inInfo.type);
+                    const size_t outWordSize = getWordSize(outInfo.type);
+                    const uint16_t w = outInfo.size.w;
+                    const size_t rowSize = w * inChannelCount;
+
+                    std::vector<uint8_t> inBytes(inSwap ? inByteCount : 0);
+                    std::vector<float> unpacked(xIdentity ? 0 : inInfo.size.w * inChannelCount);
+                    std::vector<float> rows[2] = { std::vector<float>(rowSize), std::vector<float>(rowSize) };
+                    int rowIndex[2] = { -1, -1 };
+                    std::vector<float> blended(rowSize);
+                    std::vector<float> converted(w * outChannelCount);
+                    std::vector<uint8_t> outBytes(outSwap ? outByteCount : 0);
+
+                    auto load = [&](uint16_t y, std::vector<float>& row)
+                    {
+                        const uint8_t* inP = in.getData(y);
+                        if (inSwap)
+                        {
+                            Memory::endian(inP, inBytes.data(), inByteCount / inWordSize, inWordSize);
+                            inP = inBytes.data();
+                        }
+                        if (xIdentity)
+                        {
+                            unpack(inP, inInfo.type, inInfo.size.w, row.data());
+                        }
+                        else
+                        {
+                            unpack(inP, inInfo.type, inInfo.size.w, unpacked.data());
+                            resample(unpacked.data(), xSamples, inChannelCount, row.data());
+                        }
+                    };
+
+                    for (uint16_t y = begin; y < end; ++y)
+                    {
+                        // Load the two input scanlines, re-using the scanlines
+                        // from the previous output scanline when possible.
+                        const auto& sample = ySamples[y];
+                        if (rowIndex[0] != sample.i0)
+                        {
+                            if (rowIndex[1] == sample.i0)
+                            {
+                                std::swap(rows[0], rows[1]);
+                                std::swap(rowIndex[0], rowIndex[1]);
+                            }
+                            else
+                            {
+                                load(sample.i0, rows[0]);
+                                rowIndex[0] = sample.i0;
+                            }
+                        }
+                        const float* rowP = rows[0].data();
+                        if (sample.f > 0.F && sample.i1 != sample.i0)
+                        {
+                            if (rowIndex[1] != sample.i1)
+                            {
+                                load(sample.i1, rows[1]);
+                                rowIndex[1] = sample.i1;
+                            }
+                            blend(rows[0].data(), rows[1].data(), sample.f, rowSize, blended.data());
+                            rowP = blended.data();
+                        }
+
+                        if (inChannelCount != outChannelCount)
+                        {
+                            convertChannels(rowP, inChannelCount, converted.data(), outChannelCount, w);
+                            rowP = converted.data();
+                        }
+
+                        uint8_t* outP = out.getData(y);
+                        if (outSwap)
+                        {
+                            pack(rowP, outInfo.type, w, outBytes.data());
+                            Memory::endian(outBytes.data(), outP, outByteCount / outWordSize, outWordSize);
+                        }
+                        else
+                        {
+                            pack(rowP, outInfo.type, w, outP);
+                        }
+                    }
+                }
+
+                //! Split the scanlines into tasks for the thread pool, and
+                //! process the last task on this thread. All of the tasks
+                //! are finished before returning since they may reference
+                //! data on the caller's stack.
+                void processTasks(
+                    const std::shared_ptr<ThreadPool>& threadPool,
+                    uint16_t height,
+                    const std::function<void(uint16_t, uint16_t)>& function)
+                {
+                    std::vector<std::future<void> > futures;
+                    uint16_t y = 0;
+                    if (threadPool)
+                    {
+                        for (; height - y > taskScanlineCount; y += taskScanlineCount)
+                        {
+                            const uint16_t begin = y;
+                            const uint16_t end = y + taskScanlineCount;
+                            futures.push_back(threadPool->addTaskFuture<void>(
+                                [&function, begin, end]
+                                {
+                                    function(begin, end);
+                                }));
+                        }
+                    }
+                    std::exception_ptr exception;
+                    try
+                    {
+                        function(y, height);
+                    }
+                    catch (const std::exception&)
+                    {
+                        exception = std::current_exception();
+                    }
+                    for (auto& i : futures)
+                    {
+                        try
+                        {
+                            i.get();
+                        }
+                        catch (const std::exception&)
+                        {
+                            exception = std::current_exception();
+                        }
+                    }
+                    if (exception)
+                    {
+                        std::rethrow_exception(exception);
+                    }
+                }
+
+            } // namespace
+
             struct Convert::Private
             {
+                ConvertBackend backend = ConvertBackend::First;
+                std::shared_ptr<ThreadPool> threadPool;
+
                 Size size;
                 Mirror mirror;
                 std::shared_ptr<OpenGL::OffscreenBuffer> offscreenBuffer;
@@ -62,13 +451,25 @@ namespace djv
                 glm::mat4x4 mvp = glm::mat4x4(1.F);
             };
 
-            void Convert::_init(const std::shared_ptr<ResourceSystem>& resourceSystem)
+            void Convert::_init(
+                const std::shared_ptr<ResourceSystem>& resourceSystem,
+                ConvertBackend backend,
+                const std::shared_ptr<ThreadPool>& threadPool)
             {
                 DJV_PRIVATE_PTR();
-                const FileSystem::Path shaderPath = resourceSystem->getPath(Core::FileSystem::ResourcePath::Shaders);
-                p.shader = AV::OpenGL::Shader::create(Render::Shader::create(
-                    FileSystem::Path(shaderPath, "djvAVImageConvertVertex.glsl"),
-                    FileSystem::Path(shaderPath, "djvAVImageConvertFragment.glsl")));
+                p.backend = backend;
+                if (ConvertBackend::Auto == p.backend)
+                {
+                    p.backend = glfwGetCurrentContext() ? ConvertBackend::OpenGL : ConvertBackend::CPU;
+                }
+                p.threadPool = threadPool;
+                if (ConvertBackend::OpenGL == p.backend)
+                {
+                    const FileSystem::Path shaderPath = resourceSystem->getPath(Core::FileSystem::ResourcePath::Shaders);
+                    p.shader = AV::OpenGL::Shader::create(Render::Shader::create(
+                        FileSystem::Path(shaderPath, "djvAVImageConvertVertex.glsl"),
+                        FileSystem::Path(shaderPath, "djvAVImageConvertFragment.glsl")));
+                }
             }
 
             Convert::Convert() :
@@ -78,14 +479,32 @@ namespace djv
             Convert::~Convert()
             {}
 
-            std::shared_ptr<Convert> Convert::create(const std::shared_ptr<ResourceSystem>& resourceSystem)
+            std::shared_ptr<Convert> Convert::create(
+                const std::shared_ptr<ResourceSystem>& resourceSystem,
+                ConvertBackend backend,
+                const std::shared_ptr<ThreadPool>& threadPool)
             {
                 auto out = std::shared_ptr<Convert>(new Convert);
-                out->_init(resourceSystem);
+                out->_init(resourceSystem, backend, threadPool);
                 return out;
             }
 
+            ConvertBackend Convert::getBackend() const
+            {
+                return _p->backend;
+            }
+
             void Convert::process(const Data& data, const Info& info, Data& out)
+            {
+                switch (_p->backend)
+                {
+                case ConvertBackend::OpenGL: _processGL(data, info, out); break;
+                case ConvertBackend::CPU: _processCPU(data, info, out); break;
+                default: break;
+                }
+            }
+
+            void Convert::_processGL(const Data& data, const Info& info, Data& out)
             {
                 DJV_PRIVATE_PTR();
                 bool create = !p.offscreenBuffer;
@@ -106,6 +525,8 @@ namespace djv
 
                 p.shader->bind();
                 p.shader->setUniform("textureSampler", 0);
+                p.shader->setUniform("inputChannels", static_cast<int>(getChannelCount(data.getType())));
+                p.shader->setUniform("outputChannels", static_cast<int>(getChannelCount(info.type)));
                 
                 if (info.size != p.size)
                 {
@@ -118,18 +539,21 @@ namespace djv
                     glm::mat4x4 projectionMatrix(1);
                     projectionMatrix = glm::ortho(
                         0.F,
-                        static_cast<float>(info.size.w) - 1.F,
+                        static_cast<float>(info.size.w),
                         0.F,
-                        static_cast<float>(info.size.h) - 1.F,
+                        static_cast<float>(info.size.h),
                         -1.F,
                         1.F);
                     p.mvp = projectionMatrix * viewMatrix * modelMatrix;
                 }
                 p.shader->setUniform("transform.mvp", p.mvp);
 
-                if (!p.vbo || (p.vbo && data.getLayout().mirror != p.mirror))
+                const Mirror mirror(
+                    data.getLayout().mirror.x != info.layout.mirror.x,
+                    data.getLayout().mirror.y != info.layout.mirror.y);
+                if (!p.vbo || (p.vbo && mirror != p.mirror))
                 {
-                    p.mirror = data.getLayout().mirror;
+                    p.mirror = mirror;
                     AV::Geom::Square square;
                     AV::Geom::TriangleMesh mesh;
                     square.triangulate(mesh);
@@ -164,7 +588,7 @@ namespace djv
 
                 p.vao->draw(GL_TRIANGLES, 0, 6);
 
-                glPixelStorei(GL_PACK_ALIGNMENT, 1);
+                glPixelStorei(GL_PACK_ALIGNMENT, info.layout.alignment);
 #if !defined(DJV_OPENGL_ES2)
                 glPixelStorei(GL_PACK_SWAP_BYTES, info.layout.endian != Memory::getEndian());
 #endif
@@ -175,6 +599,64 @@ namespace djv
                     out.getData());
             }
 
+            void Convert::_processCPU(const Data& data, const Info& info, Data& out)
+            {
+                DJV_PRIVATE_PTR();
+
+                // Planar YUV data is converted to RGB first.
+                if (isYUVType(data.getType()))
+                {
+                    auto rgbInfo = data.getInfo();
+                    rgbInfo.type = getRGBType(rgbInfo.type);
+                    auto rgbData = Data::create(rgbInfo);
+                    processTasks(
+                        p.threadPool,
+                        rgbInfo.size.h,
+                        [&data, &rgbData](uint16_t begin, uint16_t end)
+                        {
+                            convertYUV(data, *rgbData, begin, end);
+                        });
+                    _processCPU(*rgbData, info, out);
+                    return;
+                }
+
+                const auto& inInfo = data.getInfo();
+                const Mirror mirror(
+                    inInfo.layout.mirror.x != info.layout.mirror.x,
+                    inInfo.layout.mirror.y != info.layout.mirror.y);
+                const bool copy = inInfo.size == info.size && inInfo.type == info.type;
+                std::vector<Sample> xSamples;
+                std::vector<Sample> ySamples;
+                if (!copy)
+                {
+                    xSamples = getSamples(inInfo.size.w, info.size.w, mirror.x);
+                    ySamples = getSamples(inInfo.size.h, info.size.h, mirror.y);
+                }
+                const bool xIdentity = inInfo.size.w == info.size.w && !mirror.x;
+                const std::function<void(uint16_t, uint16_t)> function =
+                    [&data, copy, mirror, &xSamples, &ySamples, xIdentity, &out](uint16_t begin, uint16_t end)
+                {
+                    if (copy)
+                    {
+                        copyScanlines(data, mirror, out, begin, end);
+                    }
+                    else
+                    {
+                        convertScanlines(data, xSamples, ySamples, xIdentity, out, begin, end);
+                    }
+                };
+
+                processTasks(p.threadPool, info.size.h, function);
+            }
+
         } // namespace Image
     } // namespace AV
+
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        AV::Image,
+        ConvertBackend,
+        DJV_TEXT("av_image_convert_backend_auto"),
+        DJV_TEXT("av_image_convert_backend_opengl"),
+        DJV_TEXT("av_image_convert_backend_cpu"));
+
 } // namespace djv
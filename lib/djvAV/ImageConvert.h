@@ -36,6 +36,7 @@ namespace djv
     namespace Core
     {
         class ResourceSystem;
+        class ThreadPool;
 
     } // namespace Core
 
@@ -43,33 +44,74 @@ namespace djv
     {
         namespace Image
         {
+            //! This enumeration provides the image conversion backends.
+            enum class ConvertBackend
+            {
+                Auto,   //!< OpenGL if there is a current context, otherwise the CPU
+                OpenGL,
+                CPU,
+
+                Count,
+                First = Auto
+            };
+            DJV_ENUM_HELPERS(ConvertBackend);
+
             //! This class provides image data conversion.
+            //!
+            //! Both backends convert the type (luminance is replicated into
+            //! the color channels, the color channels are averaged into
+            //! luminance, and a missing alpha channel is filled with one),
+            //! change the layout (mirror, alignment, and endian), and resize
+            //! with bilinear filtering. The CPU backend produces the same
+            //! output as the OpenGL backend, give or take rounding.
+            //!
+            //! Planar YUV input is converted to RGB, planar YUV output is
+            //! not supported.
             class Convert
             {
                 DJV_NON_COPYABLE(Convert);
 
             protected:
-                void _init(const std::shared_ptr<Core::ResourceSystem>&);
+                void _init(
+                    const std::shared_ptr<Core::ResourceSystem>&,
+                    ConvertBackend,
+                    const std::shared_ptr<Core::ThreadPool>&);
                 Convert();
 
             public:
                 ~Convert();
 
-                //! Note that this function requires an OpenGL context.
+                //! Create a new converter. The OpenGL backend requires an
+                //! OpenGL context. The CPU backend splits the work across
+                //! the thread pool if one is given.
                 //! Throws:
                 //! - OpenGL::ShaderError
                 //! - Render::ShaderError
-                static std::shared_ptr<Convert> create(const std::shared_ptr<Core::ResourceSystem>&);
+                static std::shared_ptr<Convert> create(
+                    const std::shared_ptr<Core::ResourceSystem>&,
+                    ConvertBackend = ConvertBackend::Auto,
+                    const std::shared_ptr<Core::ThreadPool>& = nullptr);
 
-                //! Note that this function requires an OpenGL context.
+                //! Get the backend, this is never ConvertBackend::Auto.
+                ConvertBackend getBackend() const;
+
+                //! Note that the OpenGL backend requires an OpenGL context,
+                //! and that the CPU backend must not be called from a task
+                //! of it's own thread pool.
                 //! Throws:
                 //! - OpenGL::OffscreenBufferError
                 void process(const Data&, const Info&, Data&);
 
             private:
+                void _processGL(const Data&, const Info&, Data&);
+                void _processCPU(const Data&, const Info&, Data&);
+
                 DJV_PRIVATE();
             };
 
         } // namespace Image
     } // namespace AV
+
+    DJV_ENUM_SERIALIZE_HELPERS(AV::Image::ConvertBackend);
+
 } // namespace djv
@@ -52,6 +52,8 @@ namespace djv
     {
         namespace Image
         {
+            class DataPool;
+
             //! This struct provides information about mirroring the image.
             class Mirror
             {
@@ -113,6 +115,8 @@ namespace djv
                 float pixelAspectRatio = 1.F;
                 Type type = Type::None;
                 Layout layout;
+                YUVCoefficients yuvCoefficients = YUVCoefficients::BT709;
+                YUVRange yuvRange = YUVRange::Video;
 
                 float getAspectRatio() const;
                 GLenum getGLFormat() const;
@@ -122,11 +126,31 @@ namespace djv
                 size_t getScanlineByteCount() const;
                 size_t getDataByteCount() const;
 
+                //! \name Planes
+                //! The planar YUV types have three planes stored one after the
+                //! other, all of the other types have a single plane.
+                ///@{
+
+                size_t getPlaneCount() const;
+                Size getPlaneSize(size_t) const;
+                size_t getPlaneScanlineByteCount(size_t) const;
+                size_t getPlaneByteOffset(size_t) const;
+
+                ///@}
+
                 bool operator == (const Info&) const;
                 bool operator != (const Info&) const;
             };
 
-            //! This struct provides image data.
+            //! This struct provides image data. The data buffer is allocated
+            //! from the global image data pool.
+            //!
+            //! Image data can also reference the pixels of a memory mapped file
+            //! directly instead of copying them. The mapped data keeps the layout
+            //! of the file, including the endian, and the file mapping stays
+            //! alive for as long as the image data references it. Getting
+            //! non-const access to the pixels makes a private copy first (see
+            //! detach()).
             class Data
             {
                 DJV_NON_COPYABLE(Data);
@@ -138,11 +162,19 @@ namespace djv
             public:
                 ~Data();
 
-#if defined(DJV_MMAP)
+                //! Create new image data. If a file is given the pixels are taken
+                //! from the current file position, they are referenced directly
+                //! if canMemoryMap() is true and copied otherwise. Referenced
+                //! files must not be re-opened or closed by the caller.
+                //! Throws:
+                //! - Core::FileSystem::Error
                 static std::shared_ptr<Data> create(const Info&, const std::shared_ptr<Core::FileSystem::FileIO>& = nullptr);
-#else // DJV_MMAP
-                static std::shared_ptr<Data> create(const Info&);
-#endif // DJV_MMAP
+
+                //! Get whether the pixels at the current file position can be
+                //! referenced directly. The file must be memory mapped, have
+                //! enough data left, and the data must be aligned for the pixel
+                //! type.
+                static bool canMemoryMap(const Info&, const std::shared_ptr<Core::FileSystem::FileIO>&);
 
                 Core::UID getUID() const;
 
@@ -169,11 +201,22 @@ namespace djv
                 uint8_t* getData(uint16_t y);
                 uint8_t* getData(uint16_t x, uint16_t y);
 
+                //! Get a scanline of a plane.
+                const uint8_t* getPlaneData(size_t plane, uint16_t y) const;
+                uint8_t* getPlaneData(size_t plane, uint16_t y);
+
                 void zero();
 
-#if defined(DJV_MMAP)
+                //! \name Memory Mapping
+                ///@{
+
+                //! Get whether the pixels reference a memory mapped file.
+                bool isMemoryMapped() const;
+
+                //! Copy the pixels of a memory mapped file and release the file.
                 void detach();
-#endif // DJV_MMAP
+
+                ///@}
 
                 bool operator == (const Data&) const;
                 bool operator != (const Data&) const;
@@ -186,9 +229,8 @@ namespace djv
                 size_t _dataByteCount = 0;
                 uint8_t* _data = nullptr;
                 const uint8_t* _p = nullptr;
-#if defined(DJV_MMAP)
+                std::shared_ptr<DataPool> _pool;
                 std::shared_ptr<Core::FileSystem::FileIO> _fileIO;
-#endif // DJV_MMAP
             };
 
         } // namespace Image
@@ -140,15 +140,54 @@ namespace djv
 
             inline size_t Info::getScanlineByteCount() const
             {
-                const size_t byteCount = static_cast<size_t>(size.w) * AV::Image::getByteCount(type);
+                return getPlaneScanlineByteCount(0);
+            }
+
+            inline size_t Info::getDataByteCount() const
+            {
+                size_t out = 0;
+                const size_t planeCount = getPlaneCount();
+                for (size_t i = 0; i < planeCount; ++i)
+                {
+                    out += getPlaneSize(i).h * getPlaneScanlineByteCount(i);
+                }
+                return out;
+            }
+
+            inline size_t Info::getPlaneCount() const
+            {
+                return isYUVType(type) ? 3 : 1;
+            }
+
+            inline Size Info::getPlaneSize(size_t plane) const
+            {
+                Size out = size;
+                if (plane > 0)
+                {
+                    const uint8_t shiftX = getChromaShiftX(type);
+                    const uint8_t shiftY = getChromaShiftY(type);
+                    out.w = (size.w + (1 << shiftX) - 1) >> shiftX;
+                    out.h = (size.h + (1 << shiftY) - 1) >> shiftY;
+                }
+                return out;
+            }
+
+            inline size_t Info::getPlaneScanlineByteCount(size_t plane) const
+            {
+                const size_t byteCount = static_cast<size_t>(getPlaneSize(plane).w) * AV::Image::getByteCount(type);
                 const size_t q = byteCount / layout.alignment * layout.alignment;
                 const size_t r = byteCount - q;
                 return q + (r ? layout.alignment : 0);
             }
 
-            inline size_t Info::getDataByteCount() const
+            inline size_t Info::getPlaneByteOffset(size_t plane) const
             {
-                return size.h * getScanlineByteCount();
+                size_t out = 0;
+                for (size_t i = 0; i < plane; ++i)
+                {
+                    out += getPlaneSize(i).h * getPlaneScanlineByteCount(i);
+                }
+                return out;
             }
 
             inline bool Info::operator == (const Info& other) const
@@ -157,7 +196,9 @@ namespace djv
                     other.size.w == size.w &&
                     other.size.h == size.h &&
                     other.type == type &&
-                    other.layout == layout;
+                    other.layout == layout &&
+                    other.yuvCoefficients == yuvCoefficients &&
+                    other.yuvRange == yuvRange;
             }
 
             inline bool Info::operator != (const Info& other) const
@@ -233,6 +274,11 @@ namespace djv
                 return _scanlineByteCount;
             }
 
+            inline bool Data::isMemoryMapped() const
+            {
+                return _fileIO != nullptr;
+            }
+
             inline const uint8_t* Data::getData() const
             {
                 return _p;
@@ -250,28 +296,45 @@ namespace djv
 
             inline uint8_t* Data::getData()
             {
-#if defined(DJV_MMAP)
-                detach();
-#endif // DJV_MMAP
+                if (_fileIO)
+                {
+                    detach();
+                }
                 return _data;
             }
 
             inline uint8_t* Data::getData(uint16_t y)
             {
-#if defined(DJV_MMAP)
-                detach();
-#endif // DJV_MMAP
+                if (_fileIO)
+                {
+                    detach();
+                }
                 return _data + y * _scanlineByteCount;
             }
 
             inline uint8_t* Data::getData(uint16_t x, uint16_t y)
             {
-#if defined(DJV_MMAP)
-                detach();
-#endif // DJV_MMAP
+                if (_fileIO)
+                {
+                    detach();
+                }
                 return _data + y * _scanlineByteCount + x * static_cast<size_t>(_pixelByteCount);
             }
 
+            inline const uint8_t* Data::getPlaneData(size_t plane, uint16_t y) const
+            {
+                return _p + _info.getPlaneByteOffset(plane) + y * _info.getPlaneScanlineByteCount(plane);
+            }
+
+            inline uint8_t* Data::getPlaneData(size_t plane, uint16_t y)
+            {
+                if (_fileIO)
+                {
+                    detach();
+                }
+                return _data + _info.getPlaneByteOffset(plane) + y * _info.getPlaneScanlineByteCount(plane);
+            }
+
         } // namespace Image
     } // namespace AV
 } // namespace djv
@@ -0,0 +1,315 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/ImageDataPool.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#if defined(DJV_PLATFORM_WINDOWS)
+#include <malloc.h>
+#else // DJV_PLATFORM_WINDOWS
+#include <stdlib.h>
+#include <sys/mman.h>
+#endif // DJV_PLATFORM_WINDOWS
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            namespace
+            {
+                struct Bucket
+                {
+                    std::vector<uint8_t*> buffers;
+                    uint64_t time = 0;
+                };
+
+            } // namespace
+
+            bool DataPoolStats::operator == (const DataPoolStats& other) const
+            {
+                return
+                    freeCount == other.freeCount &&
+                    freeByteCount == other.freeByteCount &&
+                    hitCount == other.hitCount &&
+                    missCount == other.missCount &&
+                    evictCount == other.evictCount;
+            }
+
+            struct DataPool::Private
+            {
+                mutable std::mutex mutex;
+                size_t byteBudget = 0;
+                bool prefault = false;
+                std::map<size_t, Bucket> buckets;
+                uint64_t time = 0;
+                DataPoolStats stats;
+            };
+
+            void DataPool::_init(size_t byteBudget, bool prefault)
+            {
+                DJV_PRIVATE_PTR();
+                p.byteBudget = byteBudget;
+                p.prefault = prefault;
+            }
+
+            DataPool::DataPool() :
+                _p(new Private)
+            {}
+
+            DataPool::~DataPool()
+            {
+                clear();
+            }
+
+            std::shared_ptr<DataPool> DataPool::create(size_t byteBudget, bool prefault)
+            {
+                auto out = std::shared_ptr<DataPool>(new DataPool);
+                out->_init(byteBudget, prefault);
+                return out;
+            }
+
+            const std::shared_ptr<DataPool>& DataPool::getGlobal()
+            {
+                static const std::shared_ptr<DataPool> pool = DataPool::create();
+                return pool;
+            }
+
+            size_t DataPool::getByteBudget() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return p.byteBudget;
+            }
+
+            void DataPool::setByteBudget(size_t value)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.byteBudget = value;
+                _evict(0);
+            }
+
+            bool DataPool::hasPrefault() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return p.prefault;
+            }
+
+            void DataPool::setPrefault(bool value)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.prefault = value;
+            }
+
+            DataPoolStats DataPool::getStats() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return p.stats;
+            }
+
+            size_t DataPool::getBucketByteCount(size_t value)
+            {
+                size_t out = value;
+                if (value >= dataPoolMinByteCount)
+                {
+                    const size_t alignment = value >= dataPoolHugePageByteCount ?
+                        dataPoolHugePageByteCount :
+                        dataPoolPageByteCount;
+                    out = (value + alignment - 1) / alignment * alignment;
+                }
+                return out;
+            }
+
+            uint8_t* DataPool::getBuffer(size_t byteCount)
+            {
+                if (byteCount < dataPoolMinByteCount)
+                {
+                    return new uint8_t[byteCount];
+                }
+                DJV_PRIVATE_PTR();
+                const size_t bucketByteCount = getBucketByteCount(byteCount);
+                bool prefault = false;
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    const auto i = p.buckets.find(bucketByteCount);
+                    if (i != p.buckets.end() && i->second.buffers.size())
+                    {
+                        uint8_t* out = i->second.buffers.back();
+                        i->second.buffers.pop_back();
+                        if (i->second.buffers.empty())
+                        {
+                            p.buckets.erase(i);
+                        }
+                        --p.stats.freeCount;
+                        p.stats.freeByteCount -= bucketByteCount;
+                        ++p.stats.hitCount;
+                        return out;
+                    }
+                    ++p.stats.missCount;
+                    prefault = p.prefault;
+                }
+                return _alloc(bucketByteCount, prefault);
+            }
+
+            void DataPool::releaseBuffer(uint8_t* value, size_t byteCount)
+            {
+                if (!value)
+                {
+                    return;
+                }
+                if (byteCount < dataPoolMinByteCount)
+                {
+                    delete[] value;
+                    return;
+                }
+                DJV_PRIVATE_PTR();
+                const size_t bucketByteCount = getBucketByteCount(byteCount);
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    if (bucketByteCount <= p.byteBudget)
+                    {
+                        _evict(bucketByteCount);
+                        auto& bucket = p.buckets[bucketByteCount];
+                        bucket.buffers.push_back(value);
+                        bucket.time = ++p.time;
+                        ++p.stats.freeCount;
+                        p.stats.freeByteCount += bucketByteCount;
+                        return;
+                    }
+                }
+                _free(value, bucketByteCount);
+            }
+
+            void DataPool::clear()
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                for (const auto& i : p.buckets)
+                {
+                    for (auto j : i.second.buffers)
+                    {
+                        _free(j, i.first);
+                    }
+                }
+                p.buckets.clear();
+                p.stats.freeCount = 0;
+                p.stats.freeByteCount = 0;
+            }
+
+            uint8_t* DataPool::_alloc(size_t bucketByteCount, bool prefault)
+            {
+                const size_t alignment = bucketByteCount >= dataPoolHugePageByteCount ?
+                    dataPoolHugePageByteCount :
+                    dataPoolPageByteCount;
+                void* out = nullptr;
+#if defined(DJV_PLATFORM_WINDOWS)
+                out = _aligned_malloc(bucketByteCount, alignment);
+#else // DJV_PLATFORM_WINDOWS
+                if (posix_memalign(&out, alignment, bucketByteCount) != 0)
+                {
+                    out = nullptr;
+                }
+#if defined(MADV_HUGEPAGE)
+                if (out && alignment == dataPoolHugePageByteCount)
+                {
+                    madvise(out, bucketByteCount, MADV_HUGEPAGE);
+                }
+#endif // MADV_HUGEPAGE
+#endif // DJV_PLATFORM_WINDOWS
+                if (!out)
+                {
+                    throw std::bad_alloc();
+                }
+                if (prefault)
+                {
+                    uint8_t* p = reinterpret_cast<uint8_t*>(out);
+                    for (size_t i = 0; i < bucketByteCount; i += dataPoolPageByteCount)
+                    {
+                        p[i] = 0;
+                    }
+                }
+                return reinterpret_cast<uint8_t*>(out);
+            }
+
+            void DataPool::_free(uint8_t* value, size_t)
+            {
+#if defined(DJV_PLATFORM_WINDOWS)
+                _aligned_free(value);
+#else // DJV_PLATFORM_WINDOWS
+                free(value);
+#endif // DJV_PLATFORM_WINDOWS
+            }
+
+            void DataPool::_evict(size_t byteCount)
+            {
+                // Free buffers from the least recently used buckets until the
+                // given number of bytes fits in the budget. The mutex must be
+                // locked by the caller.
+                DJV_PRIVATE_PTR();
+                while (p.stats.freeByteCount && p.stats.freeByteCount + byteCount > p.byteBudget)
+                {
+                    auto oldest = p.buckets.end();
+                    for (auto i = p.buckets.begin(); i != p.buckets.end(); ++i)
+                    {
+                        if (i->second.buffers.size() &&
+                            (oldest == p.buckets.end() || i->second.time < oldest->second.time))
+                        {
+                            oldest = i;
+                        }
+                    }
+                    if (oldest == p.buckets.end())
+                    {
+                        break;
+                    }
+                    const size_t bucketByteCount = oldest->first;
+                    _free(oldest->second.buffers.back(), bucketByteCount);
+                    oldest->second.buffers.pop_back();
+                    if (oldest->second.buffers.empty())
+                    {
+                        p.buckets.erase(oldest);
+                    }
+                    --p.stats.freeCount;
+                    p.stats.freeByteCount -= bucketByteCount;
+                    ++p.stats.evictCount;
+                }
+            }
+
+        } // namespace Image
+    } // namespace AV
+} // namespace djv
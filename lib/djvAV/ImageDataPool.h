@@ -0,0 +1,139 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvCore/Core.h>
+#include <djvCore/Memory.h>
+
+#include <memory>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            //! This constant provides the default image data pool byte budget.
+            const size_t dataPoolByteBudgetDefault = 256 * Core::Memory::megabyte;
+
+            //! This constant provides the smallest buffer managed by the image
+            //! data pool. Smaller buffers are allocated directly.
+            const size_t dataPoolMinByteCount = 64 * Core::Memory::kilobyte;
+
+            //! This constant provides the alignment of small pooled buffers.
+            const size_t dataPoolPageByteCount = 4 * Core::Memory::kilobyte;
+
+            //! This constant provides the alignment of large pooled buffers.
+            const size_t dataPoolHugePageByteCount = 2 * Core::Memory::megabyte;
+
+            //! This struct provides image data pool statistics.
+            struct DataPoolStats
+            {
+                size_t freeCount     = 0;
+                size_t freeByteCount = 0;
+                size_t hitCount      = 0;
+                size_t missCount     = 0;
+                size_t evictCount    = 0;
+
+                bool operator == (const DataPoolStats&) const;
+            };
+
+            //! This class provides a pool of image data buffers.
+            //!
+            //! Released buffers are kept in buckets by size so that they can be
+            //! re-used by images of the same size, which avoids allocating and
+            //! page faulting a new buffer for every decoded frame. The total size
+            //! of the released buffers is bounded by a byte budget, buffers are
+            //! evicted from the least recently used bucket first.
+            //!
+            //! Large buffers are aligned to huge page boundaries so the operating
+            //! system can back them with huge pages.
+            class DataPool
+            {
+                DJV_NON_COPYABLE(DataPool);
+                void _init(size_t byteBudget, bool prefault);
+                DataPool();
+
+            public:
+                ~DataPool();
+
+                //! Create a new image data pool.
+                static std::shared_ptr<DataPool> create(
+                    size_t byteBudget = dataPoolByteBudgetDefault,
+                    bool prefault = false);
+
+                //! Get the global image data pool used by Data::create().
+                static const std::shared_ptr<DataPool>& getGlobal();
+
+                //! \name Byte Budget
+                ///@{
+
+                size_t getByteBudget() const;
+                void setByteBudget(size_t);
+
+                ///@}
+
+                //! \name Pre-Fault
+                //! Touch the pages of newly allocated buffers so that the page
+                //! faults happen up front instead of when the buffer is filled.
+                ///@{
+
+                bool hasPrefault() const;
+                void setPrefault(bool);
+
+                ///@}
+
+                //! Get the pool statistics.
+                DataPoolStats getStats() const;
+
+                //! Get the size of the bucket used for the given byte count.
+                static size_t getBucketByteCount(size_t);
+
+                //! Get a buffer. The buffer contents are undefined.
+                uint8_t* getBuffer(size_t byteCount);
+
+                //! Return a buffer to the pool. The byte count must be the same
+                //! as the one used to get the buffer.
+                void releaseBuffer(uint8_t*, size_t byteCount);
+
+                //! Free all of the released buffers.
+                void clear();
+
+            private:
+                static uint8_t* _alloc(size_t bucketByteCount, bool prefault);
+                static void _free(uint8_t*, size_t bucketByteCount);
+                void _evict(size_t byteCount);
+
+                DJV_PRIVATE();
+            };
+
+        } // namespace Image
+    } // namespace AV
+} // namespace djv
@@ -32,6 +32,11 @@
 #include <djvAV/Color.h>
 #include <djvAV/ImageData.h>
 
+#include <djvCore/Math.h>
+#include <djvCore/ThreadPool.h>
+
+#include <limits>
+
 using namespace djv::Core;
 
 namespace djv
@@ -42,6 +47,9 @@ namespace djv
         {
             namespace
             {
+                //! \todo Should this be configurable?
+                const uint16_t yuvTaskScanlineCount = 64;
+
                 template<typename T, typename T2>
                 void getAverageColor(const uint8_t* data, uint16_t width, uint16_t height, uint8_t channels, uint8_t* out)
                 {
@@ -84,12 +92,140 @@ namespace djv
                     outP->b = average[2] / static_cast<float>(width * height);
                 }
 
+                //! This struct provides the values for converting YUV to RGB.
+                struct YUVMatrix
+                {
+                    YUVMatrix(YUVCoefficients coefficients, YUVRange range, uint8_t bitDepth)
+                    {
+                        float kr = 0.F;
+                        float kb = 0.F;
+                        switch (coefficients)
+                        {
+                        case YUVCoefficients::BT601:  kr = .299F;  kb = .114F;  break;
+                        case YUVCoefficients::BT709:  kr = .2126F; kb = .0722F; break;
+                        case YUVCoefficients::BT2020: kr = .2627F; kb = .0593F; break;
+                        default: break;
+                        }
+                        const float kg = 1.F - kr - kb;
+                        rv = 2.F * (1.F - kr);
+                        gu = -2.F * kb * (1.F - kb) / kg;
+                        gv = -2.F * kr * (1.F - kr) / kg;
+                        bu = 2.F * (1.F - kb);
+
+                        const float scale = static_cast<float>(1 << (bitDepth - 8));
+                        switch (range)
+                        {
+                        case YUVRange::Video:
+                            yOffset = 16.F * scale;
+                            yScale = 1.F / (219.F * scale);
+                            cScale = 1.F / (224.F * scale);
+                            break;
+                        case YUVRange::Full:
+                            yScale = 1.F / static_cast<float>((1 << bitDepth) - 1);
+                            cScale = yScale;
+                            break;
+                        default: break;
+                        }
+                        cOffset = 128.F * scale;
+                    }
+
+                    float yOffset = 0.F;
+                    float yScale  = 1.F;
+                    float cOffset = 0.F;
+                    float cScale  = 1.F;
+                    float rv      = 0.F;
+                    float gu      = 0.F;
+                    float gv      = 0.F;
+                    float bu      = 0.F;
+                };
+
+                template<typename T, typename T2>
+                void yuvToRGB(const Data& in, Data& out, uint16_t begin, uint16_t end)
+                {
+                    const Info& info = in.getInfo();
+                    const YUVMatrix m(info.yuvCoefficients, info.yuvRange, getBitDepth(info.type));
+                    const uint8_t shiftX = getChromaShiftX(info.type);
+                    const uint8_t shiftY = getChromaShiftY(info.type);
+                    const uint16_t w = info.size.w;
+                    const float outMax = static_cast<float>(std::numeric_limits<T2>::max());
+                    for (uint16_t y = begin; y < end; ++y)
+                    {
+                        const T* yP = reinterpret_cast<const T*>(in.getPlaneData(0, y));
+                        const T* uP = reinterpret_cast<const T*>(in.getPlaneData(1, y >> shiftY));
+                        const T* vP = reinterpret_cast<const T*>(in.getPlaneData(2, y >> shiftY));
+                        T2* outP = reinterpret_cast<T2*>(out.getData(y));
+                        for (uint16_t x = 0; x < w; ++x, outP += 3)
+                        {
+                            const float luma = (yP[x] - m.yOffset) * m.yScale;
+                            const float u = (uP[x >> shiftX] - m.cOffset) * m.cScale;
+                            const float v = (vP[x >> shiftX] - m.cOffset) * m.cScale;
+                            outP[0] = static_cast<T2>(Math::clamp(luma + m.rv * v, 0.F, 1.F) * outMax + .5F);
+                            outP[1] = static_cast<T2>(Math::clamp(luma + m.gu * u + m.gv * v, 0.F, 1.F) * outMax + .5F);
+                            outP[2] = static_cast<T2>(Math::clamp(luma + m.bu * u, 0.F, 1.F) * outMax + .5F);
+                        }
+                    }
+                }
+
             } // namespace
 
+            void convertYUV(const Data& in, Data& out, uint16_t begin, uint16_t end)
+            {
+                switch (getDataType(in.getType()))
+                {
+                case DataType::U8:  yuvToRGB<U8_T, U8_T>(in, out, begin, end); break;
+                case DataType::U10:
+                case DataType::U16: yuvToRGB<U16_T, U16_T>(in, out, begin, end); break;
+                default: break;
+                }
+            }
+
+            void convertYUV(const Data& in, Data& out)
+            {
+                convertYUV(in, out, 0, in.getHeight());
+            }
+
+            void convertYUV(const Data& in, Data& out, const std::shared_ptr<ThreadPool>& threadPool)
+            {
+                const uint16_t height = in.getHeight();
+                std::vector<std::future<void> > futures;
+                uint16_t y = 0;
+                if (threadPool)
+                {
+                    for (; height - y > yuvTaskScanlineCount; y += yuvTaskScanlineCount)
+                    {
+                        const uint16_t begin = y;
+                        const uint16_t end = y + yuvTaskScanlineCount;
+                        futures.push_back(threadPool->addTaskFuture<void>(
+                            [&in, &out, begin, end]
+                            {
+                                convertYUV(in, out, begin, end);
+                            }));
+                    }
+                }
+                convertYUV(in, out, y, height);
+                for (auto& i : futures)
+                {
+                    i.get();
+                }
+            }
+
+            std::shared_ptr<Data> convertYUV(const Data& in)
+            {
+                auto info = in.getInfo();
+                info.type = getRGBType(info.type);
+                auto out = Data::create(info);
+                convertYUV(in, *out);
+                return out;
+            }
+
             Color getAverageColor(const std::shared_ptr<Data>& data)
             {
                 Color out;
-                if (data && data->isValid())
+                if (data && data->isValid() && isYUVType(data->getType()))
+                {
+                    out = getAverageColor(convertYUV(*data));
+                }
+                else if (data && data->isValid())
                 {
                     const uint16_t w = data->getWidth();
                     const uint16_t h = data->getHeight();
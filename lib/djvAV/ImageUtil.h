@@ -31,10 +31,17 @@
 
 #include <djvAV/AV.h>
 
+#include <cstdint>
 #include <memory>
 
 namespace djv
 {
+    namespace Core
+    {
+        class ThreadPool;
+
+    } // namespace Core
+
     namespace AV
     {
         namespace Image
@@ -44,6 +51,24 @@ namespace djv
 
             Color getAverageColor(const std::shared_ptr<Data>&);
 
+            //! Convert planar YUV image data to RGB. The output data must have
+            //! the same size and layout as the input, and the type given by
+            //! getRGBType(). Only the scanlines from begin up to (but not
+            //! including) end are converted so that the work can be split
+            //! between threads.
+            void convertYUV(const Data& in, Data& out, uint16_t begin, uint16_t end);
+
+            //! Convert planar YUV image data to RGB.
+            void convertYUV(const Data& in, Data& out);
+
+            //! Convert planar YUV image data to RGB, splitting the scanlines
+            //! between the thread pool and the calling thread. This must not
+            //! be called from a task of the same thread pool.
+            void convertYUV(const Data& in, Data& out, const std::shared_ptr<Core::ThreadPool>&);
+
+            //! Create RGB image data from planar YUV image data.
+            std::shared_ptr<Data> convertYUV(const Data&);
+
         } // namespace Image
     } // namespace AV
 } // namespace djv
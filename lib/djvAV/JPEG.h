@@ -92,10 +92,11 @@ namespace djv
                 protected:
                     Info _readInfo(const std::string& fileName) override;
                     std::shared_ptr<Image::Image> _readImage(const std::string& fileName) override;
+                    std::shared_ptr<IDecoderSession> _createSession() override;
 
                 private:
-                    struct File;
-                    Info _open(const std::string&, const std::shared_ptr<File>&);
+                    class File;
+                    Info _open(const std::string&, File&, size_t proxy);
                 };
                 
                 //! This class provides the JPEG file writer.
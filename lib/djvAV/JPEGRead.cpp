@@ -45,7 +45,9 @@ namespace djv
         {
             namespace JPEG
             {
-                class Read::File
+                //! The file is also used as the decoder session, so the libjpeg
+                //! decompress object is created once and reused between frames.
+                class Read::File : public IDecoderSession
                 {
                     DJV_NON_COPYABLE(File);
 
@@ -55,7 +57,7 @@ namespace djv
                     }
 
                 public:
-                    ~File()
+                    ~File() override
                     {
                         if (jpegInit)
                         {
@@ -103,7 +105,7 @@ namespace djv
                 Info Read::_readInfo(const std::string& fileName)
                 {
                     auto f = File::create();
-                    return _open(fileName, f);
+                    return _open(fileName, *f, 0);
                 }
 
                 namespace
@@ -142,14 +144,24 @@ namespace djv
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string& fileName)
                 {
                     // Open the file.
-                    auto f = File::create();
-                    const auto info = _open(fileName, f);
+                    std::shared_ptr<File> localFile;
+                    File* f = static_cast<File*>(_getSession());
+                    if (!f)
+                    {
+                        localFile = File::create();
+                        f = localFile.get();
+                    }
+                    const auto info = _open(fileName, *f, _options.proxy);
 
                     // Read the file.
                     auto out = Image::Image::create(info.video[0].info);
                     out->setPluginName(pluginName);
                     for (uint16_t y = 0; y < info.video[0].info.size.h; ++y)
                     {
+                        if (_isCancelled())
+                        {
+                            return nullptr;
+                        }
                         if (!jpegScanline(&f->jpeg, out->getData(y), &f->jpegError))
                         {
                             throw FileSystem::Error(f->jpegError.messages.size() ?
@@ -163,6 +175,8 @@ namespace djv
                             f->jpegError.messages.back() :
                             _textSystem->getText(DJV_TEXT("error_file_close")));
                     }
+                    fclose(f->f);
+                    f->f = nullptr;
 
                     // Log any warnings.
                     for (const auto& i : f->jpegError.messages)
@@ -178,6 +192,11 @@ namespace djv
                     return out;
                 }
 
+                std::shared_ptr<IDecoderSession> Read::_createSession()
+                {
+                    return File::create();
+                }
+
                 namespace
                 {
                     bool jpegInit(
@@ -194,6 +213,7 @@ namespace djv
 
                     bool jpegOpen(
                         FILE*                   f,
+                        size_t                  proxy,
                         jpeg_decompress_struct* jpeg,
                         JPEGErrorStruct*        error)
                     {
@@ -207,6 +227,9 @@ namespace djv
                         {
                             return false;
                         }
+                        // Use the DCT scaling for proxies.
+                        jpeg->scale_num = 1;
+                        jpeg->scale_denom = 1 << std::min(proxy, proxyMax);
                         if (!jpeg_start_decompress(jpeg))
                         {
                             return false;
@@ -216,38 +239,53 @@ namespace djv
 
                 } // namespace
 
-                Info Read::_open(const std::string& fileName, const std::shared_ptr<File>& f)
+                Info Read::_open(const std::string& fileName, File& f, size_t proxy)
                 {
-                    f->jpeg.err = jpeg_std_error(&f->jpegError.pub);
-                    f->jpegError.pub.error_exit = djvJPEGError;
-                    f->jpegError.pub.emit_message = djvJPEGWarning;
-                    if (!jpegInit(&f->jpeg, &f->jpegError))
+                    if (!f.jpegInit)
                     {
-                        throw FileSystem::Error(f->jpegError.messages.size() ?
-                            f->jpegError.messages.back() :
-                            _textSystem->getText(DJV_TEXT("error_file_open")));
+                        f.jpeg.err = jpeg_std_error(&f.jpegError.pub);
+                        f.jpegError.pub.error_exit = djvJPEGError;
+                        f.jpegError.pub.emit_message = djvJPEGWarning;
+                        if (!jpegInit(&f.jpeg, &f.jpegError))
+                        {
+                            throw FileSystem::Error(f.jpegError.messages.size() ?
+                                f.jpegError.messages.back() :
+                                _textSystem->getText(DJV_TEXT("error_file_open")));
+                        }
+                        f.jpegInit = true;
+                    }
+                    else
+                    {
+                        // Reset the decompress object from the previous frame,
+                        // keeping its permanent allocations.
+                        jpeg_abort_decompress(&f.jpeg);
                     }
-                    f->jpegInit = true;
-                    f->f = FileSystem::fopen(fileName, "rb");
-                    if (!f->f)
+                    f.jpegError.messages.clear();
+                    if (f.f)
+                    {
+                        fclose(f.f);
+                        f.f = nullptr;
+                    }
+                    f.f = FileSystem::fopen(fileName, "rb");
+                    if (!f.f)
                     {
                         throw FileSystem::Error(_textSystem->getText(DJV_TEXT("error_file_open")));
                     }
-                    if (!jpegOpen(f->f, &f->jpeg, &f->jpegError))
+                    if (!jpegOpen(f.f, proxy, &f.jpeg, &f.jpegError))
                     {
-                        throw FileSystem::Error(f->jpegError.messages.size() ?
-                            f->jpegError.messages.back() :
+                        throw FileSystem::Error(f.jpegError.messages.size() ?
+                            f.jpegError.messages.back() :
                             _textSystem->getText(DJV_TEXT("error_file_open")));
                     }
 
-                    Image::Type imageType = Image::getIntType(f->jpeg.out_color_components, 8);
+                    Image::Type imageType = Image::getIntType(f.jpeg.out_color_components, 8);
                     if (Image::Type::None == imageType)
                     {
                         throw FileSystem::Error(_textSystem->getText(DJV_TEXT("error_unsupported_color_components")));
                     }
-                    auto info = Info(fileName, VideoInfo(Image::Info(f->jpeg.output_width, f->jpeg.output_height, imageType), _speed, _sequence));
+                    auto info = Info(fileName, VideoInfo(Image::Info(f.jpeg.output_width, f.jpeg.output_height, imageType), _speed, _sequence));
 
-                    const jpeg_saved_marker_ptr marker = f->jpeg.marker_list;
+                    const jpeg_saved_marker_ptr marker = f.jpeg.marker_list;
                     if (marker)
                     {
                         info.tags.setTag("Description", std::string((const char*)marker->data, marker->data_length));
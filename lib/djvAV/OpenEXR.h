@@ -153,7 +153,8 @@ namespace djv
                     float       dwaCompressionLevel = 45.F;
                 };
 
-                //! This class provides a memory-mapped input stream.
+                //! This class provides a memory-mapped input stream. If the file
+                //! cannot be mapped it is read normally.
                 class MemoryMappedIStream : public Imf::IStream
                 {
                     DJV_NON_COPYABLE(MemoryMappedIStream);
@@ -198,6 +199,7 @@ namespace djv
                 private:
                     struct File;
                     Info _open(const std::string &, File &);
+                    std::shared_ptr<Image::Image> _readTiles(const std::string &, const File &, const Image::Info &, const Core::BBox2i &);
 
                     DJV_PRIVATE();
                 };
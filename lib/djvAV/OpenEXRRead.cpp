@@ -37,6 +37,8 @@
 #include <ImfHeader.h>
 #include <ImfInputFile.h>
 #include <ImfRgbaYca.h>
+#include <ImfTileDescription.h>
+#include <ImfTiledInputFile.h>
 
 using namespace djv::Core;
 
@@ -48,13 +50,12 @@ namespace djv
         {
             namespace OpenEXR
             {
-#if defined(DJV_MMAP)
                 struct MemoryMappedIStream::Private
                 {
-                    FileSystem::FileIO  f;
-                    uint64_t            size    = 0;
-                    uint64_t            pos     = 0;
-                    char*               p       = nullptr;
+                    std::shared_ptr<FileSystem::FileIO> f;
+                    uint64_t    size    = 0;
+                    uint64_t    pos     = 0;
+                    const char* p       = nullptr;
                 };
 
                 MemoryMappedIStream::MemoryMappedIStream(const char fileName[]) :
@@ -62,9 +63,11 @@ namespace djv
                     _p(new Private)
                 {
                     DJV_PRIVATE_PTR();
-                    p.f.open(fileName, FileSystem::FileIO::Mode::Read);
-                    p.size = p.f.getSize();
-                    p.p = (char*)(p.f.mmapP());
+                    p.f = FileSystem::FileIO::create();
+                    p.f->setMemoryMapEnabled(true);
+                    p.f->open(fileName, FileSystem::FileIO::Mode::Read);
+                    p.size = p.f->getSize();
+                    p.p = reinterpret_cast<const char*>(p.f->mmapP());
                 }
 
                 MemoryMappedIStream::~MemoryMappedIStream()
@@ -72,7 +75,7 @@ namespace djv
 
                 bool MemoryMappedIStream::isMemoryMapped() const
                 {
-                    return true;
+                    return _p->p != nullptr;
                 }
 
                 char* MemoryMappedIStream::readMemoryMapped(int n)
@@ -82,9 +85,9 @@ namespace djv
                         throw FileSystem::Error("Error reading OpenEXR file.");
                     if (p.pos + n > p.size)
                         throw FileSystem::Error("Error reading OpenEXR file.");
-                    char* out = p.p + p.pos;
+                    const char* out = p.p + p.pos;
                     p.pos += n;
-                    return out;
+                    return const_cast<char*>(out);
                 }
 
                 bool MemoryMappedIStream::read(char c[], int n)
@@ -94,7 +97,14 @@ namespace djv
                         throw FileSystem::Error("Error reading OpenEXR file.");
                     if (p.pos + n > p.size)
                         throw FileSystem::Error("Error reading OpenEXR file.");
-                    memcpy(c, p.p + p.pos, n);
+                    if (p.p)
+                    {
+                        memcpy(c, p.p + p.pos, n);
+                    }
+                    else
+                    {
+                        p.f->read(c, n);
+                    }
                     p.pos += n;
                     return p.pos < p.size;
                 }
@@ -106,9 +116,21 @@ namespace djv
 
                 void MemoryMappedIStream::seekg(Imf::Int64 pos)
                 {
-                    _p->pos = pos;
+                    DJV_PRIVATE_PTR();
+                    p.pos = pos;
+                    if (!p.p)
+                    {
+                        p.f->setPos(pos);
+                    }
                 }
-#endif // DJV_MMAP
+
+                namespace
+                {
+                    //! The number of scanlines to read at a time, the read can
+                    //! be cancelled between each block.
+                    const int scanlineBlockSize = 256;
+
+                } // namespace
 
                 struct Read::File
                 {
@@ -164,15 +186,50 @@ namespace djv
                     File f;
                     Info info = _open(fileName, f);
                     Image::Info imageInfo = info.video[std::min(_options.layer, info.video.size() - 1)].info;
-                    std::shared_ptr<Image::Image> out = Image::Image::create(imageInfo);
+                    const BBox2i roi = _getROI();
+                    std::shared_ptr<Image::Image> out;
+
+                    // Read a mip or rip map level for proxies, or only the tiles
+                    // inside of the region of interest.
+                    if (f.fast &&
+                        f.f->header().hasTileDescription() &&
+                        (_options.proxy > 0 || roi.isValid()))
+                    {
+                        out = _readTiles(fileName, f, imageInfo, roi);
+                        if (out || _isCancelled())
+                        {
+                            if (out)
+                            {
+                                out->setPluginName(pluginName);
+                                out->setTags(info.tags);
+                            }
+                            return out;
+                        }
+                    }
+
+                    out = Image::Image::create(imageInfo);
                     out->setPluginName(pluginName);
                     out->setTags(info.tags);
                     const size_t channels = Image::getChannelCount(imageInfo.type);
                     const size_t channelByteCount = Image::getByteCount(getDataType(imageInfo.type));
                     const size_t cb = channels * channelByteCount;
                     const size_t scb = imageInfo.size.w * channels * channelByteCount;
+
+                    // Only read the scanlines inside of the region of interest.
+                    int yMin = f.displayWindow.min.y;
+                    int yMax = f.displayWindow.max.y;
+                    if (roi.isValid())
+                    {
+                        yMin = std::max(yMin, f.displayWindow.min.y + roi.min.y);
+                        yMax = std::min(yMax, f.displayWindow.min.y + roi.max.y);
+                    }
+
                     if (f.fast)
                     {
+                        if (roi.isValid())
+                        {
+                            out->zero();
+                        }
                         Imf::FrameBuffer frameBuffer;
                         for (size_t c = 0; c < channels; ++c)
                         {
@@ -190,7 +247,14 @@ namespace djv
                                     0.F));
                         }
                         f.f->setFrameBuffer(frameBuffer);
-                        f.f->readPixels(f.displayWindow.min.y, f.displayWindow.max.y);
+                        for (int y = yMin; y <= yMax; y += scanlineBlockSize)
+                        {
+                            if (_isCancelled())
+                            {
+                                return nullptr;
+                            }
+                            f.f->readPixels(y, std::min(y + scanlineBlockSize - 1, yMax));
+                        }
                     }
                     else
                     {
@@ -214,9 +278,14 @@ namespace djv
                         f.f->setFrameBuffer(frameBuffer);
                         for (int y = f.displayWindow.min.y; y <= f.displayWindow.max.y; ++y)
                         {
+                            if (_isCancelled())
+                            {
+                                return nullptr;
+                            }
                             uint8_t* p = out->getData() + ((y - f.displayWindow.min.y) * scb);
                             uint8_t* end = p + scb;
-                            if (y >= f.intersectedWindow.min.y && y <= f.intersectedWindow.max.y)
+                            if (y >= yMin && y <= yMax &&
+                                y >= f.intersectedWindow.min.y && y <= f.intersectedWindow.max.y)
                             {
                                 size_t size = (f.intersectedWindow.min.x - f.displayWindow.min.x) * cb;
                                 memset(p, 0, size);
@@ -235,6 +304,103 @@ namespace djv
                     return out;
                 }
 
+                std::shared_ptr<Image::Image> Read::_readTiles(
+                    const std::string& fileName,
+                    const File& f,
+                    const Image::Info& imageInfo,
+                    const BBox2i& roi)
+                {
+                    // Proxies need a mip or rip map level.
+                    const Imf::Header& header = f.f->header();
+                    const int level = static_cast<int>(std::min(_options.proxy, proxyMax));
+                    if (level > 0)
+                    {
+                        switch (header.tileDescription().mode)
+                        {
+                        case Imf::MIPMAP_LEVELS:
+                        case Imf::RIPMAP_LEVELS: break;
+                        default: return nullptr;
+                        }
+                    }
+                    std::unique_ptr<MemoryMappedIStream> s;
+                    std::unique_ptr<Imf::TiledInputFile> t;
+                    if (_options.memoryMap)
+                    {
+                        s.reset(new MemoryMappedIStream(fileName.c_str()));
+                        t.reset(new Imf::TiledInputFile(*s.get()));
+                    }
+                    else
+                    {
+                        t.reset(new Imf::TiledInputFile(fileName.c_str()));
+                    }
+                    if (level >= t->numXLevels() || level >= t->numYLevels())
+                    {
+                        return nullptr;
+                    }
+                    const Imath::Box2i dataWindow = t->dataWindowForLevel(level, level);
+                    auto levelInfo = imageInfo;
+                    levelInfo.size = getProxySize(imageInfo.size, _options.proxy);
+                    if (dataWindow.max.x - dataWindow.min.x + 1 != levelInfo.size.w ||
+                        dataWindow.max.y - dataWindow.min.y + 1 != levelInfo.size.h)
+                    {
+                        // The level is rounded differently than the proxy.
+                        return nullptr;
+                    }
+
+                    // Find the tiles to read.
+                    const int xTileSize = static_cast<int>(header.tileDescription().xSize);
+                    const int yTileSize = static_cast<int>(header.tileDescription().ySize);
+                    BBox2i tiles(0, 0, t->numXTiles(level), t->numYTiles(level));
+                    auto out = Image::Image::create(levelInfo);
+                    if (roi.isValid())
+                    {
+                        const BBox2i bbox = roi.intersect(BBox2i(0, 0, levelInfo.size.w, levelInfo.size.h));
+                        tiles.min.x = bbox.min.x / xTileSize;
+                        tiles.min.y = bbox.min.y / yTileSize;
+                        tiles.max.x = bbox.max.x / xTileSize;
+                        tiles.max.y = bbox.max.y / yTileSize;
+                        out->zero();
+                        if (bbox.w() <= 0 || bbox.h() <= 0)
+                        {
+                            return out;
+                        }
+                    }
+
+                    // Read the tiles.
+                    const size_t channels = Image::getChannelCount(levelInfo.type);
+                    const size_t channelByteCount = Image::getByteCount(getDataType(levelInfo.type));
+                    const size_t cb = channels * channelByteCount;
+                    const size_t scb = levelInfo.size.w * cb;
+                    const ptrdiff_t offset =
+                        static_cast<ptrdiff_t>(dataWindow.min.y) * static_cast<ptrdiff_t>(scb) +
+                        static_cast<ptrdiff_t>(dataWindow.min.x) * static_cast<ptrdiff_t>(cb);
+                    Imf::FrameBuffer frameBuffer;
+                    for (size_t c = 0; c < channels; ++c)
+                    {
+                        const std::string& name = f.layers[_options.layer].channels[c].name;
+                        frameBuffer.insert(
+                            name.c_str(),
+                            Imf::Slice(
+                                toImf(Image::getDataType(levelInfo.type)),
+                                (char*)out->getData() - offset + (c * channelByteCount),
+                                cb,
+                                scb,
+                                1,
+                                1,
+                                0.F));
+                    }
+                    t->setFrameBuffer(frameBuffer);
+                    for (int y = tiles.min.y; y <= tiles.max.y; ++y)
+                    {
+                        if (_isCancelled())
+                        {
+                            return nullptr;
+                        }
+                        t->readTiles(tiles.min.x, tiles.max.x, y, y, level, level);
+                    }
+                    return out;
+                }
+
                 Info Read::_open(const std::string & fileName, File & f)
                 {
                     DJV_PRIVATE_PTR();
@@ -242,12 +408,15 @@ namespace djv
                     Info out;
 
                     // Open the file.
-#if defined(DJV_MMAP)
-                    f.s.reset(new MemoryMappedIStream(fileName.c_str()));
-                    f.f.reset(new Imf::InputFile(*f.s.get()));
-#else // DJV_MMAP
-                    f.f.reset(new Imf::InputFile(fileName.c_str()));
-#endif // DJV_MMAP
+                    if (_options.memoryMap)
+                    {
+                        f.s.reset(new MemoryMappedIStream(fileName.c_str()));
+                        f.f.reset(new Imf::InputFile(*f.s.get()));
+                    }
+                    else
+                    {
+                        f.f.reset(new Imf::InputFile(fileName.c_str()));
+                    }
 
                     // Get the display and data windows.
                     f.displayWindow = fromImath(f.f->header().displayWindow());
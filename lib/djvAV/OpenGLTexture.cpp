@@ -29,6 +29,8 @@
 
 #include <djvAV/OpenGLTexture.h>
 
+#include <djvAV/ImageUtil.h>
+
 //#pragma optimize("", off)
 
 using namespace djv::Core;
@@ -39,6 +41,17 @@ namespace djv
     {
         namespace OpenGL
         {
+            namespace
+            {
+                Image::Info getRGBInfo(const Image::Info& info)
+                {
+                    Image::Info out = info;
+                    out.type = Image::getRGBType(info.type);
+                    return out;
+                }
+
+            } // namespace
+
             void Texture::_init(const Image::Info & info, GLenum filterMin, GLenum filterMag)
             {
                 _info = info;
@@ -46,12 +59,13 @@ namespace djv
                 _filterMag = filterMag;
                 if (_info.isValid())
                 {
+                    const Image::Info rgbInfo = getRGBInfo(_info);
 #if defined(DJV_OPENGL_PBO)
                     glGenBuffers(1, &_pbo);
                     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pbo);
                     glBufferData(
                         GL_PIXEL_UNPACK_BUFFER,
-                        info.getDataByteCount(),
+                        rgbInfo.getDataByteCount(),
                         0,
                         GL_STREAM_DRAW);
 #endif // DJV_OPENGL_PBO
@@ -65,12 +79,12 @@ namespace djv
                     glTexImage2D(
                         GL_TEXTURE_2D,
                         0,
-                        getInternalFormat(_info.type),
-                        _info.size.w,
-                        _info.size.h,
+                        getInternalFormat(rgbInfo.type),
+                        rgbInfo.size.w,
+                        rgbInfo.size.h,
                         0,
-                        _info.getGLFormat(),
-                        _info.getGLType(),
+                        rgbInfo.getGLFormat(),
+                        rgbInfo.getGLType(),
                         0);
                 }
             }
@@ -105,6 +119,7 @@ namespace djv
                 _info = info;
                 if (_info.isValid())
                 {
+                    const Image::Info rgbInfo = getRGBInfo(_info);
                     if (_id)
                     {
                         glDeleteTextures(1, &_id);
@@ -118,7 +133,7 @@ namespace djv
                     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pbo);
                     glBufferData(
                         GL_PIXEL_UNPACK_BUFFER,
-                        _info.getDataByteCount(),
+                        rgbInfo.getDataByteCount(),
                         0,
                         GL_STREAM_DRAW);
 #endif // DJV_OPENGL_PBO
@@ -132,18 +147,24 @@ namespace djv
                     glTexImage2D(
                         GL_TEXTURE_2D,
                         0,
-                        getInternalFormat(_info.type),
-                        _info.size.w,
-                        _info.size.h,
+                        getInternalFormat(rgbInfo.type),
+                        rgbInfo.size.w,
+                        rgbInfo.size.h,
                         0,
-                        _info.getGLFormat(),
-                        _info.getGLType(),
+                        rgbInfo.getGLFormat(),
+                        rgbInfo.getGLType(),
                         0);
                 }
             }
 
-            void Texture::copy(const Image::Data & data)
+            void Texture::setThreadPool(const std::shared_ptr<Core::ThreadPool>& value)
+            {
+                _threadPool = value;
+            }
+
+            void Texture::copy(const Image::Data & in)
             {
+                const auto & data = _getRGBData(in);
                 const auto & info = data.getInfo();
 #if defined(DJV_OPENGL_ES2)
                 glBindTexture(GL_TEXTURE_2D, _id);
@@ -193,8 +214,9 @@ namespace djv
 #endif // DJV_OPENGL_ES2
             }
 
-            void Texture::copy(const Image::Data & data, uint16_t x, uint16_t y)
+            void Texture::copy(const Image::Data & in, uint16_t x, uint16_t y)
             {
+                const auto & data = _getRGBData(in);
                 const auto & info = data.getInfo();
 
 #if defined(DJV_OPENGL_ES2)
@@ -279,7 +301,17 @@ namespace djv
                     GL_RGBA,
                     GL_RGBA,
                     GL_RGBA,
-                    GL_RGBA
+                    GL_RGBA,
+
+                    GL_RGB,
+                    GL_RGB,
+                    GL_RGB,
+                    GL_RGB,
+                    GL_RGB,
+                    GL_RGB,
+                    GL_RGB,
+                    GL_RGB,
+                    GL_RGB
 #else // DJV_OPENGL_ES2
                     GL_R8,
                     GL_R16,
@@ -304,13 +336,36 @@ namespace djv
                     GL_RGBA16,
                     GL_RGBA32I,
                     GL_RGBA16F,
-                    GL_RGBA32F
+                    GL_RGBA32F,
+
+                    GL_RGB8,
+                    GL_RGB8,
+                    GL_RGB8,
+                    GL_RGB16,
+                    GL_RGB16,
+                    GL_RGB16,
+                    GL_RGB16,
+                    GL_RGB16,
+                    GL_RGB16
 #endif // DJV_OPENGL_ES2
                 };
                 DJV_ASSERT(sizeof(data) / sizeof(data[0]) == static_cast<size_t>(Image::Type::Count));
                 return data[static_cast<size_t>(type)];
             }
 
+            const Image::Data& Texture::_getRGBData(const Image::Data& data)
+            {
+                if (!Image::isYUVType(data.getType()))
+                    return data;
+                const Image::Info rgbInfo = getRGBInfo(data.getInfo());
+                if (!_rgbData || _rgbData->getInfo() != rgbInfo)
+                {
+                    _rgbData = Image::Data::create(rgbInfo);
+                }
+                Image::convertYUV(data, *_rgbData, _threadPool);
+                return *_rgbData;
+            }
+
             /*void Texture1D::_init(const Image::Info& info, GLenum filter)
             {
                 _info = info;
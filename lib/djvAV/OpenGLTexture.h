@@ -34,11 +34,21 @@
 
 namespace djv
 {
+    namespace Core
+    {
+        class ThreadPool;
+
+    } // namespace Core
+
     namespace AV
     {
         namespace OpenGL
         {
             //! This class provides an OpenGL texture.
+            //!
+            //! Planar YUV images are stored as RGB textures, the image data is
+            //! converted when it is copied. The conversion is split across the
+            //! thread pool if one is set.
             class Texture
             {
                 DJV_NON_COPYABLE(Texture);
@@ -60,6 +70,7 @@ namespace djv
                 GLuint getID() const;
 
                 void set(const Image::Info&);
+                void setThreadPool(const std::shared_ptr<Core::ThreadPool>&);
                 void copy(const Image::Data&);
                 void copy(const Image::Data&, uint16_t x, uint16_t y);
 
@@ -68,7 +79,11 @@ namespace djv
                 static GLenum getInternalFormat(Image::Type);
 
             private:
+                const Image::Data& _getRGBData(const Image::Data&);
+
                 Image::Info _info;
+                std::shared_ptr<Image::Data> _rgbData;
+                std::shared_ptr<Core::ThreadPool> _threadPool;
                 GLenum _filterMin = GL_LINEAR;
                 GLenum _filterMag = GL_LINEAR;
                 GLuint _id = 0;
@@ -239,6 +239,10 @@ namespace djv
                     out->setPluginName(pluginName);
                     for (uint16_t y = 0; y < info.video[0].info.size.h; ++y)
                     {
+                        if (_isCancelled())
+                        {
+                            return nullptr;
+                        }
                         if (!pngScanline(f->png, out->getData(y)))
                         {
                             throw FileSystem::Error(f->pngError.messages.size() ?
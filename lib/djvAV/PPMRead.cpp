@@ -93,33 +93,51 @@ namespace djv
                     }
                     case Data::Binary:
                     {
-#if defined(DJV_MMAP)
-                        out = Image::Image::create(imageInfo, io);
-#else // DJV_MMAP
-                        bool convertEndian = false;
-                        if (imageInfo.layout.endian != Memory::getEndian())
+                        if (0 == _options.proxy && Image::Data::canMemoryMap(imageInfo, io))
                         {
-                            convertEndian = true;
-                            imageInfo.layout.endian = Memory::getEndian();
+                            // Reference the pixels in the file, the image keeps
+                            // the endian of the file.
+                            out = Image::Image::create(imageInfo, io);
+                            out->setPluginName(pluginName);
                         }
-                        out = Image::Image::create(imageInfo);
-                        out->setPluginName(pluginName);
-                        io->read(out->getData(), io->getSize() - io->getPos());
-                        if (convertEndian)
+                        else
                         {
-                            const size_t dataByteCount = out->getDataByteCount();
-                            switch (Image::getDataType(imageInfo.type))
+                            bool convertEndian = false;
+                            if (imageInfo.layout.endian != Memory::getEndian())
+                            {
+                                convertEndian = true;
+                                imageInfo.layout.endian = Memory::getEndian();
+                            }
+                            const BBox2i roi = _getROI();
+                            if (_options.proxy > 0)
+                            {
+                                out = readProxyImage(*io, imageInfo, _options.proxy);
+                            }
+                            else if (roi.isValid())
+                            {
+                                out = readROIImage(*io, imageInfo, roi);
+                            }
+                            else
+                            {
+                                out = Image::Image::create(imageInfo);
+                                io->read(out->getData(), io->getSize() - io->getPos());
+                            }
+                            out->setPluginName(pluginName);
+                            if (convertEndian)
                             {
-                                case Image::DataType::U10:
-                                    Memory::endian(out->getData(), dataByteCount / 4, 4);
-                                    break;
-                                case Image::DataType::U16:
-                                    Memory::endian(out->getData(), dataByteCount / 2, 2);
-                                    break;
-                                default: break;                            
+                                const size_t dataByteCount = out->getDataByteCount();
+                                switch (Image::getDataType(imageInfo.type))
+                                {
+                                    case Image::DataType::U10:
+                                        Memory::endian(out->getData(), dataByteCount / 4, 4);
+                                        break;
+                                    case Image::DataType::U16:
+                                        Memory::endian(out->getData(), dataByteCount / 2, 2);
+                                        break;
+                                    default: break;                            
+                                }
                             }
                         }
-#endif // DJV_MMAP
                         break;
                     }
                     default: break;
@@ -129,6 +147,7 @@ namespace djv
 
                 Info Read::_open(const std::string& fileName, const std::shared_ptr<FileSystem::FileIO>& io, Data& data)
                 {
+                    io->setMemoryMapEnabled(_options.memoryMap);
                     io->open(fileName, FileSystem::FileIO::Mode::Read);
 
                     char magic[] = { 0, 0, 0 };
@@ -591,7 +591,16 @@ namespace djv
         DJV_TEXT("av_image_type_rgba_u16"),
         DJV_TEXT("av_image_type_rgba_u32"),
         DJV_TEXT("av_image_type_rgba_f16"),
-        DJV_TEXT("av_image_type_rgba_f32"));
+        DJV_TEXT("av_image_type_rgba_f32"),
+        DJV_TEXT("av_image_type_yuv_420p_u8"),
+        DJV_TEXT("av_image_type_yuv_422p_u8"),
+        DJV_TEXT("av_image_type_yuv_444p_u8"),
+        DJV_TEXT("av_image_type_yuv_420p_u10"),
+        DJV_TEXT("av_image_type_yuv_422p_u10"),
+        DJV_TEXT("av_image_type_yuv_444p_u10"),
+        DJV_TEXT("av_image_type_yuv_420p_u16"),
+        DJV_TEXT("av_image_type_yuv_422p_u16"),
+        DJV_TEXT("av_image_type_yuv_444p_u16"));
 
     DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
         AV::Image,
@@ -613,6 +622,19 @@ namespace djv
         DJV_TEXT("av_data_type_f16"),
         DJV_TEXT("av_data_type_f32"));
 
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        AV::Image,
+        YUVCoefficients,
+        DJV_TEXT("av_yuv_coefficients_bt601"),
+        DJV_TEXT("av_yuv_coefficients_bt709"),
+        DJV_TEXT("av_yuv_coefficients_bt2020"));
+
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        AV::Image,
+        YUVRange,
+        DJV_TEXT("av_yuv_range_video"),
+        DJV_TEXT("av_yuv_range_full"));
+
     picojson::value toJSON(AV::Image::Type value)
     {
         std::stringstream ss;
@@ -76,6 +76,16 @@ namespace djv
                 RGBA_F16,
                 RGBA_F32,
 
+                YUV_420P_U8,
+                YUV_422P_U8,
+                YUV_444P_U8,
+                YUV_420P_U10,
+                YUV_422P_U10,
+                YUV_444P_U10,
+                YUV_420P_U16,
+                YUV_422P_U16,
+                YUV_444P_U16,
+
                 Count,
                 First = None
             };
@@ -111,6 +121,29 @@ namespace djv
             };
             DJV_ENUM_HELPERS(DataType);
 
+            //! This enumeration provides the YUV color coefficients.
+            enum class YUVCoefficients
+            {
+                BT601,
+                BT709,
+                BT2020,
+
+                Count,
+                First = BT601
+            };
+            DJV_ENUM_HELPERS(YUVCoefficients);
+
+            //! This enumeration provides the YUV value ranges.
+            enum class YUVRange
+            {
+                Video,
+                Full,
+
+                Count,
+                First = Video
+            };
+            DJV_ENUM_HELPERS(YUVRange);
+
             typedef uint8_t   U8_T;
             typedef uint16_t U10_T;
             typedef uint16_t U12_T;
@@ -165,6 +198,22 @@ namespace djv
             typedef U10_S_LSB U10_S;
 #endif
 
+            //! \name Planar YUV Types
+            //! The YUV types store the luma and chroma samples in three planes,
+            //! one after the other. The 10-bit samples are stored in the low
+            //! bits of 16-bit words. The YUV types are converted to RGB when
+            //! they are displayed or written, for those conversions they look
+            //! like the RGB type given by getRGBType(). The pixel byte count,
+            //! GL format, and GL type of a YUV type are those of the luma plane.
+            ///@{
+
+            bool isYUVType(Type);
+            uint8_t getChromaShiftX(Type);
+            uint8_t getChromaShiftY(Type);
+            Type getRGBType(Type);
+
+            ///@}
+
             Channels getChannels(Type);
             uint8_t getChannelCount(Type);
             DataType getDataType(Type);
@@ -233,6 +282,8 @@ namespace djv
     DJV_ENUM_SERIALIZE_HELPERS(AV::Image::Type);
     DJV_ENUM_SERIALIZE_HELPERS(AV::Image::Channels);
     DJV_ENUM_SERIALIZE_HELPERS(AV::Image::DataType);
+    DJV_ENUM_SERIALIZE_HELPERS(AV::Image::YUVCoefficients);
+    DJV_ENUM_SERIALIZE_HELPERS(AV::Image::YUVRange);
 
     picojson::value toJSON(AV::Image::Type);
 
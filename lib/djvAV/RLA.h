@@ -68,11 +68,11 @@ namespace djv
                 protected:
                     Info _readInfo(const std::string & fileName) override;
                     std::shared_ptr<Image::Image> _readImage(const std::string & fileName) override;
+                    std::shared_ptr<IDecoderSession> _createSession() override;
 
                 private:
-                    Info _open(const std::string &, const std::shared_ptr<Core::FileSystem::FileIO>&);
-
-                    std::vector<int32_t> _rleOffset;
+                    struct Session;
+                    Info _open(const std::string &, const std::shared_ptr<Core::FileSystem::FileIO>&, Session&);
                 };
 
                 //! This class provides the RLA file I/O plugin.
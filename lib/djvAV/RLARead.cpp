@@ -43,6 +43,12 @@ namespace djv
         {
             namespace RLA
             {
+                struct Read::Session : public IDecoderSession
+                {
+                    std::vector<int32_t> rleOffset;
+                    std::vector<uint8_t> buf;
+                };
+
                 Read::Read()
                 {}
 
@@ -66,7 +72,8 @@ namespace djv
                 Info Read::_readInfo(const std::string & fileName)
                 {
                     auto io = FileSystem::FileIO::create();
-                    return _open(fileName, io);
+                    Session session;
+                    return _open(fileName, io, session);
                 }
 
                 namespace
@@ -76,11 +83,11 @@ namespace djv
                         uint8_t* out,
                         size_t size,
                         size_t channels,
-                        size_t bytes)
+                        size_t bytes,
+                        std::vector<uint8_t>& buf)
                     {
                         int16_t _size = 0;
                         io->read16(&_size);
-                        std::vector<uint8_t> buf;
                         buf.resize(_size);
                         io->read(buf.data(), _size);
                         const uint8_t* p = buf.data();
@@ -118,11 +125,12 @@ namespace djv
                         const std::shared_ptr<FileSystem::FileIO>& io,
                         uint8_t* out,
                         size_t size,
-                        size_t channels)
+                        size_t channels,
+                        std::vector<uint8_t>& buf)
                     {
                         int16_t _size = 0;
                         io->read16(&_size);
-                        std::vector<uint8_t> buf(_size);
+                        buf.resize(_size);
                         io->read(buf.data(), _size);
                         const uint8_t* p = buf.data();
                         const size_t outInc = channels * 4;
@@ -152,9 +160,11 @@ namespace djv
 
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
                 {
+                    Session localSession;
+                    Session& session = _getSession() ? static_cast<Session&>(*_getSession()) : localSession;
                     std::shared_ptr<Image::Image> out;
                     auto io = FileSystem::FileIO::create();
-                    const auto info = _open(fileName, io);
+                    const auto info = _open(fileName, io, session);
                     out = Image::Image::create(info.video[0].info);
                     out->setPluginName(pluginName);
 
@@ -166,16 +176,20 @@ namespace djv
                     uint8_t* dataP = out->getData();
                     for (uint16_t y = 0; y < h; ++y, dataP += w * channels * bytes)
                     {
-                        io->setPos(_rleOffset[y]);
+                        if (_isCancelled())
+                        {
+                            return nullptr;
+                        }
+                        io->setPos(session.rleOffset[y]);
                         for (int c = 0; c < channels; ++c)
                         {
                             if (Image::DataType::F32 == dataType)
                             {
-                                readFloat(io, dataP + c * bytes, w, channels);
+                                readFloat(io, dataP + c * bytes, w, channels, session.buf);
                             }
                             else
                             {
-                                readRle(io, dataP + c * bytes, w, channels, bytes);
+                                readRle(io, dataP + c * bytes, w, channels, bytes, session.buf);
                             }
                         }
                     }
@@ -183,6 +197,11 @@ namespace djv
                     return out;
                 }
 
+                std::shared_ptr<IDecoderSession> Read::_createSession()
+                {
+                    return std::shared_ptr<IDecoderSession>(new Session);
+                }
+
                 namespace
                 {
                     struct Header
@@ -243,7 +262,7 @@ namespace djv
 
                 } // namespace
 
-                Info Read::_open(const std::string & fileName, const std::shared_ptr<FileSystem::FileIO>& io)
+                Info Read::_open(const std::string & fileName, const std::shared_ptr<FileSystem::FileIO>& io, Session& session)
                 {
                     // Open the file.
                     io->setEndianConversion(Memory::getEndian() != Memory::Endian::MSB);
@@ -260,8 +279,8 @@ namespace djv
                     const int h = header.active[3] - header.active[2] + 1;
 
                     // Read the scanline table.
-                    _rleOffset.resize(h);
-                    io->read32(_rleOffset.data(), h);
+                    session.rleOffset.resize(h);
+                    io->read32(session.rleOffset.data(), h);
 
                     // Get file information.
                     if (header.matteChannels > 1)
@@ -0,0 +1,233 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/ReadScheduler.h>
+
+#include <list>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            namespace
+            {
+                //! The maximum distance from the playhead before reads are
+                //! considered the same.
+                const uint64_t rankDistanceMax = 0xffffffff;
+
+                //! Frames behind the playhead are less important than frames
+                //! ahead of it.
+                const uint64_t rankBehindScale = 4;
+
+                struct Read
+                {
+                    UID reader = 0;
+                    Frame::Index frame = 0;
+                    ReadType type = ReadType::First;
+                    std::function<void(void)> task;
+                };
+
+            } // namespace
+
+            uint64_t getReadRank(const ReadState& state, Frame::Index frame, ReadType type)
+            {
+                const bool queue = ReadType::Queue == type;
+                uint64_t tier = 0;
+                if (state.active)
+                {
+                    tier = queue ? 0 : 2;
+                }
+                else if (state.visible)
+                {
+                    tier = queue ? 1 : 3;
+                }
+                else
+                {
+                    tier = queue ? 4 : 5;
+                }
+
+                Frame::Index offset = frame - state.frame;
+                if (Direction::Reverse == state.direction)
+                {
+                    offset = -offset;
+                }
+                uint64_t distance = 0;
+                if (offset >= 0)
+                {
+                    distance = static_cast<uint64_t>(offset);
+                }
+                else
+                {
+                    distance = static_cast<uint64_t>(-offset) * rankBehindScale;
+                    // The frame may also be ahead of the playhead when looping.
+                    const Frame::Index wrapped = static_cast<Frame::Index>(state.sequenceSize) + offset;
+                    if (wrapped >= 0)
+                    {
+                        distance = std::min(distance, static_cast<uint64_t>(wrapped));
+                    }
+                }
+
+                return tier * (rankDistanceMax + 1) + std::min(distance, rankDistanceMax);
+            }
+
+            struct ReadScheduler::Private
+            {
+                std::shared_ptr<ThreadPool> threadPool;
+                mutable std::mutex mutex;
+                std::map<UID, ReadState> readers;
+                std::list<Read> reads;
+            };
+
+            void ReadScheduler::_init(const std::shared_ptr<ThreadPool>& threadPool)
+            {
+                _p->threadPool = threadPool;
+            }
+
+            ReadScheduler::ReadScheduler() :
+                _p(new Private)
+            {}
+
+            ReadScheduler::~ReadScheduler()
+            {}
+
+            std::shared_ptr<ReadScheduler> ReadScheduler::create(const std::shared_ptr<ThreadPool>& threadPool)
+            {
+                auto out = std::shared_ptr<ReadScheduler>(new ReadScheduler);
+                out->_init(threadPool);
+                return out;
+            }
+
+            UID ReadScheduler::addReader()
+            {
+                DJV_PRIVATE_PTR();
+                const UID out = createUID();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.readers[out] = ReadState();
+                return out;
+            }
+
+            void ReadScheduler::removeReader(UID value)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.readers.find(value);
+                if (i != p.readers.end())
+                {
+                    p.readers.erase(i);
+                }
+            }
+
+            void ReadScheduler::setReadState(UID reader, const ReadState& value)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.readers.find(reader);
+                if (i != p.readers.end())
+                {
+                    i->second = value;
+                }
+            }
+
+            size_t ReadScheduler::getPendingCount() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return p.reads.size();
+            }
+
+            void ReadScheduler::_addRead(
+                UID reader,
+                Frame::Index frame,
+                ReadType type,
+                const std::function<void(void)>& task)
+            {
+                DJV_PRIVATE_PTR();
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    Read read;
+                    read.reader = reader;
+                    read.frame = frame;
+                    read.type = type;
+                    read.task = task;
+                    p.reads.push_back(std::move(read));
+                }
+
+                // Each read adds a task to the thread pool, but the task will
+                // run whichever read has the best rank at that time.
+                auto scheduler = shared_from_this();
+                p.threadPool->addTask(
+                    [scheduler]
+                    {
+                        scheduler->_runNext();
+                    },
+                    ReadType::Queue == type ? TaskPriority::High : TaskPriority::Low);
+            }
+
+            void ReadScheduler::_runNext()
+            {
+                DJV_PRIVATE_PTR();
+                std::function<void(void)> task;
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    auto best = p.reads.end();
+                    uint64_t bestRank = 0;
+                    for (auto i = p.reads.begin(); i != p.reads.end(); ++i)
+                    {
+                        ReadState state;
+                        const auto j = p.readers.find(i->reader);
+                        if (j != p.readers.end())
+                        {
+                            state = j->second;
+                        }
+                        const uint64_t rank = getReadRank(state, i->frame, i->type);
+                        if (best == p.reads.end() || rank < bestRank)
+                        {
+                            best = i;
+                            bestRank = rank;
+                        }
+                    }
+                    if (best != p.reads.end())
+                    {
+                        task = std::move(best->task);
+                        p.reads.erase(best);
+                    }
+                }
+                if (task)
+                {
+                    task();
+                }
+            }
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
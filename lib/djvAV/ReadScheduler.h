@@ -0,0 +1,146 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvAV/IO.h>
+
+#include <djvCore/ThreadPool.h>
+#include <djvCore/UID.h>
+
+#include <atomic>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            //! This enumeration provides the frame read types.
+            enum class ReadType
+            {
+                Queue,
+                Cache,
+
+                Count,
+                First = Queue
+            };
+
+            //! This class provides a token for cancelling frame reads. Reads
+            //! check the token cooperatively, so a read that has already
+            //! started will stop at the next scanline or tile.
+            class CancelToken
+            {
+                DJV_NON_COPYABLE(CancelToken);
+                CancelToken();
+
+            public:
+                //! Create a new cancel token.
+                static std::shared_ptr<CancelToken> create();
+
+                bool isCancelled() const;
+                void cancel();
+
+            private:
+                std::atomic<bool> _cancelled;
+            };
+
+            //! This class provides the scheduling state of a reader.
+            class ReadState
+            {
+            public:
+                ReadState();
+
+                Core::Frame::Index frame        = 0;
+                Direction          direction    = Direction::Forward;
+                size_t             sequenceSize = 0;
+                bool               active       = false;
+                bool               visible      = true;
+
+                bool operator == (const ReadState&) const;
+            };
+
+            //! Get the rank of a frame read, lower values are read first. Reads
+            //! are ordered by whether the media is active or visible, whether
+            //! the frame is for the queue or the cache, and then by the distance
+            //! from the playhead in the direction of playback.
+            uint64_t getReadRank(const ReadState&, Core::Frame::Index, ReadType);
+
+            //! This class provides a scheduler for frame reads across all of
+            //! the readers.
+            //!
+            //! Reads are not run in the order they are added, instead each time
+            //! a thread pool worker becomes available it runs the pending read
+            //! with the best rank.
+            class ReadScheduler : public std::enable_shared_from_this<ReadScheduler>
+            {
+                DJV_NON_COPYABLE(ReadScheduler);
+                void _init(const std::shared_ptr<Core::ThreadPool>&);
+                ReadScheduler();
+
+            public:
+                ~ReadScheduler();
+
+                //! Create a new read scheduler.
+                static std::shared_ptr<ReadScheduler> create(const std::shared_ptr<Core::ThreadPool>&);
+
+                //! \name Readers
+                ///@{
+
+                Core::UID addReader();
+                void removeReader(Core::UID);
+                void setReadState(Core::UID, const ReadState&);
+
+                ///@}
+
+                //! Get the number of pending reads.
+                size_t getPendingCount() const;
+
+                //! Add a read and get a future for the result. The optional
+                //! callback is called once the result is ready.
+                template<typename T>
+                std::future<T> addRead(
+                    Core::UID,
+                    Core::Frame::Index,
+                    ReadType,
+                    const std::function<T(void)>&,
+                    const std::function<void(void)>& callback = nullptr);
+
+            private:
+                void _addRead(Core::UID, Core::Frame::Index, ReadType, const std::function<void(void)>&);
+                void _runNext();
+
+                DJV_PRIVATE();
+            };
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
+
+#include <djvAV/ReadSchedulerInline.h>
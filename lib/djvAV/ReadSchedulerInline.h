@@ -0,0 +1,95 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            inline CancelToken::CancelToken() :
+                _cancelled(false)
+            {}
+
+            inline std::shared_ptr<CancelToken> CancelToken::create()
+            {
+                return std::shared_ptr<CancelToken>(new CancelToken);
+            }
+
+            inline bool CancelToken::isCancelled() const
+            {
+                return _cancelled;
+            }
+
+            inline void CancelToken::cancel()
+            {
+                _cancelled = true;
+            }
+
+            inline ReadState::ReadState()
+            {}
+
+            inline bool ReadState::operator == (const ReadState& other) const
+            {
+                return
+                    frame == other.frame &&
+                    direction == other.direction &&
+                    sequenceSize == other.sequenceSize &&
+                    active == other.active &&
+                    visible == other.visible;
+            }
+
+            template<typename T>
+            inline std::future<T> ReadScheduler::addRead(
+                Core::UID reader,
+                Core::Frame::Index frame,
+                ReadType type,
+                const std::function<T(void)>& value,
+                const std::function<void(void)>& callback)
+            {
+                auto task = std::make_shared<std::packaged_task<T(void)> >(value);
+                auto out = task->get_future();
+                _addRead(
+                    reader,
+                    frame,
+                    type,
+                    [task, callback]
+                    {
+                        (*task)();
+                        if (callback)
+                        {
+                            callback();
+                        }
+                    });
+                return out;
+            }
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
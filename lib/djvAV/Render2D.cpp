@@ -45,6 +45,7 @@
 #include <djvCore/LogSystem.h>
 #include <djvCore/Range.h>
 #include <djvCore/ResourceSystem.h>
+#include <djvCore/ThreadPool.h>
 #include <djvCore/Timer.h>
 
 #include <OpenColorIO/OpenColorIO.h>
@@ -69,6 +70,7 @@ namespace djv
                 const uint16_t textureAtlasSize       = 8192;
                 const size_t   dynamicTextureCount    = 16;
                 const size_t   dynamicTextureCacheMax = 16;
+                const size_t   yuvConvertThreadCount  = 4;
 #if !defined(DJV_OPENGL_ES2)
                 const size_t   lut3DSize              = 32;
                 const size_t   colorSpaceCacheMax     = 32;
@@ -494,6 +496,7 @@ namespace djv
                 std::map<UID, uint64_t>                             glyphTextureIDs;
                 std::vector<std::shared_ptr<OpenGL::Texture> >      dynamicTextures;
                 std::map<UID, std::shared_ptr<OpenGL::Texture> >    dynamicTextureCache;
+                std::shared_ptr<ThreadPool>                         threadPool;
 #if !defined(DJV_OPENGL_ES2)
                 std::map<OCIO::Convert, ColorSpaceData>             colorSpaceCache;
 #endif // DJV_OPENGL_ES2
@@ -532,6 +535,10 @@ namespace djv
 
                 addDependency(context->getSystemT<AV::GLFW::System>());
 
+                // Converting planar YUV images for the dynamic textures uses a
+                // separate thread pool so drawing never waits on the I/O tasks.
+                p.threadPool = ThreadPool::create(yuvConvertThreadCount);
+
                 GLint maxTextureUnits = 0;
                 GLint maxTextureSize = 0;
                 glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxTextureUnits);
@@ -1646,6 +1653,7 @@ namespace djv
                             else
                             {
                                 texture = OpenGL::Texture::create(image->getInfo(), GL_LINEAR, GL_NEAREST);
+                                texture->setThreadPool(threadPool);
                             }
                             texture->copy(*image);
                             dynamicTextureCache[uid] = texture;
@@ -67,13 +67,11 @@ namespace djv
                 protected:
                     Info _readInfo(const std::string & fileName) override;
                     std::shared_ptr<Image::Image> _readImage(const std::string & fileName) override;
+                    std::shared_ptr<IDecoderSession> _createSession() override;
 
                 private:
-                    Info _open(const std::string &, const std::shared_ptr<Core::FileSystem::FileIO>&);
-
-                    bool _compression = false;
-                    std::vector<uint32_t> _rleOffset;
-                    std::vector<uint32_t> _rleSize;
+                    struct Session;
+                    Info _open(const std::string &, const std::shared_ptr<Core::FileSystem::FileIO>&, Session&);
                 };
                 
                 //! This class provides the SGI file I/O plugin.
@@ -43,6 +43,15 @@ namespace djv
         {
             namespace SGI
             {
+                struct Read::Session : public IDecoderSession
+                {
+                    bool compression = false;
+                    std::vector<uint32_t> rleOffset;
+                    std::vector<uint32_t> rleSize;
+                    std::vector<uint8_t> rleData;
+                    std::shared_ptr<Image::Data> planar;
+                };
+
                 Read::Read()
                 {}
 
@@ -66,7 +75,8 @@ namespace djv
                 Info Read::_readInfo(const std::string & fileName)
                 {
                     auto io = FileSystem::FileIO::create();
-                    return _open(fileName, io);
+                    Session session;
+                    return _open(fileName, io, session);
                 }
 
                 namespace
@@ -161,9 +171,12 @@ namespace djv
                         return false;
                     }
 
+                    //! Interleave the image channels, taking every nth pixel for
+                    //! proxies.
                     void planarInterleave(
                         const std::shared_ptr<Image::Data>& in,
-                        std::shared_ptr<Image::Image>& out)
+                        std::shared_ptr<Image::Image>& out,
+                        size_t scale)
                     {
                         const size_t w = out->getWidth();
                         const size_t h = out->getHeight();
@@ -174,12 +187,12 @@ namespace djv
                         {
                             for (size_t y = 0; y < h; ++y)
                             {
-                                const uint8_t* inP = in->getData() + (c * in->getHeight() + y) * in->getWidth() * channelByteCount;
+                                const uint8_t* inP = in->getData() + (c * in->getHeight() + y * scale) * in->getWidth() * channelByteCount;
                                 uint8_t* outP = out->getData(0, y) + c * channelByteCount;
                                 for (
                                     size_t x = 0;
                                     x < w;
-                                    ++x, inP += channelByteCount,
+                                    ++x, inP += scale * channelByteCount,
                                     outP += pixelByteCount)
                                 {
                                     switch (channelByteCount)
@@ -213,24 +226,35 @@ namespace djv
 
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
                 {
+                    Session localSession;
+                    Session& session = _getSession() ? static_cast<Session&>(*_getSession()) : localSession;
                     std::shared_ptr<Image::Image> out;
                     auto io = FileSystem::FileIO::create();
-                    const auto info = _open(fileName, io);
-                    out = Image::Image::create(info.video[0].info);
+                    const auto info = _open(fileName, io, session);
+                    const Image::Info& imageInfo = info.video[0].info;
+                    auto proxyInfo = imageInfo;
+                    proxyInfo.size = getProxySize(imageInfo.size, _options.proxy);
+                    out = Image::Image::create(proxyInfo);
                     out->setPluginName(pluginName);
 
                     const size_t pos = io->getPos();
                     const size_t size = io->getSize() - pos;
-                    const Image::Info& imageInfo = info.video[0].info;
                     const size_t channels = Image::getChannelCount(imageInfo.type);
                     const size_t bytes = Image::getByteCount(Image::getDataType(imageInfo.type));
-                    const size_t dataByteCount = out->getDataByteCount();
-                    std::shared_ptr<Image::Data> tmp = Image::Data::create(imageInfo);
-                    if (!_compression)
+                    const size_t scale = static_cast<size_t>(1) << std::min(_options.proxy, proxyMax);
+
+                    // The planar data and the compressed data are read into
+                    // scratch buffers that are kept by the session.
+                    if (!session.planar || session.planar->getInfo() != imageInfo)
+                    {
+                        session.planar = Image::Data::create(imageInfo);
+                    }
+                    const auto& tmp = session.planar;
+                    if (!session.compression)
                     {
                         if (1 == bytes)
                         {
-                            io->readU8(tmp->getData(), dataByteCount);
+                            io->readU8(tmp->getData(), tmp->getDataByteCount());
                         }
                         else
                         {
@@ -239,17 +263,23 @@ namespace djv
                     }
                     else
                     {
-                        std::vector<uint8_t> rleData(size);
-                        io->read(rleData.data(), size / bytes, bytes);
-                        const uint8_t* inP = rleData.data();
+                        session.rleData.resize(size);
+                        io->read(session.rleData.data(), size / bytes, bytes);
+                        const uint8_t* inP = session.rleData.data();
                         const uint8_t* end = inP + size;
                         uint8_t* outP = tmp->getData();
                         for (size_t c = 0; c < channels; ++c)
                         {
                             for (size_t y = 0; y < imageInfo.size.h; ++y, outP += imageInfo.size.w * bytes)
                             {
+                                // Only the scanlines that are used by the proxy
+                                // are decompressed.
+                                if (y % scale != 0)
+                                {
+                                    continue;
+                                }
                                 if (!readRle(
-                                    inP + _rleOffset[y + imageInfo.size.h * c] - pos,
+                                    inP + session.rleOffset[y + imageInfo.size.h * c] - pos,
                                     end,
                                     outP,
                                     imageInfo.size.w,
@@ -263,11 +293,16 @@ namespace djv
                     }
 
                     // Interleave the image channels.
-                    planarInterleave(tmp, out);
+                    planarInterleave(tmp, out, scale);
 
                     return out;
                 }
 
+                std::shared_ptr<IDecoderSession> Read::_createSession()
+                {
+                    return std::shared_ptr<IDecoderSession>(new Session);
+                }
+
                 namespace
                 {
                     class Header
@@ -348,12 +383,21 @@ namespace djv
                 
                 } // namespace
 
-                Info Read::_open(const std::string & fileName, const std::shared_ptr<FileSystem::FileIO>& io)
+                Info Read::_open(const std::string & fileName, const std::shared_ptr<FileSystem::FileIO>& io, Session& session)
                 {
                     io->setEndianConversion(Memory::getEndian() != Memory::Endian::MSB);
                     io->open(fileName, FileSystem::FileIO::Mode::Read);
                     Image::Info imageInfo;
-                    Header().read(io, imageInfo, _compression, _textSystem);
+                    Header().read(io, imageInfo, session.compression, _textSystem);
+                    if (session.compression)
+                    {
+                        // Read the scanline offset and size tables.
+                        const size_t tableSize = imageInfo.size.h * Image::getChannelCount(imageInfo.type);
+                        session.rleOffset.resize(tableSize);
+                        session.rleSize.resize(tableSize);
+                        io->readU32(session.rleOffset.data(), tableSize);
+                        io->readU32(session.rleSize.data(), tableSize);
+                    }
                     auto info = Info(fileName, VideoInfo(imageInfo, _speed, _sequence));
                     return info;
                 }
@@ -29,23 +29,30 @@
 
 #include <djvAV/SequenceIO.h>
 
+#include <djvAV/CompressedImage.h>
+#include <djvAV/DiskCache.h>
+#include <djvAV/FrameCache.h>
 #include <djvAV/ImageConvert.h>
 
 #include <djvCore/Context.h>
 #include <djvCore/FileSystem.h>
 #include <djvCore/FileInfo.h>
+#include <djvCore/FilePrefetch.h>
 #include <djvCore/LogSystem.h>
 #include <djvCore/OS.h>
 #include <djvCore/Path.h>
 #include <djvCore/String.h>
 #include <djvCore/StringFormat.h>
 #include <djvCore/TextSystem.h>
+#include <djvCore/ThreadPool.h>
 #include <djvCore/Timer.h>
 
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
 #include <future>
+#include <list>
 
 using namespace djv::Core;
 
@@ -60,22 +67,66 @@ namespace djv
                 //! \todo Should this be configurable?
                 const double infoTimeout = 0.5;
 
+                //! The cancel token for the frame read running on this thread.
+                thread_local const CancelToken* currentCancelToken = nullptr;
+
+                //! The decoder session for the frame read running on this thread.
+                thread_local IDecoderSession* currentSession = nullptr;
+
+                //! The region of interest for the frame read running on this
+                //! thread.
+                thread_local const BBox2i* currentROI = nullptr;
+
             } // namespace
 
+            IDecoderSession::~IDecoderSession()
+            {}
+
             struct ISequenceRead::Future
             {
                 Frame::Number frame = Frame::invalid;
                 std::shared_ptr<Image::Image> image;
+
+                //! Frames read with a region of interest and frames decompressed
+                //! from the compressed tier are not added to the cache. Adding a
+                //! decompressed frame would only evict another frame to compress.
+                bool cache = true;
             };
 
             struct ISequenceRead::Private
             {
+                //! This struct provides a frame on its way to the video queue.
+                struct QueueItem
+                {
+                    Frame::Number frame = Frame::invalid;
+                    std::shared_ptr<Image::Image> image;
+                    std::future<Future> future;
+                };
+
+                //! This struct provides a frame compressed for the compressed
+                //! tier of the cache.
+                struct CompressResult
+                {
+                    Frame::Number frame = Frame::invalid;
+                    std::shared_ptr<CompressedImage> compressed;
+                };
+
                 Frame::Number frame = Frame::invalid;
                 std::promise<Info> infoPromise;
+                std::list<QueueItem> queueItems;
                 std::vector<std::future<Future> > cacheFutures;
-                std::condition_variable queueCV;
+                std::vector<std::future<CompressResult> > compressFutures;
+                std::shared_ptr<CancelToken> compressCancelToken;
+                std::mutex sessionMutex;
+                std::vector<std::shared_ptr<IDecoderSession> > sessions;
                 Direction direction = Direction::Forward;
                 Frame::Number seek = Frame::invalid;
+                std::shared_ptr<CancelToken> cancelToken;
+                std::shared_ptr<ReadScheduler> readScheduler;
+                UID readerUID = 0;
+                std::shared_ptr<FileSystem::FilePrefetch> filePrefetch;
+                std::vector<std::string> prefetchFileNames;
+                Image::Size proxySize;
                 std::thread thread;
                 std::atomic<bool> running;
                 std::chrono::steady_clock::time_point infoTimer;
@@ -89,9 +140,16 @@ namespace djv
                 const std::shared_ptr<LogSystem>& logSystem)
             {
                 IRead::_init(fileInfo, options, textSystem, resourceSystem, logSystem);
+                DJV_PRIVATE_PTR();
                 _speed = Time::Speed();
-                _p->running = true;
-                _p->thread = std::thread(
+                p.readScheduler = options.readScheduler ? options.readScheduler : ReadScheduler::create(_threadPool);
+                p.readerUID = p.readScheduler->addReader();
+                p.filePrefetch = FileSystem::FilePrefetch::getGlobal();
+                p.cancelToken = CancelToken::create();
+                p.compressCancelToken = CancelToken::create();
+                _cache.setCompressEnabled(true);
+                p.running = true;
+                p.thread = std::thread(
                     [this]
                 {
                     DJV_PRIVATE_PTR();
@@ -121,6 +179,17 @@ namespace djv
                     {
                         info = _readInfo(fileName);
                         info.fileName = _fileInfo.getFileName();
+                        if (_options.proxy > 0)
+                        {
+                            for (auto& i : info.video)
+                            {
+                                i.info.size = getProxySize(i.info.size, _options.proxy);
+                            }
+                            if (_options.layer < info.video.size())
+                            {
+                                p.proxySize = info.video[_options.layer].info.size;
+                            }
+                        }
                         p.infoPromise.set_value(info);
                     }
                     catch (const std::exception&)
@@ -143,7 +212,8 @@ namespace djv
 
                     // Start looping...
                     p.infoTimer = std::chrono::steady_clock::now();
-                    const auto timeout = Time::getValue(Time::TimerValue::VeryFast);
+                    bool infoDirty = false;
+                    const auto timeout = Time::getTime(Time::TimerValue::Slow);
                     while (p.running)
                     {
                         // Update the options.
@@ -151,24 +221,45 @@ namespace djv
                         bool playback = false;
                         bool loop = false;
                         InOutPoints inOutPoints;
+                        ReadState readState;
                         bool cacheEnabled = false;
                         size_t cacheMaxByteCount = 0;
+                        BBox2i roi;
+                        std::shared_ptr<CancelToken> cancelToken;
                         {
                             std::lock_guard<std::mutex> lock(_mutex);
                             threadCount = _threadCount;
                             playback = _playback;
                             loop = _loop;
                             inOutPoints = _inOutPoints;
+                            readState.active = _active;
+                            readState.visible = _visible;
                             cacheEnabled = _cacheEnabled;
                             cacheMaxByteCount = _cacheMaxByteCount;
+                            if (0 == _options.proxy)
+                            {
+                                roi = _roi;
+                            }
+                            cancelToken = p.cancelToken;
                         }
+                        const size_t oldCacheCount = _cache.getCount();
+                        const size_t oldCompressedCount = _cache.getCompressedCount();
+                        const Frame::Sequence oldCacheSequence = _cache.getSequence();
+                        _cache.removeEvicted();
                         if (!cacheEnabled)
                         {
                             _cache.clear();
                         }
+                        size_t dataByteCount = 0;
                         if (info.video.size() && _options.layer < info.video.size())
                         {
-                            const size_t dataByteCount = info.video[_options.layer].info.getDataByteCount();
+                            // The frames of a sequence can differ in size, so the
+                            // window is sized from the frames that have been
+                            // cached. The information is only used until then.
+                            const size_t cacheCount = _cache.getCount();
+                            dataByteCount = cacheCount ?
+                                (_cache.getTotalByteCount() / cacheCount) :
+                                info.video[_options.layer].info.getDataByteCount();
                             _cache.setMax(dataByteCount ? (cacheMaxByteCount / dataByteCount) : 0);
                             _cache.setSequenceSize(info.video[_options.layer].sequence.getSize());
                             _cache.setInOutPoints(inOutPoints);
@@ -178,35 +269,36 @@ namespace djv
                             _cache.setMax(0);
                         }
 
-                        // Check to see if there is work to be done.
+                        // Check for seeks and changes of direction.
                         size_t queueCount = 0;
                         Frame::Number seek = Frame::invalid;
+                        bool clearQueue = false;
                         {
-                            std::unique_lock<std::mutex> lock(_mutex);
-                            if (p.queueCV.wait_for(
-                                lock,
-                                std::chrono::milliseconds(timeout),
-                                [this]
-                                {
-                                    return _hasWork();
-                                }))
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            if (p.direction != _direction)
+                            {
+                                p.direction = _direction;
+                                _videoQueue.setFinished(false);
+                                _videoQueue.clearFrames();
+                                clearQueue = true;
+                            }
+                            if (p.seek != Frame::invalid)
+                            {
+                                seek = p.seek;
+                                p.seek = Frame::invalid;
+                                _videoQueue.setFinished(false);
+                                _videoQueue.clearFrames();
+                                clearQueue = true;
+                            }
+                            if (!_videoQueue.isFinished())
                             {
                                 queueCount = _getQueueCount(playback ? (threadCount / 2) : 1);
-                                if (p.direction != _direction)
-                                {
-                                    p.direction = _direction;
-                                    _videoQueue.setFinished(false);
-                                    _videoQueue.clearFrames();
-                                }
-                                if (p.seek != Frame::invalid)
-                                {
-                                    seek = p.seek;
-                                    p.seek = Frame::invalid;
-                                    _videoQueue.setFinished(false);
-                                    _videoQueue.clearFrames();
-                                }
                             }
                         }
+                        if (clearQueue)
+                        {
+                            _clearQueue();
+                        }
                         if (seek != Frame::invalid)
                         {
                             p.frame = seek;
@@ -217,25 +309,54 @@ namespace djv
                             }*/
                         }
 
+                        // Update the scheduling state.
+                        readState.frame = p.frame != Frame::invalid ? p.frame : 0;
+                        readState.direction = p.direction;
+                        readState.sequenceSize = sequenceSize;
+                        p.readScheduler->setReadState(p.readerUID, readState);
+                        _cache.setReadState(readState);
+
                         // Fill the queue.
-                        size_t read = 0;
+                        size_t work = 0;
                         if (queueCount > 0)
                         {
-                            read = _readQueue(queueCount, loop, cacheEnabled);
+                            work += _readQueue(queueCount, loop, cacheEnabled, roi, cancelToken);
                         }
 
                         // Fill the cache.
                         if (cacheEnabled)
                         {
-                            _readCache(playback ? (threadCount / 2) : threadCount, inOutPoints);
+                            work += _readCache(
+                                playback ? (threadCount / 2) : threadCount,
+                                inOutPoints,
+                                dataByteCount,
+                                cancelToken);
+                        }
+
+                        // Compress the frames evicted from the cache.
+                        work += _compressFrames();
+
+                        // Prefetch the files for the reads that were started so
+                        // they are in memory by the time the reads run.
+                        if (p.prefetchFileNames.size())
+                        {
+                            p.filePrefetch->add(p.prefetchFileNames);
+                            p.prefetchFileNames.clear();
                         }
 
+                        infoDirty |=
+                            work > 0 ||
+                            _cache.getCount() != oldCacheCount ||
+                            _cache.getCompressedCount() != oldCompressedCount ||
+                            _cache.getSequence() != oldCacheSequence;
+
                         // Update information.
                         const auto now = std::chrono::steady_clock::now();
                         std::chrono::duration<double> delta = now - p.infoTimer;
-                        if (delta.count() > infoTimeout)
+                        if (infoDirty && delta.count() > infoTimeout)
                         {
                             p.infoTimer = now;
+                            infoDirty = false;
                             size_t cacheByteCount = _cache.getTotalByteCount();
                             auto cacheSequence = _cache.getSequence();
                             auto cachedFrames = _cache.getFrames();
@@ -246,8 +367,50 @@ namespace djv
                                 _cachedFrames = std::move(cachedFrames);
                             }
                         }
+
+                        // Sleep until there is more work. The thread is woken
+                        // when a read finishes, a frame is removed from the
+                        // queue, or the options change. If the information is
+                        // out of date only sleep until it is due.
+                        if (0 == work && p.running)
+                        {
+                            auto waitTimeout = timeout;
+                            if (infoDirty)
+                            {
+                                const auto infoDue = std::chrono::duration_cast<Time::Unit>(
+                                    std::chrono::duration<double>(infoTimeout) - delta);
+                                waitTimeout = std::max(std::min(waitTimeout, infoDue), Time::Unit(0));
+                            }
+                            _wait(waitTimeout);
+                        }
                     }
 
+                    // Wait for any outstanding cache reads since they reference
+                    // this object.
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        p.cancelToken->cancel();
+                    }
+                    _clearQueue();
+                    for (auto& i : p.cacheFutures)
+                    {
+                        if (i.valid())
+                        {
+                            i.wait();
+                        }
+                    }
+                    p.cacheFutures.clear();
+                    p.compressCancelToken->cancel();
+                    for (auto& i : p.compressFutures)
+                    {
+                        if (i.valid())
+                        {
+                            i.wait();
+                        }
+                    }
+                    p.compressFutures.clear();
+                    p.readScheduler->removeReader(p.readerUID);
+
                     p.running = false;
                 });
             }
@@ -276,14 +439,20 @@ namespace djv
                     std::lock_guard<std::mutex> lock(_mutex);
                     p.seek = value;
                     _direction = direction;
+
+                    // Cancel any reads that are in flight, they will be stale
+                    // after the seek.
+                    p.cancelToken->cancel();
+                    p.cancelToken = CancelToken::create();
                 }
-                p.queueCV.notify_one();
+                _notify();
             }
 
             void ISequenceRead::_finish()
             {
                 DJV_PRIVATE_PTR();
                 p.running = false;
+                _notify();
                 if (p.thread.joinable())
                 {
                     //! \todo How do we safely detach the thread here so we don't block?
@@ -291,34 +460,119 @@ namespace djv
                 }
             }
 
-            bool ISequenceRead::_hasWork() const
+            bool ISequenceRead::_isCancelled() const
+            {
+                return currentCancelToken && currentCancelToken->isCancelled();
+            }
+
+            std::shared_ptr<IDecoderSession> ISequenceRead::_createSession()
+            {
+                return nullptr;
+            }
+
+            IDecoderSession* ISequenceRead::_getSession() const
             {
-                const bool queue = (_videoQueue.getCount() < _videoQueue.getMax()) && !_videoQueue.isFinished();
-                const bool seek = _p->seek != Frame::invalid;
-                const bool direction = _p->direction != _direction;
-                return queue || seek || direction;
+                return currentSession;
+            }
+
+            BBox2i ISequenceRead::_getROI() const
+            {
+                return currentROI ? *currentROI : BBox2i();
             }
 
             size_t ISequenceRead::_getQueueCount(size_t threadCount) const
             {
-                const size_t queueMax = _videoQueue.getMax() - _videoQueue.getCount();
+                const size_t max = _videoQueue.getMax();
+                const size_t count = _videoQueue.getCount();
+                const size_t queueMax = count < max ? (max - count) : 0;
                 return std::min(queueMax, threadCount);
             }
 
-            std::future<ISequenceRead::Future> ISequenceRead::_getFuture(Frame::Number i, std::string fileName)
+            std::future<ISequenceRead::Future> ISequenceRead::_getFuture(
+                Frame::Number i,
+                std::string fileName,
+                ReadType type,
+                const BBox2i& roi,
+                const std::shared_ptr<CancelToken>& cancelToken)
             {
-                return std::async(
-                    std::launch::async,
-                    [this, i, fileName]
+                DJV_PRIVATE_PTR();
+                p.prefetchFileNames.push_back(fileName);
+                return p.readScheduler->addRead<Future>(
+                    p.readerUID,
+                    i,
+                    type,
+                    [this, i, fileName, roi, cancelToken]
                     {
+                        DJV_PRIVATE_PTR();
                         Future out;
                         out.frame = i;
+                        out.cache = !roi.isValid();
+                        if (cancelToken->isCancelled())
+                        {
+                            return out;
+                        }
+
+                        // Look for the frame in the disk cache before reading the
+                        // file. Only whole frames are kept in the disk cache.
+                        const bool diskCache = out.cache && _options.diskCache && _options.diskCache->isEnabled();
+                        DiskCacheKey diskCacheKey;
+                        if (diskCache)
+                        {
+                            const FileSystem::FileInfo fileInfo(fileName);
+                            diskCacheKey = DiskCacheKey(
+                                fileName,
+                                fileInfo.getTime(),
+                                fileInfo.getSize(),
+                                _options.layer,
+                                _options.proxy);
+                            out.image = _options.diskCache->read(diskCacheKey);
+                            if (out.image)
+                            {
+                                return out;
+                            }
+                        }
+
+                        currentCancelToken = cancelToken.get();
+                        currentROI = roi.isValid() ? &roi : nullptr;
+                        std::shared_ptr<IDecoderSession> session;
                         try
                         {
+                            // Borrow a decoder session from the pool or create
+                            // a new one.
+                            {
+                                std::lock_guard<std::mutex> lock(p.sessionMutex);
+                                if (p.sessions.size())
+                                {
+                                    session = p.sessions.back();
+                                    p.sessions.pop_back();
+                                }
+                            }
+                            if (!session)
+                            {
+                                session = _createSession();
+                            }
+                            currentSession = session.get();
+
                             out.image = _readImage(fileName);
+                            if (cancelToken->isCancelled())
+                            {
+                                out.image.reset();
+                            }
+                            else if (out.image && p.proxySize.isValid() && out.image->getSize() != p.proxySize)
+                            {
+                                // The plugin does not support proxies natively.
+                                out.image = resizeProxyImage(out.image, p.proxySize);
+                            }
+                            if (diskCache && out.image)
+                            {
+                                _options.diskCache->write(diskCacheKey, out.image);
+                            }
                         }
                         catch (const std::exception& e)
                         {
+                            // The session may be in a bad state so it is not
+                            // returned to the pool.
+                            session.reset();
                             _logSystem->log(
                                 "djv::AV::ISequenceRead",
                                 String::Format("'{0}': {1}").
@@ -326,42 +580,108 @@ namespace djv
                                     arg(e.what()),
                                 LogLevel::Error);
                         }
+                        currentSession = nullptr;
+                        currentCancelToken = nullptr;
+                        currentROI = nullptr;
+                        if (session)
+                        {
+                            std::lock_guard<std::mutex> lock(p.sessionMutex);
+                            p.sessions.push_back(session);
+                        }
                         return out;
-                    });
+                    },
+                    _getNotifyCallback());
             }
 
-            size_t ISequenceRead::_readQueue(size_t count, bool loop, bool cacheEnabled)
+            std::future<ISequenceRead::Future> ISequenceRead::_getDecompressFuture(
+                Frame::Number i,
+                const std::shared_ptr<CompressedImage>& compressed,
+                ReadType type,
+                const std::shared_ptr<CancelToken>& cancelToken)
+            {
+                DJV_PRIVATE_PTR();
+                return p.readScheduler->addRead<Future>(
+                    p.readerUID,
+                    i,
+                    type,
+                    [this, i, compressed, cancelToken]
+                    {
+                        Future out;
+                        out.frame = i;
+                        out.cache = false;
+                        if (cancelToken->isCancelled())
+                        {
+                            return out;
+                        }
+                        try
+                        {
+                            const auto start = std::chrono::steady_clock::now();
+                            out.image = compressed->decompress();
+                            if (_options.frameCache)
+                            {
+                                const std::chrono::duration<float> delta = std::chrono::steady_clock::now() - start;
+                                _options.frameCache->addDecompress(compressed->getDataByteCount(), delta.count());
+                            }
+                        }
+                        catch (const std::exception& e)
+                        {
+                            _logSystem->log(
+                                "djv::AV::ISequenceRead",
+                                String::Format("'{0}': {1}").
+                                    arg(_fileInfo.getFileName()).
+                                    arg(e.what()),
+                                LogLevel::Error);
+                        }
+                        return out;
+                    },
+                    _getNotifyCallback());
+            }
+
+            size_t ISequenceRead::_readQueue(
+                size_t count,
+                bool loop,
+                bool cacheEnabled,
+                const BBox2i& roi,
+                const std::shared_ptr<CancelToken>& cancelToken)
             {
                 DJV_PRIVATE_PTR();
 
-                // Get frames to be added to the queue.
+                // Start reading frames until there are enough in flight.
                 const size_t sequenceSize = _sequence.getSize();
-                std::vector<std::pair<Frame::Number, std::shared_ptr<Image::Image> > > images;
-                std::vector<std::future<Future> > futures;
-                for (size_t i = 0; i < count; ++i)
+                size_t out = 0;
+                while (p.queueItems.size() < count)
                 {
-                    std::shared_ptr<Image::Image> cachedImage;
-                    if (cacheEnabled && _cache.get(p.frame, cachedImage))
+                    if (sequenceSize)
                     {
-                        images.push_back(std::make_pair(p.frame, cachedImage));
+                        if (Frame::invalid == p.frame || p.frame < 0 || p.frame >= static_cast<Frame::Number>(sequenceSize))
+                        {
+                            break;
+                        }
                     }
-                    else
+                    else if (p.queueItems.size())
                     {
-                        if (sequenceSize)
+                        break;
+                    }
+
+                    Private::QueueItem item;
+                    item.frame = p.frame;
+                    if (!(cacheEnabled && _cache.get(p.frame, item.image)))
+                    {
+                        std::shared_ptr<CompressedImage> compressed;
+                        if (cacheEnabled && _cache.getCompressed(p.frame, compressed))
                         {
-                            if (p.frame >= 0 && p.frame < sequenceSize)
-                            {
-                                const Frame::Number frameNumber = _sequence.getFrame(p.frame);
-                                const std::string fileName = _fileInfo.getFileName(frameNumber);
-                                futures.push_back(_getFuture(p.frame, fileName));
-                            }
+                            item.future = _getDecompressFuture(p.frame, compressed, ReadType::Queue, cancelToken);
                         }
                         else
                         {
-                            const std::string fileName = _fileInfo.getFileName();
-                            futures.push_back(_getFuture(p.frame, fileName));
+                            const std::string fileName = sequenceSize ?
+                                _fileInfo.getFileName(_sequence.getFrame(p.frame)) :
+                                _fileInfo.getFileName();
+                            item.future = _getFuture(p.frame, fileName, ReadType::Queue, roi, cancelToken);
                         }
+                        ++out;
                     }
+                    p.queueItems.push_back(std::move(item));
 
                     if (sequenceSize)
                     {
@@ -386,57 +706,78 @@ namespace djv
                     }
                 }
 
-                // Get the results.
-                for (auto& future : futures)
+                // Move frames into the queue as soon as they are ready. Frames
+                // that finish out of order wait here until the frames in front
+                // of them are done, so the queue stays sequential.
+                while (p.queueItems.size() && !cancelToken->isCancelled())
                 {
-                    const auto result = future.get();
-                    if (result.image)
+                    auto& item = p.queueItems.front();
+                    if (item.future.valid())
                     {
-                        images.push_back(std::make_pair(result.frame, result.image));
-                        if (cacheEnabled)
+                        if (item.future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
                         {
-#if defined(DJV_MMAP)
-                            result.image->detach();
-#endif // DJV_MMAP
-                            _cache.add(result.frame, result.image);
+                            break;
+                        }
+                        const auto result = item.future.get();
+                        item.image = result.image;
+                        if (item.image && cacheEnabled && result.cache)
+                        {
+                            // Memory mapped images are cached without copying
+                            // them, they only hold on to the file mapping.
+                            _cache.add(item.frame, item.image);
                         }
                     }
-                }
-
-                // Add the frames to the queue.
-                {
-                    std::lock_guard<std::mutex> lock(_mutex);
-                    for (const auto& i : images)
+                    if (item.image)
                     {
                         if (_videoQueue.getCount() >= _videoQueue.getMax())
                         {
                             break;
                         }
-                        _videoQueue.addFrame(VideoFrame(i.first, i.second));
+                        _videoQueue.addFrame(VideoFrame(item.frame, item.image));
                     }
+                    p.queueItems.pop_front();
+                    ++out;
                 }
 
-                if (Frame::invalid == p.frame || p.frame < 0 || p.frame >= static_cast<Frame::Number>(sequenceSize))
+                if (p.queueItems.empty() &&
+                    (Frame::invalid == p.frame || p.frame < 0 || p.frame >= static_cast<Frame::Number>(sequenceSize)))
                 {
                     std::lock_guard<std::mutex> lock(_mutex);
                     _videoQueue.setFinished(true);
                 }
 
-                return futures.size();
+                return out;
             }
 
-            void ISequenceRead::_readCache(size_t count, const AV::IO::InOutPoints& inOutPoints)
+            void ISequenceRead::_clearQueue()
             {
                 DJV_PRIVATE_PTR();
+                // The reads may still be running so they are moved to the
+                // cache futures, which keeps any frames that were finished.
+                for (auto& i : p.queueItems)
+                {
+                    if (i.future.valid())
+                    {
+                        p.cacheFutures.push_back(std::move(i.future));
+                    }
+                }
+                p.queueItems.clear();
+            }
+
+            size_t ISequenceRead::_readCache(
+                size_t count,
+                const AV::IO::InOutPoints& inOutPoints,
+                size_t byteCount,
+                const std::shared_ptr<CancelToken>& cancelToken)
+            {
+                DJV_PRIVATE_PTR();
+                size_t out = 0;
 
                 // Get frames to be added to the cache.
                 Frame::Number frame = Frame::invalid;
+                if (_videoQueue.getCount())
                 {
-                    std::lock_guard<std::mutex> lock(_mutex);
-                    if (_videoQueue.getCount())
-                    {
-                        frame = _videoQueue.getFrame().frame;
-                    }
+                    frame = _videoQueue.getFrame().frame;
                 }
                 if (count > 0 && frame != Frame::invalid)
                 {
@@ -460,10 +801,17 @@ namespace djv
                         const size_t max = std::min(_cache.getMax(), sequenceSize);
                         for (size_t i = 0; i < max && p.cacheFutures.size() < count; ++i)
                         {
-                            if (!_cache.contains(frame))
+                            if (!_cache.contains(frame) && _cache.canAdd(frame, byteCount))
                             {
                                 const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
-                                p.cacheFutures.push_back(_getFuture(frame, fileName));
+                                p.cacheFutures.push_back(_getFuture(frame, fileName, ReadType::Cache, BBox2i(), cancelToken));
+                                ++out;
+                            }
+                            else if (i >= readBehind && !_cache.contains(frame))
+                            {
+                                // The frames further ahead of the playhead will
+                                // not fit in the frame cache either.
+                                break;
                             }
                             ++frame;
                             if (frame > range.max)
@@ -486,10 +834,17 @@ namespace djv
                         const size_t max = std::min(_cache.getMax(), sequenceSize);
                         for (Frame::Number i = 0; i < max && p.cacheFutures.size() < count; ++i)
                         {
-                            if (!_cache.contains(frame))
+                            if (!_cache.contains(frame) && _cache.canAdd(frame, byteCount))
                             {
                                 const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
-                                p.cacheFutures.push_back(_getFuture(frame, fileName));
+                                p.cacheFutures.push_back(_getFuture(frame, fileName, ReadType::Cache, BBox2i(), cancelToken));
+                                ++out;
+                            }
+                            else if (i >= readBehind && !_cache.contains(frame))
+                            {
+                                // The frames further ahead of the playhead will
+                                // not fit in the frame cache either.
+                                break;
                             }
                             --frame;
                             if (frame < range.min)
@@ -511,20 +866,95 @@ namespace djv
                         i->wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                     {
                         const auto result = i->get();
-                        if (result.image)
+                        if (result.image && result.cache)
                         {
-#if defined(DJV_MMAP)
-                            result.image->detach();
-#endif // DJV_MMAP
                             _cache.add(result.frame, result.image);
                         }
                         i = p.cacheFutures.erase(i);
+                        ++out;
                     }
                     else
                     {
                         ++i;
                     }
                 }
+                return out;
+            }
+
+            size_t ISequenceRead::_compressFrames()
+            {
+                DJV_PRIVATE_PTR();
+                size_t out = 0;
+
+                // Start compressing the frames that were evicted from the cache.
+                // The compression runs with the cache reads since the frames are
+                // not needed right away.
+                for (const auto& i : _cache.getCompressible())
+                {
+                    const Frame::Number frame = i.first;
+                    const auto image = i.second;
+                    const auto cancelToken = p.compressCancelToken;
+                    p.compressFutures.push_back(p.readScheduler->addRead<Private::CompressResult>(
+                        p.readerUID,
+                        frame,
+                        ReadType::Cache,
+                        [this, frame, image, cancelToken]
+                        {
+                            Private::CompressResult out;
+                            out.frame = frame;
+                            if (!cancelToken->isCancelled())
+                            {
+                                try
+                                {
+                                    out.compressed = CompressedImage::create(image);
+                                }
+                                catch (const std::exception& e)
+                                {
+                                    _logSystem->log(
+                                        "djv::AV::ISequenceRead",
+                                        String::Format("'{0}': {1}").
+                                            arg(_fileInfo.getFileName()).
+                                            arg(e.what()),
+                                        LogLevel::Error);
+                                }
+                            }
+                            return out;
+                        },
+                        _getNotifyCallback()));
+                    ++out;
+                }
+
+                // Get the results.
+                auto i = p.compressFutures.begin();
+                while (i != p.compressFutures.end())
+                {
+                    if (i->valid() &&
+                        i->wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    {
+                        const auto result = i->get();
+                        if (result.compressed)
+                        {
+                            _cache.addCompressed(result.frame, result.compressed);
+                        }
+                        i = p.compressFutures.erase(i);
+                        ++out;
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+                return out;
+            }
+
+            float SequenceWriteStats::getConvertThroughput() const
+            {
+                return convertTime > 0.F ? (convertCount / convertTime) : 0.F;
+            }
+
+            float SequenceWriteStats::getWriteThroughput() const
+            {
+                return writeTime > 0.F ? (writeCount / writeTime) : 0.F;
             }
 
             struct ISequenceWrite::Private
@@ -535,6 +965,8 @@ namespace djv
                 std::shared_ptr<Image::Convert> convert;
                 std::thread thread;
                 std::atomic<bool> running;
+                mutable std::mutex statsMutex;
+                SequenceWriteStats stats;
             };
 
             void ISequenceWrite::_init(
@@ -566,27 +998,37 @@ namespace djv
                     }
                 }
 
+                // Create a hidden window for the OpenGL context, unless the
+                // images are converted on the CPU. If the window can't be
+                // created fall back to the CPU.
+                if (options.convertBackend != Image::ConvertBackend::CPU)
+                {
 #if defined(DJV_OPENGL_ES2)
-                glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+                    glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
+                    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
+                    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
 #else // DJV_OPENGL_ES2
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
-                glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-                glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+                    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+                    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+                    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+                    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 #endif // DJV_OPENGL_ES2
-                glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
-                if (OS::getIntEnv("DJV_OPENGL_DEBUG") != 0)
-                {
-                    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
-                }
-                p.glfwWindow = glfwCreateWindow(100, 100, "djv::IO::ISequenceWrite", NULL, NULL);
-                if (!p.glfwWindow)
-                {
-                    std::stringstream ss;
-                    ss << _textSystem->getText(DJV_TEXT("error_glfw_window_creation"));
-                    throw FileSystem::Error(ss.str());
+                    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+                    if (OS::getIntEnv("DJV_OPENGL_DEBUG") != 0)
+                    {
+                        glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
+                    }
+                    p.glfwWindow = glfwCreateWindow(100, 100, "djv::IO::ISequenceWrite", NULL, NULL);
+                    if (!p.glfwWindow)
+                    {
+                        std::stringstream ss;
+                        ss << _textSystem->getText(DJV_TEXT("error_glfw_window_creation"));
+                        if (Image::ConvertBackend::OpenGL == options.convertBackend)
+                        {
+                            throw FileSystem::Error(ss.str());
+                        }
+                        _logSystem->log("djv::AV::ISequenceWrite", ss.str(), LogLevel::Warning);
+                    }
                 }
 
                 p.running = true;
@@ -596,62 +1038,104 @@ namespace djv
                     DJV_PRIVATE_PTR();
                     try
                     {
-                        glfwMakeContextCurrent(p.glfwWindow);
+                        if (p.glfwWindow)
+                        {
+                            glfwMakeContextCurrent(p.glfwWindow);
 #if defined(DJV_OPENGL_ES2)
-                        if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
+                            if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
 #else
-                        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+                            if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
 #endif
-                        {
-                            std::stringstream ss;
-                            ss << _textSystem->getText(DJV_TEXT("error_glad_init"));
-                            throw FileSystem::Error(ss.str());
+                            {
+                                std::stringstream ss;
+                                ss << _textSystem->getText(DJV_TEXT("error_glad_init"));
+                                throw FileSystem::Error(ss.str());
+                            }
                         }
 
-                        p.convert = Image::Convert::create(_resourceSystem);
+                        p.convert = Image::Convert::create(
+                            _resourceSystem,
+                            p.glfwWindow ? Image::ConvertBackend::OpenGL : Image::ConvertBackend::CPU,
+                            _threadPool);
 
-                        const auto timeout = Time::getValue(Time::TimerValue::VeryFast);
+                        // The frames flow through a pipeline: the frames are
+                        // taken from the queue and converted on this thread,
+                        // since the OpenGL context is current on this thread,
+                        // then encoded and written by the thread pool. Up to
+                        // _threadCount frames are written at the same time,
+                        // and the writes are retired in sequence order.
+                        struct Future
+                        {
+                            std::string fileName;
+                            bool error = false;
+                            std::string errorString;
+                            float time = 0.F;
+                        };
+                        std::list<std::future<Future> > futures;
+                        auto retire = [this](const Future& result)
+                        {
+                            DJV_PRIVATE_PTR();
+                            if (result.error)
+                            {
+                                const std::string error = String::Format("'{0}': {1}").
+                                    arg(result.fileName).
+                                    arg(result.errorString);
+                                _logSystem->log("djv::AV::ISequenceWrite", error, LogLevel::Error);
+                                _setError(error);
+                                p.running = false;
+                            }
+                            std::lock_guard<std::mutex> lock(p.statsMutex);
+                            ++p.stats.writeCount;
+                            p.stats.writeTime += result.time;
+                        };
+                        auto notifyCallback = _getNotifyCallback();
+                        const auto timeout = Time::getTime(Time::TimerValue::Slow);
                         while (p.running)
                         {
-                            std::vector<std::shared_ptr<Image::Image> > images;
+                            bool work = false;
+                            size_t threadCount = 0;
                             {
-                                std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
-                                if (lock.owns_lock())
+                                std::lock_guard<std::mutex> lock(_mutex);
+                                threadCount = _threadCount;
+                            }
+
+                            // Retire the finished writes.
+                            while (futures.size() &&
+                                futures.front().valid() &&
+                                futures.front().wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                            {
+                                retire(futures.front().get());
+                                futures.pop_front();
+                                work = true;
+                            }
+
+                            // Convert the next frame and start writing it.
+                            std::shared_ptr<Image::Image> image;
+                            const bool full = futures.size() >= std::max(threadCount, static_cast<size_t>(1));
+                            if (p.running && !full)
+                            {
+                                std::lock_guard<std::mutex> lock(_mutex);
+                                if (!_videoQueue.isEmpty())
                                 {
-                                    while (!_videoQueue.isEmpty() && images.size() < _threadCount)
-                                    {
-                                        auto frame = _videoQueue.popFrame();
-                                        images.push_back(frame.image);
-                                    }
-                                    if (_videoQueue.isEmpty() && _videoQueue.isFinished())
-                                    {
-                                        p.running = false;
-                                    }
+                                    image = _videoQueue.popFrame().image;
+                                }
+                                else if (_videoQueue.isFinished() && futures.empty())
+                                {
+                                    p.running = false;
                                 }
                             }
-                            if (images.size())
+                            std::string fileName;
+                            if (image)
                             {
-                                struct Future
+                                work = true;
+                                fileName = p.fileInfo.getFileName(p.frameNumber);
+                                if (p.frameNumber != Frame::invalid)
                                 {
-                                    std::string fileName;
-                                    bool error = false;
-                                    std::string errorString;
-                                };
-                                std::vector<std::future<Future> > futures;
-                                for (size_t i = 0; i < images.size(); ++i)
+                                    ++p.frameNumber;
+                                }
+                                try
                                 {
-                                    const auto fileName = p.fileInfo.getFileName(p.frameNumber);
-                                    /*{
-                                        std::stringstream ss;
-                                        ss << "Writing: " << fileName;
-                                        _logSystem->log("djv::AV::IO::ISequenceWrite", ss.str());
-                                    }*/
-                                    if (p.frameNumber != Frame::invalid)
-                                    {
-                                        ++p.frameNumber;
-                                    }
-                                    auto image = images[i];
-                                    const Image::Type imageType = _getImageType(image->getType());
+                                    const Image::Type imageType = _getImageType(Image::getRGBType(image->getType()));
                                     if (Image::Type::None == imageType)
                                     {
                                         throw FileSystem::Error(String::Format("'{0}': {1}").
@@ -661,56 +1145,92 @@ namespace djv
                                     const Image::Layout imageLayout = _getImageLayout();
                                     if (imageType != image->getType() || imageLayout != image->getLayout())
                                     {
+                                        const auto start = std::chrono::steady_clock::now();
                                         const Image::Info info(image->getSize(), imageType, imageLayout);
                                         auto tmp = Image::Image::create(info);
                                         tmp->setTags(image->getTags());
                                         p.convert->process(*image, info, *tmp);
                                         image = tmp;
+                                        const std::chrono::duration<float> delta = std::chrono::steady_clock::now() - start;
+                                        std::lock_guard<std::mutex> lock(p.statsMutex);
+                                        ++p.stats.convertCount;
+                                        p.stats.convertTime += delta.count();
                                     }
-                                    futures.push_back(std::async(
-                                        std::launch::async,
-                                        [this, fileName, image]
-                                        {
-                                            Future out;
-                                            out.fileName = fileName;
-                                            try
-                                            {
-                                                _write(fileName, image);
-                                            }
-                                            catch (const std::exception& e)
-                                            {
-                                                out.error = true;
-                                                out.errorString = e.what();
-                                            }
-                                            return out;
-                                        }));
                                 }
-                                for (auto& future : futures)
+                                catch (const std::exception& e)
                                 {
-                                    const auto result = future.get();
-                                    if (result.error)
+                                    _logSystem->log("djv::AV::ISequenceWrite", e.what(), LogLevel::Error);
+                                    _setError(e.what());
+                                    image.reset();
+                                    p.running = false;
+                                }
+                            }
+                            if (image)
+                            {
+                                futures.push_back(_threadPool->addTaskFuture<Future>(
+                                    [this, fileName, image, notifyCallback]
                                     {
-                                        _logSystem->log(
-                                            "djv::AV::ISequenceWrite",
-                                            String::Format("'{0}': {1}").
-                                                arg(result.fileName).
-                                                arg(result.errorString),
-                                            LogLevel::Error);
-                                        p.running = false;
-                                    }
+                                        Future out;
+                                        out.fileName = fileName;
+                                        const auto start = std::chrono::steady_clock::now();
+                                        try
+                                        {
+                                            _write(fileName, image);
+                                        }
+                                        catch (const std::exception& e)
+                                        {
+                                            out.error = true;
+                                            out.errorString = e.what();
+                                        }
+                                        const std::chrono::duration<float> delta = std::chrono::steady_clock::now() - start;
+                                        out.time = delta.count();
+                                        notifyCallback();
+                                        return out;
+                                    }));
+                            }
+
+                            if (!work && p.running)
+                            {
+                                // Sleep until a frame is added to the queue, a
+                                // write finishes, or the queue is finished.
+                                const auto start = std::chrono::steady_clock::now();
+                                _wait(timeout);
+                                if (full)
+                                {
+                                    const std::chrono::duration<float> delta = std::chrono::steady_clock::now() - start;
+                                    std::lock_guard<std::mutex> lock(p.statsMutex);
+                                    p.stats.stallTime += delta.count();
                                 }
                             }
-                            else
+                        }
+
+                        // Wait for the writes that are still running.
+                        for (auto& future : futures)
+                        {
+                            if (future.valid())
                             {
-                                std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+                                retire(future.get());
                             }
                         }
+                        futures.clear();
+
+                        {
+                            const auto stats = getStats();
+                            std::stringstream ss;
+                            ss << "'" << p.fileInfo.getFileName() << "' converted frames: " << stats.convertCount <<
+                                ", convert frames per second: " << stats.getConvertThroughput() <<
+                                ", written frames: " << stats.writeCount <<
+                                ", write frames per second per thread: " << stats.getWriteThroughput() <<
+                                ", stalled seconds: " << stats.stallTime;
+                            _logSystem->log("djv::AV::ISequenceWrite", ss.str());
+                        }
 
                         p.convert.reset();
                     }
                     catch (const std::exception & e)
                     {
                         _logSystem->log("djv::AV::ISequenceWrite", e.what(), LogLevel::Error);
+                        _setError(e.what());
                     }
 
                     p.running = false;
@@ -729,6 +1249,13 @@ namespace djv
                 return _p->running;
             }
 
+            SequenceWriteStats ISequenceWrite::getStats() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.statsMutex);
+                return p.stats;
+            }
+
             Image::Type ISequenceWrite::_getImageType(Image::Type value) const
             {
                 return value;
@@ -743,6 +1270,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.running = false;
+                _notify();
                 if (p.thread.joinable())
                 {
                     //! \todo How do we safely detach the thread here so we don't block?
@@ -30,8 +30,10 @@
 #pragma once
 
 #include <djvAV/IO.h>
+#include <djvAV/ReadScheduler.h>
 
 #include <djvCore/Frame.h>
+#include <djvCore/ThreadPool.h>
 
 namespace djv
 {
@@ -39,6 +41,17 @@ namespace djv
     {
         namespace IO
         {
+            //! This class provides the base class for decoder sessions.
+            //!
+            //! A decoder session holds state that can be reused between frames,
+            //! like parsed headers, library decoder objects, and scratch
+            //! buffers. A session is only used by one thread at a time.
+            class IDecoderSession
+            {
+            public:
+                virtual ~IDecoderSession() = 0;
+            };
+
             //! This class provides an interface for reading sequences.
             class ISequenceRead : public IRead
             {
@@ -66,21 +79,86 @@ namespace djv
                 virtual std::shared_ptr<Image::Image> _readImage(const std::string & fileName) = 0;
                 void _finish();
 
+                //! Get whether the current frame read has been cancelled by a
+                //! seek or a change of direction. Implementations of
+                //! _readImage() should check this between scanlines or tiles
+                //! and return a null image if it is set.
+                bool _isCancelled() const;
+
+                //! Create a decoder session. Sessions are created as needed,
+                //! one for each frame read running at the same time, and are
+                //! reused for later frames. A session is discarded if
+                //! _readImage() throws. The default implementation returns null.
+                virtual std::shared_ptr<IDecoderSession> _createSession();
+
+                //! Get the decoder session for the current frame read. This
+                //! returns null outside of _readImage() or if the plugin does
+                //! not use sessions.
+                IDecoderSession* _getSession() const;
+
+                //! Get the region of interest for the current frame read.
+                //! Implementations of _readImage() may only read the pixels
+                //! inside of the region and set the others to zero. An invalid
+                //! region means the whole frame is read.
+                Core::BBox2i _getROI() const;
+
                 Core::Time::Speed _speed;
                 Core::Frame::Sequence _sequence;
 
             private:
-                bool _hasWork() const;
                 size_t _getQueueCount(size_t threadCount) const;
                 struct Future;
-                std::future<Future> _getFuture(Core::Frame::Number, std::string fileName);
-                size_t _readQueue(size_t count, bool loop, bool cacheEnabled);
-                void _readCache(size_t count, const AV::IO::InOutPoints&);
+                std::future<Future> _getFuture(
+                    Core::Frame::Number,
+                    std::string fileName,
+                    ReadType,
+                    const Core::BBox2i& roi,
+                    const std::shared_ptr<CancelToken>&);
+                std::future<Future> _getDecompressFuture(
+                    Core::Frame::Number,
+                    const std::shared_ptr<CompressedImage>&,
+                    ReadType,
+                    const std::shared_ptr<CancelToken>&);
+
+                //! Returns the number of reads started and frames finished, or
+                //! zero if there was nothing to do.
+                size_t _readQueue(size_t count, bool loop, bool cacheEnabled, const Core::BBox2i& roi, const std::shared_ptr<CancelToken>&);
+                void _clearQueue();
+
+                //! Returns the number of reads started and frames finished, or
+                //! zero if there was nothing to do.
+                size_t _readCache(size_t count, const AV::IO::InOutPoints&, size_t byteCount, const std::shared_ptr<CancelToken>&);
+
+                //! Compress the frames evicted from the cache and add them to the
+                //! compressed tier. Returns the number of frames started and
+                //! finished, or zero if there was nothing to do.
+                size_t _compressFrames();
 
                 DJV_PRIVATE();
             };
 
+            //! This struct provides sequence writer statistics.
+            struct SequenceWriteStats
+            {
+                size_t convertCount = 0;
+                float  convertTime  = 0.F; //!< The time spent converting in seconds.
+                size_t writeCount   = 0;
+                float  writeTime    = 0.F; //!< The time spent encoding and writing, summed over the threads.
+                float  stallTime    = 0.F; //!< The time spent waiting for writes to finish.
+
+                //! Get the conversion throughput in frames per second.
+                float getConvertThroughput() const;
+
+                //! Get the write throughput of a single thread in frames per
+                //! second.
+                float getWriteThroughput() const;
+            };
+
             //! This class provides an interface for writing sequences.
+            //!
+            //! The frames are converted on the writer thread and then encoded
+            //! and written by the thread pool, with up to the thread count
+            //! frames written at the same time.
             class ISequenceWrite : public IWrite
             {
                 DJV_NON_COPYABLE(ISequenceWrite);
@@ -100,6 +178,8 @@ namespace djv
 
                 bool isRunning() const override;
 
+                SequenceWriteStats getStats() const;
+
             protected:
                 virtual Image::Type _getImageType(Image::Type) const;
                 virtual Image::Layout _getImageLayout() const;
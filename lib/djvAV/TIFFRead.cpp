@@ -58,6 +58,11 @@ namespace djv
                     bool     compression = false;
                     bool     palette     = false;
                     uint16 * colormap[3] = { nullptr, nullptr, nullptr };
+                    bool     contiguous  = false;
+                    toff_t   offset      = 0;
+                    bool     tiled       = false;
+                    uint32   tileWidth   = 0;
+                    uint32   tileLength  = 0;
                 };
 
                 Read::Read()
@@ -91,21 +96,97 @@ namespace djv
                     std::shared_ptr<Image::Image> out;
                     File f;
                     const auto info = _open(fileName, f);
-                    out = Image::Image::create(info.video[0].info);
+
+                    // Reference the pixels in the file if they are stored
+                    // uncompressed in one block with the same layout as the image.
+                    if (_options.memoryMap &&
+                        f.contiguous &&
+                        static_cast<size_t>(TIFFScanlineSize(f.f)) == info.video[0].info.getScanlineByteCount())
+                    {
+                        auto io = FileSystem::FileIO::create();
+                        io->setMemoryMapEnabled(true);
+                        io->open(fileName, FileSystem::FileIO::Mode::Read);
+                        if (io->isMemoryMapped() && f.offset < io->getSize())
+                        {
+                            io->setPos(f.offset);
+                            auto imageInfo = info.video[0].info;
+                            if (TIFFIsByteSwapped(f.f))
+                            {
+                                imageInfo.layout.endian = Memory::opposite(imageInfo.layout.endian);
+                            }
+                            if (Image::Data::canMemoryMap(imageInfo, io))
+                            {
+                                out = Image::Image::create(imageInfo, io);
+                                out->setPluginName(pluginName);
+                                return out;
+                            }
+                        }
+                    }
+
+                    const Image::Info& imageInfo = info.video[0].info;
+                    out = Image::Image::create(imageInfo);
                     out->setPluginName(pluginName);
-                    for (uint16_t y = 0; y < info.video[0].info.size.h; ++y)
+
+                    // Only read the scanlines or tiles inside of the region of
+                    // interest.
+                    BBox2i bbox(0, 0, imageInfo.size.w, imageInfo.size.h);
+                    const BBox2i roi = _getROI();
+                    if (roi.isValid())
+                    {
+                        bbox = bbox.intersect(roi);
+                        out->zero();
+                    }
+                    if (f.tiled)
                     {
-                        if (TIFFReadScanline(f.f, (tdata_t *)out->getData(y), y) == -1)
+                        std::vector<uint8_t> tile(TIFFTileSize(f.f));
+                        const size_t tileRowByteCount = TIFFTileRowSize(f.f);
+                        const size_t pixelByteCount = imageInfo.getPixelByteCount();
+                        const int tileWidth = static_cast<int>(f.tileWidth);
+                        const int tileLength = static_cast<int>(f.tileLength);
+                        for (int y = bbox.min.y / tileLength * tileLength; y <= bbox.max.y; y += tileLength)
                         {
-                            throw FileSystem::Error(_textSystem->getText(_textSystem->getText(("error_read_scanline"))));
+                            if (_isCancelled())
+                            {
+                                return nullptr;
+                            }
+                            for (int x = bbox.min.x / tileWidth * tileWidth; x <= bbox.max.x; x += tileWidth)
+                            {
+                                if (TIFFReadTile(f.f, tile.data(), x, y, 0, 0) == -1)
+                                {
+                                    throw FileSystem::Error(_textSystem->getText(DJV_TEXT("error_read")));
+                                }
+                                const int w = std::min(tileWidth, imageInfo.size.w - x);
+                                const int h = std::min(tileLength, imageInfo.size.h - y);
+                                for (int j = 0; j < h; ++j)
+                                {
+                                    memcpy(
+                                        out->getData(x, y + j),
+                                        tile.data() + j * tileRowByteCount,
+                                        w * pixelByteCount);
+                                }
+                            }
                         }
-                        if (f.palette)
+                    }
+                    else
+                    {
+                        for (int y = bbox.min.y; y <= bbox.max.y; ++y)
                         {
-                            TIFF::paletteLoad(
-                                out->getData(y),
-                                info.video[0].info.size.w,
-                                static_cast<int>(Image::getChannelCount(info.video[0].info.type)),
-                                f.colormap[0], f.colormap[1], f.colormap[2]);
+                            if (_isCancelled())
+                            {
+                                return nullptr;
+                            }
+                            if (TIFFReadScanline(f.f, (tdata_t *)out->getData(y), y) == -1)
+                            {
+                                throw FileSystem::Error(_textSystem->getText(_textSystem->getText(("error_read_scanline"))));
+                            }
+                            if (f.palette)
+                            {
+                                TIFF::paletteLoad(
+                                    out->getData(y),
+                                    imageInfo.size.w,
+                                    static_cast<int>(Image::getChannelCount(imageInfo.type)),
+                                    f.colormap[0], f.colormap[1], f.colormap[2]);
+                            }
                         }
                     }
                     return out;
@@ -184,6 +265,44 @@ namespace djv
                     f.compression = compression != COMPRESSION_NONE;
                     f.palette = PHOTOMETRIC_PALETTE == photometric;
 
+                    // Tiles are read directly into the image so they need to have
+                    // the same layout.
+                    f.tiled = TIFFIsTiled(f.f);
+                    if (f.tiled)
+                    {
+                        TIFFGetField(f.f, TIFFTAG_TILEWIDTH, &f.tileWidth);
+                        TIFFGetField(f.f, TIFFTAG_TILELENGTH, &f.tileLength);
+                        if (f.palette ||
+                            (channels != PLANARCONFIG_CONTIG && samples > 1) ||
+                            0 == f.tileWidth ||
+                            0 == f.tileLength)
+                        {
+                            throw FileSystem::Error(_textSystem->getText(("error_unsupported_image_type")));
+                        }
+                    }
+
+                    // Check whether the pixels are stored in one contiguous block.
+                    f.contiguous = false;
+                    toff_t* stripOffsets = nullptr;
+                    toff_t* stripByteCounts = nullptr;
+                    if (!f.compression &&
+                        !f.palette &&
+                        (PLANARCONFIG_CONTIG == channels || 1 == samples) &&
+                        !TIFFIsTiled(f.f) &&
+                        TIFFGetField(f.f, TIFFTAG_STRIPOFFSETS, &stripOffsets) &&
+                        TIFFGetField(f.f, TIFFTAG_STRIPBYTECOUNTS, &stripByteCounts) &&
+                        stripOffsets &&
+                        stripByteCounts)
+                    {
+                        const tstrip_t stripCount = TIFFNumberOfStrips(f.f);
+                        f.contiguous = stripCount > 0;
+                        for (tstrip_t i = 1; i < stripCount && f.contiguous; ++i)
+                        {
+                            f.contiguous = stripOffsets[i] == stripOffsets[i - 1] + stripByteCounts[i - 1];
+                        }
+                        f.offset = stripOffsets[0];
+                    }
+
                     AV::Tags tags;
                     char * tag = 0;
                     if (TIFFGetField(f.f, TIFFTAG_ARTIST, &tag))
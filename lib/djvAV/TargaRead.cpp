@@ -43,6 +43,13 @@ namespace djv
         {
             namespace Targa
             {
+                struct Read::Session : public IDecoderSession
+                {
+                    bool bgr = false;
+                    bool compression = false;
+                    std::vector<uint8_t> rleData;
+                };
+
                 Read::Read()
                 {}
 
@@ -66,7 +73,8 @@ namespace djv
                 Info Read::_readInfo(const std::string & fileName)
                 {
                     auto io = FileSystem::FileIO::create();
-                    return _open(fileName, io);
+                    Session session;
+                    return _open(fileName, io, session);
                 }
 
                 namespace
@@ -161,24 +169,28 @@ namespace djv
 
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
                 {
+                    Session localSession;
+                    Session& session = _getSession() ? static_cast<Session&>(*_getSession()) : localSession;
                     std::shared_ptr<Image::Image> out;
                     auto io = FileSystem::FileIO::create();
-                    const auto info = _open(fileName, io);
+                    const auto info = _open(fileName, io, session);
                     out = Image::Image::create(info.video[0].info);
                     out->setPluginName(pluginName);
 
                     const Image::Info& imageInfo = info.video[0].info;
                     const size_t channels = Image::getChannelCount(imageInfo.type);
-                    if (!_compression)
+                    if (!session.compression)
                     {
                         io->read(out->getData(), out->getDataByteCount());
                     }
                     else
                     {
+                        // The compressed data is read into a scratch buffer
+                        // that is kept by the session.
                         const size_t tmpSize = io->getSize() - io->getPos();
-                        std::vector<uint8_t> tmp(tmpSize);
-                        io->read(tmp.data(), tmpSize);
-                        const uint8_t* p = tmp.data();
+                        session.rleData.resize(tmpSize);
+                        io->read(session.rleData.data(), tmpSize);
+                        const uint8_t* p = session.rleData.data();
                         const uint8_t* const end = p + tmpSize;
                         for (uint16_t y = 0; y < imageInfo.size.h; ++y)
                         {
@@ -195,7 +207,7 @@ namespace djv
                         }
                     }
 
-                    if (_bgr)
+                    if (session.bgr)
                     {
                         for (uint16_t y = 0; y < imageInfo.size.h; ++y)
                         {
@@ -212,6 +224,11 @@ namespace djv
                     return out;
                 }
 
+                std::shared_ptr<IDecoderSession> Read::_createSession()
+                {
+                    return std::shared_ptr<IDecoderSession>(new Session);
+                }
+
                 namespace
                 {
                     class Header
@@ -341,12 +358,14 @@ namespace djv
 
                 } // namespace
 
-                Info Read::_open(const std::string & fileName, const std::shared_ptr<FileSystem::FileIO>& io)
+                Info Read::_open(const std::string & fileName, const std::shared_ptr<FileSystem::FileIO>& io, Session& session)
                 {
                     io->setEndianConversion(Memory::getEndian() != Memory::Endian::LSB);
                     io->open(fileName, FileSystem::FileIO::Mode::Read);
                     Image::Info imageInfo;
-                    Header().read(io, imageInfo, _bgr, _compression, _textSystem);
+                    session.bgr = false;
+                    session.compression = false;
+                    Header().read(io, imageInfo, session.bgr, session.compression, _textSystem);
                     auto info = Info(fileName, VideoInfo(imageInfo, _speed, _sequence));
                     return info;
                 }
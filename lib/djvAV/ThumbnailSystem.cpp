@@ -156,6 +156,22 @@ namespace djv
                 return out;
             }
 
+            //! Get the smallest proxy that is still larger than the thumbnail.
+            size_t getProxy(const Image::Size& imageSize, const Image::Size& thumbnailSize)
+            {
+                size_t out = 0;
+                while (out < IO::proxyMax)
+                {
+                    const Image::Size proxySize = IO::getProxySize(imageSize, out + 1);
+                    if (proxySize.w < thumbnailSize.w || proxySize.h < thumbnailSize.h)
+                    {
+                        break;
+                    }
+                    ++out;
+                }
+                return out;
+            }
+
         } // namespace
         
         ThumbnailSystem::InfoFuture::InfoFuture()
@@ -237,9 +253,11 @@ namespace djv
             p.glfwWindow = glfwCreateWindow(100, 100, context->getName().c_str(), NULL, NULL);
             if (!p.glfwWindow)
             {
+                // Without an OpenGL context the thumbnails are converted on
+                // the CPU.
                 std::stringstream ss;
                 ss << p.textSystem->getText(DJV_TEXT("error_glfw_window_creation"));
-                throw ThumbnailError(ss.str());
+                _log(ss.str(), LogLevel::Warning);
             }
 
             p.statsTimer = Time::Timer::create(context);
@@ -266,19 +284,25 @@ namespace djv
                 DJV_PRIVATE_PTR();
                 try
                 {
-                    glfwMakeContextCurrent(p.glfwWindow);
+                    if (p.glfwWindow)
+                    {
+                        glfwMakeContextCurrent(p.glfwWindow);
 #if defined(DJV_OPENGL_ES2)
-                    if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
+                        if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
 #else // DJV_OPENGL_ES2
-                    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+                        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
 #endif // DJV_OPENGL_ES2
-                    {
-                        std::stringstream ss;
-                        ss << p.textSystem->getText(DJV_TEXT("error_glad_init"));
-                        throw ThumbnailError(ss.str());
+                        {
+                            std::stringstream ss;
+                            ss << p.textSystem->getText(DJV_TEXT("error_glad_init"));
+                            throw ThumbnailError(ss.str());
+                        }
                     }
 
-                    auto convert = Image::Convert::create(resourceSystem);
+                    auto convert = Image::Convert::create(
+                        resourceSystem,
+                        p.glfwWindow ? Image::ConvertBackend::OpenGL : Image::ConvertBackend::CPU,
+                        p.io->getThreadPool());
 
                     const auto timeout = Time::getValue(Time::TimerValue::Medium);
                     while (p.running)
@@ -562,7 +586,15 @@ namespace djv
                 {
                     try
                     {
-                        i.read = p.io->read(i.fileInfo);
+                        // If the information is already cached read a proxy
+                        // instead of the full resolution image.
+                        IO::ReadOptions options;
+                        IO::Info cachedInfo;
+                        if (p.infoCache.get(getInfoCacheKey(i.fileInfo), cachedInfo) && cachedInfo.video.size() > 0)
+                        {
+                            options.proxy = getProxy(cachedInfo.video[0].info.size, i.size);
+                        }
+                        i.read = p.io->read(i.fileInfo, options);
                         const auto info = i.read->getInfo().get();
                         if (info.video.size() > 0)
                         {
@@ -594,16 +626,12 @@ namespace djv
                 std::shared_ptr<Image::Image> image;
                 bool finished = false;
                 {
-                    std::lock_guard<std::mutex> lock(i->read->getMutex());
                     auto& queue = i->read->getVideoQueue();
+                    finished = queue.isFinished();
                     if (!queue.isEmpty())
                     {
                         image = queue.getFrame().image;
                     }
-                    if (queue.isFinished())
-                    {
-                        finished = true;
-                    }
                 }
                 if (image)
                 {
@@ -624,7 +652,7 @@ namespace djv
                             {
                                 size.h = static_cast<int>(size.w / imageAspect);
                             }
-                            const auto type = i->type != Image::Type::None ? i->type : image->getType();
+                            const auto type = i->type != Image::Type::None ? i->type : Image::getRGBType(image->getType());
                             const auto info = Image::Info(size, type);
                             auto tmp = Image::Image::create(info);
                             tmp->setPluginName(image->getPluginName());
@@ -0,0 +1,334 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/Transcode.h>
+
+#include <djvAV/ImageConvert.h>
+
+#include <djvCore/Memory.h>
+#include <djvCore/Timer.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <thread>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            namespace
+            {
+                //! This struct wakes up the pipeline thread when the queues
+                //! change. It is shared with the queue observers so that they
+                //! may be safely called after the pipeline is destroyed.
+                struct Notify
+                {
+                    std::mutex mutex;
+                    std::condition_variable cv;
+                    bool notified = false;
+
+                    void notify()
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            notified = true;
+                        }
+                        cv.notify_one();
+                    }
+
+                    void wait(const Time::Unit& timeout)
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        cv.wait_for(
+                            lock,
+                            timeout,
+                            [this]
+                            {
+                                return notified;
+                            });
+                        notified = false;
+                    }
+                };
+
+            } // namespace
+
+            float TranscodeStats::getFramesPerSecond() const
+            {
+                return time > 0.F ? (frameCount / time) : 0.F;
+            }
+
+            float TranscodeStats::getMegabytesPerSecond() const
+            {
+                return time > 0.F ? (byteCount / static_cast<float>(Memory::megabyte) / time) : 0.F;
+            }
+
+            float TranscodeStats::getReadUtilization() const
+            {
+                return time > 0.F ? (readTime / time) : 0.F;
+            }
+
+            float TranscodeStats::getResizeUtilization() const
+            {
+                return time > 0.F ? (resizeTime / time) : 0.F;
+            }
+
+            float TranscodeStats::getWriteUtilization() const
+            {
+                return time > 0.F ? (writeTime / time) : 0.F;
+            }
+
+            struct Transcode::Private
+            {
+                std::shared_ptr<IRead> read;
+                std::shared_ptr<IWrite> write;
+                TranscodeOptions options;
+                std::shared_ptr<Image::Convert> convert;
+                mutable std::mutex mutex;
+                TranscodeStats stats;
+                std::string error;
+                std::shared_ptr<Notify> notify;
+                std::thread thread;
+                std::atomic<bool> running;
+            };
+
+            void Transcode::_init(
+                const std::shared_ptr<IRead>& read,
+                const Info& info,
+                const std::shared_ptr<IWrite>& write,
+                const TranscodeOptions& options)
+            {
+                DJV_PRIVATE_PTR();
+                p.read = read;
+                p.write = write;
+                p.options = options;
+                if (info.video.size())
+                {
+                    p.stats.frameTotal = info.video[0].sequence.getSize();
+                }
+                if (p.options.resize.isValid())
+                {
+                    p.convert = Image::Convert::create(nullptr, Image::ConvertBackend::CPU, p.options.threadPool);
+                }
+
+                // Wake up the thread when frames are added to the read queue or
+                // removed from the write queue.
+                p.notify = std::make_shared<Notify>();
+                auto notify = p.notify;
+                p.read->getVideoQueue().setObserver(
+                    [notify]
+                    {
+                        notify->notify();
+                    });
+                p.write->getVideoQueue().setObserver(
+                    [notify]
+                    {
+                        notify->notify();
+                    });
+
+                p.running = true;
+                p.thread = std::thread(
+                    [this]
+                {
+                    DJV_PRIVATE_PTR();
+                    auto& readQueue = p.read->getVideoQueue();
+                    auto& writeQueue = p.write->getVideoQueue();
+                    const auto timeout = Time::getTime(Time::TimerValue::Slow);
+                    const auto start = std::chrono::steady_clock::now();
+                    auto t = start;
+                    try
+                    {
+                        while (p.running)
+                        {
+                            // Sample whether the reader and writer are busy.
+                            const auto now = std::chrono::steady_clock::now();
+                            const std::chrono::duration<float> delta = now - t;
+                            t = now;
+                            {
+                                std::lock_guard<std::mutex> lock(p.mutex);
+                                const std::chrono::duration<float> time = now - start;
+                                p.stats.time = time.count();
+                                if (!readQueue.isFinished() && readQueue.getCount() < readQueue.getMax())
+                                {
+                                    p.stats.readTime += delta.count();
+                                }
+                                if (writeQueue.getCount() > 0)
+                                {
+                                    p.stats.writeTime += delta.count();
+                                }
+                            }
+
+                            // Stop if the writer has failed, otherwise the write
+                            // queue would stay full.
+                            if (!p.write->isRunning())
+                            {
+                                std::string error = p.write->getError();
+                                if (error.empty())
+                                {
+                                    error = DJV_TEXT("error_file_write");
+                                }
+                                std::lock_guard<std::mutex> lock(p.mutex);
+                                p.error = error;
+                                break;
+                            }
+
+                            // Move the frames from the read queue to the write
+                            // queue while there is room.
+                            bool work = false;
+                            const bool finished = readQueue.isFinished();
+                            while (p.running && !readQueue.isEmpty() && writeQueue.getCount() < writeQueue.getMax())
+                            {
+                                auto frame = readQueue.popFrame();
+                                if (frame.image && p.convert && frame.image->getSize() != p.options.resize)
+                                {
+                                    const auto resizeStart = std::chrono::steady_clock::now();
+                                    const Image::Info info(p.options.resize, frame.image->getType());
+                                    auto image = Image::Image::create(info);
+                                    image->setPluginName(frame.image->getPluginName());
+                                    image->setTags(frame.image->getTags());
+                                    p.convert->process(*frame.image, info, *image);
+                                    frame.image = image;
+                                    const std::chrono::duration<float> resizeTime = std::chrono::steady_clock::now() - resizeStart;
+                                    std::lock_guard<std::mutex> lock(p.mutex);
+                                    p.stats.resizeTime += resizeTime.count();
+                                }
+                                const size_t byteCount = frame.image ? frame.image->getDataByteCount() : 0;
+                                writeQueue.addFrame(frame);
+                                {
+                                    std::lock_guard<std::mutex> lock(p.mutex);
+                                    ++p.stats.frameCount;
+                                    p.stats.byteCount += byteCount;
+                                }
+                                work = true;
+                            }
+
+                            if (finished && readQueue.isEmpty())
+                            {
+                                p.running = false;
+                            }
+                            else if (!work)
+                            {
+                                // Sleep until a frame is added to the read queue,
+                                // a frame is removed from the write queue, or the
+                                // pipeline is cancelled.
+                                p.notify->wait(timeout);
+                            }
+                        }
+                    }
+                    catch (const std::exception& e)
+                    {
+                        std::lock_guard<std::mutex> lock(p.mutex);
+                        p.error = e.what();
+                    }
+                    writeQueue.setFinished(true);
+                    {
+                        std::lock_guard<std::mutex> lock(p.mutex);
+                        const std::chrono::duration<float> time = std::chrono::steady_clock::now() - start;
+                        p.stats.time = time.count();
+                    }
+                    p.running = false;
+                });
+            }
+
+            Transcode::Transcode() :
+                _p(new Private)
+            {}
+
+            Transcode::~Transcode()
+            {
+                DJV_PRIVATE_PTR();
+                p.running = false;
+                if (p.notify)
+                {
+                    p.notify->notify();
+                }
+                if (p.thread.joinable())
+                {
+                    p.thread.join();
+                }
+                if (p.read)
+                {
+                    p.read->getVideoQueue().setObserver(nullptr);
+                }
+                if (p.write)
+                {
+                    p.write->getVideoQueue().setObserver(nullptr);
+                }
+            }
+
+            std::shared_ptr<Transcode> Transcode::create(
+                const std::shared_ptr<IRead>& read,
+                const Info& info,
+                const std::shared_ptr<IWrite>& write,
+                const TranscodeOptions& options)
+            {
+                auto out = std::shared_ptr<Transcode>(new Transcode);
+                out->_init(read, info, write, options);
+                return out;
+            }
+
+            bool Transcode::isRunning() const
+            {
+                DJV_PRIVATE_PTR();
+                return p.running || p.write->isRunning();
+            }
+
+            TranscodeStats Transcode::getStats() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return p.stats;
+            }
+
+            std::string Transcode::getError() const
+            {
+                DJV_PRIVATE_PTR();
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    if (!p.error.empty())
+                    {
+                        return p.error;
+                    }
+                }
+                return p.write->getError();
+            }
+
+            void Transcode::cancel()
+            {
+                DJV_PRIVATE_PTR();
+                p.running = false;
+                p.notify->notify();
+            }
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvAV/IO.h>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            //! This struct provides transcode options.
+            struct TranscodeOptions
+            {
+                //! Resize the images. The images are not resized if the size
+                //! is not valid.
+                Image::Size resize;
+
+                //! The thread pool for resizing the images.
+                std::shared_ptr<Core::ThreadPool> threadPool;
+            };
+
+            //! This struct provides transcode statistics.
+            //!
+            //! The utilization of each stage is the fraction of the time that
+            //! it was busy: the reader while there is room in the read queue,
+            //! the resize while resizing, and the writer while there are
+            //! frames waiting in the write queue. The stage closest to one is
+            //! the bottleneck.
+            struct TranscodeStats
+            {
+                size_t   frameCount  = 0;
+                size_t   frameTotal  = 0;
+                uint64_t byteCount   = 0;
+                float    time        = 0.F;
+                float    readTime    = 0.F;
+                float    resizeTime  = 0.F;
+                float    writeTime   = 0.F;
+
+                float getFramesPerSecond() const;
+                float getMegabytesPerSecond() const;
+                float getReadUtilization() const;
+                float getResizeUtilization() const;
+                float getWriteUtilization() const;
+            };
+
+            //! This class provides a pipeline for transcoding video.
+            //!
+            //! The frames are taken from the read queue, resized if needed,
+            //! and added to the write queue on a dedicated thread. The thread
+            //! waits while the read queue is empty or the write queue is
+            //! full, so the reader and writer run as fast as the slower of
+            //! the two allows. When the reader is finished the write queue
+            //! is finished.
+            class Transcode : public std::enable_shared_from_this<Transcode>
+            {
+                DJV_NON_COPYABLE(Transcode);
+
+            protected:
+                void _init(
+                    const std::shared_ptr<IRead>&,
+                    const Info&,
+                    const std::shared_ptr<IWrite>&,
+                    const TranscodeOptions&);
+                Transcode();
+
+            public:
+                ~Transcode();
+
+                //! Create a new transcode pipeline. The information is used for
+                //! the total number of frames.
+                static std::shared_ptr<Transcode> create(
+                    const std::shared_ptr<IRead>&,
+                    const Info&,
+                    const std::shared_ptr<IWrite>&,
+                    const TranscodeOptions& = TranscodeOptions());
+
+                //! Get whether the pipeline or the writer is still running.
+                bool isRunning() const;
+
+                //! Get the statistics.
+                TranscodeStats getStats() const;
+
+                //! Get the error if the pipeline or the writer failed.
+                std::string getError() const;
+
+                //! Stop the pipeline. The write queue is finished with the
+                //! frames that have been added so far.
+                void cancel();
+
+            private:
+                DJV_PRIVATE();
+            };
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
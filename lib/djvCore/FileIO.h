@@ -154,15 +154,40 @@ namespace djv
                 ///@}
 
                 //! \name Memory Mapping
+                //! Files opened for reading can be memory mapped instead of
+                //! read with system calls. If the file cannot be mapped it is
+                //! read normally. The file descriptor is closed once the file is
+                //! mapped, the mapping stays valid until the file is closed.
                 ///@{
 
-#if defined(DJV_MMAP)
-                //! Get the current memory-map position.
+                //! Get whether files opened for reading are memory mapped.
+                bool isMemoryMapEnabled() const;
+
+                //! Set whether files opened for reading are memory mapped. This
+                //! takes effect the next time a file is opened.
+                void setMemoryMapEnabled(bool);
+
+                //! Get whether the open file is memory mapped.
+                bool isMemoryMapped() const;
+
+                //! Get the current memory-map position, or null if the file is
+                //! not memory mapped.
                 const uint8_t * mmapP() const;
 
-                //! Get a pointer to the end of the memory-map.
+                //! Get a pointer to the end of the memory-map, or null if the
+                //! file is not memory mapped.
                 const uint8_t * mmapEnd() const;
-#endif // DJV_MMAP
+
+                ///@}
+
+                //! \name Prefetching
+                ///@{
+
+                //! Ask the operating system to read a file into memory ahead of
+                //! time. This may block, so it should be called from a background
+                //! thread (see FilePrefetch). Returns the number of bytes
+                //! requested, or zero if the file cannot be prefetched.
+                static size_t prefetch(const std::string& fileName);
 
                 ///@}
 
@@ -216,27 +241,15 @@ namespace djv
                 size_t          _pos                = 0;
                 size_t          _size               = 0;
                 bool            _endianConversion   = false;
+                bool            _memoryMapEnabled   = false;
 #if defined(DJV_PLATFORM_WINDOWS)
-#if defined(DJV_MMAP)
-                HANDLE          _f                  = INVALID_HANDLE_VALUE;
-#else // DJV_MMAP
                 FILE*           _f                  = nullptr;
-#endif // DJV_MMAP
-#if defined(DJV_MMAP)
-                void *          _mmap               = nullptr;
-                const uint8_t * _mmapStart          = nullptr;
-                const uint8_t * _mmapEnd            = nullptr;
-                const uint8_t * _mmapP              = nullptr;
-#endif // DJV_MMAP
 #else // DJV_PLATFORM_WINDOWS
                 int             _f                  = -1;
-#if defined(DJV_MMAP)
-                void *          _mmap               = reinterpret_cast<void *>(-1);
+#endif //DJV_PLATFORM_WINDOWS
                 const uint8_t * _mmapStart          = nullptr;
                 const uint8_t * _mmapEnd            = nullptr;
                 const uint8_t * _mmapP              = nullptr;
-#endif // DJV_MMAP
-#endif //DJV_PLATFORM_WINDOWS
             };
 
         } // namespace FileSystem
@@ -30,10 +30,12 @@
 #include <djvCore/FileIO.h>
 
 #include <djvCore/Error.h>
+#include <djvCore/FilePrefetch.h>
 #include <djvCore/FileSystem.h>
 #include <djvCore/Math.h>
 #include <djvCore/Memory.h>
 
+#include <climits>
 #include <iostream>
 #include <sstream>
 
@@ -208,22 +210,29 @@ namespace djv
                 _mode     = mode;
                 _pos      = 0;
                 _size     = info.st_size;
+                if (Mode::Read == _mode)
+                {
+                    FilePrefetch::getGlobal()->consume(fileName);
+                }
 
-#if defined(DJV_MMAP)
                 // Memory mapping.
-                if (Mode::Read == _mode && _size > 0)
+                if (_memoryMapEnabled && Mode::Read == _mode && _size > 0)
                 {
-                    _mmap = mmap(0, _size, PROT_READ, MAP_SHARED, _f, 0);
-                    madvise(_mmap, _size, MADV_SEQUENTIAL | MADV_SEQUENTIAL);
-                    if (_mmap == (void *) - 1)
+                    void* mmapP = mmap(0, _size, PROT_READ, MAP_SHARED, _f, 0);
+                    if (mmapP != MAP_FAILED)
                     {
-                        throw Error(getErrorMessage(ErrorType::MemoryMap, fileName));
+                        madvise(mmapP, _size, MADV_SEQUENTIAL | MADV_WILLNEED);
+                        _mmapStart = reinterpret_cast<const uint8_t *>(mmapP);
+                        _mmapEnd   = _mmapStart + _size;
+                        _mmapP     = _mmapStart;
+
+                        // The mapping does not need the file descriptor, closing
+                        // it means that images which reference the mapping do not
+                        // use up file descriptors.
+                        ::close(_f);
+                        _f = -1;
                     }
-                    _mmapStart = reinterpret_cast<const uint8_t *>(_mmap);
-                    _mmapEnd   = _mmapStart + _size;
-                    _mmapP     = _mmapStart;
                 }
-#endif // DJV_MMAP
             }
             
             void FileIO::openTemp()
@@ -255,15 +264,54 @@ namespace djv
                 _size     = info.st_size;
             }
 
+            size_t FileIO::prefetch(const std::string& fileName)
+            {
+                size_t out = 0;
+                const int f = ::open(fileName.c_str(), O_RDONLY);
+                if (f != -1)
+                {
+                    _STAT info;
+                    memset(&info, 0, sizeof(_STAT));
+                    if (0 == fstat(f, &info) && info.st_size > 0)
+                    {
+#if defined(DJV_PLATFORM_LINUX)
+                        // Start reading the whole file into the page cache, this
+                        // returns without waiting for the read to finish.
+                        if (0 == posix_fadvise(f, 0, 0, POSIX_FADV_WILLNEED))
+                        {
+                            out = info.st_size;
+                        }
+#elif defined(DJV_PLATFORM_OSX)
+                        struct radvisory advisory;
+                        advisory.ra_offset = 0;
+                        advisory.ra_count = static_cast<int>(std::min(static_cast<off_t>(INT_MAX), info.st_size));
+                        if (fcntl(f, F_RDADVISE, &advisory) != -1)
+                        {
+                            out = advisory.ra_count;
+                        }
+#else // DJV_PLATFORM_LINUX
+                        // Fall back to reading the file on this thread.
+                        std::vector<uint8_t> buf(Memory::megabyte);
+                        ssize_t r = 0;
+                        while ((r = ::read(f, buf.data(), buf.size())) > 0)
+                        {
+                            out += r;
+                        }
+#endif // DJV_PLATFORM_LINUX
+                    }
+                    ::close(f);
+                }
+                return out;
+            }
+
             bool FileIO::close(std::string* error)
             {
                 bool out = true;
                 
                 _fileName = std::string();
-#if defined(DJV_MMAP)
-                if (_mmap != (void *) - 1)
+                if (_mmapStart)
                 {
-                    int r = munmap(_mmap, _size);
+                    int r = munmap(const_cast<uint8_t *>(_mmapStart), _size);
                     if (-1 == r)
                     {
                         out = false;
@@ -272,11 +320,10 @@ namespace djv
                             *error = getErrorMessage(ErrorType::CloseMemoryMap, _fileName);
                         }
                     }
-                    _mmap = (void *)-1;
+                    _mmapStart = nullptr;
                 }
-                _mmapStart = 0;
-                _mmapEnd   = 0;
-#endif // DJV_MMAP
+                _mmapEnd   = nullptr;
+                _mmapP     = nullptr;
                 if (_f != -1)
                 {
                     int r = ::close(_f);
@@ -304,32 +351,35 @@ namespace djv
                 {
                 case Mode::Read:
                 {
-#if defined(DJV_MMAP)
-                    const uint8_t* mmapP = _mmapP + size * wordSize;
-                    if (mmapP > _mmapEnd)
-                    {
-                        throw Error(getErrorMessage(ErrorType::ReadMemoryMap, _fileName));
-                    }
-                    if (_endianConversion && wordSize > 1)
+                    if (_mmapStart)
                     {
-                        Memory::endian(_mmapP, in, size, wordSize);
+                        const uint8_t* mmapP = _mmapP + size * wordSize;
+                        if (mmapP > _mmapEnd)
+                        {
+                            throw Error(getErrorMessage(ErrorType::ReadMemoryMap, _fileName));
+                        }
+                        if (_endianConversion && wordSize > 1)
+                        {
+                            Memory::endian(_mmapP, in, size, wordSize);
+                        }
+                        else
+                        {
+                            memcpy(in, _mmapP, size * wordSize);
+                        }
+                        _mmapP = mmapP;
                     }
                     else
                     {
-                        memcpy(in, _mmapP, size * wordSize);
-                    }
-                    _mmapP = mmapP;
-#else // DJV_MMAP
-                    const size_t r = ::read(_f, in, size * wordSize);
-                    if (r != size * wordSize)
-                    {
-                        throw Error(getErrorMessage(ErrorType::Read, _fileName));
-                    }
-                    if (_endianConversion && wordSize > 1)
-                    {
-                        Memory::endian(in, size, wordSize);
+                        const size_t r = ::read(_f, in, size * wordSize);
+                        if (r != size * wordSize)
+                        {
+                            throw Error(getErrorMessage(ErrorType::Read, _fileName));
+                        }
+                        if (_endianConversion && wordSize > 1)
+                        {
+                            Memory::endian(in, size, wordSize);
+                        }
                     }
-#endif // DJV_MMAP
                     break;
                 }
                 case Mode::ReadWrite:
@@ -374,25 +424,19 @@ namespace djv
                 {
                 case Mode::Read:
                 {
-#if defined(DJV_MMAP)
-                    if (!seek)
-                    {
-                        _mmapP = reinterpret_cast<const uint8_t*>(_mmapStart) + in;
-                    }
-                    else
-                    {
-                        _mmapP += in;
-                    }
-                    if (_mmapP > _mmapEnd)
+                    if (_mmapStart)
                     {
-                        throw Error(getErrorMessage(ErrorType::SeekMemoryMap, _fileName));
+                        const uint8_t* mmapP = !seek ? (_mmapStart + in) : (_mmapP + in);
+                        if (mmapP > _mmapEnd)
+                        {
+                            throw Error(getErrorMessage(ErrorType::SeekMemoryMap, _fileName));
+                        }
+                        _mmapP = mmapP;
                     }
-#else // DJV_MMAP
-                    if (::lseek(_f, in, ! seek ? SEEK_SET : SEEK_CUR) == (off_t) - 1)
+                    else if (::lseek(_f, in, ! seek ? SEEK_SET : SEEK_CUR) == (off_t) - 1)
                     {
                         throw Error(getErrorMessage(ErrorType::Seek, _fileName));
                     }
-#endif // DJV_MMAP
                     break;
                 }
                 case Mode::Write:
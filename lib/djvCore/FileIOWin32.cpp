@@ -30,6 +30,7 @@
 #include <djvCore/FileIO.h>
 
 #include <djvCore/Error.h>
+#include <djvCore/FilePrefetch.h>
 #include <djvCore/FileSystem.h>
 #include <djvCore/Math.h>
 #include <djvCore/Memory.h>
@@ -119,66 +120,49 @@ namespace djv
             {
                 close();
 
-#if defined(DJV_MMAP)
-                // Open the file.
-                DWORD desiredAccess = 0;
-                DWORD shareMode = 0;
-                DWORD disposition = 0;
-                DWORD flags =
-                    //FILE_ATTRIBUTE_NORMAL;
-                    FILE_FLAG_SEQUENTIAL_SCAN;
-                switch (mode)
-                {
-                case Mode::Read:
-                    desiredAccess = GENERIC_READ;
-                    shareMode     = FILE_SHARE_READ;
-                    disposition   = OPEN_EXISTING;
-                    break;
-                case Mode::Write:
-                    desiredAccess = GENERIC_WRITE;
-                    disposition   = CREATE_ALWAYS;
-                    break;
-                case Mode::ReadWrite:
-                    desiredAccess = GENERIC_READ | GENERIC_WRITE;
-                    shareMode     = FILE_SHARE_READ;
-                    disposition   = CREATE_ALWAYS;
-                    break;
-                case Mode::Append:
-                    desiredAccess = GENERIC_WRITE;
-                    disposition   = OPEN_EXISTING;
-                    break;
-                default: break;
-                }
-                std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> utf16;
-                _f = CreateFileW(utf16.from_bytes(fileName).c_str(), desiredAccess, shareMode, 0, disposition, flags, 0);
-                if (INVALID_HANDLE_VALUE == _f)
-                {
-                    throw Error(getErrorMessage(ErrorType::Open, fileName));
-                }
-                _fileName = fileName;
-                _mode = mode;
-                _pos = 0;
-                _size = GetFileSize(_f, 0);
-
                 // Memory mapping.
-                if (Mode::Read == _mode && _size > 0)
+                if (_memoryMapEnabled && Mode::Read == mode)
                 {
-                    _mmap = CreateFileMapping(_f, 0, PAGE_READONLY, 0, 0, 0);
-                    if (!_mmap)
+                    std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> utf16;
+                    HANDLE f = CreateFileW(
+                        utf16.from_bytes(fileName).c_str(),
+                        GENERIC_READ,
+                        FILE_SHARE_READ,
+                        0,
+                        OPEN_EXISTING,
+                        FILE_FLAG_SEQUENTIAL_SCAN,
+                        0);
+                    if (INVALID_HANDLE_VALUE == f)
                     {
-                        throw Error(getErrorMessage(ErrorType::MemoryMap, fileName));
+                        throw Error(getErrorMessage(ErrorType::Open, fileName));
                     }
-
-                    _mmapStart = reinterpret_cast<const uint8_t *>(MapViewOfFile(_mmap, FILE_MAP_READ, 0, 0, 0));
-                    if (!_mmapStart)
+                    LARGE_INTEGER size;
+                    if (GetFileSizeEx(f, &size) && size.QuadPart > 0)
+                    {
+                        // The view does not need the file or mapping handles,
+                        // closing them means that images which reference the
+                        // view do not use up handles.
+                        HANDLE mmap = CreateFileMapping(f, 0, PAGE_READONLY, 0, 0, 0);
+                        if (mmap)
+                        {
+                            _mmapStart = reinterpret_cast<const uint8_t *>(MapViewOfFile(mmap, FILE_MAP_READ, 0, 0, 0));
+                            CloseHandle(mmap);
+                        }
+                    }
+                    CloseHandle(f);
+                    if (_mmapStart)
                     {
-                        throw Error(getErrorMessage(ErrorType::MemoryMap, fileName));
+                        _fileName = fileName;
+                        _mode     = mode;
+                        _pos      = 0;
+                        _size     = static_cast<size_t>(size.QuadPart);
+                        _mmapEnd  = _mmapStart + _size;
+                        _mmapP    = _mmapStart;
+                        FilePrefetch::getGlobal()->consume(fileName);
+                        return;
                     }
-
-                    _mmapEnd = _mmapStart + _size;
-                    _mmapP = _mmapStart;
                 }
-#else // DJV_MMAP
+
                 std::string modeStr;
                 switch (mode)
                 {
@@ -213,7 +197,10 @@ namespace djv
                 {
                     throw Error(getErrorMessage(ErrorType::Open, fileName));
                 }
-#endif // DJV_MMAP
+                if (Mode::Read == _mode)
+                {
+                    FilePrefetch::getGlobal()->consume(fileName);
+                }
             }
 
             void FileIO::openTemp()
@@ -236,52 +223,59 @@ namespace djv
                 }
             }
 
+            size_t FileIO::prefetch(const std::string& fileName)
+            {
+                // There is no asynchronous read ahead hint for files, so read the
+                // file on this thread to bring it into the file system cache.
+                size_t out = 0;
+                std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> utf16;
+                HANDLE f = CreateFileW(
+                    utf16.from_bytes(fileName).c_str(),
+                    GENERIC_READ,
+                    FILE_SHARE_READ,
+                    0,
+                    OPEN_EXISTING,
+                    FILE_FLAG_SEQUENTIAL_SCAN,
+                    0);
+                if (f != INVALID_HANDLE_VALUE)
+                {
+                    std::vector<uint8_t> buf(Memory::megabyte);
+                    DWORD r = 0;
+                    while (ReadFile(f, buf.data(), static_cast<DWORD>(buf.size()), &r, 0) && r > 0)
+                    {
+                        out += r;
+                    }
+                    CloseHandle(f);
+                }
+                return out;
+            }
+
             bool FileIO::close(std::string* error)
             {
                 bool out = true;
 
                 _fileName = std::string();
                 
-#if defined(DJV_MMAP)
-                if (_mmapStart != 0)
+                if (_mmapStart)
                 {
                     if (!::UnmapViewOfFile((void *)_mmapStart))
                     {
                         out = false;
                         if (error)
                         {
-                            *error = getErrorMessage(Error::CloseMemoryMap, _fileName);
-                        }
-                    }
-                    _mmapStart = 0;
-                }
-                if (_mmap != 0)
-                {
-                    if (!::CloseHandle(_mmap))
-                    {
-                        out = false;
-                        if (error)
-                        {
-                            *error = getErrorMessage(Error::Close, _fileName);
+                            *error = getErrorMessage(ErrorType::CloseMemoryMap, _fileName);
                         }
                     }
-                    _mmap = 0;
+                    _mmapStart = nullptr;
                 }
-                _mmapEnd = 0;
-                _mmapP   = 0;
+                _mmapEnd = nullptr;
+                _mmapP   = nullptr;
 
-                if (_f != INVALID_HANDLE_VALUE)
-                {
-                    CloseHandle(_f);
-                    _f = INVALID_HANDLE_VALUE;
-                }
-#else // DJV_MMAP
                 if (_f)
                 {
                     fclose(_f);
                     _f = nullptr;
                 }
-#endif // DJV_MMAP
 
                 _mode = Mode::First;
                 _pos  = 0;
@@ -296,37 +290,35 @@ namespace djv
                 {
                 case Mode::Read:
                 {
-#if defined(DJV_MMAP)
-                    const uint8_t * p = _mmapP + size * wordSize;
-                    if (p > _mmapEnd)
-                    {
-                        throw Error(getErrorMessage(ErrorType::ReadMemoryMap, _fileName));
-                    }
-                    if (_endianConversion && wordSize > 1)
+                    if (_mmapStart)
                     {
-                        Memory::endian(_mmapP, in, size, wordSize);
+                        const uint8_t * p = _mmapP + size * wordSize;
+                        if (p > _mmapEnd)
+                        {
+                            throw Error(getErrorMessage(ErrorType::ReadMemoryMap, _fileName));
+                        }
+                        if (_endianConversion && wordSize > 1)
+                        {
+                            Memory::endian(_mmapP, in, size, wordSize);
+                        }
+                        else
+                        {
+                            memcpy(in, _mmapP, size * wordSize);
+                        }
+                        _mmapP = p;
                     }
                     else
                     {
-                        memcpy(in, _mmapP, size * wordSize);
-                    }
-                    _mmapP = p;
-#else // DJV_MMAP
-                    /*DWORD n;
-                    if (!::ReadFile(_f, in, static_cast<DWORD>(size * wordSize), &n, 0))
-                    {
-                        throw Error(getErrorMessage(ErrorType::Read, _fileName));
-                    }*/
-                    size_t r = fread(in, 1, size * wordSize, _f);
-                    if (r != size * wordSize)
-                    {
-                        throw Error(getErrorMessage(ErrorType::Read, _fileName));
-                    }
-                    if (_endianConversion && wordSize > 1)
-                    {
-                        Memory::endian(in, size, wordSize);
+                        size_t r = fread(in, 1, size * wordSize, _f);
+                        if (r != size * wordSize)
+                        {
+                            throw Error(getErrorMessage(ErrorType::Read, _fileName));
+                        }
+                        if (_endianConversion && wordSize > 1)
+                        {
+                            Memory::endian(in, size, wordSize);
+                        }
                     }
-#endif // DJV_MMAP
                     break;
                 }
                 case Mode::ReadWrite:
@@ -385,35 +377,19 @@ namespace djv
                 {
                 case Mode::Read:
                 {
-#if defined(DJV_MMAP)
-                    if (!seek)
-                    {
-                        _mmapP = reinterpret_cast<const uint8_t*>(_mmapStart) + value;
-                    }
-                    else
-                    {
-                        _mmapP += value;
-                    }
-                    if (_mmapP > _mmapEnd)
+                    if (_mmapStart)
                     {
-                        throw Error(getErrorMessage(ErrorType::SeekMemoryMap, _fileName));
+                        const uint8_t* p = !seek ? (_mmapStart + value) : (_mmapP + value);
+                        if (p > _mmapEnd)
+                        {
+                            throw Error(getErrorMessage(ErrorType::SeekMemoryMap, _fileName));
+                        }
+                        _mmapP = p;
                     }
-#else // DJV_MMAP
-                    /*LARGE_INTEGER v;
-                    v.QuadPart = value;
-                    if (!::SetFilePointerEx(
-                        _f,
-                        static_cast<LARGE_INTEGER>(v),
-                        0,
-                        !seek ? FILE_BEGIN : FILE_CURRENT))
-                    {
-                        throw Error(getErrorMessage(ErrorType::Seek, _fileName));
-                    }*/
-                    if (fseek(_f, value, !seek ? SEEK_SET : SEEK_CUR) != 0)
+                    else if (fseek(_f, value, !seek ? SEEK_SET : SEEK_CUR) != 0)
                     {
                         throw Error(getErrorMessage(ErrorType::Seek, _fileName));
                     }
-#endif // DJV_MMAP
                     break;
                 }
                 case Mode::Write:
@@ -0,0 +1,286 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCore/FilePrefetch.h>
+
+#include <djvCore/FileIO.h>
+
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace FileSystem
+        {
+            bool FilePrefetchStats::operator == (const FilePrefetchStats& other) const
+            {
+                return
+                    queueCount == other.queueCount &&
+                    fileCount == other.fileCount &&
+                    byteCount == other.byteCount &&
+                    consumedFileCount == other.consumedFileCount &&
+                    consumedByteCount == other.consumedByteCount &&
+                    lateFileCount == other.lateFileCount;
+            }
+
+            struct FilePrefetch::Private
+            {
+                //! This struct provides a prefetched file.
+                struct File
+                {
+                    size_t byteCount = 0;
+                    std::list<std::string>::iterator order;
+                };
+
+                mutable std::mutex mutex;
+                std::condition_variable queueCV;
+                std::condition_variable doneCV;
+                size_t maxCount = 0;
+                std::list<std::string> queue;
+                std::set<std::string> queueSet;
+                bool busy = false;
+                std::set<std::string> batchSet;
+                std::set<std::string> late;
+                std::list<std::string> order;
+                std::map<std::string, File> files;
+                FilePrefetchStats stats;
+                std::thread thread;
+                bool running = false;
+            };
+
+            void FilePrefetch::_init(size_t maxCount)
+            {
+                DJV_PRIVATE_PTR();
+                p.maxCount = maxCount;
+            }
+
+            FilePrefetch::FilePrefetch() :
+                _p(new Private)
+            {}
+
+            FilePrefetch::~FilePrefetch()
+            {
+                DJV_PRIVATE_PTR();
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    p.running = false;
+                }
+                p.queueCV.notify_one();
+                if (p.thread.joinable())
+                {
+                    p.thread.join();
+                }
+            }
+
+            std::shared_ptr<FilePrefetch> FilePrefetch::create(size_t maxCount)
+            {
+                auto out = std::shared_ptr<FilePrefetch>(new FilePrefetch);
+                out->_init(maxCount);
+                return out;
+            }
+
+            const std::shared_ptr<FilePrefetch>& FilePrefetch::getGlobal()
+            {
+                static const std::shared_ptr<FilePrefetch> prefetch = FilePrefetch::create();
+                return prefetch;
+            }
+
+            size_t FilePrefetch::getMaxCount() const
+            {
+                return _p->maxCount;
+            }
+
+            FilePrefetchStats FilePrefetch::getStats() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                FilePrefetchStats out = p.stats;
+                out.queueCount = p.queue.size();
+                return out;
+            }
+
+            void FilePrefetch::add(const std::vector<std::string>& value)
+            {
+                DJV_PRIVATE_PTR();
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    for (const auto& i : value)
+                    {
+                        if (p.queueSet.find(i) == p.queueSet.end() &&
+                            p.files.find(i) == p.files.end())
+                        {
+                            p.queue.push_back(i);
+                            p.queueSet.insert(i);
+                        }
+                    }
+                    while (p.queue.size() > p.maxCount)
+                    {
+                        p.queueSet.erase(p.queue.back());
+                        p.queue.pop_back();
+                    }
+
+                    // The thread is started the first time files are added so
+                    // that applications which never prefetch don't pay for it.
+                    if (!p.running && p.queue.size())
+                    {
+                        p.running = true;
+                        p.thread = std::thread(
+                            [this]
+                            {
+                                _run();
+                            });
+                    }
+                }
+                p.queueCV.notify_one();
+            }
+
+            void FilePrefetch::clear()
+            {
+                DJV_PRIVATE_PTR();
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    p.queue.clear();
+                    p.queueSet.clear();
+                }
+                p.doneCV.notify_all();
+            }
+
+            void FilePrefetch::wait()
+            {
+                DJV_PRIVATE_PTR();
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.doneCV.wait(
+                    lock,
+                    [this]
+                    {
+                        return _p->queue.empty() && !_p->busy;
+                    });
+            }
+
+            void FilePrefetch::consume(const std::string& value)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.files.find(value);
+                if (i != p.files.end())
+                {
+                    ++p.stats.consumedFileCount;
+                    p.stats.consumedByteCount += i->second.byteCount;
+                    p.order.erase(i->second.order);
+                    p.files.erase(i);
+                }
+                else if (p.queueSet.erase(value))
+                {
+                    p.queue.remove(value);
+                    ++p.stats.lateFileCount;
+                }
+                else if (p.batchSet.find(value) != p.batchSet.end())
+                {
+                    // The file is counted when the batch is finished.
+                    p.late.insert(value);
+                }
+            }
+
+            void FilePrefetch::_run()
+            {
+                DJV_PRIVATE_PTR();
+                while (true)
+                {
+                    // Take all of the queued files as one batch.
+                    std::list<std::string> batch;
+                    {
+                        std::unique_lock<std::mutex> lock(p.mutex);
+                        p.queueCV.wait(
+                            lock,
+                            [this]
+                            {
+                                return !_p->running || _p->queue.size();
+                            });
+                        if (!p.running)
+                        {
+                            break;
+                        }
+                        batch = std::move(p.queue);
+                        p.queue.clear();
+                        p.batchSet = std::move(p.queueSet);
+                        p.queueSet.clear();
+                        p.busy = true;
+                    }
+
+                    // Prefetch the files outside of the lock.
+                    std::vector<std::pair<std::string, size_t> > results;
+                    for (const auto& i : batch)
+                    {
+                        const size_t byteCount = FileIO::prefetch(i);
+                        if (byteCount)
+                        {
+                            results.push_back(std::make_pair(i, byteCount));
+                        }
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> lock(p.mutex);
+                        for (const auto& i : results)
+                        {
+                            // Files that were opened before they were prefetched
+                            // are not added.
+                            if (p.late.find(i.first) == p.late.end() &&
+                                p.files.find(i.first) == p.files.end())
+                            {
+                                Private::File file;
+                                file.byteCount = i.second;
+                                file.order = p.order.insert(p.order.end(), i.first);
+                                p.files[i.first] = file;
+                                ++p.stats.fileCount;
+                                p.stats.byteCount += i.second;
+                            }
+                        }
+                        while (p.files.size() > p.maxCount)
+                        {
+                            p.files.erase(p.order.front());
+                            p.order.pop_front();
+                        }
+                        p.stats.lateFileCount += p.late.size();
+                        p.late.clear();
+                        p.batchSet.clear();
+                        p.busy = false;
+                    }
+                    p.doneCV.notify_all();
+                }
+            }
+
+        } // namespace FileSystem
+    } // namespace Core
+} // namespace djv
@@ -0,0 +1,117 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace FileSystem
+        {
+            //! This constant provides the default maximum number of files tracked
+            //! by the file prefetcher.
+            const size_t filePrefetchMaxCountDefault = 1000;
+
+            //! This struct provides file prefetch statistics.
+            struct FilePrefetchStats
+            {
+                size_t queueCount        = 0;
+                size_t fileCount         = 0;
+                size_t byteCount         = 0;
+                size_t consumedFileCount = 0;
+                size_t consumedByteCount = 0;
+                size_t lateFileCount     = 0;
+
+                bool operator == (const FilePrefetchStats&) const;
+            };
+
+            //! This class provides asynchronous file prefetching.
+            //!
+            //! File names are queued in batches and a background thread asks the
+            //! operating system to read the files ahead of time with
+            //! FileIO::prefetch(), so that the bytes are already in memory when
+            //! the files are opened. Opening a prefetched file with FileIO counts
+            //! the file as consumed. Opening a file that is still queued or
+            //! being prefetched counts the file as late instead.
+            //!
+            //! The queue and the list of prefetched files are bounded by a
+            //! maximum count. The last queued files are dropped first since
+            //! they are the furthest ahead, and the oldest prefetched files
+            //! are dropped first.
+            class FilePrefetch
+            {
+                DJV_NON_COPYABLE(FilePrefetch);
+                void _init(size_t maxCount);
+                FilePrefetch();
+
+            public:
+                ~FilePrefetch();
+
+                //! Create a new file prefetcher.
+                static std::shared_ptr<FilePrefetch> create(size_t maxCount = filePrefetchMaxCountDefault);
+
+                //! Get the global file prefetcher used by FileIO.
+                static const std::shared_ptr<FilePrefetch>& getGlobal();
+
+                //! Get the maximum number of files.
+                size_t getMaxCount() const;
+
+                //! Get the prefetch statistics.
+                FilePrefetchStats getStats() const;
+
+                //! Add files to be prefetched. Files that are already queued or
+                //! prefetched are ignored.
+                void add(const std::vector<std::string>&);
+
+                //! Remove all of the queued files.
+                void clear();
+
+                //! Wait for the queued files to be prefetched.
+                void wait();
+
+                //! Mark a file as consumed. Queued files are removed from the
+                //! queue since they no longer need to be prefetched.
+                void consume(const std::string&);
+
+            private:
+                void _run();
+
+                DJV_PRIVATE();
+            };
+
+        } // namespace FileSystem
+    } // namespace Core
+} // namespace djv
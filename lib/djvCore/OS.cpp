@@ -32,6 +32,7 @@
 #include <djvCore/String.h>
 
 #include <algorithm>
+#include <thread>
 
 //#pragma optimize("", off)
 
@@ -41,6 +42,11 @@ namespace djv
     {
         namespace OS
         {
+            size_t getCoreCount()
+            {
+                return std::max(std::thread::hardware_concurrency(), 1U);
+            }
+
             char getListSeparator(ListSeparator value)
             {
                 return ListSeparator::Unix == value ? ':' : ';';
@@ -53,6 +53,9 @@ namespace djv
             //! Get the total amount of RAM available.
             size_t getRAMSize();
 
+            //! Get the number of CPU cores.
+            size_t getCoreCount();
+
             //! Get the current user.
             //! Throws:
             //! - std::exception
@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <vector>
+
+namespace djv
+{
+    namespace Core
+    {
+        //! This class provides a single producer, single consumer queue.
+        //!
+        //! The queue is backed by a preallocated ring buffer, and pushing and
+        //! popping are wait-free while there is room in the ring buffer. Items
+        //! pushed while the ring buffer is full are kept in an overflow list
+        //! guarded by a mutex, so nothing is dropped.
+        //!
+        //! Only one thread may push items and only one thread may pop them.
+        //! The other functions may be called from either thread.
+        template<typename T>
+        class SPSCQueue
+        {
+            DJV_NON_COPYABLE(SPSCQueue);
+
+        public:
+            SPSCQueue();
+
+            //! Get the ring buffer capacity.
+            size_t getCapacity() const;
+
+            //! Set the ring buffer capacity. This removes all of the items and
+            //! is not thread safe.
+            void setCapacity(size_t);
+
+            size_t getCount() const;
+            bool isEmpty() const;
+
+            //! Add an item to the back of the queue. This is only called by
+            //! the producer. Returns false if the ring buffer is full and the
+            //! item went to the overflow list.
+            bool push(const T&);
+
+            //! Remove the item at the front of the queue. This is only called
+            //! by the consumer. Returns false if the queue is empty.
+            bool pop(T&);
+
+            //! Get the item at the front of the queue. Returns false if the
+            //! queue is empty.
+            bool peek(T&) const;
+
+            //! Remove all of the items.
+            void clear();
+
+            //! \name Finished
+            //! The producer sets this flag when there are no more items. The
+            //! consumer should check it before checking whether the queue is
+            //! empty.
+            ///@{
+
+            bool isFinished() const;
+            void setFinished(bool);
+
+            ///@}
+
+        private:
+            bool _hasRoom(uint64_t tail) const;
+            void _trim(uint64_t tail);
+
+            std::vector<T> _ring;
+            std::atomic<uint64_t> _head;
+            std::atomic<uint64_t> _tail;
+            std::atomic<uint64_t> _clear;
+            uint64_t _trimmed = 0;
+            std::list<T> _overflow;
+            std::atomic<size_t> _overflowCount;
+            mutable std::mutex _overflowMutex;
+            std::atomic<bool> _finished;
+        };
+
+    } // namespace Core
+} // namespace djv
+
+#include <djvCore/SPSCQueueInline.h>
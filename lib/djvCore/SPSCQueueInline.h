@@ -0,0 +1,231 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+
+namespace djv
+{
+    namespace Core
+    {
+        // Items are addressed by ever increasing 64-bit positions, the ring
+        // buffer slot is the position modulo the capacity. The producer owns
+        // the tail, the consumer owns the head, and the clear position lets
+        // either thread skip the items in front of it. The producer only
+        // writes slots that are behind the consumer's head, so the consumer
+        // can copy an item out of its slot without any locking.
+
+        template<typename T>
+        inline SPSCQueue<T>::SPSCQueue() :
+            _head(0),
+            _tail(0),
+            _clear(0),
+            _overflowCount(0),
+            _finished(false)
+        {}
+
+        template<typename T>
+        inline size_t SPSCQueue<T>::getCapacity() const
+        {
+            return _ring.size();
+        }
+
+        template<typename T>
+        inline void SPSCQueue<T>::setCapacity(size_t value)
+        {
+            _ring.clear();
+            _ring.resize(value);
+            _head = 0;
+            _tail = 0;
+            _clear = 0;
+            _trimmed = 0;
+            std::lock_guard<std::mutex> lock(_overflowMutex);
+            _overflow.clear();
+            _overflowCount = 0;
+        }
+
+        template<typename T>
+        inline size_t SPSCQueue<T>::getCount() const
+        {
+            const uint64_t tail = _tail.load(std::memory_order_acquire);
+            const uint64_t head = std::max(_head.load(std::memory_order_acquire), _clear.load(std::memory_order_acquire));
+            return static_cast<size_t>(head < tail ? (tail - head) : 0) + _overflowCount.load();
+        }
+
+        template<typename T>
+        inline bool SPSCQueue<T>::isEmpty() const
+        {
+            return 0 == getCount();
+        }
+
+        template<typename T>
+        inline bool SPSCQueue<T>::push(const T& value)
+        {
+            const uint64_t tail = _tail.load(std::memory_order_relaxed);
+            _trim(tail);
+            if (0 == _overflowCount.load() && _hasRoom(tail))
+            {
+                _ring[tail % _ring.size()] = value;
+                _tail.store(tail + 1, std::memory_order_release);
+                return true;
+            }
+
+            // Move any items from the overflow list into the ring buffer first
+            // so they stay in order.
+            std::lock_guard<std::mutex> lock(_overflowMutex);
+            uint64_t t = tail;
+            while (_overflow.size() && _hasRoom(t))
+            {
+                _ring[t % _ring.size()] = std::move(_overflow.front());
+                _overflow.pop_front();
+                --_overflowCount;
+                ++t;
+                _tail.store(t, std::memory_order_release);
+            }
+            if (_overflow.empty() && _hasRoom(t))
+            {
+                _ring[t % _ring.size()] = value;
+                _tail.store(t + 1, std::memory_order_release);
+                return true;
+            }
+            _overflow.push_back(value);
+            ++_overflowCount;
+            return false;
+        }
+
+        template<typename T>
+        inline bool SPSCQueue<T>::pop(T& out)
+        {
+            uint64_t tail = _tail.load(std::memory_order_acquire);
+            uint64_t head = std::max(_head.load(std::memory_order_relaxed), _clear.load(std::memory_order_acquire));
+            if (head < tail)
+            {
+                out = _ring[head % _ring.size()];
+                _head.store(head + 1, std::memory_order_release);
+                return true;
+            }
+            if (_overflowCount.load() > 0)
+            {
+                std::lock_guard<std::mutex> lock(_overflowMutex);
+
+                // The producer may have moved items into the ring buffer while
+                // we were waiting for the lock.
+                tail = _tail.load(std::memory_order_acquire);
+                head = std::max(_head.load(std::memory_order_relaxed), _clear.load(std::memory_order_acquire));
+                if (head < tail)
+                {
+                    out = _ring[head % _ring.size()];
+                    _head.store(head + 1, std::memory_order_release);
+                    return true;
+                }
+                if (_overflow.size())
+                {
+                    out = std::move(_overflow.front());
+                    _overflow.pop_front();
+                    --_overflowCount;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        template<typename T>
+        inline bool SPSCQueue<T>::peek(T& out) const
+        {
+            uint64_t tail = _tail.load(std::memory_order_acquire);
+            uint64_t head = std::max(_head.load(std::memory_order_acquire), _clear.load(std::memory_order_acquire));
+            if (head < tail)
+            {
+                out = _ring[head % _ring.size()];
+                return true;
+            }
+            if (_overflowCount.load() > 0)
+            {
+                std::lock_guard<std::mutex> lock(_overflowMutex);
+                tail = _tail.load(std::memory_order_acquire);
+                head = std::max(_head.load(std::memory_order_acquire), _clear.load(std::memory_order_acquire));
+                if (head < tail)
+                {
+                    out = _ring[head % _ring.size()];
+                    return true;
+                }
+                if (_overflow.size())
+                {
+                    out = _overflow.front();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        template<typename T>
+        inline void SPSCQueue<T>::clear()
+        {
+            std::lock_guard<std::mutex> lock(_overflowMutex);
+            _overflow.clear();
+            _overflowCount = 0;
+            const uint64_t tail = _tail.load(std::memory_order_acquire);
+            uint64_t clear = _clear.load();
+            while (clear < tail && !_clear.compare_exchange_weak(clear, tail))
+                ;
+        }
+
+        template<typename T>
+        inline bool SPSCQueue<T>::isFinished() const
+        {
+            return _finished;
+        }
+
+        template<typename T>
+        inline void SPSCQueue<T>::setFinished(bool value)
+        {
+            _finished = value;
+        }
+
+        template<typename T>
+        inline bool SPSCQueue<T>::_hasRoom(uint64_t tail) const
+        {
+            return _ring.size() && (tail - _head.load(std::memory_order_acquire)) < _ring.size();
+        }
+
+        template<typename T>
+        inline void SPSCQueue<T>::_trim(uint64_t tail)
+        {
+            // Release the items the consumer has finished with.
+            const size_t size = _ring.size();
+            const uint64_t head = _head.load(std::memory_order_acquire);
+            uint64_t i = std::max(_trimmed, tail > size ? (tail - size) : 0);
+            for (; i < head; ++i)
+            {
+                _ring[i % size] = T();
+            }
+            _trimmed = std::max(_trimmed, i);
+        }
+
+    } // namespace Core
+} // namespace djv
@@ -0,0 +1,253 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCore/ThreadPool.h>
+
+#include <djvCore/OS.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace
+        {
+            //! The pool and worker index for the current thread.
+            thread_local const ThreadPool* currentPool = nullptr;
+            thread_local size_t currentWorker = 0;
+
+        } // namespace
+
+        namespace
+        {
+            struct Worker
+            {
+                std::mutex mutex;
+                std::deque<std::function<void(void)> > tasks[static_cast<size_t>(TaskPriority::Count)];
+                std::thread thread;
+            };
+
+        } // namespace
+
+        struct ThreadPool::Private
+        {
+            std::vector<std::unique_ptr<Worker> > workers;
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::atomic<size_t> queueCount;
+            std::atomic<size_t> busyCount;
+            std::atomic<size_t> stealCount;
+            std::atomic<size_t> taskCount;
+            std::atomic<size_t> next;
+            bool running = true;
+        };
+
+        void ThreadPool::_init(size_t threadCount)
+        {
+            DJV_PRIVATE_PTR();
+            p.queueCount = 0;
+            p.busyCount = 0;
+            p.stealCount = 0;
+            p.taskCount = 0;
+            p.next = 0;
+            if (!threadCount)
+            {
+                threadCount = OS::getCoreCount();
+            }
+            for (size_t i = 0; i < threadCount; ++i)
+            {
+                p.workers.push_back(std::unique_ptr<Worker>(new Worker));
+            }
+            for (size_t i = 0; i < threadCount; ++i)
+            {
+                p.workers[i]->thread = std::thread(
+                    [this, i]
+                    {
+                        _run(i);
+                    });
+            }
+        }
+
+        ThreadPool::ThreadPool() :
+            _p(new Private)
+        {}
+
+        ThreadPool::~ThreadPool()
+        {
+            DJV_PRIVATE_PTR();
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.running = false;
+            }
+            p.cv.notify_all();
+            for (auto& i : p.workers)
+            {
+                if (i->thread.joinable())
+                {
+                    i->thread.join();
+                }
+            }
+        }
+
+        std::shared_ptr<ThreadPool> ThreadPool::create(size_t threadCount)
+        {
+            auto out = std::shared_ptr<ThreadPool>(new ThreadPool);
+            out->_init(threadCount);
+            return out;
+        }
+
+        size_t ThreadPool::getThreadCount() const
+        {
+            return _p->workers.size();
+        }
+
+        ThreadPoolStats ThreadPool::getStats() const
+        {
+            DJV_PRIVATE_PTR();
+            ThreadPoolStats out;
+            out.threadCount = p.workers.size();
+            out.queueCount  = p.queueCount;
+            out.busyCount   = p.busyCount;
+            out.stealCount  = p.stealCount;
+            out.taskCount   = p.taskCount;
+            return out;
+        }
+
+        void ThreadPool::addTask(const std::function<void(void)>& value, TaskPriority priority)
+        {
+            DJV_PRIVATE_PTR();
+
+            // Tasks added from a worker go to that worker's queue, otherwise
+            // they are distributed round-robin.
+            const size_t workerCount = p.workers.size();
+            const size_t index = this == currentPool ? currentWorker : (p.next++ % workerCount);
+            {
+                auto& worker = *p.workers[index];
+                std::lock_guard<std::mutex> lock(worker.mutex);
+                worker.tasks[static_cast<size_t>(priority)].push_back(value);
+            }
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                ++p.queueCount;
+            }
+            p.cv.notify_one();
+        }
+
+        void ThreadPool::_run(size_t index)
+        {
+            DJV_PRIVATE_PTR();
+            currentPool = this;
+            currentWorker = index;
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex);
+                    p.cv.wait(
+                        lock,
+                        [this]
+                        {
+                            return _p->queueCount > 0 || !_p->running;
+                        });
+                    if (!p.running && 0 == p.queueCount)
+                    {
+                        break;
+                    }
+                }
+                std::function<void(void)> task;
+                if (_getTask(index, task))
+                {
+                    ++p.busyCount;
+                    try
+                    {
+                        task();
+                    }
+                    catch (const std::exception& e)
+                    {
+                        std::cerr << "djv::Core::ThreadPool: " << e.what() << std::endl;
+                    }
+                    --p.busyCount;
+                    ++p.taskCount;
+                }
+                else
+                {
+                    // Another worker took the task first.
+                    std::this_thread::yield();
+                }
+            }
+            currentPool = nullptr;
+        }
+
+        bool ThreadPool::_getTask(size_t index, std::function<void(void)>& out)
+        {
+            DJV_PRIVATE_PTR();
+            const size_t workerCount = p.workers.size();
+            for (size_t priority = 0; priority < static_cast<size_t>(TaskPriority::Count); ++priority)
+            {
+                // Take the oldest task from our own queue.
+                {
+                    auto& worker = *p.workers[index];
+                    std::lock_guard<std::mutex> lock(worker.mutex);
+                    auto& tasks = worker.tasks[priority];
+                    if (tasks.size())
+                    {
+                        out = std::move(tasks.front());
+                        tasks.pop_front();
+                        --p.queueCount;
+                        return true;
+                    }
+                }
+
+                // Steal the oldest task from another worker's queue.
+                for (size_t i = 1; i < workerCount; ++i)
+                {
+                    auto& worker = *p.workers[(index + i) % workerCount];
+                    std::lock_guard<std::mutex> lock(worker.mutex);
+                    auto& tasks = worker.tasks[priority];
+                    if (tasks.size())
+                    {
+                        out = std::move(tasks.front());
+                        tasks.pop_front();
+                        --p.queueCount;
+                        ++p.stealCount;
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+    } // namespace Core
+} // namespace djv
@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <functional>
+#include <future>
+#include <memory>
+
+namespace djv
+{
+    namespace Core
+    {
+        //! This enumeration provides thread pool task priorities.
+        enum class TaskPriority
+        {
+            High,
+            Low,
+
+            Count,
+            First = High
+        };
+
+        //! This struct provides thread pool statistics.
+        struct ThreadPoolStats
+        {
+            size_t threadCount = 0;
+            size_t queueCount  = 0;
+            size_t busyCount   = 0;
+            size_t stealCount  = 0;
+            size_t taskCount   = 0;
+
+            bool operator == (const ThreadPoolStats&) const;
+        };
+
+        //! This class provides a pool of worker threads.
+        //!
+        //! Each worker has it's own task queue for each priority. Tasks added
+        //! from outside of the pool are distributed across the workers, and idle
+        //! workers steal tasks from the other workers. High priority tasks are
+        //! run before low priority tasks.
+        class ThreadPool : public std::enable_shared_from_this<ThreadPool>
+        {
+            DJV_NON_COPYABLE(ThreadPool);
+            void _init(size_t threadCount);
+            ThreadPool();
+
+        public:
+            ~ThreadPool();
+
+            //! Create a new thread pool. If the thread count is zero the
+            //! number of CPU cores is used.
+            static std::shared_ptr<ThreadPool> create(size_t threadCount = 0);
+
+            //! Get the number of threads.
+            size_t getThreadCount() const;
+
+            //! Get the pool statistics.
+            ThreadPoolStats getStats() const;
+
+            //! Add a task.
+            void addTask(const std::function<void(void)>&, TaskPriority = TaskPriority::High);
+
+            //! Add a task and get a future for the result.
+            template<typename T>
+            std::future<T> addTaskFuture(const std::function<T(void)>&, TaskPriority = TaskPriority::High);
+
+        private:
+            void _run(size_t);
+            bool _getTask(size_t, std::function<void(void)>&);
+
+            DJV_PRIVATE();
+        };
+
+    } // namespace Core
+} // namespace djv
+
+#include <djvCore/ThreadPoolInline.h>
@@ -294,13 +294,13 @@ namespace djv
                 std::shared_ptr<AV::Image::Image> image;
                 bool finished = false;
                 {
-                    std::lock_guard<std::mutex> lock(i->read->getMutex());
                     auto& queue = i->read->getVideoQueue();
+                    const bool queueFinished = queue.isFinished();
                     if (!queue.isEmpty())
                     {
                         image = queue.getFrame().image;
                     }
-                    else if (queue.isFinished())
+                    else if (queueFinished)
                     {
                         finished = true;
                     }
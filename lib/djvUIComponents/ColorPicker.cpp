@@ -148,8 +148,11 @@ namespace djv
             p.comboBox->clearItems();
             for (size_t i = static_cast<size_t>(AV::Image::Type::L_U8); i < static_cast<size_t>(AV::Image::Type::Count); ++i)
             {
+                const auto type = static_cast<AV::Image::Type>(i);
+                if (AV::Image::isYUVType(type))
+                    continue;
                 std::stringstream ss;
-                ss << static_cast<AV::Image::Type>(i);
+                ss << type;
                 p.comboBox->addItem(_getText(ss.str()));
             }
             p.comboBox->setCurrentItem(static_cast<int>(p.type) - 1);
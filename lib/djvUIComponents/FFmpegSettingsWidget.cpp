@@ -29,6 +29,7 @@
 
 #include <djvUIComponents/FFmpegSettingsWidget.h>
 
+#include <djvUI/ComboBox.h>
 #include <djvUI/FormLayout.h>
 #include <djvUI/GroupBox.h>
 #include <djvUI/IntSlider.h>
@@ -46,6 +47,7 @@ namespace djv
         struct FFmpegSettingsWidget::Private
         {
             std::shared_ptr<IntSlider> threadCountSlider;
+            std::shared_ptr<ComboBox> threadTypeComboBox;
             std::shared_ptr<FormLayout> layout;
         };
 
@@ -59,8 +61,11 @@ namespace djv
             p.threadCountSlider = IntSlider::create(context);
             p.threadCountSlider->setRange(IntRange(1, 16));
 
+            p.threadTypeComboBox = ComboBox::create(context);
+
             p.layout = FormLayout::create(context);
             p.layout->addChild(p.threadCountSlider);
+            p.layout->addChild(p.threadTypeComboBox);
             addChild(p.layout);
 
             _widgetUpdate();
@@ -82,6 +87,22 @@ namespace djv
                         }
                     }
                 });
+
+            p.threadTypeComboBox->setCallback(
+                [weak, contextWeak](int value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            auto io = context->getSystemT<AV::IO::System>();
+                            AV::IO::FFmpeg::Options options;
+                            fromJSON(io->getOptions(AV::IO::FFmpeg::pluginName), options);
+                            options.threadType = static_cast<AV::IO::FFmpeg::ThreadType>(value);
+                            io->setOptions(AV::IO::FFmpeg::pluginName, toJSON(options));
+                        }
+                    }
+                });
         }
 
         FFmpegSettingsWidget::FFmpegSettingsWidget() :
@@ -120,6 +141,7 @@ namespace djv
             ISettingsWidget::_initEvent(event);
             DJV_PRIVATE_PTR();
             p.layout->setText(p.threadCountSlider, _getText(DJV_TEXT("settings_io_ffmpeg_thread_count")) + ":");
+            p.layout->setText(p.threadTypeComboBox, _getText(DJV_TEXT("settings_io_ffmpeg_thread_type")) + ":");
             _widgetUpdate();
         }
 
@@ -133,6 +155,15 @@ namespace djv
                 fromJSON(io->getOptions(AV::IO::FFmpeg::pluginName), options);
 
                 p.threadCountSlider->setValue(options.threadCount);
+
+                p.threadTypeComboBox->clearItems();
+                for (auto i : AV::IO::FFmpeg::getThreadTypeEnums())
+                {
+                    std::stringstream ss;
+                    ss << i;
+                    p.threadTypeComboBox->addItem(_getText(ss.str()));
+                }
+                p.threadTypeComboBox->setCurrentItem(static_cast<int>(options.threadType));
             }
         }
 
@@ -104,7 +104,6 @@ namespace djv
                                                 {
                                                     std::shared_ptr<AV::Image::Image> image;
                                                     {
-                                                        std::unique_lock<std::mutex> lock(widget->_p->read->getMutex());
                                                         auto& queue = widget->_p->read->getVideoQueue();
                                                         if (!queue.isEmpty())
                                                         {
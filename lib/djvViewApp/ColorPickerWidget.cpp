@@ -504,7 +504,7 @@ namespace djv
 
                     const size_t sampleSize = std::max(p.sampleSize, bufferSizeMin);
                     const AV::Image::Size size(sampleSize, sampleSize);
-                    const AV::Image::Type type = p.typeLock != AV::Image::Type::None ? p.typeLock : p.image->getType();
+                    const AV::Image::Type type = p.typeLock != AV::Image::Type::None ? p.typeLock : AV::Image::getRGBType(p.image->getType());
                     
                     bool create = !p.offscreenBuffer;
                     create |= p.offscreenBuffer && size != p.offscreenBuffer->getSize();
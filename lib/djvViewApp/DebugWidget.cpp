@@ -48,6 +48,7 @@
 #include <djvAV/ThumbnailSystem.h>
 
 #include <djvCore/Context.h>
+#include <djvCore/ThreadPool.h>
 #include <djvCore/Timer.h>
 
 using namespace djv::Core;
@@ -553,6 +554,135 @@ namespace djv
                 }
             }
 
+            class IODebugWidget : public IDebugWidget
+            {
+                DJV_NON_COPYABLE(IODebugWidget);
+
+            protected:
+                void _init(const std::shared_ptr<Context>&);
+                IODebugWidget();
+
+            public:
+                static std::shared_ptr<IODebugWidget> create(const std::shared_ptr<Context>&);
+
+            protected:
+                void _widgetUpdate() override;
+            };
+
+            void IODebugWidget::_init(const std::shared_ptr<Context>& context)
+            {
+                IDebugWidget::_init(context);
+
+                setClassName("djv::ViewApp::IODebugWidget");
+
+                _labels["ThreadPoolQueue"] = UI::Label::create(context);
+                _labels["ThreadPoolQueueValue"] = UI::Label::create(context);
+                _labels["ThreadPoolQueueValue"]->setFont(AV::Font::familyMono);
+                _lineGraphs["ThreadPoolQueue"] = UI::LineGraphWidget::create(context);
+                _lineGraphs["ThreadPoolQueue"]->setPrecision(0);
+
+                _labels["ThreadPoolBusy"] = UI::Label::create(context);
+                _labels["ThreadPoolBusyValue"] = UI::Label::create(context);
+                _labels["ThreadPoolBusyValue"]->setFont(AV::Font::familyMono);
+                _thermometerWidgets["ThreadPoolBusy"] = UI::ThermometerWidget::create(context);
+
+                _labels["ThreadPoolSteals"] = UI::Label::create(context);
+                _labels["ThreadPoolStealsValue"] = UI::Label::create(context);
+                _labels["ThreadPoolStealsValue"]->setFont(AV::Font::familyMono);
+
+                for (auto& i : _labels)
+                {
+                    i.second->setTextHAlign(UI::TextHAlign::Left);
+                }
+
+                _layout = UI::VerticalLayout::create(context);
+                _layout->setMargin(UI::Layout::Margin(UI::MetricsRole::Margin));
+                auto hLayout = UI::HorizontalLayout::create(context);
+                hLayout->addChild(_labels["ThreadPoolQueue"]);
+                hLayout->addChild(_labels["ThreadPoolQueueValue"]);
+                _layout->addChild(hLayout);
+                _layout->addChild(_lineGraphs["ThreadPoolQueue"]);
+                hLayout = UI::HorizontalLayout::create(context);
+                hLayout->addChild(_labels["ThreadPoolBusy"]);
+                hLayout->addChild(_labels["ThreadPoolBusyValue"]);
+                _layout->addChild(hLayout);
+                _layout->addChild(_thermometerWidgets["ThreadPoolBusy"]);
+                hLayout = UI::HorizontalLayout::create(context);
+                hLayout->addChild(_labels["ThreadPoolSteals"]);
+                hLayout->addChild(_labels["ThreadPoolStealsValue"]);
+                _layout->addChild(hLayout);
+                addChild(_layout);
+
+                _timer = Time::Timer::create(context);
+                _timer->setRepeating(true);
+                auto weak = std::weak_ptr<IODebugWidget>(std::dynamic_pointer_cast<IODebugWidget>(shared_from_this()));
+                _timer->start(
+                    Core::Time::getTime(Core::Time::TimerValue::Medium),
+                    [weak](const std::chrono::steady_clock::time_point&, const Time::Unit&)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_widgetUpdate();
+                    }
+                });
+            }
+
+            IODebugWidget::IODebugWidget()
+            {}
+
+            std::shared_ptr<IODebugWidget> IODebugWidget::create(const std::shared_ptr<Context>& context)
+            {
+                auto out = std::shared_ptr<IODebugWidget>(new IODebugWidget);
+                out->_init(context);
+                return out;
+            }
+
+            void IODebugWidget::_widgetUpdate()
+            {
+                if (auto context = getContext().lock())
+                {
+                    auto io = context->getSystemT<AV::IO::System>();
+                    const auto stats = io->getThreadPool()->getStats();
+                    const float busyPercentage = stats.threadCount ?
+                        (stats.busyCount / static_cast<float>(stats.threadCount) * 100.F) :
+                        0.F;
+
+                    _lineGraphs["ThreadPoolQueue"]->addSample(stats.queueCount);
+                    _thermometerWidgets["ThreadPoolBusy"]->setPercentage(busyPercentage);
+
+                    {
+                        std::stringstream ss;
+                        ss << _getText(DJV_TEXT("debug_io_thread_pool_queue")) << ":";
+                        _labels["ThreadPoolQueue"]->setText(ss.str());
+                    }
+                    {
+                        std::stringstream ss;
+                        ss << stats.queueCount;
+                        _labels["ThreadPoolQueueValue"]->setText(ss.str());
+                    }
+                    {
+                        std::stringstream ss;
+                        ss << _getText(DJV_TEXT("debug_io_thread_pool_busy")) << ":";
+                        _labels["ThreadPoolBusy"]->setText(ss.str());
+                    }
+                    {
+                        std::stringstream ss;
+                        ss << stats.busyCount << " / " << stats.threadCount;
+                        _labels["ThreadPoolBusyValue"]->setText(ss.str());
+                    }
+                    {
+                        std::stringstream ss;
+                        ss << _getText(DJV_TEXT("debug_io_thread_pool_steals")) << ":";
+                        _labels["ThreadPoolSteals"]->setText(ss.str());
+                    }
+                    {
+                        std::stringstream ss;
+                        ss << stats.stealCount;
+                        _labels["ThreadPoolStealsValue"]->setText(ss.str());
+                    }
+                }
+            }
+
             class MediaDebugWidget : public UI::Widget
             {
                 DJV_NON_COPYABLE(MediaDebugWidget);
@@ -804,6 +934,12 @@ namespace djv
             p.bellows["Render"]->addChild(renderDebugWidget);
             layout->addChild(p.bellows["Render"]);
 
+            auto ioDebugWidget = IODebugWidget::create(context);
+            p.bellows["IO"] = UI::Bellows::create(context);
+            p.bellows["IO"]->setOpen(false);
+            p.bellows["IO"]->addChild(ioDebugWidget);
+            layout->addChild(p.bellows["IO"]);
+
             auto mediaDebugWidget = MediaDebugWidget::create(context);
             p.bellows["Media"] = UI::Bellows::create(context);
             p.bellows["Media"]->setOpen(false);
@@ -863,6 +999,7 @@ namespace djv
             setTitle(_getText(DJV_TEXT("debug_title")));
             p.bellows["General"]->setText(_getText(DJV_TEXT("debug_section_general")));
             p.bellows["Render"]->setText(_getText(DJV_TEXT("debug_section_render")));
+            p.bellows["IO"]->setText(_getText(DJV_TEXT("debug_section_io")));
             p.bellows["Media"]->setText(_getText(DJV_TEXT("debug_section_media")));
         }
 
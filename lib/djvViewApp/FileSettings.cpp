@@ -52,6 +52,10 @@ namespace djv
             std::shared_ptr<ValueSubject<bool> > autoDetectSequences;
             std::shared_ptr<ValueSubject<bool> > cacheEnabled;
             std::shared_ptr<ValueSubject<int> > cacheMaxGB;
+            std::shared_ptr<ValueSubject<int> > cacheCompressedMaxGB;
+            std::shared_ptr<ValueSubject<bool> > diskCacheEnabled;
+            std::shared_ptr<ValueSubject<int> > diskCacheMaxGB;
+            std::shared_ptr<ValueSubject<std::string> > diskCachePath;
             std::map<std::string, BBox2f> widgetGeom;
         };
 
@@ -65,6 +69,10 @@ namespace djv
             p.autoDetectSequences = ValueSubject<bool>::create(true);
             p.cacheEnabled = ValueSubject<bool>::create(true);
             p.cacheMaxGB = ValueSubject<int>::create(4);
+            p.cacheCompressedMaxGB = ValueSubject<int>::create(0);
+            p.diskCacheEnabled = ValueSubject<bool>::create(false);
+            p.diskCacheMaxGB = ValueSubject<int>::create(20);
+            p.diskCachePath = ValueSubject<std::string>::create();
             _load();
         }
 
@@ -156,6 +164,46 @@ namespace djv
             _p->cacheMaxGB->setIfChanged(value);
         }
 
+        std::shared_ptr<IValueSubject<int> > FileSettings::observeCacheCompressedMaxGB() const
+        {
+            return _p->cacheCompressedMaxGB;
+        }
+
+        void FileSettings::setCacheCompressedMaxGB(int value)
+        {
+            _p->cacheCompressedMaxGB->setIfChanged(value);
+        }
+
+        std::shared_ptr<IValueSubject<bool> > FileSettings::observeDiskCacheEnabled() const
+        {
+            return _p->diskCacheEnabled;
+        }
+
+        std::shared_ptr<IValueSubject<int> > FileSettings::observeDiskCacheMaxGB() const
+        {
+            return _p->diskCacheMaxGB;
+        }
+
+        std::shared_ptr<IValueSubject<std::string> > FileSettings::observeDiskCachePath() const
+        {
+            return _p->diskCachePath;
+        }
+
+        void FileSettings::setDiskCacheEnabled(bool value)
+        {
+            _p->diskCacheEnabled->setIfChanged(value);
+        }
+
+        void FileSettings::setDiskCacheMaxGB(int value)
+        {
+            _p->diskCacheMaxGB->setIfChanged(value);
+        }
+
+        void FileSettings::setDiskCachePath(const std::string& value)
+        {
+            _p->diskCachePath->setIfChanged(value);
+        }
+
         const std::map<std::string, BBox2f>& FileSettings::getWidgetGeom() const
         {
             return _p->widgetGeom;
@@ -178,6 +226,10 @@ namespace djv
                 UI::Settings::read("AutoDetectSequences", object, p.autoDetectSequences);
                 UI::Settings::read("CacheEnabled", object, p.cacheEnabled);
                 UI::Settings::read("CacheMax", object, p.cacheMaxGB);
+                UI::Settings::read("CacheCompressedMax", object, p.cacheCompressedMaxGB);
+                UI::Settings::read("DiskCacheEnabled", object, p.diskCacheEnabled);
+                UI::Settings::read("DiskCacheMax", object, p.diskCacheMaxGB);
+                UI::Settings::read("DiskCachePath", object, p.diskCachePath);
                 UI::Settings::read("WidgetGeom", object, p.widgetGeom);
             }
         }
@@ -193,6 +245,10 @@ namespace djv
             UI::Settings::write("AutoDetectSequences", p.autoDetectSequences->get(), object);
             UI::Settings::write("CacheEnabled", p.cacheEnabled->get(), object);
             UI::Settings::write("CacheMax", p.cacheMaxGB->get(), object);
+            UI::Settings::write("CacheCompressedMax", p.cacheCompressedMaxGB->get(), object);
+            UI::Settings::write("DiskCacheEnabled", p.diskCacheEnabled->get(), object);
+            UI::Settings::write("DiskCacheMax", p.diskCacheMaxGB->get(), object);
+            UI::Settings::write("DiskCachePath", p.diskCachePath->get(), object);
             UI::Settings::write("WidgetGeom", p.widgetGeom, object);
             return out;
         }
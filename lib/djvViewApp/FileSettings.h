@@ -79,6 +79,20 @@ namespace djv
             void setCacheEnabled(bool);
             void setCacheMaxGB(int);
 
+            //! The size of the compressed tier of the memory cache, zero
+            //! disables the compressed tier.
+            std::shared_ptr<Core::IValueSubject<int> > observeCacheCompressedMaxGB() const;
+            void setCacheCompressedMaxGB(int);
+
+            //! The disk cache keeps decoded frames between sessions. An empty
+            //! path means the "djv_cache" directory in the temp directory.
+            std::shared_ptr<Core::IValueSubject<bool> > observeDiskCacheEnabled() const;
+            std::shared_ptr<Core::IValueSubject<int> > observeDiskCacheMaxGB() const;
+            std::shared_ptr<Core::IValueSubject<std::string> > observeDiskCachePath() const;
+            void setDiskCacheEnabled(bool);
+            void setDiskCacheMaxGB(int);
+            void setDiskCachePath(const std::string&);
+
             const std::map<std::string, Core::BBox2f>& getWidgetGeom() const;
             void setWidgetGeom(const std::map<std::string, Core::BBox2f>&);
 
@@ -44,8 +44,12 @@
 #include <djvUI/SettingsSystem.h>
 #include <djvUI/Shortcut.h>
 
+#include <djvAV/DiskCache.h>
+#include <djvAV/FrameCache.h>
+
 #include <djvCore/Context.h>
 #include <djvCore/FileInfo.h>
+#include <djvCore/Path.h>
 #include <djvCore/RecentFilesModel.h>
 #include <djvCore/TextSystem.h>
 #include <djvCore/Timer.h>
@@ -68,18 +72,25 @@ namespace djv
             std::shared_ptr<ListSubject<std::shared_ptr<Media> > > media;
             std::shared_ptr<ValueSubject<std::shared_ptr<Media> > > currentMedia;
             std::shared_ptr<ValueSubject<float> > cachePercentage;
+            std::shared_ptr<ValueSubject<AV::IO::FrameCacheStats> > cacheStats;
+            std::shared_ptr<ValueSubject<AV::IO::DiskCacheStats> > diskCacheStats;
             std::map<std::string, std::shared_ptr<UI::Action> > actions;
             std::shared_ptr<UI::Menu> menu;
             std::shared_ptr<UI::FileBrowser::Dialog> fileBrowserDialog;
             Core::FileSystem::Path fileBrowserPath = Core::FileSystem::Path(".");
             std::shared_ptr<RecentFilesDialog> recentFilesDialog;
             size_t threadCount = 4;
+            bool allMediaVisible = true;
             std::shared_ptr<Core::FileSystem::RecentFilesModel> recentFilesModel;
             std::shared_ptr<ListObserver<Core::FileSystem::FileInfo> > recentFilesObserver;
             std::shared_ptr<ListObserver<Core::FileSystem::FileInfo> > recentFilesObserver2;
             std::shared_ptr<ValueObserver<size_t> > threadCountObserver;
             std::shared_ptr<ValueObserver<bool> > cacheEnabledObserver;
             std::shared_ptr<ValueObserver<int> > cacheMaxGBObserver;
+            std::shared_ptr<ValueObserver<int> > cacheCompressedMaxGBObserver;
+            std::shared_ptr<ValueObserver<bool> > diskCacheEnabledObserver;
+            std::shared_ptr<ValueObserver<int> > diskCacheMaxGBObserver;
+            std::shared_ptr<ValueObserver<std::string> > diskCachePathObserver;
             std::map<std::string, std::shared_ptr<ValueObserver<bool> > > actionObservers;
             std::shared_ptr<Time::Timer> cacheTimer;
         };
@@ -99,6 +110,8 @@ namespace djv
             p.media = ListSubject<std::shared_ptr<Media> >::create();
             p.currentMedia = ValueSubject<std::shared_ptr<Media> >::create();
             p.cachePercentage = ValueSubject<float>::create();
+            p.cacheStats = ValueSubject<AV::IO::FrameCacheStats>::create();
+            p.diskCacheStats = ValueSubject<AV::IO::DiskCacheStats>::create();
 
             p.actions["Open"] = UI::Action::create();
             p.actions["Open"]->setIcon("djvIconFileOpen");
@@ -384,6 +397,46 @@ namespace djv
                     }
                 });
 
+            p.cacheCompressedMaxGBObserver = ValueObserver<int>::create(
+                p.settings->observeCacheCompressedMaxGB(),
+                [weak](int value)
+                {
+                    if (auto system = weak.lock())
+                    {
+                        system->_cacheUpdate();
+                    }
+                });
+
+            p.diskCacheEnabledObserver = ValueObserver<bool>::create(
+                p.settings->observeDiskCacheEnabled(),
+                [weak](bool value)
+                {
+                    if (auto system = weak.lock())
+                    {
+                        system->_diskCacheUpdate();
+                    }
+                });
+
+            p.diskCacheMaxGBObserver = ValueObserver<int>::create(
+                p.settings->observeDiskCacheMaxGB(),
+                [weak](int value)
+                {
+                    if (auto system = weak.lock())
+                    {
+                        system->_diskCacheUpdate();
+                    }
+                });
+
+            p.diskCachePathObserver = ValueObserver<std::string>::create(
+                p.settings->observeDiskCachePath(),
+                [weak](const std::string& value)
+                {
+                    if (auto system = weak.lock())
+                    {
+                        system->_diskCacheUpdate();
+                    }
+                });
+
             p.actionObservers["Exit"] = ValueObserver<bool>::create(
                 p.actions["Exit"]->observeClicked(),
                 [weak, contextWeak](bool value)
@@ -416,26 +469,28 @@ namespace djv
 
             p.cacheTimer = Time::Timer::create(context);
             p.cacheTimer->setRepeating(true);
+            auto io = context->getSystemT<AV::IO::System>();
+            auto frameCacheWeak = std::weak_ptr<AV::IO::FrameCache>(io->getFrameCache());
+            auto diskCacheWeak = std::weak_ptr<AV::IO::DiskCache>(io->getDiskCache());
             p.cacheTimer->start(
                 Time::getTime(Time::TimerValue::Medium),
-                [weak](const std::chrono::steady_clock::time_point&, const Time::Unit&)
+                [weak, frameCacheWeak, diskCacheWeak](const std::chrono::steady_clock::time_point&, const Time::Unit&)
                 {
                     if (auto system = weak.lock())
                     {
-                        size_t cacheMaxByteCount  = 0;
-                        size_t cacheByteCount = 0;
-                        for (const auto& i : system->_p->media->get())
+                        if (auto frameCache = frameCacheWeak.lock())
                         {
-                            if (i->hasCache())
-                            {
-                                cacheMaxByteCount  += i->getCacheMaxByteCount();
-                                cacheByteCount += i->getCacheByteCount();
-                            }
+                            const auto stats = frameCache->getStats();
+                            const float percentage = stats.maxByteCount ?
+                                (stats.byteCount / static_cast<float>(stats.maxByteCount) * 100.F) :
+                                0.F;
+                            system->_p->cachePercentage->setIfChanged(percentage);
+                            system->_p->cacheStats->setIfChanged(stats);
+                        }
+                        if (auto diskCache = diskCacheWeak.lock())
+                        {
+                            system->_p->diskCacheStats->setIfChanged(diskCache->getStats());
                         }
-                        const float percentage = cacheMaxByteCount ?
-                            (cacheByteCount / static_cast<float>(cacheMaxByteCount) * 100.F) :
-                            0.F;
-                        system->_p->cachePercentage->setIfChanged(percentage);
                     }
                 });
         }
@@ -496,6 +551,16 @@ namespace djv
             return _p->cachePercentage;
         }
 
+        std::shared_ptr<IValueSubject<AV::IO::FrameCacheStats> > FileSystem::observeCacheStats() const
+        {
+            return _p->cacheStats;
+        }
+
+        std::shared_ptr<IValueSubject<AV::IO::DiskCacheStats> > FileSystem::observeDiskCacheStats() const
+        {
+            return _p->diskCacheStats;
+        }
+
         void FileSystem::open()
         {
             _showFileBrowserDialog();
@@ -601,6 +666,17 @@ namespace djv
             if (p.currentMedia->setIfChanged(media))
             {
                 _actionsUpdate();
+                _readUpdate();
+            }
+        }
+
+        void FileSystem::setAllMediaVisible(bool value)
+        {
+            DJV_PRIVATE_PTR();
+            if (value != p.allMediaVisible)
+            {
+                p.allMediaVisible = value;
+                _readUpdate();
             }
         }
 
@@ -635,22 +711,70 @@ namespace djv
         void FileSystem::_cacheUpdate()
         {
             DJV_PRIVATE_PTR();
-            size_t cacheCount = 0;
-            const auto& media = p.media->get();
-            for (const auto& i : media)
+            // The media share the frame cache, which evicts frames across all
+            // of the media so each media is allowed to use the whole cache.
+            const bool cacheEnabled = p.settings->observeCacheEnabled()->get();
+            const size_t cacheMaxByteCount = p.settings->observeCacheMaxGB()->get() * Memory::gigabyte;
+            const size_t cacheCompressedMaxByteCount = p.settings->observeCacheCompressedMaxGB()->get() * Memory::gigabyte;
+            if (auto context = getContext().lock())
             {
-                if (i->hasCache())
+                auto io = context->getSystemT<AV::IO::System>();
+                io->getFrameCache()->setMaxByteCount(cacheMaxByteCount);
+                io->getFrameCache()->setCompressedMaxByteCount(cacheEnabled ? cacheCompressedMaxByteCount : 0);
+            }
+            for (const auto& i : p.media->get())
+            {
+                i->setCacheEnabled(cacheEnabled);
+                i->setCacheMaxByteCount(cacheMaxByteCount);
+            }
+        }
+
+        void FileSystem::_diskCacheUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            if (auto context = getContext().lock())
+            {
+                auto io = context->getSystemT<AV::IO::System>();
+                const auto& diskCache = io->getDiskCache();
+                if (p.settings->observeDiskCacheEnabled()->get())
                 {
-                    ++cacheCount;
+                    std::string path = p.settings->observeDiskCachePath()->get();
+                    try
+                    {
+                        if (path.empty())
+                        {
+                            path = Core::FileSystem::Path(Core::FileSystem::Path::getTemp(), "djv_cache").get();
+                        }
+                        diskCache->setPath(path);
+                        diskCache->setMaxByteCount(p.settings->observeDiskCacheMaxGB()->get() * Memory::gigabyte);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        diskCache->setMaxByteCount(0);
+                        std::stringstream ss;
+                        ss << _getText(DJV_TEXT("error_disk_cache")) << " '" << path << "'. " << e.what();
+                        _log(ss.str(), LogLevel::Error);
+                    }
+                }
+                else
+                {
+                    diskCache->setMaxByteCount(0);
                 }
             }
-            const bool cacheEnabled = p.settings->observeCacheEnabled()->get();
-            const size_t cacheMaxByteCount = p.settings->observeCacheMaxGB()->get() * Memory::gigabyte;
-            const size_t mediaCacheSizeByteCount = cacheCount > 0 ? (cacheMaxByteCount / cacheCount) : 0;
+        }
+
+        void FileSystem::_readUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            // The current media is read first, followed by any other media
+            // visible in the canvas.
+            const auto& currentMedia = p.currentMedia->get();
+            const auto& media = p.media->get();
             for (const auto& i : media)
             {
-                i->setCacheEnabled(cacheEnabled);
-                i->setCacheMaxByteCount(mediaCacheSizeByteCount);
+                const bool active = i == currentMedia;
+                i->setActive(active);
+                i->setVisible(active || p.allMediaVisible);
             }
         }
 
@@ -47,6 +47,16 @@ namespace djv
         } // namespace FileSystem
     } // namespace Core
 
+    namespace AV
+    {
+        namespace IO
+        {
+            struct DiskCacheStats;
+            struct FrameCacheStats;
+
+        } // namespace IO
+    } // namespace AV
+
     namespace ViewApp
     {
         class Media;
@@ -71,6 +81,8 @@ namespace djv
             std::shared_ptr<Core::IListSubject<std::shared_ptr<Media> > > observeMedia() const;
             std::shared_ptr<Core::IValueSubject<std::shared_ptr<Media> > > observeCurrentMedia() const;
             std::shared_ptr<Core::IValueSubject<float> > observeCachePercentage() const;
+            std::shared_ptr<Core::IValueSubject<AV::IO::FrameCacheStats> > observeCacheStats() const;
+            std::shared_ptr<Core::IValueSubject<AV::IO::DiskCacheStats> > observeDiskCacheStats() const;
 
             void open();
             void open(const Core::FileSystem::FileInfo&);
@@ -81,6 +93,10 @@ namespace djv
             void closeAll();
             void setCurrentMedia(const std::shared_ptr<Media> &);
 
+            //! Set whether all of the media is visible, or only the current
+            //! media. This is used to prioritize reading.
+            void setAllMediaVisible(bool);
+
             std::map<std::string, std::shared_ptr<UI::Action> > getActions() const override;
             MenuData getMenu() const override;
 
@@ -88,6 +104,8 @@ namespace djv
             void _mediaInit(const std::shared_ptr<Media>&);
             void _actionsUpdate();
             void _cacheUpdate();
+            void _diskCacheUpdate();
+            void _readUpdate();
             void _showFileBrowserDialog();
             void _showRecentFilesDialog();
 
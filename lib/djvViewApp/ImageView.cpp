@@ -242,6 +242,52 @@ namespace djv
             return _getBBox(_getImagePoints());
         }
 
+        BBox2i ImageView::getImageROI() const
+        {
+            DJV_PRIVATE_PTR();
+            BBox2i out;
+            const auto& style = _getStyle();
+            const BBox2f& g = getMargin().bbox(getGeometry(), style);
+            auto image = p.image->get();
+            if (image && g.isValid())
+            {
+                const float zoom = p.imageZoom->get();
+                glm::mat3x3 m(1.F);
+                m = glm::translate(m, g.min + p.imagePos->get());
+                m *= UI::ImageWidget::getXForm(image, p.imageRotate->get(), glm::vec2(zoom, zoom), p.imageAspectRatio->get());
+                const glm::mat3x3 inverse = glm::inverse(m);
+                std::vector<glm::vec3> points(4);
+                points[0] = inverse * glm::vec3(g.min.x, g.min.y, 1.F);
+                points[1] = inverse * glm::vec3(g.max.x, g.min.y, 1.F);
+                points[2] = inverse * glm::vec3(g.max.x, g.max.y, 1.F);
+                points[3] = inverse * glm::vec3(g.min.x, g.max.y, 1.F);
+                const BBox2f bbox = _getBBox(points);
+
+                // Convert to pixel coordinates, adding a pixel on each side for filtering.
+                const auto& info = image->getInfo();
+                out = BBox2i(
+                    glm::ivec2(static_cast<int>(floorf(bbox.min.x)) - 1, static_cast<int>(floorf(bbox.min.y)) - 1),
+                    glm::ivec2(static_cast<int>(ceilf(bbox.max.x)) + 1, static_cast<int>(ceilf(bbox.max.y)) + 1));
+                out = out.intersect(BBox2i(0, 0, info.size.w, info.size.h));
+
+                // Convert from display to data coordinates.
+                const auto& options = p.imageOptions->get();
+                if (info.layout.mirror.x != options.mirror.x)
+                {
+                    const int min = info.size.w - 1 - out.max.x;
+                    out.max.x = info.size.w - 1 - out.min.x;
+                    out.min.x = min;
+                }
+                if (info.layout.mirror.y != options.mirror.y)
+                {
+                    const int min = info.size.h - 1 - out.max.y;
+                    out.max.y = info.size.h - 1 - out.min.y;
+                    out.min.y = min;
+                }
+            }
+            return out;
+        }
+
         void ImageView::setImagePos(const glm::vec2& value, bool animate)
         {
             DJV_PRIVATE_PTR();
@@ -100,6 +100,12 @@ namespace djv
             std::shared_ptr<Core::IValueSubject<UI::ImageRotate> > observeImageRotate() const;
             std::shared_ptr<Core::IValueSubject<UI::ImageAspectRatio> > observeImageAspectRatio() const;
             Core::BBox2f getImageBBox() const;
+
+            //! Get the region of the image data that is visible in the view, in
+            //! pixel coordinates. The region is invalid when there is no image
+            //! or the view has not been laid out.
+            Core::BBox2i getImageROI() const;
+
             void setImagePos(const glm::vec2&, bool animate = false);
             void setImageZoom(float, bool animate = false);
             void setImageZoomFocus(float, const glm::vec2&, bool animate = false);
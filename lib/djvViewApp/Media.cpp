@@ -81,6 +81,9 @@ namespace djv
             std::shared_ptr<ValueSubject<float> > volume;
             std::shared_ptr<ValueSubject<bool> > mute;
             std::shared_ptr<ValueSubject<size_t> > threadCount;
+            bool active = false;
+            bool visible = true;
+            BBox2i roi;
             std::shared_ptr<ValueSubject<Frame::Sequence> > cacheSequence;
             std::shared_ptr<ValueSubject<Frame::Sequence> > cachedFrames;
             bool cacheEnabled = false;
@@ -556,6 +559,40 @@ namespace djv
             }
         }
 
+        void Media::setActive(bool value)
+        {
+            DJV_PRIVATE_PTR();
+            p.active = value;
+            if (p.read)
+            {
+                p.read->setActive(p.active);
+            }
+        }
+
+        void Media::setVisible(bool value)
+        {
+            DJV_PRIVATE_PTR();
+            p.visible = value;
+            if (p.read)
+            {
+                p.read->setVisible(p.visible);
+            }
+        }
+
+        void Media::setROI(const BBox2i& value)
+        {
+            DJV_PRIVATE_PTR();
+            if (value != p.roi)
+            {
+                p.roi = value;
+                if (p.read && Playback::Stop == p.playback->get())
+                {
+                    p.read->setROI(p.roi);
+                    _seek(p.currentFrame->get());
+                }
+            }
+        }
+
         bool Media::hasCache() const
         {
             DJV_PRIVATE_PTR();
@@ -673,6 +710,9 @@ namespace djv
                     p.read = io->read(p.fileInfo, options);
                     p.read->setThreadCount(p.threadCount->get());
                     p.read->setLoop(true);
+                    p.read->setActive(p.active);
+                    p.read->setVisible(p.visible);
+                    p.read->setROI(Playback::Stop == p.playback->get() ? p.roi : BBox2i());
                     p.read->setCacheEnabled(p.cacheEnabled);
                     p.read->setCacheMaxByteCount(p.cacheMaxByteCount);
 
@@ -774,31 +814,12 @@ namespace djv
                             {
                                 if (media->_p->read)
                                 {
-                                    bool valid = false;
-                                    size_t videoQueueMax   = 0;
-                                    size_t videoQueueCount = 0;
-                                    size_t audioQueueMax   = 0;
-                                    size_t audioQueueCount = 0;
-                                    {
-                                        std::unique_lock<std::mutex> lock(media->_p->read->getMutex());
-                                        if (lock.owns_lock())
-                                        {
-                                            valid = true;
-                                            const auto& videoQueue = media->_p->read->getVideoQueue();
-                                            const auto& audioQueue = media->_p->read->getAudioQueue();
-                                            videoQueueMax   = videoQueue.getMax();
-                                            videoQueueCount = videoQueue.getCount();
-                                            audioQueueMax   = audioQueue.getMax();
-                                            audioQueueCount = audioQueue.getCount();
-                                        }
-                                    }
-                                    if (valid)
-                                    {
-                                        media->_p->videoQueueMax->setAlways(videoQueueMax);
-                                        media->_p->videoQueueCount->setAlways(videoQueueCount);
-                                        media->_p->audioQueueMax->setAlways(audioQueueMax);
-                                        media->_p->audioQueueCount->setAlways(audioQueueCount);
-                                    }
+                                    const auto& videoQueue = media->_p->read->getVideoQueue();
+                                    const auto& audioQueue = media->_p->read->getAudioQueue();
+                                    media->_p->videoQueueMax->setAlways(videoQueue.getMax());
+                                    media->_p->videoQueueCount->setAlways(videoQueue.getCount());
+                                    media->_p->audioQueueMax->setAlways(audioQueue.getMax());
+                                    media->_p->audioQueueCount->setAlways(audioQueue.getCount());
                                 }
                             }
                         });
@@ -933,6 +954,7 @@ namespace djv
                     if (p.read)
                     {
                         p.read->setPlayback(false);
+                        p.read->setROI(p.roi);
                     }
                     _stopAudioStream();
                     p.playbackTimer->stop();
@@ -946,6 +968,7 @@ namespace djv
                     if (p.read)
                     {
                         p.read->setPlayback(true);
+                        p.read->setROI(BBox2i());
                     }
                     p.ioDirection = forward ? AV::IO::Direction::Forward : AV::IO::Direction::Reverse;
                     _seek(p.currentFrame->get());
@@ -1094,7 +1117,6 @@ namespace djv
                 AV::IO::VideoFrame frame;
                 bool gotFrame = false;
                 {
-                    std::lock_guard<std::mutex> lock(p.read->getMutex());
                     auto& queue = p.read->getVideoQueue();
                     if (p.playEveryFrame->get())
                     {
@@ -1143,7 +1165,7 @@ namespace djv
                 // Update the audio queue.
                 if (_hasAudio() && !_hasAudioSyncPlayback())
                 {
-                    std::lock_guard<std::mutex> lock(p.read->getMutex());
+                    // The audio stream is stopped so this is the only consumer.
                     auto& queue = p.read->getAudioQueue();
                     while (queue.getCount() > queue.getMax())
                     {
@@ -1177,7 +1199,6 @@ namespace djv
             // Get audio frames from the read queue.
             std::vector<AV::IO::AudioFrame> frames;
             {
-                std::lock_guard<std::mutex> lock(media->_p->read->getMutex());
                 auto& queue = media->_p->read->getAudioQueue();
                 while (!queue.isEmpty() && sampleCount < outputSampleCount)
                 {
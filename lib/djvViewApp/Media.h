@@ -155,6 +155,19 @@ namespace djv
 
             void setThreadCount(size_t);
 
+            //! Set whether this is the active media, reads for the active
+            //! media are scheduled first.
+            void setActive(bool);
+
+            //! Set whether this media is visible, reads for visible media are
+            //! scheduled before reads for hidden media.
+            void setVisible(bool);
+
+            //! Set the region of interest in image pixel coordinates. The
+            //! region is only used while playback is stopped, an invalid
+            //! region reads the whole frame.
+            void setROI(const Core::BBox2i&);
+
             ///@}
 
             //! \name Memory Cache
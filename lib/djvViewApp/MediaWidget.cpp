@@ -122,6 +122,7 @@ namespace djv
             bool audioMute = false;
             bool active = false;
             float fade = 1.F;
+            BBox2i roi;
 
             std::map<std::string, std::shared_ptr<UI::Action> > actions;
             std::shared_ptr<UI::ActionGroup> playbackActionGroup;
@@ -188,6 +189,8 @@ namespace djv
             std::shared_ptr<ValueObserver<bool> > frameStoreEnabledObserver;
             std::shared_ptr<ValueObserver<std::shared_ptr<AV::Image::Image> > > frameStoreObserver;
             std::shared_ptr<ValueObserver<AV::Render2D::ImageOptions> > imageOptionsObserver;
+            std::shared_ptr<ValueObserver<glm::vec2> > imagePosObserver;
+            std::shared_ptr<ValueObserver<float> > imageZoomObserver;
             std::shared_ptr<ValueObserver<UI::ImageRotate> > imageRotateObserver;
             std::shared_ptr<ValueObserver<UI::ImageAspectRatio> > imageAspectRatioObserver;
         };
@@ -1144,6 +1147,27 @@ namespace djv
                     if (auto widget = weak.lock())
                     {
                         widget->_p->timelineSlider->setImageOptions(value);
+                        widget->_roiUpdate();
+                    }
+                });
+
+            p.imagePosObserver = ValueObserver<glm::vec2>::create(
+                p.imageView->observeImagePos(),
+                [weak](const glm::vec2&)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_roiUpdate();
+                    }
+                });
+
+            p.imageZoomObserver = ValueObserver<float>::create(
+                p.imageView->observeImageZoom(),
+                [weak](float)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_roiUpdate();
                     }
                 });
 
@@ -1154,6 +1178,7 @@ namespace djv
                     if (auto widget = weak.lock())
                     {
                         widget->_p->timelineSlider->setImageRotate(value);
+                        widget->_roiUpdate();
                     }
                 });
 
@@ -1164,6 +1189,7 @@ namespace djv
                     if (auto widget = weak.lock())
                     {
                         widget->_p->timelineSlider->setImageAspectRatio(value);
+                        widget->_roiUpdate();
                     }
                 });
         }
@@ -1420,6 +1446,38 @@ namespace djv
         {
             DJV_PRIVATE_PTR();
             p.imageView->setImage(p.active && p.frameStoreEnabled && p.frameStore ? p.frameStore : p.image);
+            _roiUpdate();
+        }
+
+        void MediaWidget::_roiUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            BBox2i roi;
+            if (p.image && p.imageView->observeImage()->get() == p.image)
+            {
+                // Keep the current region while the view stays inside of it,
+                // otherwise pad the visible region so that small pans do not
+                // trigger new reads. Read the whole frame when most of the
+                // image is visible.
+                const BBox2i visible = p.imageView->getImageROI();
+                if (p.roi.isValid() && p.roi.contains(visible))
+                {
+                    roi = p.roi;
+                }
+                else if (visible.isValid())
+                {
+                    const AV::Image::Size& size = p.image->getSize();
+                    const int mx = visible.w() / 2;
+                    const int my = visible.h() / 2;
+                    roi = visible.margin(mx, my, mx, my).intersect(BBox2i(0, 0, size.w, size.h));
+                    if (roi.getArea() > size.w * size.h / 2)
+                    {
+                        roi = BBox2i();
+                    }
+                }
+            }
+            p.roi = roi;
+            p.media->setROI(p.roi);
         }
 
         void MediaWidget::_speedUpdate()
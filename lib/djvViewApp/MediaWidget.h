@@ -104,6 +104,7 @@ namespace djv
         private:
             void _widgetUpdate();
             void _imageUpdate();
+            void _roiUpdate();
             void _speedUpdate();
             void _realSpeedUpdate();
             void _audioUpdate();
@@ -38,6 +38,9 @@
 #include <djvUI/RowLayout.h>
 #include <djvUI/SettingsSystem.h>
 
+#include <djvAV/DiskCache.h>
+#include <djvAV/FrameCache.h>
+
 #include <djvCore/Context.h>
 #include <djvCore/OS.h>
 
@@ -50,6 +53,8 @@ namespace djv
         struct MemoryCacheWidget::Private
         {
             float percentageUsed = 0.F;
+            AV::IO::FrameCacheStats stats;
+            AV::IO::DiskCacheStats diskStats;
 
             std::shared_ptr<UI::Label> titleLabel;
             std::shared_ptr<UI::CheckBox> enabledCheckBox;
@@ -57,11 +62,41 @@ namespace djv
             std::shared_ptr<UI::Label> maxGBLabel;
             std::shared_ptr<UI::Label> percentageLabel;
             std::shared_ptr<UI::Label> percentageLabel2;
+            std::shared_ptr<UI::Label> hitsLabel;
+            std::shared_ptr<UI::Label> hitsLabel2;
+            std::shared_ptr<UI::Label> missesLabel;
+            std::shared_ptr<UI::Label> missesLabel2;
+            std::shared_ptr<UI::Label> evictionsLabel;
+            std::shared_ptr<UI::Label> evictionsLabel2;
+            std::shared_ptr<UI::Label> compressedTitleLabel;
+            std::shared_ptr<UI::IntSlider> compressedMaxGBSlider;
+            std::shared_ptr<UI::Label> compressedMaxGBLabel;
+            std::shared_ptr<UI::Label> compressedLabel;
+            std::shared_ptr<UI::Label> compressedLabel2;
+            std::shared_ptr<UI::Label> compressionRatioLabel;
+            std::shared_ptr<UI::Label> compressionRatioLabel2;
+            std::shared_ptr<UI::Label> decompressLabel;
+            std::shared_ptr<UI::Label> decompressLabel2;
+            std::shared_ptr<UI::Label> diskTitleLabel;
+            std::shared_ptr<UI::CheckBox> diskEnabledCheckBox;
+            std::shared_ptr<UI::IntSlider> diskMaxGBSlider;
+            std::shared_ptr<UI::Label> diskMaxGBLabel;
+            std::shared_ptr<UI::Label> diskPercentageLabel;
+            std::shared_ptr<UI::Label> diskPercentageLabel2;
+            std::shared_ptr<UI::Label> diskHitsLabel;
+            std::shared_ptr<UI::Label> diskHitsLabel2;
+            std::shared_ptr<UI::Label> diskMissesLabel;
+            std::shared_ptr<UI::Label> diskMissesLabel2;
             std::shared_ptr<UI::VerticalLayout> layout;
 
             std::shared_ptr<ValueObserver<bool> > enabledObserver;
             std::shared_ptr<ValueObserver<int> > maxGBObserver;
+            std::shared_ptr<ValueObserver<int> > compressedMaxGBObserver;
+            std::shared_ptr<ValueObserver<bool> > diskEnabledObserver;
+            std::shared_ptr<ValueObserver<int> > diskMaxGBObserver;
             std::shared_ptr<ValueObserver<float> > percentageObserver;
+            std::shared_ptr<ValueObserver<AV::IO::FrameCacheStats> > statsObserver;
+            std::shared_ptr<ValueObserver<AV::IO::DiskCacheStats> > diskStatsObserver;
         };
 
         void MemoryCacheWidget::_init(const std::shared_ptr<Core::Context>& context)
@@ -86,6 +121,59 @@ namespace djv
             p.percentageLabel->setTextHAlign(UI::TextHAlign::Left);
             p.percentageLabel2 = UI::Label::create(context);
             p.percentageLabel2->setFont(AV::Font::familyMono);
+            p.hitsLabel = UI::Label::create(context);
+            p.hitsLabel->setTextHAlign(UI::TextHAlign::Left);
+            p.hitsLabel2 = UI::Label::create(context);
+            p.hitsLabel2->setFont(AV::Font::familyMono);
+            p.missesLabel = UI::Label::create(context);
+            p.missesLabel->setTextHAlign(UI::TextHAlign::Left);
+            p.missesLabel2 = UI::Label::create(context);
+            p.missesLabel2->setFont(AV::Font::familyMono);
+            p.evictionsLabel = UI::Label::create(context);
+            p.evictionsLabel->setTextHAlign(UI::TextHAlign::Left);
+            p.evictionsLabel2 = UI::Label::create(context);
+            p.evictionsLabel2->setFont(AV::Font::familyMono);
+
+            p.compressedTitleLabel = UI::Label::create(context);
+            p.compressedTitleLabel->setTextHAlign(UI::TextHAlign::Left);
+            p.compressedTitleLabel->setMargin(UI::Layout::Margin(UI::MetricsRole::MarginSmall));
+            p.compressedMaxGBSlider = UI::IntSlider::create(context);
+            p.compressedMaxGBSlider->setRange(IntRange(0, OS::getRAMSize() / Memory::gigabyte));
+            p.compressedMaxGBLabel = UI::Label::create(context);
+            p.compressedMaxGBLabel->setTextHAlign(UI::TextHAlign::Left);
+            p.compressedLabel = UI::Label::create(context);
+            p.compressedLabel->setTextHAlign(UI::TextHAlign::Left);
+            p.compressedLabel2 = UI::Label::create(context);
+            p.compressedLabel2->setFont(AV::Font::familyMono);
+            p.compressionRatioLabel = UI::Label::create(context);
+            p.compressionRatioLabel->setTextHAlign(UI::TextHAlign::Left);
+            p.compressionRatioLabel2 = UI::Label::create(context);
+            p.compressionRatioLabel2->setFont(AV::Font::familyMono);
+            p.decompressLabel = UI::Label::create(context);
+            p.decompressLabel->setTextHAlign(UI::TextHAlign::Left);
+            p.decompressLabel2 = UI::Label::create(context);
+            p.decompressLabel2->setFont(AV::Font::familyMono);
+
+            p.diskTitleLabel = UI::Label::create(context);
+            p.diskTitleLabel->setTextHAlign(UI::TextHAlign::Left);
+            p.diskTitleLabel->setMargin(UI::Layout::Margin(UI::MetricsRole::MarginSmall));
+            p.diskEnabledCheckBox = UI::CheckBox::create(context);
+            p.diskMaxGBSlider = UI::IntSlider::create(context);
+            p.diskMaxGBSlider->setRange(IntRange(1, 1024));
+            p.diskMaxGBLabel = UI::Label::create(context);
+            p.diskMaxGBLabel->setTextHAlign(UI::TextHAlign::Left);
+            p.diskPercentageLabel = UI::Label::create(context);
+            p.diskPercentageLabel->setTextHAlign(UI::TextHAlign::Left);
+            p.diskPercentageLabel2 = UI::Label::create(context);
+            p.diskPercentageLabel2->setFont(AV::Font::familyMono);
+            p.diskHitsLabel = UI::Label::create(context);
+            p.diskHitsLabel->setTextHAlign(UI::TextHAlign::Left);
+            p.diskHitsLabel2 = UI::Label::create(context);
+            p.diskHitsLabel2->setFont(AV::Font::familyMono);
+            p.diskMissesLabel = UI::Label::create(context);
+            p.diskMissesLabel->setTextHAlign(UI::TextHAlign::Left);
+            p.diskMissesLabel2 = UI::Label::create(context);
+            p.diskMissesLabel2->setFont(AV::Font::familyMono);
 
             p.layout = UI::VerticalLayout::create(context);
             p.layout->setSpacing(UI::Layout::Spacing(UI::MetricsRole::None));
@@ -107,6 +195,53 @@ namespace djv
             hLayout->addChild(p.percentageLabel);
             hLayout->addChild(p.percentageLabel2);
             vLayout->addChild(hLayout);
+            hLayout = UI::HorizontalLayout::create(context);
+            hLayout->setMargin(UI::Layout::Margin(UI::MetricsRole::MarginSmall));
+            hLayout->setSpacing(UI::Layout::Spacing(UI::MetricsRole::SpacingSmall));
+            hLayout->addChild(p.hitsLabel);
+            hLayout->addChild(p.hitsLabel2);
+            hLayout->addChild(p.missesLabel);
+            hLayout->addChild(p.missesLabel2);
+            hLayout->addChild(p.evictionsLabel);
+            hLayout->addChild(p.evictionsLabel2);
+            vLayout->addChild(hLayout);
+            vLayout->addChild(p.compressedTitleLabel);
+            hLayout = UI::HorizontalLayout::create(context);
+            hLayout->setMargin(UI::Layout::Margin(UI::MetricsRole::MarginSmall));
+            hLayout->setSpacing(UI::Layout::Spacing(UI::MetricsRole::SpacingSmall));
+            hLayout->addChild(p.compressedMaxGBSlider);
+            hLayout->setStretch(p.compressedMaxGBSlider, UI::RowStretch::Expand);
+            hLayout->addChild(p.compressedMaxGBLabel);
+            vLayout->addChild(hLayout);
+            hLayout = UI::HorizontalLayout::create(context);
+            hLayout->setMargin(UI::Layout::Margin(UI::MetricsRole::MarginSmall));
+            hLayout->setSpacing(UI::Layout::Spacing(UI::MetricsRole::SpacingSmall));
+            hLayout->addChild(p.compressedLabel);
+            hLayout->addChild(p.compressedLabel2);
+            hLayout->addChild(p.compressionRatioLabel);
+            hLayout->addChild(p.compressionRatioLabel2);
+            hLayout->addChild(p.decompressLabel);
+            hLayout->addChild(p.decompressLabel2);
+            vLayout->addChild(hLayout);
+            vLayout->addChild(p.diskTitleLabel);
+            vLayout->addChild(p.diskEnabledCheckBox);
+            hLayout = UI::HorizontalLayout::create(context);
+            hLayout->setMargin(UI::Layout::Margin(UI::MetricsRole::MarginSmall));
+            hLayout->setSpacing(UI::Layout::Spacing(UI::MetricsRole::SpacingSmall));
+            hLayout->addChild(p.diskMaxGBSlider);
+            hLayout->setStretch(p.diskMaxGBSlider, UI::RowStretch::Expand);
+            hLayout->addChild(p.diskMaxGBLabel);
+            vLayout->addChild(hLayout);
+            hLayout = UI::HorizontalLayout::create(context);
+            hLayout->setMargin(UI::Layout::Margin(UI::MetricsRole::MarginSmall));
+            hLayout->setSpacing(UI::Layout::Spacing(UI::MetricsRole::SpacingSmall));
+            hLayout->addChild(p.diskPercentageLabel);
+            hLayout->addChild(p.diskPercentageLabel2);
+            hLayout->addChild(p.diskHitsLabel);
+            hLayout->addChild(p.diskHitsLabel2);
+            hLayout->addChild(p.diskMissesLabel);
+            hLayout->addChild(p.diskMissesLabel2);
+            vLayout->addChild(hLayout);
             p.layout->addChild(vLayout);
             addChild(p.layout);
 
@@ -135,6 +270,42 @@ namespace djv
                         }
                     }
                 });
+            p.compressedMaxGBSlider->setValueCallback(
+                [contextWeak](int value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        auto settingsSystem = context->getSystemT<UI::Settings::System>();
+                        if (auto fileSettings = settingsSystem->getSettingsT<FileSettings>())
+                        {
+                            fileSettings->setCacheCompressedMaxGB(value);
+                        }
+                    }
+                });
+            p.diskEnabledCheckBox->setCheckedCallback(
+                [contextWeak](bool value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        auto settingsSystem = context->getSystemT<UI::Settings::System>();
+                        if (auto fileSettings = settingsSystem->getSettingsT<FileSettings>())
+                        {
+                            fileSettings->setDiskCacheEnabled(value);
+                        }
+                    }
+                });
+            p.diskMaxGBSlider->setValueCallback(
+                [contextWeak](int value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        auto settingsSystem = context->getSystemT<UI::Settings::System>();
+                        if (auto fileSettings = settingsSystem->getSettingsT<FileSettings>())
+                        {
+                            fileSettings->setDiskCacheMaxGB(value);
+                        }
+                    }
+                });
 
             auto weak = std::weak_ptr<MemoryCacheWidget>(
                 std::dynamic_pointer_cast<MemoryCacheWidget>(shared_from_this()));
@@ -160,6 +331,36 @@ namespace djv
                             widget->_p->maxGBSlider->setValue(value);
                         }
                     });
+
+                p.compressedMaxGBObserver = ValueObserver<int>::create(
+                    fileSettings->observeCacheCompressedMaxGB(),
+                    [weak](int value)
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            widget->_p->compressedMaxGBSlider->setValue(value);
+                        }
+                    });
+
+                p.diskEnabledObserver = ValueObserver<bool>::create(
+                    fileSettings->observeDiskCacheEnabled(),
+                    [weak](bool value)
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            widget->_p->diskEnabledCheckBox->setChecked(value);
+                        }
+                    });
+
+                p.diskMaxGBObserver = ValueObserver<int>::create(
+                    fileSettings->observeDiskCacheMaxGB(),
+                    [weak](int value)
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            widget->_p->diskMaxGBSlider->setValue(value);
+                        }
+                    });
             }
 
             if (auto fileSystem = context->getSystemT<FileSystem>())
@@ -174,6 +375,28 @@ namespace djv
                             widget->_widgetUpdate();
                         }
                     });
+
+                p.statsObserver = ValueObserver<AV::IO::FrameCacheStats>::create(
+                    fileSystem->observeCacheStats(),
+                    [weak](const AV::IO::FrameCacheStats& value)
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            widget->_p->stats = value;
+                            widget->_widgetUpdate();
+                        }
+                    });
+
+                p.diskStatsObserver = ValueObserver<AV::IO::DiskCacheStats>::create(
+                    fileSystem->observeDiskCacheStats(),
+                    [weak](const AV::IO::DiskCacheStats& value)
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            widget->_p->diskStats = value;
+                            widget->_widgetUpdate();
+                        }
+                    });
             }
         }
 
@@ -218,6 +441,8 @@ namespace djv
                 std::stringstream ss;
                 ss << Memory::Unit::GB;
                 p.maxGBLabel->setText(_getText(ss.str()));
+                p.compressedMaxGBLabel->setText(_getText(ss.str()));
+                p.diskMaxGBLabel->setText(_getText(ss.str()));
             }
             p.percentageLabel->setText(_getText(DJV_TEXT("memory_cache_used")) + ":");
             {
@@ -225,6 +450,68 @@ namespace djv
                 ss << static_cast<int>(p.percentageUsed) << "%";
                 p.percentageLabel2->setText(ss.str());
             }
+            p.hitsLabel->setText(_getText(DJV_TEXT("memory_cache_hits")) + ":");
+            {
+                std::stringstream ss;
+                ss << p.stats.hitCount;
+                p.hitsLabel2->setText(ss.str());
+            }
+            p.missesLabel->setText(_getText(DJV_TEXT("memory_cache_misses")) + ":");
+            {
+                std::stringstream ss;
+                ss << p.stats.missCount;
+                p.missesLabel2->setText(ss.str());
+            }
+            p.evictionsLabel->setText(_getText(DJV_TEXT("memory_cache_evictions")) + ":");
+            {
+                std::stringstream ss;
+                ss << p.stats.evictCount;
+                p.evictionsLabel2->setText(ss.str());
+            }
+            p.compressedTitleLabel->setText(_getText(DJV_TEXT("memory_cache_compressed")));
+            p.compressedLabel->setText(_getText(DJV_TEXT("memory_cache_used")) + ":");
+            {
+                std::stringstream ss;
+                ss << (p.stats.compressedMaxByteCount > 0 ?
+                    static_cast<int>(p.stats.compressedByteCount / static_cast<float>(p.stats.compressedMaxByteCount) * 100.F) :
+                    0) << "%";
+                p.compressedLabel2->setText(ss.str());
+            }
+            p.compressionRatioLabel->setText(_getText(DJV_TEXT("memory_cache_compression_ratio")) + ":");
+            {
+                std::stringstream ss;
+                ss.precision(2);
+                ss << std::fixed << p.stats.getCompressionRatio();
+                p.compressionRatioLabel2->setText(ss.str());
+            }
+            p.decompressLabel->setText(_getText(DJV_TEXT("memory_cache_decompress")) + ":");
+            {
+                std::stringstream ss;
+                ss << static_cast<int>(p.stats.getDecompressThroughput() / Memory::megabyte) << " " << Memory::Unit::MB << "/s";
+                p.decompressLabel2->setText(ss.str());
+            }
+            p.diskTitleLabel->setText(_getText(DJV_TEXT("memory_cache_disk")));
+            p.diskEnabledCheckBox->setText(_getText(DJV_TEXT("memory_cache_enable")));
+            p.diskPercentageLabel->setText(_getText(DJV_TEXT("memory_cache_used")) + ":");
+            {
+                std::stringstream ss;
+                ss << (p.diskStats.maxByteCount > 0 ?
+                    static_cast<int>(p.diskStats.byteCount / static_cast<float>(p.diskStats.maxByteCount) * 100.F) :
+                    0) << "%";
+                p.diskPercentageLabel2->setText(ss.str());
+            }
+            p.diskHitsLabel->setText(_getText(DJV_TEXT("memory_cache_hits")) + ":");
+            {
+                std::stringstream ss;
+                ss << p.diskStats.hitCount;
+                p.diskHitsLabel2->setText(ss.str());
+            }
+            p.diskMissesLabel->setText(_getText(DJV_TEXT("memory_cache_misses")) + ":");
+            {
+                std::stringstream ss;
+                ss << p.diskStats.missCount;
+                p.diskMissesLabel2->setText(ss.str());
+            }
         }
 
     } // namespace ViewApp
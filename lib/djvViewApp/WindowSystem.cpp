@@ -29,6 +29,7 @@
 
 #include <djvViewApp/WindowSystem.h>
 
+#include <djvViewApp/FileSystem.h>
 #include <djvViewApp/MediaCanvas.h>
 #include <djvViewApp/MediaWidget.h>
 #include <djvViewApp/WindowSettings.h>
@@ -329,6 +330,13 @@ namespace djv
             if (p.maximize->setIfChanged(value))
             {
                 p.settings->setMaximize(value);
+                if (auto context = getContext().lock())
+                {
+                    if (auto fileSystem = context->getSystemT<FileSystem>())
+                    {
+                        fileSystem->setAllMediaVisible(!value);
+                    }
+                }
                 _actionsUpdate();
             }
         }
@@ -0,0 +1,324 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCmdLineApp/Application.h>
+
+#include <djvAV/FFmpeg.h>
+#include <djvAV/IO.h>
+
+#include <djvCore/Error.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/TextSystem.h>
+#include <djvCore/Timer.h>
+
+extern "C"
+{
+#include <libavformat/avformat.h>
+
+} // extern "C"
+
+#include <iostream>
+#include <thread>
+
+using namespace djv;
+
+// This benchmark decodes a long-GOP file with each of the FFmpeg thread types
+// and reports the decoded frames per second. A synthetic file is generated
+// if one is not given on the command line.
+
+const std::string syntheticFileName = "FFmpegBenchmark.mp4";
+const int syntheticWidth = 1920;
+const int syntheticHeight = 1080;
+const int syntheticGOPSize = 250;
+const int syntheticFrameRate = 24;
+
+class Application : public CmdLine::Application
+{
+    DJV_NON_COPYABLE(Application);
+
+protected:
+    void _init(std::list<std::string>&);
+
+    Application();
+
+public:
+    static std::shared_ptr<Application> create(std::list<std::string>&);
+
+    void run() override;
+
+private:
+    void _writeSynthetic();
+    void _decode(AV::IO::FFmpeg::ThreadType);
+
+    std::string _fileName;
+    size_t _frameCount = 500;
+    size_t _threadCount = 0;
+};
+
+void Application::_init(std::list<std::string>& args)
+{
+    CmdLine::Application::_init(args);
+
+    auto i = args.begin();
+    while (i != args.end())
+    {
+        if ("-frames" == *i)
+        {
+            i = args.erase(i);
+            int value = 0;
+            std::stringstream ss(*i);
+            ss >> value;
+            i = args.erase(i);
+            _frameCount = std::max(value, 1);
+        }
+        else if ("-threads" == *i)
+        {
+            i = args.erase(i);
+            int value = 0;
+            std::stringstream ss(*i);
+            ss >> value;
+            i = args.erase(i);
+            _threadCount = std::max(value, 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+    if (args.size())
+    {
+        _fileName = args.front();
+        args.pop_front();
+    }
+}
+
+Application::Application()
+{}
+
+std::shared_ptr<Application> Application::create(std::list<std::string>& args)
+{
+    auto out = std::shared_ptr<Application>(new Application);
+    out->_init(args);
+    return out;
+}
+
+void Application::run()
+{
+    if (_fileName.empty())
+    {
+        _fileName = syntheticFileName;
+        _writeSynthetic();
+    }
+    for (auto i : AV::IO::FFmpeg::getThreadTypeEnums())
+    {
+        _decode(i);
+    }
+}
+
+void Application::_writeSynthetic()
+{
+    std::cout << "Writing: " << _fileName << std::endl;
+
+    AVFormatContext* avFormatContext = nullptr;
+    AVCodecContext* avCodecContext = nullptr;
+    AVFrame* avFrame = nullptr;
+    AVPacket* avPacket = nullptr;
+    try
+    {
+        int r = avformat_alloc_output_context2(&avFormatContext, nullptr, nullptr, _fileName.c_str());
+        if (r < 0)
+        {
+            throw std::runtime_error(AV::IO::FFmpeg::getErrorString(r));
+        }
+        auto avCodec = avcodec_find_encoder(AV_CODEC_ID_MPEG4);
+        if (!avCodec)
+        {
+            throw std::runtime_error("No MPEG-4 encoder");
+        }
+        auto avStream = avformat_new_stream(avFormatContext, avCodec);
+        avCodecContext = avcodec_alloc_context3(avCodec);
+        avCodecContext->width = syntheticWidth;
+        avCodecContext->height = syntheticHeight;
+        avCodecContext->time_base = AVRational{ 1, syntheticFrameRate };
+        avCodecContext->framerate = AVRational{ syntheticFrameRate, 1 };
+        avCodecContext->pix_fmt = AV_PIX_FMT_YUV420P;
+        avCodecContext->gop_size = syntheticGOPSize;
+        avCodecContext->max_b_frames = 2;
+        avCodecContext->bit_rate = 20000000;
+        if (avFormatContext->oformat->flags & AVFMT_GLOBALHEADER)
+        {
+            avCodecContext->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+        }
+        r = avcodec_open2(avCodecContext, avCodec, nullptr);
+        if (r < 0)
+        {
+            throw std::runtime_error(AV::IO::FFmpeg::getErrorString(r));
+        }
+        avcodec_parameters_from_context(avStream->codecpar, avCodecContext);
+        avStream->time_base = avCodecContext->time_base;
+        r = avio_open(&avFormatContext->pb, _fileName.c_str(), AVIO_FLAG_WRITE);
+        if (r < 0)
+        {
+            throw std::runtime_error(AV::IO::FFmpeg::getErrorString(r));
+        }
+        r = avformat_write_header(avFormatContext, nullptr);
+        if (r < 0)
+        {
+            throw std::runtime_error(AV::IO::FFmpeg::getErrorString(r));
+        }
+
+        avFrame = av_frame_alloc();
+        avFrame->format = avCodecContext->pix_fmt;
+        avFrame->width = avCodecContext->width;
+        avFrame->height = avCodecContext->height;
+        av_frame_get_buffer(avFrame, 0);
+        avPacket = av_packet_alloc();
+        auto writePackets = [avFormatContext, avCodecContext, avStream, avPacket]
+        {
+            while (avcodec_receive_packet(avCodecContext, avPacket) >= 0)
+            {
+                av_packet_rescale_ts(avPacket, avCodecContext->time_base, avStream->time_base);
+                avPacket->stream_index = avStream->index;
+                av_interleaved_write_frame(avFormatContext, avPacket);
+            }
+        };
+        for (size_t i = 0; i < _frameCount; ++i)
+        {
+            // Draw a moving gradient so that the encoder has to code motion
+            // between the key frames.
+            av_frame_make_writable(avFrame);
+            for (int y = 0; y < avFrame->height; ++y)
+            {
+                uint8_t* p = avFrame->data[0] + y * avFrame->linesize[0];
+                for (int x = 0; x < avFrame->width; ++x)
+                {
+                    p[x] = static_cast<uint8_t>(x + y + i * 3);
+                }
+            }
+            for (int y = 0; y < avFrame->height / 2; ++y)
+            {
+                uint8_t* u = avFrame->data[1] + y * avFrame->linesize[1];
+                uint8_t* v = avFrame->data[2] + y * avFrame->linesize[2];
+                for (int x = 0; x < avFrame->width / 2; ++x)
+                {
+                    u[x] = static_cast<uint8_t>(128 + y + i * 2);
+                    v[x] = static_cast<uint8_t>(64 + x + i * 5);
+                }
+            }
+            avFrame->pts = i;
+            avcodec_send_frame(avCodecContext, avFrame);
+            writePackets();
+        }
+        avcodec_send_frame(avCodecContext, nullptr);
+        writePackets();
+        av_write_trailer(avFormatContext);
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << Core::Error::format(e) << std::endl;
+    }
+    if (avPacket)
+    {
+        av_packet_free(&avPacket);
+    }
+    if (avFrame)
+    {
+        av_frame_free(&avFrame);
+    }
+    if (avCodecContext)
+    {
+        avcodec_free_context(&avCodecContext);
+    }
+    if (avFormatContext)
+    {
+        if (avFormatContext->pb)
+        {
+            avio_closep(&avFormatContext->pb);
+        }
+        avformat_free_context(avFormatContext);
+    }
+}
+
+void Application::_decode(AV::IO::FFmpeg::ThreadType threadType)
+{
+    auto io = getSystemT<AV::IO::System>();
+    AV::IO::FFmpeg::Options options;
+    fromJSON(io->getOptions(AV::IO::FFmpeg::pluginName), options);
+    if (_threadCount)
+    {
+        options.threadCount = _threadCount;
+    }
+    options.threadType = threadType;
+    io->setOptions(AV::IO::FFmpeg::pluginName, toJSON(options));
+
+    AV::IO::ReadOptions readOptions;
+    readOptions.videoQueueSize = 10;
+    const auto start = std::chrono::steady_clock::now();
+    auto read = io->read(Core::FileSystem::FileInfo(_fileName), readOptions);
+    read->getInfo().get();
+    size_t frameCount = 0;
+    auto& queue = read->getVideoQueue();
+    while (read->isRunning())
+    {
+        const bool finished = queue.isFinished();
+        while (!queue.isEmpty())
+        {
+            queue.popFrame();
+            ++frameCount;
+        }
+        if (finished)
+        {
+            break;
+        }
+        std::this_thread::sleep_for(Core::Time::getTime(Core::Time::TimerValue::Fast));
+    }
+    const float time = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+
+    std::stringstream ss;
+    ss << threadType;
+    std::cout << getSystemT<Core::TextSystem>()->getText(ss.str()) << ": " << frameCount << " frames, " << options.threadCount << " threads, " <<
+        (time > 0.F ? (frameCount / time) : 0.F) << " fps" << std::endl;
+}
+
+int main(int argc, char ** argv)
+{
+    int r = 1;
+    try
+    {
+        auto args = Application::args(argc, argv);
+        auto app = Application::create(args);
+        app->run();
+        r = app->getExitCode();
+    }
+    catch (const std::exception & e)
+    {
+        std::cout << Core::Error::format(e) << std::endl;
+    }
+    return r;
+}
@@ -0,0 +1,236 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVTest/DiskCacheTest.h>
+
+#include <djvAV/DiskCache.h>
+
+#include <djvCore/FileIO.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/Path.h>
+#include <djvCore/Timer.h>
+
+#include <cstring>
+#include <thread>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            void waitForWrites(const std::shared_ptr<IO::DiskCache>& diskCache, size_t writeCount)
+            {
+                for (size_t i = 0; i < 1000 && diskCache->getStats().writeCount < writeCount; ++i)
+                {
+                    std::this_thread::sleep_for(Time::getTime(Time::TimerValue::Fast));
+                }
+            }
+
+        } // namespace
+
+        DiskCacheTest::DiskCacheTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::DiskCacheTest", context)
+        {}
+        
+        void DiskCacheTest::run()
+        {
+            _key();
+            _cache();
+            _mediaData();
+        }
+
+        void DiskCacheTest::_key()
+        {
+            {
+                const IO::DiskCacheKey key;
+                DJV_ASSERT(key.fileName.empty());
+                DJV_ASSERT(0 == key.time);
+                DJV_ASSERT(0 == key.size);
+                DJV_ASSERT(0 == key.layer);
+                DJV_ASSERT(0 == key.proxy);
+            }
+            
+            {
+                const IO::DiskCacheKey key("render.0001.exr", 1, 2, 3, 1);
+                DJV_ASSERT(key == IO::DiskCacheKey("render.0001.exr", 1, 2, 3, 1));
+                DJV_ASSERT(!(key == IO::DiskCacheKey("render.0001.exr", 2, 2, 3, 1)));
+                DJV_ASSERT(key.getString() != IO::DiskCacheKey("render.0001.exr", 1, 2, 3, 0).getString());
+            }
+        }
+
+        void DiskCacheTest::_cache()
+        {
+            const std::string path = "DiskCacheTest";
+            const Image::Info info(64, 32, Image::Type::RGBA_U16);
+            const IO::DiskCacheKey key("render.0001.exr", 1, 2, 0, 0);
+            auto image = Image::Image::create(info);
+            image->setPluginName("DiskCacheTest");
+            Tags tags;
+            tags.setTag("Key", "Value");
+            image->setTags(tags);
+            uint8_t* p = image->getData();
+            for (size_t i = 0; i < info.getDataByteCount(); ++i)
+            {
+                p[i] = static_cast<uint8_t>(i);
+            }
+
+            {
+                // The cache is disabled until a path and size are set.
+                auto diskCache = IO::DiskCache::create();
+                DJV_ASSERT(!diskCache->isEnabled());
+                diskCache->write(key, image);
+                DJV_ASSERT(!diskCache->read(key));
+
+                diskCache->setPath(path);
+                diskCache->setMaxByteCount(Memory::megabyte);
+                DJV_ASSERT(diskCache->isEnabled());
+                DJV_ASSERT(!diskCache->read(key));
+                diskCache->write(key, image);
+                waitForWrites(diskCache, 1);
+                auto stats = diskCache->getStats();
+                DJV_ASSERT(1 == stats.count);
+                DJV_ASSERT(stats.byteCount > info.getDataByteCount());
+
+                auto read = diskCache->read(key);
+                DJV_ASSERT(read);
+                DJV_ASSERT(info == read->getInfo());
+                DJV_ASSERT("DiskCacheTest" == read->getPluginName());
+                DJV_ASSERT(tags == read->getTags());
+                const Image::Data& data = *read;
+                DJV_ASSERT(0 == memcmp(image->getData(), data.getData(), info.getDataByteCount()));
+                stats = diskCache->getStats();
+                DJV_ASSERT(1 == stats.hitCount);
+                DJV_ASSERT(2 == stats.missCount);
+
+                // Entries for a different version of the file are not found.
+                DJV_ASSERT(!diskCache->read(IO::DiskCacheKey("render.0001.exr", 2, 2, 0, 0)));
+            }
+
+            {
+                // The entries are found again by a new cache.
+                auto diskCache = IO::DiskCache::create();
+                diskCache->setPath(path);
+                diskCache->setMaxByteCount(Memory::megabyte);
+                DJV_ASSERT(1 == diskCache->getStats().count);
+                DJV_ASSERT(diskCache->read(key));
+
+                // The least recently used entries are evicted.
+                const size_t entryByteCount = diskCache->getStats().byteCount;
+                diskCache->setMaxByteCount(entryByteCount * 2);
+                const IO::DiskCacheKey key2("render.0002.exr", 1, 2, 0, 0);
+                const IO::DiskCacheKey key3("render.0003.exr", 1, 2, 0, 0);
+                diskCache->write(key2, image);
+                waitForWrites(diskCache, 1);
+                DJV_ASSERT(diskCache->read(key));
+                diskCache->write(key3, image);
+                waitForWrites(diskCache, 2);
+                auto stats = diskCache->getStats();
+                DJV_ASSERT(2 == stats.count);
+                DJV_ASSERT(1 == stats.evictCount);
+                DJV_ASSERT(diskCache->read(key));
+                DJV_ASSERT(!diskCache->read(key2));
+                DJV_ASSERT(diskCache->read(key3));
+
+                // Damaged entries are removed.
+                for (const auto& i : FileSystem::FileInfo::directoryList(FileSystem::Path(path)))
+                {
+                    auto io = FileSystem::FileIO::create();
+                    io->open(i.getFileName(), FileSystem::FileIO::Mode::ReadWrite);
+                    io->setPos(io->getSize() - 1);
+                    io->writeU8(0);
+                }
+                DJV_ASSERT(!diskCache->read(key));
+                stats = diskCache->getStats();
+                DJV_ASSERT(1 == stats.errorCount);
+                DJV_ASSERT(1 == stats.count);
+
+                diskCache->clear();
+                DJV_ASSERT(0 == diskCache->getStats().count);
+            }
+            FileSystem::Path::rmdir(FileSystem::Path(path));
+        }
+
+        void DiskCacheTest::_mediaData()
+        {
+            const std::string path = "DiskCacheTest";
+            const IO::DiskCacheKey key("movie.mov", 1, 2, 0, 0);
+            const std::vector<uint8_t> data = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+            {
+                auto diskCache = IO::DiskCache::create();
+                std::vector<uint8_t> read;
+                diskCache->writeMediaData(key, data);
+                DJV_ASSERT(!diskCache->readMediaData(key, read));
+
+                diskCache->setPath(path);
+                diskCache->setMaxByteCount(Memory::megabyte);
+                DJV_ASSERT(!diskCache->readMediaData(key, read));
+                diskCache->writeMediaData(key, data);
+                DJV_ASSERT(diskCache->readMediaData(key, read));
+                DJV_ASSERT(data == read);
+                DJV_ASSERT(!diskCache->readMediaData(IO::DiskCacheKey("movie.mov", 2, 2, 0, 0), read));
+
+                // Media data is not counted as a cache entry.
+                DJV_ASSERT(0 == diskCache->getStats().count);
+            }
+
+            {
+                auto diskCache = IO::DiskCache::create();
+                diskCache->setPath(path);
+                diskCache->setMaxByteCount(Memory::megabyte);
+                std::vector<uint8_t> read;
+                DJV_ASSERT(diskCache->readMediaData(key, read));
+                DJV_ASSERT(data == read);
+
+                // Damaged media data is removed.
+                for (const auto& i : FileSystem::FileInfo::directoryList(FileSystem::Path(path)))
+                {
+                    auto io = FileSystem::FileIO::create();
+                    io->open(i.getFileName(), FileSystem::FileIO::Mode::ReadWrite);
+                    io->setPos(io->getSize() - 1);
+                    io->writeU8(0);
+                }
+                DJV_ASSERT(!diskCache->readMediaData(key, read));
+                DJV_ASSERT(1 == diskCache->getStats().errorCount);
+                DJV_ASSERT(!diskCache->readMediaData(key, read));
+
+                diskCache->writeMediaData(key, data);
+                diskCache->clear();
+                DJV_ASSERT(!diskCache->readMediaData(key, read));
+            }
+            FileSystem::Path::rmdir(FileSystem::Path(path));
+        }
+        
+    } // namespace AVTest
+} // namespace djv
+
@@ -0,0 +1,317 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVTest/FrameCacheTest.h>
+
+#include <djvAV/CompressedImage.h>
+#include <djvAV/FrameCache.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        FrameCacheTest::FrameCacheTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::FrameCacheTest", context)
+        {}
+        
+        void FrameCacheTest::run()
+        {
+            _key();
+            _budget();
+            _eviction();
+            _cache();
+            _compressed();
+        }
+
+        void FrameCacheTest::_key()
+        {
+            {
+                const IO::FrameCacheKey key;
+                DJV_ASSERT(0 == key.media);
+                DJV_ASSERT(0 == key.layer);
+                DJV_ASSERT(0 == key.frame);
+            }
+
+            {
+                const IO::FrameCacheKey key(1, 2, 3);
+                DJV_ASSERT(1 == key.media);
+                DJV_ASSERT(2 == key.layer);
+                DJV_ASSERT(3 == key.frame);
+                DJV_ASSERT(key == IO::FrameCacheKey(1, 2, 3));
+                DJV_ASSERT(key < IO::FrameCacheKey(1, 2, 4));
+                DJV_ASSERT(key < IO::FrameCacheKey(1, 3, 0));
+                DJV_ASSERT(key < IO::FrameCacheKey(2, 0, 0));
+                DJV_ASSERT(!(IO::FrameCacheKey(1, 2, 4) < key));
+            }
+        }
+
+        void FrameCacheTest::_budget()
+        {
+            auto frameCache = IO::FrameCache::create(100);
+            DJV_ASSERT(100 == frameCache->getMaxByteCount());
+            DJV_ASSERT(0 == frameCache->getStats().byteCount);
+
+            const UID media = frameCache->addMedia();
+            Frame::Sequence sequence;
+            sequence.ranges.push_back(Frame::Range(0, 9));
+            frameCache->setMediaSequence(media, sequence);
+            IO::ReadState state;
+            state.sequenceSize = 10;
+            frameCache->setMediaState(media, state);
+
+            DJV_ASSERT(!frameCache->canAdd(IO::FrameCacheKey(media, 0, 0), 101));
+            DJV_ASSERT(!frameCache->add(IO::FrameCacheKey(media, 0, 0), 101));
+            for (Frame::Index i = 0; i < 4; ++i)
+            {
+                DJV_ASSERT(frameCache->add(IO::FrameCacheKey(media, 0, i), 25));
+            }
+            auto stats = frameCache->getStats();
+            DJV_ASSERT(4 == stats.count);
+            DJV_ASSERT(100 == stats.byteCount);
+            DJV_ASSERT(100 == frameCache->getByteCount(media));
+            DJV_ASSERT(frameCache->getEvicted(media).empty());
+
+            frameCache->remove(IO::FrameCacheKey(media, 0, 3));
+            DJV_ASSERT(75 == frameCache->getByteCount(media));
+
+            frameCache->addLookup(true);
+            frameCache->addLookup(false);
+            frameCache->addLookup(false);
+            stats = frameCache->getStats();
+            DJV_ASSERT(1 == stats.hitCount);
+            DJV_ASSERT(2 == stats.missCount);
+
+            frameCache->setMaxByteCount(50);
+            stats = frameCache->getStats();
+            DJV_ASSERT(50 == stats.byteCount);
+            DJV_ASSERT(1 == stats.evictCount);
+            const auto evicted = frameCache->getEvicted(media);
+            DJV_ASSERT(1 == evicted.size());
+            DJV_ASSERT(IO::FrameCacheKey(media, 0, 2) == evicted[0]);
+            DJV_ASSERT(frameCache->getEvicted(media).empty());
+
+            frameCache->removeMedia(media);
+            DJV_ASSERT(0 == frameCache->getStats().byteCount);
+            DJV_ASSERT(0 == frameCache->getByteCount(media));
+        }
+
+        void FrameCacheTest::_eviction()
+        {
+            auto frameCache = IO::FrameCache::create(40);
+            bool evictedCallback = false;
+            const UID active = frameCache->addMedia();
+            const UID inactive = frameCache->addMedia(
+                [&evictedCallback]
+                {
+                    evictedCallback = true;
+                });
+            Frame::Sequence sequence;
+            sequence.ranges.push_back(Frame::Range(0, 99));
+            frameCache->setMediaSequence(active, sequence);
+            frameCache->setMediaSequence(inactive, sequence);
+            IO::ReadState state;
+            state.sequenceSize = 100;
+            state.active = true;
+            frameCache->setMediaState(active, state);
+            state.active = false;
+            frameCache->setMediaState(inactive, state);
+
+            // Fill the cache with frames from the inactive media.
+            for (Frame::Index i = 0; i < 4; ++i)
+            {
+                DJV_ASSERT(frameCache->add(IO::FrameCacheKey(inactive, 0, i), 10));
+            }
+
+            // Frames from the active media replace the frames from the inactive
+            // media that are furthest from the playhead.
+            DJV_ASSERT(frameCache->canAdd(IO::FrameCacheKey(active, 0, 0), 10));
+            DJV_ASSERT(frameCache->add(IO::FrameCacheKey(active, 0, 0), 10));
+            DJV_ASSERT(evictedCallback);
+            auto evicted = frameCache->getEvicted(inactive);
+            DJV_ASSERT(1 == evicted.size());
+            DJV_ASSERT(IO::FrameCacheKey(inactive, 0, 3) == evicted[0]);
+            DJV_ASSERT(40 == frameCache->getStats().byteCount);
+
+            // Frames from the inactive media do not replace frames that are
+            // closer to the playhead.
+            DJV_ASSERT(!frameCache->canAdd(IO::FrameCacheKey(inactive, 0, 3), 10));
+            DJV_ASSERT(!frameCache->add(IO::FrameCacheKey(inactive, 0, 3), 10));
+
+            // Frames outside of the cache sequence are evicted first.
+            sequence.ranges.clear();
+            sequence.ranges.push_back(Frame::Range(0, 1));
+            frameCache->setMediaSequence(inactive, sequence);
+            DJV_ASSERT(frameCache->add(IO::FrameCacheKey(active, 0, 10), 10));
+            evicted = frameCache->getEvicted(inactive);
+            DJV_ASSERT(1 == evicted.size());
+            DJV_ASSERT(IO::FrameCacheKey(inactive, 0, 2) == evicted[0]);
+            DJV_ASSERT(2 == frameCache->getStats().evictCount);
+        }
+
+        void FrameCacheTest::_cache()
+        {
+            auto frameCache = IO::FrameCache::create(Image::Info(1, 2, Image::Type::RGB_U8).getDataByteCount() * 5);
+            {
+                IO::Cache cache;
+                cache.setFrameCache(frameCache, 0);
+                cache.setMax(10);
+                cache.setSequenceSize(10);
+                IO::ReadState state;
+                state.sequenceSize = 10;
+                cache.setReadState(state);
+                for (Frame::Index i = 0; i < 10; ++i)
+                {
+                    cache.add(i, Image::Image::create(Image::Info(1, 2, Image::Type::RGB_U8)));
+                }
+                DJV_ASSERT(5 == cache.getCount());
+                DJV_ASSERT(5 == frameCache->getStats().count);
+                DJV_ASSERT(!cache.canAdd(9, Image::Info(1, 2, Image::Type::RGB_U8).getDataByteCount()));
+
+                std::shared_ptr<Image::Image> image;
+                DJV_ASSERT(cache.get(0, image));
+                DJV_ASSERT(!cache.get(9, image));
+                const auto stats = frameCache->getStats();
+                DJV_ASSERT(1 == stats.hitCount);
+                DJV_ASSERT(1 == stats.missCount);
+
+                cache.clear();
+                DJV_ASSERT(0 == frameCache->getStats().count);
+                cache.add(0, Image::Image::create(Image::Info(1, 2, Image::Type::RGB_U8)));
+                DJV_ASSERT(1 == frameCache->getStats().count);
+            }
+            DJV_ASSERT(0 == frameCache->getStats().count);
+        }
+
+        void FrameCacheTest::_compressed()
+        {
+            for (auto type : { Image::Type::RGB_U8, Image::Type::RGBA_F16, Image::Type::L_U16 })
+            {
+                const Image::Info info(64, 32, type);
+                auto image = Image::Image::create(info);
+                uint8_t* p = image->getData();
+                for (size_t i = 0; i < info.getDataByteCount(); ++i)
+                {
+                    p[i] = static_cast<uint8_t>(i / 7);
+                }
+                auto compressed = IO::CompressedImage::create(image);
+                DJV_ASSERT(info == compressed->getInfo());
+                DJV_ASSERT(info.getDataByteCount() == compressed->getDataByteCount());
+                DJV_ASSERT(compressed->getByteCount() < compressed->getDataByteCount());
+                auto decompressed = compressed->decompress();
+                DJV_ASSERT(info == decompressed->getInfo());
+                DJV_ASSERT(0 == memcmp(image->getData(), decompressed->getData(), info.getDataByteCount()));
+            }
+
+            {
+                // The compressed tier is disabled by default.
+                auto frameCache = IO::FrameCache::create(0);
+                const UID uid = frameCache->addMedia();
+                DJV_ASSERT(!frameCache->canAddCompressed(IO::FrameCacheKey(uid, 0, 0), 10));
+                DJV_ASSERT(!frameCache->addCompressed(IO::FrameCacheKey(uid, 0, 0), 10, 40));
+
+                frameCache->setCompressedMaxByteCount(20);
+                Frame::Sequence sequence;
+                sequence.ranges.push_back(Frame::Range(0, 9));
+                frameCache->setMediaSequence(uid, sequence);
+                IO::ReadState state;
+                state.sequenceSize = 10;
+                state.active = true;
+                frameCache->setMediaState(uid, state);
+                DJV_ASSERT(frameCache->addCompressed(IO::FrameCacheKey(uid, 0, 2), 10, 40));
+                DJV_ASSERT(frameCache->addCompressed(IO::FrameCacheKey(uid, 0, 1), 10, 40));
+                auto stats = frameCache->getStats();
+                DJV_ASSERT(2 == stats.compressedCount);
+                DJV_ASSERT(20 == stats.compressedByteCount);
+                DJV_ASSERT(4.F == stats.getCompressionRatio());
+                DJV_ASSERT(0 == stats.count);
+
+                // Frames closer to the playhead replace frames further away.
+                DJV_ASSERT(!frameCache->addCompressed(IO::FrameCacheKey(uid, 0, 3), 10, 40));
+                DJV_ASSERT(frameCache->addCompressed(IO::FrameCacheKey(uid, 0, 0), 10, 40));
+                auto evicted = frameCache->getEvictedCompressed(uid);
+                DJV_ASSERT(1 == evicted.size());
+                DJV_ASSERT(IO::FrameCacheKey(uid, 0, 2) == evicted[0]);
+                DJV_ASSERT(1 == frameCache->getStats().compressedEvictCount);
+
+                frameCache->addDecompress(100, .5F);
+                DJV_ASSERT(200.F == frameCache->getStats().getDecompressThroughput());
+
+                frameCache->setCompressedMaxByteCount(0);
+                DJV_ASSERT(0 == frameCache->getStats().compressedCount);
+                DJV_ASSERT(2 == frameCache->getEvictedCompressed(uid).size());
+            }
+
+            {
+                const Image::Info info(1, 2, Image::Type::RGB_U8);
+                auto frameCache = IO::FrameCache::create(info.getDataByteCount() * 2);
+                frameCache->setCompressedMaxByteCount(info.getDataByteCount() * 10);
+                IO::Cache cache;
+                cache.setFrameCache(frameCache, 0);
+                cache.setCompressEnabled(true);
+                cache.setMax(10);
+                cache.setSequenceSize(10);
+                IO::ReadState state;
+                state.sequenceSize = 10;
+                cache.setReadState(state);
+                // Frames evicted by frames closer to the playhead are kept
+                // for compression.
+                for (Frame::Index i = 3; i >= 0; --i)
+                {
+                    cache.add(i, Image::Image::create(info));
+                }
+                DJV_ASSERT(2 == cache.getCount());
+                auto compressible = cache.getCompressible();
+                DJV_ASSERT(2 == compressible.size());
+                DJV_ASSERT(cache.getCompressible().empty());
+                for (const auto& i : compressible)
+                {
+                    cache.addCompressed(i.first, IO::CompressedImage::create(i.second));
+                }
+                DJV_ASSERT(2 == cache.getCompressedCount());
+                DJV_ASSERT(2 == frameCache->getStats().compressedCount);
+
+                std::shared_ptr<Image::Image> image;
+                std::shared_ptr<IO::CompressedImage> compressed;
+                const Frame::Index index = compressible[0].first;
+                DJV_ASSERT(cache.contains(index));
+                DJV_ASSERT(!cache.get(index, image));
+                DJV_ASSERT(cache.getCompressed(index, compressed));
+
+                cache.clear();
+                DJV_ASSERT(0 == cache.getCompressedCount());
+                DJV_ASSERT(0 == frameCache->getStats().compressedCount);
+            }
+        }
+        
+    } // namespace AVTest
+} // namespace djv
+
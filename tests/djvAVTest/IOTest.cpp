@@ -30,11 +30,17 @@
 #include <djvAVTest/IOTest.h>
 
 #include <djvAV/IO.h>
+#if defined(TIFF_FOUND)
+#include <djvAV/TIFF.h>
+#endif // TIFF_FOUND
 
 #include <djvCore/Context.h>
+#include <djvCore/FileIO.h>
 #include <djvCore/String.h>
 #include <djvCore/Timer.h>
 
+#include <thread>
+
 using namespace djv::Core;
 using namespace djv::AV;
 
@@ -42,6 +48,41 @@ namespace djv
 {
     namespace AVTest
     {
+        namespace
+        {
+            std::shared_ptr<Image::Image> readImage(const std::shared_ptr<IO::IRead>& read)
+            {
+                std::shared_ptr<Image::Image> out;
+                bool running = true;
+                while (running)
+                {
+                    bool sleep = false;
+                    {
+                        auto& readQueue = read->getVideoQueue();
+                        if (!readQueue.isEmpty())
+                        {
+                            out = readQueue.popFrame().image;
+                            running = false;
+                        }
+                        else if (readQueue.isFinished())
+                        {
+                            running = false;
+                        }
+                        else
+                        {
+                            sleep = true;
+                        }
+                    }
+                    if (sleep)
+                    {
+                        std::this_thread::sleep_for(Time::getTime(Time::TimerValue::Fast));
+                    }
+                }
+                return out;
+            }
+
+        } // namespace
+
         IOTest::IOTest(const std::shared_ptr<Core::Context>& context) :
             ITest("djv::AVTest::IOTest", context)
         {}
@@ -57,6 +98,9 @@ namespace djv
             _audioQueue();
             _cache();
             _io();
+            _memoryMap();
+            _proxy();
+            _roi();
             _system();
             _operators();
         }
@@ -277,6 +321,45 @@ namespace djv
                     _print(ss.str());
                 }
             }
+
+            {
+                IO::Cache cache;
+                cache.setSequenceSize(100);
+                cache.setMax(19);
+                cache.setCurrentFrame(50);
+                const auto image = Image::Image::create(Image::Info(1, 2, Image::Type::RGB_U8));
+                for (Frame::Index i = 0; i < 100; ++i)
+                {
+                    cache.add(i, image);
+                }
+                DJV_ASSERT(20 == cache.getCount());
+                DJV_ASSERT(20 * image->getDataByteCount() == cache.getTotalByteCount());
+                DJV_ASSERT(Frame::Sequence(Frame::Range(40, 59)) == cache.getFrames());
+
+                cache.setCurrentFrame(55);
+                DJV_ASSERT(15 == cache.getCount());
+                DJV_ASSERT(15 * image->getDataByteCount() == cache.getTotalByteCount());
+                DJV_ASSERT(Frame::Sequence(Frame::Range(45, 59)) == cache.getFrames());
+                DJV_ASSERT(Frame::Sequence(Frame::Range(45, 64)) == cache.getSequence());
+
+                cache.setCurrentFrame(5);
+                DJV_ASSERT(0 == cache.getCount());
+                for (Frame::Index i = 0; i < 100; ++i)
+                {
+                    cache.add(i, image);
+                }
+                Frame::Sequence frames;
+                frames.ranges.push_back(Frame::Range(0, 14));
+                frames.ranges.push_back(Frame::Range(95, 99));
+                DJV_ASSERT(frames == cache.getFrames());
+
+                cache.setSequenceSize(10);
+                DJV_ASSERT(Frame::Sequence(Frame::Range(0, 9)) == cache.getFrames());
+                cache.clear();
+                DJV_ASSERT(0 == cache.getCount());
+                DJV_ASSERT(0 == cache.getTotalByteCount());
+                DJV_ASSERT(Frame::Sequence() == cache.getFrames());
+            }
         }
         
         void IOTest::_io()
@@ -325,7 +408,6 @@ namespace djv
                                     info.video.push_back(imageInfo);
                                     auto write = io->write(FileSystem::FileInfo(path), info);
                                     {
-                                        std::lock_guard<std::mutex> lock(write->getMutex());
                                         auto& writeQueue = write->getVideoQueue();
                                         writeQueue.addFrame(IO::VideoFrame(0, image));
                                         writeQueue.setFinished(true);
@@ -341,22 +423,15 @@ namespace djv
                                     {
                                         bool sleep = false;
                                         {
-                                            std::unique_lock<std::mutex> lock(read->getMutex(), std::try_to_lock);
-                                            if (lock.owns_lock())
+                                            auto& readQueue = read->getVideoQueue();
+                                            const bool finished = readQueue.isFinished();
+                                            if (!readQueue.isEmpty())
                                             {
-                                                auto& readQueue = read->getVideoQueue();
-                                                if (!readQueue.isEmpty())
-                                                {
-                                                    auto frame = readQueue.popFrame();
-                                                }
-                                                else if (readQueue.isFinished())
-                                                {
-                                                    running = false;
-                                                }
-                                                else
-                                                {
-                                                    sleep = true;
-                                                }
+                                                auto frame = readQueue.popFrame();
+                                            }
+                                            else if (finished)
+                                            {
+                                                running = false;
                                             }
                                             else
                                             {
@@ -378,6 +453,188 @@ namespace djv
             }
         }
         
+        void IOTest::_memoryMap()
+        {
+            if (auto context = getContext().lock())
+            {
+                auto io = context->getSystemT<AV::IO::System>();
+                // The PPM header is an odd number of bytes so 16-bit data is
+                // not aligned and is copied instead.
+                struct Test
+                {
+                    std::string extension;
+                    Image::Type type;
+                    bool memoryMapped;
+                };
+                std::vector<Test> tests =
+                {
+                    { ".cin", Image::Type::RGB_U10, true },
+                    { ".dpx", Image::Type::RGB_U10, true },
+                    { ".ppm", Image::Type::RGB_U8, true },
+                    { ".ppm", Image::Type::RGB_U16, false }
+                };
+#if defined(TIFF_FOUND)
+                const auto tiffOptions = io->getOptions(IO::TIFF::pluginName);
+                {
+                    IO::TIFF::Options options;
+                    options.compression = IO::TIFF::Compression::None;
+                    io->setOptions(IO::TIFF::pluginName, toJSON(options));
+                }
+                tests.push_back({ ".tif", Image::Type::RGB_U8, true });
+                tests.push_back({ ".tif", Image::Type::RGB_U16, true });
+#endif // TIFF_FOUND
+                for (const auto& test : tests)
+                {
+                    const Image::Type type = test.type;
+                    const std::string& extension = test.extension;
+                    const Image::Info imageInfo(32, 32, type);
+                    auto image = Image::Image::create(imageInfo);
+                    image->zero();
+
+                    std::stringstream ss;
+                    ss << "IOTest_mmap_" << type << extension;
+                    _print(ss.str());
+                    FileSystem::Path path(ss.str());
+                    {
+                        IO::Info info;
+                        info.video.push_back(imageInfo);
+                        auto write = io->write(FileSystem::FileInfo(path), info);
+                        {
+                            auto& writeQueue = write->getVideoQueue();
+                            writeQueue.addFrame(IO::VideoFrame(0, image));
+                            writeQueue.setFinished(true);
+                        }
+                        while (write->isRunning())
+                        {}
+                    }
+
+                    {
+                        auto read = io->read(FileSystem::FileInfo(path));
+                        auto image = readImage(read);
+                        DJV_ASSERT(image);
+                        DJV_ASSERT(!image->isMemoryMapped());
+                    }
+
+                    {
+                        // The renderer only uses const access to the pixels,
+                        // so a mapped image is drawn straight from the file.
+                        IO::ReadOptions options;
+                        options.memoryMap = true;
+                        auto read = io->read(FileSystem::FileInfo(path), options);
+                        read->setCacheEnabled(true);
+                        read->setCacheMaxByteCount(Memory::megabyte);
+                        auto image = readImage(read);
+                        DJV_ASSERT(image);
+                        DJV_ASSERT(test.memoryMapped == image->isMemoryMapped());
+                        const Image::Data& data = *image;
+                        const uint8_t* p = data.getData();
+                        DJV_ASSERT(p == data.getData());
+                        DJV_ASSERT(test.memoryMapped == image->isMemoryMapped());
+                    }
+                }
+#if defined(TIFF_FOUND)
+                io->setOptions(IO::TIFF::pluginName, tiffOptions);
+#endif // TIFF_FOUND
+            }
+        }
+        
+        void IOTest::_proxy()
+        {
+            {
+                DJV_ASSERT(Image::Size(100, 50) == IO::getProxySize(Image::Size(100, 50), 0));
+                DJV_ASSERT(Image::Size(50, 25) == IO::getProxySize(Image::Size(100, 50), 1));
+                DJV_ASSERT(Image::Size(13, 7) == IO::getProxySize(Image::Size(100, 50), 3));
+                DJV_ASSERT(Image::Size(13, 7) == IO::getProxySize(Image::Size(100, 50), IO::proxyMax + 1));
+                DJV_ASSERT(Image::Size(1, 1) == IO::getProxySize(Image::Size(1, 1), 3));
+                DJV_ASSERT(Image::Size() == IO::getProxySize(Image::Size(), 1));
+            }
+            
+            {
+                auto image = Image::Image::create(Image::Info(4, 2, Image::Type::L_U8));
+                for (uint16_t y = 0; y < 2; ++y)
+                {
+                    for (uint16_t x = 0; x < 4; ++x)
+                    {
+                        *image->getData(x, y) = y * 4 + x;
+                    }
+                }
+                image->setPluginName("IOTest");
+                auto proxy = IO::resizeProxyImage(image, Image::Size(2, 1));
+                DJV_ASSERT(Image::Size(2, 1) == proxy->getSize());
+                DJV_ASSERT(0 == *proxy->getData(0, 0));
+                DJV_ASSERT(2 == *proxy->getData(1, 0));
+                DJV_ASSERT("IOTest" == proxy->getPluginName());
+            }
+            
+            if (auto context = getContext().lock())
+            {
+                auto io = context->getSystemT<AV::IO::System>();
+                for (const auto& extension : { ".cin", ".dpx", ".ppm" })
+                {
+                    const Image::Info imageInfo(100, 50, Image::Type::RGB_U8);
+                    auto image = Image::Image::create(imageInfo);
+                    image->zero();
+
+                    std::stringstream ss;
+                    ss << "IOTest_proxy" << extension;
+                    _print(ss.str());
+                    FileSystem::Path path(ss.str());
+                    {
+                        IO::Info info;
+                        info.video.push_back(imageInfo);
+                        auto write = io->write(FileSystem::FileInfo(path), info);
+                        {
+                            auto& writeQueue = write->getVideoQueue();
+                            writeQueue.addFrame(IO::VideoFrame(0, image));
+                            writeQueue.setFinished(true);
+                        }
+                        while (write->isRunning())
+                        {}
+                    }
+
+                    for (size_t proxy = 0; proxy <= IO::proxyMax; ++proxy)
+                    {
+                        IO::ReadOptions options;
+                        options.proxy = proxy;
+                        auto read = io->read(FileSystem::FileInfo(path), options);
+                        const auto info = read->getInfo().get();
+                        const Image::Size size = IO::getProxySize(imageInfo.size, proxy);
+                        DJV_ASSERT(info.video.size());
+                        DJV_ASSERT(size == info.video[0].info.size);
+                        auto image = readImage(read);
+                        DJV_ASSERT(image);
+                        DJV_ASSERT(size == image->getSize());
+                    }
+                }
+            }
+        }
+
+        void IOTest::_roi()
+        {
+            const Image::Info info(4, 4, Image::Type::L_U8);
+            const std::string fileName = "IOTest_roi";
+            {
+                auto image = Image::Image::create(info);
+                memset(image->getData(), 1, image->getDataByteCount());
+                auto io = FileSystem::FileIO::create();
+                io->open(fileName, FileSystem::FileIO::Mode::Write);
+                io->write(image->getData(), image->getDataByteCount());
+            }
+            for (const auto& roi : { BBox2i(1, 1, 2, 2), BBox2i(2, 3, 4, 4), BBox2i(-2, -2, 3, 3) })
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(fileName, FileSystem::FileIO::Mode::Read);
+                auto image = IO::readROIImage(*io, info, roi);
+                DJV_ASSERT(info == image->getInfo());
+                const BBox2i bbox = roi.intersect(BBox2i(0, 0, info.size.w, info.size.h));
+                for (uint16_t y = 0; y < info.size.h; ++y)
+                {
+                    const bool inside = y >= bbox.min.y && y <= bbox.max.y;
+                    DJV_ASSERT((inside ? 1 : 0) == *image->getData(0, y));
+                }
+            }
+        }
+
         void IOTest::_system()
         {
             if (auto context = getContext().lock())
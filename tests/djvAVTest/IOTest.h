@@ -50,6 +50,9 @@ namespace djv
             void _audioQueue();
             void _cache();
             void _io();
+            void _memoryMap();
+            void _proxy();
+            void _roi();
             void _system();
             void _operators();
         };
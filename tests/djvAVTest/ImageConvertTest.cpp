@@ -33,6 +33,13 @@
 
 #include <djvCore/Context.h>
 #include <djvCore/ResourceSystem.h>
+#include <djvCore/ThreadPool.h>
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <cmath>
+#include <cstring>
 
 using namespace djv::Core;
 using namespace djv::AV;
@@ -41,38 +48,206 @@ namespace djv
 {
     namespace AVTest
     {
+        namespace
+        {
+            std::shared_ptr<Image::Data> createGradient(const Image::Info& info)
+            {
+                auto out = Image::Data::create(info);
+                const Image::Info f32Info(info.size, Image::Type::RGBA_F32);
+                auto f32 = Image::Data::create(f32Info);
+                for (uint16_t y = 0; y < info.size.h; ++y)
+                {
+                    Image::F32_T* p = reinterpret_cast<Image::F32_T*>(f32->getData(y));
+                    for (uint16_t x = 0; x < info.size.w; ++x, p += 4)
+                    {
+                        p[0] = x / static_cast<float>(info.size.w - 1);
+                        p[1] = y / static_cast<float>(info.size.h - 1);
+                        p[2] = ((x + y) % 7) / 6.F;
+                        p[3] = 1.F - p[0];
+                    }
+                }
+                auto convert = Image::Convert::create(nullptr, Image::ConvertBackend::CPU);
+                convert->process(*f32, info, *out);
+                return out;
+            }
+
+            float getMaxDifference(const Image::Data& a, const Image::Data& b)
+            {
+                const Image::Info info(a.getSize(), Image::Type::RGBA_F32);
+                auto aF32 = Image::Data::create(info);
+                auto bF32 = Image::Data::create(info);
+                auto convert = Image::Convert::create(nullptr, Image::ConvertBackend::CPU);
+                convert->process(a, info, *aF32);
+                convert->process(b, info, *bF32);
+                float out = 0.F;
+                const Image::F32_T* aP = reinterpret_cast<const Image::F32_T*>(aF32->getData());
+                const Image::F32_T* bP = reinterpret_cast<const Image::F32_T*>(bF32->getData());
+                for (size_t i = 0; i < info.size.w * info.size.h * 4; ++i)
+                {
+                    out = std::max(out, std::abs(aP[i] - bP[i]));
+                }
+                return out;
+            }
+
+        } // namespace
+
         ImageConvertTest::ImageConvertTest(const std::shared_ptr<Core::Context>& context) :
             ITest("djv::AVTest::ImageConvertTest", context)
         {}
         
         void ImageConvertTest::run()
+        {
+            _enum();
+            _cpu();
+            _compare();
+        }
+
+        void ImageConvertTest::_enum()
+        {
+            for (auto i : Image::getConvertBackendEnums())
+            {
+                std::stringstream ss;
+                ss << i;
+                std::stringstream ss2;
+                ss2 << "convert backend string: " << _getText(ss.str());
+                _print(ss2.str());
+            }
+        }
+
+        void ImageConvertTest::_cpu()
+        {
+            auto threadPool = ThreadPool::create(4);
+            for (const auto& i : { threadPool, std::shared_ptr<ThreadPool>() })
+            {
+                auto convert = Image::Convert::create(nullptr, Image::ConvertBackend::CPU, i);
+                DJV_ASSERT(Image::ConvertBackend::CPU == convert->getBackend());
+
+                {
+                    const Image::Info info(3, 100, Image::Type::L_U8);
+                    auto data = Image::Data::create(info);
+                    for (uint16_t y = 0; y < info.size.h; ++y)
+                    {
+                        for (uint16_t x = 0; x < info.size.w; ++x)
+                        {
+                            data->getData(x, y)[0] = static_cast<Image::U8_T>(x * 50 + y);
+                        }
+                    }
+                    const Image::Info info2(3, 100, Image::Type::RGBA_U8, Image::Layout(Image::Mirror(true, true), 4));
+                    auto data2 = Image::Data::create(info2);
+                    convert->process(*data, info2, *data2);
+                    for (uint16_t y = 0; y < info.size.h; ++y)
+                    {
+                        for (uint16_t x = 0; x < info.size.w; ++x)
+                        {
+                            const Image::U8_T l = data->getData(x, y)[0];
+                            const Image::U8_T* p = data2->getData(info.size.w - 1 - x, info.size.h - 1 - y);
+                            DJV_ASSERT(l == p[0]);
+                            DJV_ASSERT(l == p[1]);
+                            DJV_ASSERT(l == p[2]);
+                            DJV_ASSERT(Image::U8Range.max == p[3]);
+                        }
+                    }
+                }
+
+                {
+                    const Image::Info info(2, 1, Image::Type::RGB_U16, Image::Layout(Image::Mirror(), 1, Memory::Endian::MSB));
+                    auto data = Image::Data::create(info);
+                    const Image::U16_T values[] = { 0x1000, 0x2000, 0x3000, 0xffff, 0xffff, 0xffff };
+                    for (size_t j = 0; j < 6; ++j)
+                    {
+                        data->getData()[j * 2] = values[j] >> 8;
+                        data->getData()[j * 2 + 1] = values[j] & 0xff;
+                    }
+                    const Image::Info info2(2, 1, Image::Type::L_U16);
+                    auto data2 = Image::Data::create(info2);
+                    convert->process(*data, info2, *data2);
+                    const Image::U16_T* p = reinterpret_cast<const Image::U16_T*>(data2->getData());
+                    DJV_ASSERT(0x2000 == p[0]);
+                    DJV_ASSERT(0xffff == p[1]);
+                }
+
+                {
+                    const Image::Info info(4, 1, Image::Type::L_F32);
+                    auto data = Image::Data::create(info);
+                    Image::F32_T* p = reinterpret_cast<Image::F32_T*>(data->getData());
+                    p[0] = 0.F;
+                    p[1] = 1.F;
+                    p[2] = 2.F;
+                    p[3] = 3.F;
+                    const Image::Info info2(2, 1, Image::Type::L_F32);
+                    auto data2 = Image::Data::create(info2);
+                    convert->process(*data, info2, *data2);
+                    const Image::F32_T* p2 = reinterpret_cast<const Image::F32_T*>(data2->getData());
+                    DJV_ASSERT(.5F == p2[0]);
+                    DJV_ASSERT(2.5F == p2[1]);
+                }
+
+                for (auto type : Image::getTypeEnums())
+                {
+                    if (type != Image::Type::None && !Image::isYUVType(type))
+                    {
+                        const Image::Info info(65, 67, type);
+                        auto data = createGradient(info);
+                        const Image::Info info2(65, 67, type, Image::Layout(Image::Mirror(true, false), 4, Memory::opposite(Memory::getEndian())));
+                        auto data2 = Image::Data::create(info2);
+                        convert->process(*data, info2, *data2);
+                        auto data3 = Image::Data::create(info);
+                        convert->process(*data2, info, *data3);
+                        DJV_ASSERT(0 == memcmp(data->getData(), data3->getData(), info.getDataByteCount()));
+                    }
+                }
+            }
+        }
+
+        void ImageConvertTest::_compare()
         {
             if (auto context = getContext().lock())
             {
-                const Image::Info info(64, 64, Image::Type::L_U8);
-                auto data = Image::Data::create(info);
-                data->getData()[0] = Image::U8Range.max;
+                if (!glfwGetCurrentContext())
                 {
-                    std::stringstream ss;
-                    ss << "input: " << static_cast<uint16_t>(data->getData()[0]);
-                    _print(ss.str());
+                    _print("no OpenGL context, skipping the comparison");
+                    return;
                 }
-                
-                const Image::Info info2(64, 64, Image::Type::RGBA_U8);
-                auto data2 = Image::Data::create(info2);
-                
-                auto convert = Image::Convert::create(context->getSystemT<ResourceSystem>());
-                convert->process(*data, info2, *data2);
-                const Image::U8_T u8 = reinterpret_cast<const Image::U8_T*>(data2->getData())[0];
+                auto resourceSystem = context->getSystemT<ResourceSystem>();
+                auto glConvert = Image::Convert::create(resourceSystem);
+                DJV_ASSERT(Image::ConvertBackend::OpenGL == glConvert->getBackend());
+                auto cpuConvert = Image::Convert::create(resourceSystem, Image::ConvertBackend::CPU, ThreadPool::create());
+
+                const struct Data
                 {
-                    std::stringstream ss;
-                    ss << "output: " << static_cast<uint16_t>(u8);
-                    _print(ss.str());
+                    Image::Info in;
+                    Image::Info out;
+                    float tolerance;
+                }
+                data[] =
+                {
+                    { Image::Info(64, 64, Image::Type::L_U8), Image::Info(64, 64, Image::Type::RGBA_U8), .005F },
+                    { Image::Info(64, 64, Image::Type::RGBA_U8), Image::Info(64, 64, Image::Type::L_U8), .005F },
+                    { Image::Info(64, 64, Image::Type::LA_U16), Image::Info(64, 64, Image::Type::RGB_U8), .005F },
+                    { Image::Info(64, 64, Image::Type::RGB_U8), Image::Info(64, 64, Image::Type::RGB_U10, Image::Layout(Image::Mirror(), 4, Memory::Endian::MSB)), .005F },
+                    { Image::Info(64, 64, Image::Type::RGBA_F16), Image::Info(64, 64, Image::Type::RGB_U16, Image::Layout(Image::Mirror(false, true), 1, Memory::Endian::MSB)), .005F },
+                    { Image::Info(63, 65, Image::Type::RGB_U8, Image::Layout(Image::Mirror(true, false))), Image::Info(63, 65, Image::Type::RGBA_F32), .005F },
+                    { Image::Info(101, 77, Image::Type::RGB_U8), Image::Info(51, 39, Image::Type::RGB_U8, Image::Layout(Image::Mirror(), 4)), .02F },
+                    { Image::Info(33, 17, Image::Type::RGBA_U16), Image::Info(120, 80, Image::Type::RGBA_F32), .02F }
+                };
+                for (const auto& i : data)
+                {
+                    auto in = createGradient(i.in);
+                    auto glOut = Image::Data::create(i.out);
+                    auto cpuOut = Image::Data::create(i.out);
+                    glConvert->process(*in, i.out, *glOut);
+                    cpuConvert->process(*in, i.out, *cpuOut);
+                    const float difference = getMaxDifference(*glOut, *cpuOut);
+                    {
+                        std::stringstream ss;
+                        ss << i.in.type << " " << i.in.size << " -> " << i.out.type << " " << i.out.size <<
+                            " maximum difference: " << difference;
+                        _print(ss.str());
+                    }
+                    DJV_ASSERT(difference <= i.tolerance);
                 }
-                //DJV_ASSERT(Image::U8Range.max == u8);
             }
         }
                 
     } // namespace AVTest
 } // namespace djv
-
@@ -39,6 +39,11 @@ namespace djv
             ImageConvertTest(const std::shared_ptr<Core::Context>&);
             
             void run() override;
+
+        private:
+            void _enum();
+            void _cpu();
+            void _compare();
         };
         
     } // namespace AVTest
@@ -0,0 +1,142 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVTest/ImageDataPoolTest.h>
+
+#include <djvAV/ImageData.h>
+#include <djvAV/ImageDataPool.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        ImageDataPoolTest::ImageDataPoolTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::ImageDataPoolTest", context)
+        {}
+        
+        void ImageDataPoolTest::run()
+        {
+            {
+                DJV_ASSERT(1 == Image::DataPool::getBucketByteCount(1));
+                DJV_ASSERT(Image::dataPoolMinByteCount == Image::DataPool::getBucketByteCount(Image::dataPoolMinByteCount));
+                DJV_ASSERT(
+                    Image::dataPoolMinByteCount + Image::dataPoolPageByteCount ==
+                    Image::DataPool::getBucketByteCount(Image::dataPoolMinByteCount + 1));
+                DJV_ASSERT(
+                    Image::dataPoolHugePageByteCount * 2 ==
+                    Image::DataPool::getBucketByteCount(Image::dataPoolHugePageByteCount + 1));
+            }
+
+            {
+                auto pool = Image::DataPool::create(Image::dataPoolByteBudgetDefault, true);
+                DJV_ASSERT(Image::dataPoolByteBudgetDefault == pool->getByteBudget());
+                DJV_ASSERT(pool->hasPrefault());
+                pool->setPrefault(false);
+                DJV_ASSERT(!pool->hasPrefault());
+                DJV_ASSERT(Image::DataPoolStats() == pool->getStats());
+
+                const size_t byteCount = Image::dataPoolHugePageByteCount + 1;
+                uint8_t* buffer = pool->getBuffer(byteCount);
+                DJV_ASSERT(buffer);
+                DJV_ASSERT(0 == reinterpret_cast<uintptr_t>(buffer) % Image::dataPoolHugePageByteCount);
+                memset(buffer, 0, byteCount);
+                DJV_ASSERT(1 == pool->getStats().missCount);
+
+                pool->releaseBuffer(buffer, byteCount);
+                auto stats = pool->getStats();
+                DJV_ASSERT(1 == stats.freeCount);
+                DJV_ASSERT(Image::DataPool::getBucketByteCount(byteCount) == stats.freeByteCount);
+
+                uint8_t* buffer2 = pool->getBuffer(byteCount);
+                DJV_ASSERT(buffer == buffer2);
+                stats = pool->getStats();
+                DJV_ASSERT(1 == stats.hitCount);
+                DJV_ASSERT(0 == stats.freeCount);
+                DJV_ASSERT(0 == stats.freeByteCount);
+                pool->releaseBuffer(buffer2, byteCount);
+
+                uint8_t* small = pool->getBuffer(1);
+                DJV_ASSERT(small);
+                pool->releaseBuffer(small, 1);
+                DJV_ASSERT(1 == pool->getStats().freeCount);
+
+                pool->clear();
+                DJV_ASSERT(0 == pool->getStats().freeCount);
+            }
+
+            {
+                const size_t byteCount = Image::dataPoolMinByteCount;
+                auto pool = Image::DataPool::create(byteCount);
+                uint8_t* a = pool->getBuffer(byteCount);
+                uint8_t* b = pool->getBuffer(byteCount * 2);
+                uint8_t* c = pool->getBuffer(byteCount * 4);
+                pool->releaseBuffer(a, byteCount);
+                pool->releaseBuffer(b, byteCount * 2);
+                pool->releaseBuffer(c, byteCount * 4);
+                auto stats = pool->getStats();
+                DJV_ASSERT(1 == stats.freeCount);
+                DJV_ASSERT(byteCount == stats.freeByteCount);
+
+                pool->setByteBudget(byteCount * 2);
+                b = pool->getBuffer(byteCount * 2);
+                pool->releaseBuffer(b, byteCount * 2);
+                stats = pool->getStats();
+                DJV_ASSERT(1 == stats.freeCount);
+                DJV_ASSERT(byteCount * 2 == stats.freeByteCount);
+                DJV_ASSERT(1 == stats.evictCount);
+
+                pool->setByteBudget(0);
+                stats = pool->getStats();
+                DJV_ASSERT(0 == stats.freeCount);
+                DJV_ASSERT(2 == stats.evictCount);
+            }
+
+            {
+                const Image::Info info(512, 512, Image::Type::RGBA_U8);
+                auto pool = Image::DataPool::getGlobal();
+                const auto stats = pool->getStats();
+                const uint8_t* p = nullptr;
+                {
+                    auto data = Image::Data::create(info);
+                    p = data->getData();
+                }
+                {
+                    auto data = Image::Data::create(info);
+                    DJV_ASSERT(p == data->getData());
+                }
+                DJV_ASSERT(pool->getStats().hitCount > stats.hitCount);
+            }
+        }
+        
+    } // namespace AVTest
+} // namespace djv
+
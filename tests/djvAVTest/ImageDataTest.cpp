@@ -30,7 +30,9 @@
 #include <djvAVTest/ImageDataTest.h>
 
 #include <djvAV/ImageData.h>
+#include <djvAV/ImageUtil.h>
 
+#include <djvCore/FileIO.h>
 #include <djvCore/Memory.h>
 
 using namespace djv::Core;
@@ -50,7 +52,9 @@ namespace djv
             _layout();
             _size();
             _info();
+            _planes();
             _data();
+            _memoryMap();
             _operators();
             _serialize();
         }
@@ -211,6 +215,94 @@ namespace djv
             }
         }
         
+        void ImageDataTest::_planes()
+        {
+            {
+                const Image::Info info(3, 2, Image::Type::RGB_U8);
+                DJV_ASSERT(1 == info.getPlaneCount());
+                DJV_ASSERT(info.size == info.getPlaneSize(0));
+                DJV_ASSERT(0 == info.getPlaneByteOffset(0));
+                DJV_ASSERT(info.getScanlineByteCount() == info.getPlaneScanlineByteCount(0));
+            }
+
+            {
+                const Image::Info info(5, 3, Image::Type::YUV_420P_U8);
+                DJV_ASSERT(3 == info.getPlaneCount());
+                DJV_ASSERT(Image::Size(5, 3) == info.getPlaneSize(0));
+                DJV_ASSERT(Image::Size(3, 2) == info.getPlaneSize(1));
+                DJV_ASSERT(Image::Size(3, 2) == info.getPlaneSize(2));
+                DJV_ASSERT(0 == info.getPlaneByteOffset(0));
+                DJV_ASSERT(15 == info.getPlaneByteOffset(1));
+                DJV_ASSERT(21 == info.getPlaneByteOffset(2));
+                DJV_ASSERT(27 == info.getDataByteCount());
+            }
+
+            {
+                const Image::Info info(5, 3, Image::Type::YUV_422P_U10);
+                DJV_ASSERT(Image::Size(3, 3) == info.getPlaneSize(1));
+                DJV_ASSERT(6 == info.getPlaneScanlineByteCount(1));
+                DJV_ASSERT(30 + 18 + 18 == info.getDataByteCount());
+                DJV_ASSERT(Image::Type::RGB_U16 == Image::getRGBType(info.type));
+            }
+
+            {
+                const Image::Info info(4, 4, Image::Type::YUV_444P_U16, Image::Layout(Image::Mirror(), 4));
+                DJV_ASSERT(Image::Size(4, 4) == info.getPlaneSize(2));
+                DJV_ASSERT(3 * 4 * 8 == info.getDataByteCount());
+            }
+
+            {
+                // Video range BT.709 white, black, and red.
+                Image::Info info(2, 2, Image::Type::YUV_444P_U8);
+                info.yuvCoefficients = Image::YUVCoefficients::BT709;
+                info.yuvRange = Image::YUVRange::Video;
+                auto data = Image::Data::create(info);
+                const uint8_t yuv[3][3] =
+                {
+                    { 235, 128, 128 },
+                    {  16, 128, 128 },
+                    {  63, 102, 240 }
+                };
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    data->getPlaneData(i, 0)[0] = yuv[0][i];
+                    data->getPlaneData(i, 0)[1] = yuv[1][i];
+                    data->getPlaneData(i, 1)[0] = yuv[2][i];
+                    data->getPlaneData(i, 1)[1] = yuv[2][i];
+                }
+                auto rgb = Image::convertYUV(*data);
+                DJV_ASSERT(Image::Type::RGB_U8 == rgb->getType());
+                const uint8_t* p = rgb->getData(0);
+                DJV_ASSERT(255 == p[0] && 255 == p[1] && 255 == p[2]);
+                DJV_ASSERT(0 == p[3] && 0 == p[4] && 0 == p[5]);
+                p = rgb->getData(1);
+                DJV_ASSERT(p[0] > 250 && p[1] < 5 && p[2] < 5);
+            }
+
+            {
+                // Full range 4:2:0, the chroma is shared by each 2x2 block.
+                Image::Info info(2, 2, Image::Type::YUV_420P_U16);
+                info.yuvRange = Image::YUVRange::Full;
+                auto data = Image::Data::create(info);
+                for (uint16_t y = 0; y < 2; ++y)
+                {
+                    Image::U16_T* p = reinterpret_cast<Image::U16_T*>(data->getPlaneData(0, y));
+                    p[0] = 65535;
+                    p[1] = 0;
+                }
+                reinterpret_cast<Image::U16_T*>(data->getPlaneData(1, 0))[0] = 32768;
+                reinterpret_cast<Image::U16_T*>(data->getPlaneData(2, 0))[0] = 32768;
+                auto rgb = Image::convertYUV(*data);
+                DJV_ASSERT(Image::Type::RGB_U16 == rgb->getType());
+                for (uint16_t y = 0; y < 2; ++y)
+                {
+                    const Image::U16_T* p = reinterpret_cast<const Image::U16_T*>(rgb->getData(y));
+                    DJV_ASSERT(p[0] > 65500 && p[1] > 65500 && p[2] > 65500);
+                    DJV_ASSERT(p[3] < 35 && p[4] < 35 && p[5] < 35);
+                }
+            }
+        }
+
         void ImageDataTest::_data()
         {
             {
@@ -243,6 +335,78 @@ namespace djv
             }
         }
         
+        void ImageDataTest::_memoryMap()
+        {
+            const std::string fileName = "ImageDataTest.raw";
+            const Image::Info info(16, 4, Image::Type::RGB_U16);
+            const size_t headerByteCount = 8;
+            std::vector<uint8_t> buf(headerByteCount + 1 + info.getDataByteCount());
+            for (size_t i = 0; i < buf.size(); ++i)
+            {
+                buf[i] = static_cast<uint8_t>(i);
+            }
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(fileName, FileSystem::FileIO::Mode::Write);
+                io->write(buf.data(), buf.size());
+            }
+
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(fileName, FileSystem::FileIO::Mode::Read);
+                DJV_ASSERT(!io->isMemoryMapped());
+                io->setPos(headerByteCount);
+                DJV_ASSERT(!Image::Data::canMemoryMap(info, io));
+                auto data = Image::Data::create(info, io);
+                DJV_ASSERT(!data->isMemoryMapped());
+                DJV_ASSERT(0 == memcmp(buf.data() + headerByteCount, data->getData(), info.getDataByteCount()));
+            }
+
+            {
+                auto io = FileSystem::FileIO::create();
+                io->setMemoryMapEnabled(true);
+                DJV_ASSERT(io->isMemoryMapEnabled());
+                io->open(fileName, FileSystem::FileIO::Mode::Read);
+                DJV_ASSERT(io->isMemoryMapped());
+                io->setPos(headerByteCount);
+                DJV_ASSERT(Image::Data::canMemoryMap(info, io));
+                DJV_ASSERT(!Image::Data::canMemoryMap(Image::Info(16, 5, Image::Type::RGB_U16), io));
+                auto data = Image::Data::create(info, io);
+                DJV_ASSERT(data->isMemoryMapped());
+                const auto& constData = *data;
+                DJV_ASSERT(io->mmapP() == constData.getData());
+                DJV_ASSERT(info.getDataByteCount() == data->getDataByteCount());
+
+                data->detach();
+                DJV_ASSERT(!data->isMemoryMapped());
+                DJV_ASSERT(io->mmapP() != constData.getData());
+                DJV_ASSERT(0 == memcmp(buf.data() + headerByteCount, constData.getData(), info.getDataByteCount()));
+            }
+
+            {
+                auto io = FileSystem::FileIO::create();
+                io->setMemoryMapEnabled(true);
+                io->open(fileName, FileSystem::FileIO::Mode::Read);
+                io->setPos(headerByteCount);
+                auto data = Image::Data::create(info, io);
+                DJV_ASSERT(data->isMemoryMapped());
+                data->getData();
+                DJV_ASSERT(!data->isMemoryMapped());
+            }
+
+            {
+                // The data is not aligned for the pixel type so it is copied.
+                auto io = FileSystem::FileIO::create();
+                io->setMemoryMapEnabled(true);
+                io->open(fileName, FileSystem::FileIO::Mode::Read);
+                io->setPos(headerByteCount + 1);
+                DJV_ASSERT(!Image::Data::canMemoryMap(info, io));
+                auto data = Image::Data::create(info, io);
+                DJV_ASSERT(!data->isMemoryMapped());
+                DJV_ASSERT(0 == memcmp(buf.data() + headerByteCount + 1, data->getData(), info.getDataByteCount()));
+            }
+        }
+
         void ImageDataTest::_util()
         {
             {
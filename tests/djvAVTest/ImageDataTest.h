@@ -45,7 +45,9 @@ namespace djv
             void _layout();
             void _size();
             void _info();
+            void _planes();
             void _data();
+            void _memoryMap();
             void _util();
             void _operators();
             void _serialize();
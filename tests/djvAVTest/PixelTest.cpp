@@ -88,6 +88,35 @@ namespace djv
                 ss2 << "data type string: " << _getText(ss.str());
                 _print(ss2.str());
             }
+
+            for (auto i : Image::getYUVCoefficientsEnums())
+            {
+                std::stringstream ss;
+                ss << i;
+                std::stringstream ss2;
+                ss2 << "YUV coefficients string: " << _getText(ss.str());
+                _print(ss2.str());
+            }
+
+            for (auto i : Image::getYUVRangeEnums())
+            {
+                std::stringstream ss;
+                ss << i;
+                std::stringstream ss2;
+                ss2 << "YUV range string: " << _getText(ss.str());
+                _print(ss2.str());
+            }
+
+            for (auto i : Image::getTypeEnums())
+            {
+                DJV_ASSERT(Image::isYUVType(i) == (Image::getRGBType(i) != i));
+            }
+            DJV_ASSERT(1 == Image::getChromaShiftX(Image::Type::YUV_420P_U8));
+            DJV_ASSERT(1 == Image::getChromaShiftY(Image::Type::YUV_420P_U10));
+            DJV_ASSERT(1 == Image::getChromaShiftX(Image::Type::YUV_422P_U16));
+            DJV_ASSERT(0 == Image::getChromaShiftY(Image::Type::YUV_422P_U8));
+            DJV_ASSERT(0 == Image::getChromaShiftX(Image::Type::YUV_444P_U8));
+            DJV_ASSERT(0 == Image::getChromaShiftY(Image::Type::RGB_U8));
         }
         
         void PixelTest::_constants()
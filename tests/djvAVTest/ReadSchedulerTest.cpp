@@ -0,0 +1,140 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVTest/ReadSchedulerTest.h>
+
+#include <djvAV/ReadScheduler.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        ReadSchedulerTest::ReadSchedulerTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::ReadSchedulerTest", context)
+        {}
+        
+        void ReadSchedulerTest::run()
+        {
+            {
+                auto cancelToken = IO::CancelToken::create();
+                DJV_ASSERT(!cancelToken->isCancelled());
+                cancelToken->cancel();
+                DJV_ASSERT(cancelToken->isCancelled());
+            }
+            
+            {
+                const IO::ReadState state;
+                DJV_ASSERT(0 == state.frame);
+                DJV_ASSERT(IO::Direction::Forward == state.direction);
+                DJV_ASSERT(0 == state.sequenceSize);
+                DJV_ASSERT(!state.active);
+                DJV_ASSERT(state.visible);
+                DJV_ASSERT(state == IO::ReadState());
+            }
+            
+            {
+                IO::ReadState state;
+                state.frame = 10;
+                state.sequenceSize = 100;
+                DJV_ASSERT(
+                    IO::getReadRank(state, 10, IO::ReadType::Queue) <
+                    IO::getReadRank(state, 11, IO::ReadType::Queue));
+                DJV_ASSERT(
+                    IO::getReadRank(state, 11, IO::ReadType::Queue) <
+                    IO::getReadRank(state, 9, IO::ReadType::Queue));
+                DJV_ASSERT(
+                    IO::getReadRank(state, 99, IO::ReadType::Queue) <
+                    IO::getReadRank(state, 10, IO::ReadType::Cache));
+                state.direction = IO::Direction::Reverse;
+                DJV_ASSERT(
+                    IO::getReadRank(state, 9, IO::ReadType::Queue) <
+                    IO::getReadRank(state, 11, IO::ReadType::Queue));
+            }
+            
+            {
+                IO::ReadState state;
+                state.sequenceSize = 100;
+                state.frame = 99;
+                DJV_ASSERT(
+                    IO::getReadRank(state, 0, IO::ReadType::Queue) <
+                    IO::getReadRank(state, 90, IO::ReadType::Queue));
+            }
+            
+            {
+                IO::ReadState active;
+                active.active = true;
+                IO::ReadState visible;
+                IO::ReadState hidden;
+                hidden.visible = false;
+                DJV_ASSERT(
+                    IO::getReadRank(active, 1000, IO::ReadType::Queue) <
+                    IO::getReadRank(visible, 0, IO::ReadType::Queue));
+                DJV_ASSERT(
+                    IO::getReadRank(visible, 1000, IO::ReadType::Queue) <
+                    IO::getReadRank(active, 0, IO::ReadType::Cache));
+                DJV_ASSERT(
+                    IO::getReadRank(visible, 1000, IO::ReadType::Cache) <
+                    IO::getReadRank(hidden, 0, IO::ReadType::Queue));
+            }
+            
+            {
+                auto threadPool = ThreadPool::create(2);
+                auto readScheduler = IO::ReadScheduler::create(threadPool);
+                const UID reader = readScheduler->addReader();
+                IO::ReadState state;
+                state.active = true;
+                state.sequenceSize = 100;
+                readScheduler->setReadState(reader, state);
+                std::vector<std::future<Frame::Index> > futures;
+                for (Frame::Index i = 0; i < 100; ++i)
+                {
+                    futures.push_back(readScheduler->addRead<Frame::Index>(
+                        reader,
+                        i,
+                        i % 2 ? IO::ReadType::Queue : IO::ReadType::Cache,
+                        [i]
+                        {
+                            return i;
+                        }));
+                }
+                for (Frame::Index i = 0; i < 100; ++i)
+                {
+                    DJV_ASSERT(i == futures[i].get());
+                }
+                DJV_ASSERT(0 == readScheduler->getPendingCount());
+                readScheduler->removeReader(reader);
+            }
+        }
+
+    } // namespace AVTest
+} // namespace djv
+
@@ -0,0 +1,200 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVTest/TranscodeTest.h>
+
+#include <djvAV/IO.h>
+#include <djvAV/Transcode.h>
+
+#include <djvCore/Context.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/Memory.h>
+#include <djvCore/Timer.h>
+
+#include <thread>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        TranscodeTest::TranscodeTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::TranscodeTest", context)
+        {}
+        
+        void TranscodeTest::run()
+        {
+            _stats();
+            _transcode();
+        }
+
+        void TranscodeTest::_stats()
+        {
+            {
+                const IO::TranscodeStats stats;
+                DJV_ASSERT(0.F == stats.getFramesPerSecond());
+                DJV_ASSERT(0.F == stats.getMegabytesPerSecond());
+                DJV_ASSERT(0.F == stats.getReadUtilization());
+                DJV_ASSERT(0.F == stats.getResizeUtilization());
+                DJV_ASSERT(0.F == stats.getWriteUtilization());
+            }
+            
+            {
+                IO::TranscodeStats stats;
+                stats.frameCount = 48;
+                stats.byteCount = 4 * Memory::megabyte;
+                stats.time = 2.F;
+                stats.readTime = 2.F;
+                stats.resizeTime = .5F;
+                stats.writeTime = 1.F;
+                DJV_ASSERT(24.F == stats.getFramesPerSecond());
+                DJV_ASSERT(2.F == stats.getMegabytesPerSecond());
+                DJV_ASSERT(1.F == stats.getReadUtilization());
+                DJV_ASSERT(.25F == stats.getResizeUtilization());
+                DJV_ASSERT(.5F == stats.getWriteUtilization());
+            }
+        }
+
+        void TranscodeTest::_transcode()
+        {
+            if (auto context = getContext().lock())
+            {
+                auto io = context->getSystemT<IO::System>();
+                const Frame::Sequence sequence(1, 10);
+                const Image::Info imageInfo(64, 32, Image::Type::RGB_U8);
+
+                FileSystem::FileInfo input;
+                input.setPath(FileSystem::Path("TranscodeTest.1-10.ppm"), FileSystem::FileType::Sequence, false);
+                {
+                    IO::Info info;
+                    info.video.push_back(IO::VideoInfo(imageInfo, Time::Speed(), sequence));
+                    auto write = io->write(input, info);
+                    auto& writeQueue = write->getVideoQueue();
+                    for (Frame::Index i = 0; i < static_cast<Frame::Index>(sequence.getSize()); ++i)
+                    {
+                        auto image = Image::Image::create(imageInfo);
+                        image->zero();
+                        while (writeQueue.getCount() >= writeQueue.getMax())
+                        {
+                            std::this_thread::sleep_for(Time::getTime(Time::TimerValue::Fast));
+                        }
+                        writeQueue.addFrame(IO::VideoFrame(sequence.getFrame(i), image));
+                    }
+                    writeQueue.setFinished(true);
+                    while (write->isRunning())
+                    {}
+                }
+
+                FileSystem::FileInfo output;
+                output.setPath(FileSystem::Path("TranscodeTest_output.1-10.ppm"), FileSystem::FileType::Sequence, false);
+                const Image::Size resize(32, 16);
+                {
+                    IO::ReadOptions readOptions;
+                    readOptions.videoQueueSize = 4;
+                    auto read = io->read(input, readOptions);
+                    auto info = read->getInfo().get();
+                    DJV_ASSERT(info.video.size());
+                    info.video[0].info.size = resize;
+                    IO::WriteOptions writeOptions;
+                    writeOptions.videoQueueSize = 4;
+                    auto write = io->write(output, info, writeOptions);
+                    IO::TranscodeOptions options;
+                    options.resize = resize;
+                    options.threadPool = io->getThreadPool();
+                    auto transcode = IO::Transcode::create(read, info, write, options);
+                    while (transcode->isRunning())
+                    {
+                        std::this_thread::sleep_for(Time::getTime(Time::TimerValue::Fast));
+                    }
+                    DJV_ASSERT(transcode->getError().empty());
+                    const auto stats = transcode->getStats();
+                    {
+                        std::stringstream ss;
+                        ss << "frames: " << stats.frameCount << "/" << stats.frameTotal;
+                        _print(ss.str());
+                    }
+                    {
+                        std::stringstream ss;
+                        ss << "fps: " << stats.getFramesPerSecond();
+                        _print(ss.str());
+                    }
+                    {
+                        std::stringstream ss;
+                        ss << "read utilization: " << stats.getReadUtilization();
+                        _print(ss.str());
+                    }
+                    {
+                        std::stringstream ss;
+                        ss << "resize utilization: " << stats.getResizeUtilization();
+                        _print(ss.str());
+                    }
+                    {
+                        std::stringstream ss;
+                        ss << "write utilization: " << stats.getWriteUtilization();
+                        _print(ss.str());
+                    }
+                    DJV_ASSERT(sequence.getSize() == stats.frameTotal);
+                    DJV_ASSERT(sequence.getSize() == stats.frameCount);
+                    DJV_ASSERT(sequence.getSize() * Image::Info(resize, imageInfo.type).getDataByteCount() == stats.byteCount);
+                }
+
+                {
+                    // The pipeline stops when the writer fails.
+                    FileSystem::FileInfo badOutput;
+                    badOutput.setPath(FileSystem::Path("TranscodeTest_missing/output.1-10.ppm"), FileSystem::FileType::Sequence, false);
+                    IO::ReadOptions readOptions;
+                    readOptions.videoQueueSize = 1;
+                    auto read = io->read(input, readOptions);
+                    const auto info = read->getInfo().get();
+                    IO::WriteOptions writeOptions;
+                    writeOptions.videoQueueSize = 1;
+                    auto write = io->write(badOutput, info, writeOptions);
+                    auto transcode = IO::Transcode::create(read, info, write);
+                    while (transcode->isRunning())
+                    {
+                        std::this_thread::sleep_for(Time::getTime(Time::TimerValue::Fast));
+                    }
+                    DJV_ASSERT(!transcode->getError().empty());
+                    DJV_ASSERT(!write->getError().empty());
+                }
+
+                {
+                    auto read = io->read(output);
+                    const auto info = read->getInfo().get();
+                    DJV_ASSERT(info.video.size());
+                    DJV_ASSERT(resize == info.video[0].info.size);
+                    DJV_ASSERT(sequence.getSize() == info.video[0].sequence.getSize());
+                }
+            }
+        }
+                
+    } // namespace AVTest
+} // namespace djv
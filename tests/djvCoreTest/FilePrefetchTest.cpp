@@ -0,0 +1,166 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCoreTest/FilePrefetchTest.h>
+
+#include <djvCore/FileIO.h>
+#include <djvCore/FilePrefetch.h>
+
+#include <sstream>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        FilePrefetchTest::FilePrefetchTest(const std::shared_ptr<Context>& context) :
+            ITest("djv::CoreTest::FilePrefetchTest", context)
+        {}
+        
+        void FilePrefetchTest::run()
+        {
+            _stats();
+            _prefetch();
+            _maxCount();
+        }
+
+        void FilePrefetchTest::_stats()
+        {
+            {
+                const FileSystem::FilePrefetchStats stats;
+                DJV_ASSERT(stats == stats);
+                DJV_ASSERT(0 == stats.fileCount);
+                DJV_ASSERT(0 == stats.consumedByteCount);
+            }
+
+            {
+                auto prefetch = FileSystem::FilePrefetch::create();
+                DJV_ASSERT(FileSystem::filePrefetchMaxCountDefault == prefetch->getMaxCount());
+                DJV_ASSERT(FileSystem::FilePrefetchStats() == prefetch->getStats());
+                prefetch->wait();
+            }
+        }
+
+        void FilePrefetchTest::_prefetch()
+        {
+            const std::string fileName = "FilePrefetchTest";
+            const std::string text = "Hello world!";
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(fileName, FileSystem::FileIO::Mode::Write);
+                io->write(text);
+            }
+
+            {
+                DJV_ASSERT(text.size() == FileSystem::FileIO::prefetch(fileName));
+                DJV_ASSERT(0 == FileSystem::FileIO::prefetch("FilePrefetchTest.missing"));
+            }
+
+            {
+                auto prefetch = FileSystem::FilePrefetch::create();
+                prefetch->add({ fileName, fileName, "FilePrefetchTest.missing" });
+                prefetch->wait();
+                auto stats = prefetch->getStats();
+                {
+                    std::stringstream ss;
+                    ss << "prefetch files: " << stats.fileCount << ", bytes: " << stats.byteCount;
+                    _print(ss.str());
+                }
+                DJV_ASSERT(0 == stats.queueCount);
+                DJV_ASSERT(1 == stats.fileCount);
+                DJV_ASSERT(text.size() == stats.byteCount);
+
+                prefetch->add({ fileName });
+                prefetch->wait();
+                DJV_ASSERT(1 == prefetch->getStats().fileCount);
+
+                prefetch->consume(fileName);
+                prefetch->consume(fileName);
+                stats = prefetch->getStats();
+                DJV_ASSERT(1 == stats.consumedFileCount);
+                DJV_ASSERT(text.size() == stats.consumedByteCount);
+
+                prefetch->clear();
+                prefetch->wait();
+            }
+
+            {
+                // Files opened before they are prefetched are counted as
+                // late instead of prefetched.
+                auto prefetch = FileSystem::FilePrefetch::create();
+                prefetch->add({ fileName });
+                prefetch->consume(fileName);
+                prefetch->wait();
+                const auto stats = prefetch->getStats();
+                DJV_ASSERT(0 == stats.queueCount);
+                DJV_ASSERT(1 == stats.consumedFileCount + stats.lateFileCount);
+                DJV_ASSERT(stats.consumedFileCount == stats.fileCount);
+            }
+
+            {
+                auto prefetch = FileSystem::FilePrefetch::getGlobal();
+                const auto stats = prefetch->getStats();
+                prefetch->add({ fileName });
+                prefetch->wait();
+                auto io = FileSystem::FileIO::create();
+                io->open(fileName, FileSystem::FileIO::Mode::Read);
+                DJV_ASSERT(stats.consumedFileCount + 1 == prefetch->getStats().consumedFileCount);
+            }
+        }
+
+        void FilePrefetchTest::_maxCount()
+        {
+            std::vector<std::string> fileNames;
+            for (size_t i = 0; i < 3; ++i)
+            {
+                std::stringstream ss;
+                ss << "FilePrefetchTest." << i;
+                fileNames.push_back(ss.str());
+                auto io = FileSystem::FileIO::create();
+                io->open(fileNames.back(), FileSystem::FileIO::Mode::Write);
+                io->write(fileNames.back());
+            }
+            auto prefetch = FileSystem::FilePrefetch::create(2);
+            DJV_ASSERT(2 == prefetch->getMaxCount());
+            prefetch->add(fileNames);
+            prefetch->wait();
+            const auto stats = prefetch->getStats();
+            DJV_ASSERT(stats.fileCount <= 2);
+
+            // The last file was dropped from the queue.
+            prefetch->consume(fileNames[2]);
+            DJV_ASSERT(0 == prefetch->getStats().consumedFileCount);
+            DJV_ASSERT(0 == prefetch->getStats().lateFileCount);
+            prefetch->consume(fileNames[0]);
+            DJV_ASSERT(1 == prefetch->getStats().consumedFileCount);
+        }
+
+    } // namespace CoreTest
+} // namespace djv
@@ -72,6 +72,13 @@ namespace djv
                 _print(ss.str());
             }
             
+            {
+                std::stringstream ss;
+                ss << "CPU cores: " << OS::getCoreCount();
+                _print(ss.str());
+                DJV_ASSERT(OS::getCoreCount() > 0);
+            }
+            
             {
                 std::stringstream ss;
                 ss << "Terminal width: " << OS::getTerminalWidth();
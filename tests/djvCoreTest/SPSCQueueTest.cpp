@@ -0,0 +1,123 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCoreTest/SPSCQueueTest.h>
+
+#include <djvCore/SPSCQueue.h>
+
+#include <thread>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        SPSCQueueTest::SPSCQueueTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::CoreTest::SPSCQueueTest", context)
+        {}
+        
+        void SPSCQueueTest::run()
+        {
+            {
+                const SPSCQueue<int> queue;
+                DJV_ASSERT(0 == queue.getCapacity());
+                DJV_ASSERT(0 == queue.getCount());
+                DJV_ASSERT(queue.isEmpty());
+                DJV_ASSERT(!queue.isFinished());
+                int value = 0;
+                DJV_ASSERT(!queue.peek(value));
+            }
+            
+            {
+                SPSCQueue<int> queue;
+                queue.setCapacity(2);
+                DJV_ASSERT(2 == queue.getCapacity());
+                DJV_ASSERT(queue.push(1));
+                DJV_ASSERT(queue.push(2));
+                DJV_ASSERT(!queue.push(3));
+                DJV_ASSERT(3 == queue.getCount());
+                int value = 0;
+                DJV_ASSERT(queue.peek(value));
+                DJV_ASSERT(1 == value);
+                for (int i = 1; i <= 3; ++i)
+                {
+                    DJV_ASSERT(queue.pop(value));
+                    DJV_ASSERT(i == value);
+                }
+                DJV_ASSERT(!queue.pop(value));
+                queue.push(4);
+                queue.push(5);
+                queue.push(6);
+                queue.clear();
+                DJV_ASSERT(queue.isEmpty());
+                DJV_ASSERT(!queue.pop(value));
+                queue.push(7);
+                DJV_ASSERT(queue.pop(value));
+                DJV_ASSERT(7 == value);
+                queue.setFinished(true);
+                DJV_ASSERT(queue.isFinished());
+            }
+            
+            {
+                SPSCQueue<int> queue;
+                queue.setCapacity(4);
+                const int count = 10000;
+                std::thread thread(
+                    [&queue, count]
+                    {
+                        for (int i = 0; i < count; ++i)
+                        {
+                            queue.push(i);
+                        }
+                        queue.setFinished(true);
+                    });
+                int next = 0;
+                while (true)
+                {
+                    const bool finished = queue.isFinished();
+                    int value = 0;
+                    if (queue.pop(value))
+                    {
+                        DJV_ASSERT(next == value);
+                        ++next;
+                    }
+                    else if (finished)
+                    {
+                        break;
+                    }
+                }
+                thread.join();
+                DJV_ASSERT(count == next);
+            }
+        }
+        
+    } // namespace CoreTest
+} // namespace djv
+
@@ -0,0 +1,116 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCoreTest/ThreadPoolTest.h>
+
+#include <djvCore/OS.h>
+#include <djvCore/ThreadPool.h>
+
+#include <atomic>
+#include <sstream>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        ThreadPoolTest::ThreadPoolTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::CoreTest::ThreadPoolTest", context)
+        {}
+        
+        void ThreadPoolTest::run()
+        {
+            {
+                auto threadPool = ThreadPool::create();
+                DJV_ASSERT(OS::getCoreCount() == threadPool->getThreadCount());
+            }
+            
+            {
+                auto threadPool = ThreadPool::create(4);
+                DJV_ASSERT(4 == threadPool->getThreadCount());
+                std::vector<std::future<int> > futures;
+                for (int i = 0; i < 1000; ++i)
+                {
+                    futures.push_back(threadPool->addTaskFuture<int>(
+                        [i]
+                        {
+                            return i;
+                        },
+                        i % 2 ? TaskPriority::High : TaskPriority::Low));
+                }
+                for (int i = 0; i < 1000; ++i)
+                {
+                    DJV_ASSERT(i == futures[i].get());
+                }
+                const auto stats = threadPool->getStats();
+                DJV_ASSERT(4 == stats.threadCount);
+                DJV_ASSERT(0 == stats.queueCount);
+                DJV_ASSERT(stats.taskCount <= 1000);
+                std::stringstream ss;
+                ss << "steal count: " << stats.stealCount;
+                _print(ss.str());
+            }
+            
+            {
+                std::atomic<size_t> count(0);
+                {
+                    auto threadPool = ThreadPool::create(2);
+                    for (size_t i = 0; i < 100; ++i)
+                    {
+                        threadPool->addTask(
+                            [&count]
+                            {
+                                ++count;
+                            });
+                    }
+                }
+                DJV_ASSERT(100 == count);
+            }
+            
+            {
+                auto threadPool = ThreadPool::create(1);
+                auto future = threadPool->addTaskFuture<bool>(
+                    []
+                    {
+                        throw std::runtime_error("error");
+                        return true;
+                    });
+                try
+                {
+                    future.get();
+                    DJV_ASSERT(false);
+                }
+                catch (const std::exception&)
+                {}
+            }
+        }
+        
+    } // namespace CoreTest
+} // namespace djv
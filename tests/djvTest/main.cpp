@@ -39,6 +39,7 @@
 #include <djvCoreTest/EventTest.h>
 #include <djvCoreTest/FileIOTest.h>
 #include <djvCoreTest/FileInfoTest.h>
+#include <djvCoreTest/FilePrefetchTest.h>
 #include <djvCoreTest/FrameTest.h>
 #include <djvCoreTest/IEventSystemTest.h>
 #include <djvCoreTest/ISystemTest.h>
@@ -52,10 +53,12 @@
 #include <djvCoreTest/PathTest.h>
 #include <djvCoreTest/PicoJSONTest.h>
 #include <djvCoreTest/RangeTest.h>
+#include <djvCoreTest/SPSCQueueTest.h>
 #include <djvCoreTest/SpeedTest.h>
 #include <djvCoreTest/StringFormatTest.h>
 #include <djvCoreTest/StringTest.h>
 #include <djvCoreTest/TextSystemTest.h>
+#include <djvCoreTest/ThreadPoolTest.h>
 #include <djvCoreTest/TimeTest.h>
 #include <djvCoreTest/ValueObserverTest.h>
 #include <djvCoreTest/VectorTest.h>
@@ -64,18 +67,23 @@
 #include <djvAVTest/AudioDataTest.h>
 #include <djvAVTest/AudioTest.h>
 #include <djvAVTest/ColorTest.h>
+#include <djvAVTest/DiskCacheTest.h>
 #include <djvAVTest/EnumTest.h>
 #include <djvAVTest/FontSystemTest.h>
+#include <djvAVTest/FrameCacheTest.h>
 #include <djvAVTest/IOTest.h>
 #include <djvAVTest/ImageConvertTest.h>
+#include <djvAVTest/ImageDataPoolTest.h>
 #include <djvAVTest/ImageDataTest.h>
 #include <djvAVTest/ImageTest.h>
 #include <djvAVTest/OCIOSystemTest.h>
 #include <djvAVTest/OCIOTest.h>
 #include <djvAVTest/PixelTest.h>
+#include <djvAVTest/ReadSchedulerTest.h>
 #include <djvAVTest/Render2DTest.h>
 #include <djvAVTest/ThumbnailSystemTest.h>
 #include <djvAVTest/TagsTest.h>
+#include <djvAVTest/TranscodeTest.h>
 
 #include <djvUITest/EnumTest.h>
 #include <djvUITest/WidgetTest.h>
@@ -111,6 +119,7 @@ int main(int argc, char ** argv)
         tests.emplace_back(new CoreTest::EventTest(context));
         tests.emplace_back(new CoreTest::FileIOTest(context));
         tests.emplace_back(new CoreTest::FileInfoTest(context));
+        tests.emplace_back(new CoreTest::FilePrefetchTest(context));
         tests.emplace_back(new CoreTest::FrameTest(context));
         tests.emplace_back(new CoreTest::IEventSystemTest(context));
         tests.emplace_back(new CoreTest::ISystemTest(context));
@@ -124,10 +133,12 @@ int main(int argc, char ** argv)
         tests.emplace_back(new CoreTest::PathTest(context));
         tests.emplace_back(new CoreTest::PicoJSONTest(context));
         tests.emplace_back(new CoreTest::RangeTest(context));
+        tests.emplace_back(new CoreTest::SPSCQueueTest(context));
         tests.emplace_back(new CoreTest::SpeedTest(context));
         tests.emplace_back(new CoreTest::StringFormatTest(context));
         tests.emplace_back(new CoreTest::StringTest(context));
         tests.emplace_back(new CoreTest::TextSystemTest(context));
+        tests.emplace_back(new CoreTest::ThreadPoolTest(context));
         tests.emplace_back(new CoreTest::TimeTest(context));
         tests.emplace_back(new CoreTest::ValueObserverTest(context));
         tests.emplace_back(new CoreTest::VectorTest(context));
@@ -136,18 +147,23 @@ int main(int argc, char ** argv)
         tests.emplace_back(new AVTest::AudioDataTest(context));
         tests.emplace_back(new AVTest::AudioTest(context));
         tests.emplace_back(new AVTest::ColorTest(context));
+        tests.emplace_back(new AVTest::DiskCacheTest(context));
         tests.emplace_back(new AVTest::EnumTest(context));
         tests.emplace_back(new AVTest::FontSystemTest(context));
+        tests.emplace_back(new AVTest::FrameCacheTest(context));
         tests.emplace_back(new AVTest::IOTest(context));
         tests.emplace_back(new AVTest::ImageConvertTest(context));
+        tests.emplace_back(new AVTest::ImageDataPoolTest(context));
         tests.emplace_back(new AVTest::ImageDataTest(context));
         tests.emplace_back(new AVTest::ImageTest(context));
         tests.emplace_back(new AVTest::OCIOSystemTest(context));
         tests.emplace_back(new AVTest::OCIOTest(context));
         tests.emplace_back(new AVTest::PixelTest(context));
+        tests.emplace_back(new AVTest::ReadSchedulerTest(context));
         tests.emplace_back(new AVTest::Render2DTest(context));
         tests.emplace_back(new AVTest::ThumbnailSystemTest(context));
         tests.emplace_back(new AVTest::TagsTest(context));
+        tests.emplace_back(new AVTest::TranscodeTest(context));
 
         tests.emplace_back(new UITest::EnumTest(context));
         tests.emplace_back(new UITest::WidgetTest(context));